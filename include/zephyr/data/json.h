@@ -758,6 +758,195 @@ int json_obj_encode(const struct json_obj_descr *descr, size_t descr_len,
 int json_arr_encode(const struct json_obj_descr *descr, const void *val,
 		    json_append_bytes_t append_bytes, void *data);
 
+/** Maximum nesting depth of objects and arrays accepted by the streaming parser. */
+#define JSON_STREAM_MAX_DEPTH 32
+
+/** Maximum nesting depth of objects and arrays supported by the resumable encoder. */
+#define JSON_ENCODER_MAX_DEPTH 8
+
+/**
+ * @brief Token reported by the streaming parser.
+ *
+ * String tokens do not include the quotes, and are not unescaped. Number
+ * tokens are the number's text, not converted.
+ */
+struct json_stream_token {
+	/** JSON_TOK_OBJECT_START, JSON_TOK_OBJECT_END, JSON_TOK_ARRAY_START,
+	 * JSON_TOK_ARRAY_END, JSON_TOK_STRING, JSON_TOK_NUMBER, JSON_TOK_TRUE,
+	 * JSON_TOK_FALSE or JSON_TOK_NULL.
+	 */
+	enum json_tokens type;
+	/** Token text, only valid during the callback. */
+	const char *start;
+	/** Length of the token text. */
+	size_t len;
+	/** Nesting level of the token, 0 for the top-level value. */
+	uint8_t depth;
+	/** The string is an object key. */
+	bool key;
+	/** More chunks of this string follow, see json_stream_init(). */
+	bool partial;
+};
+
+/**
+ * @brief Callback invoked by the streaming parser for each token.
+ *
+ * @param tok The token.
+ * @param user_data User-provided pointer
+ *
+ * @return 0 to continue parsing, or a negative number to stop it (which
+ * will be propagated to the return value of json_stream_feed()).
+ */
+typedef int (*json_stream_cb_t)(const struct json_stream_token *tok,
+				void *user_data);
+
+/**
+ * @brief Streaming parser state
+ *
+ * Only to be used through the json_stream_*() functions.
+ */
+struct json_stream {
+	json_stream_cb_t cb;
+	void *user_data;
+	char *buf;
+	size_t buf_size;
+	size_t buf_used;
+	uint32_t objects;
+	uint8_t depth;
+	uint8_t expect;
+	uint8_t lex;
+	uint8_t lex_count;
+	uint8_t lit;
+	bool key;
+	bool partial;
+};
+
+/**
+ * @brief Frame of the resumable encoder, one per nesting level.
+ */
+struct json_encoder_frame {
+	const struct json_obj_descr *descr;
+	const char *val;
+	size_t len;
+	size_t idx;
+	uint8_t step;
+	bool array;
+};
+
+/**
+ * @brief Resumable encoder state
+ *
+ * Only to be used through the json_*_encoder_init() and json_encoder_write()
+ * functions.
+ */
+struct json_encoder {
+	struct json_encoder_frame stack[JSON_ENCODER_MAX_DEPTH];
+	char *out;
+	size_t out_size;
+	size_t out_used;
+	size_t piece_off;
+	uint8_t depth;
+	uint8_t sub;
+};
+
+/**
+ * @brief Initialize the streaming parser
+ *
+ * The streaming parser tokenizes a JSON value provided in fragments of any
+ * size, for example the fragments of a net_buf chain as they are received,
+ * and reports each token to @a cb. The fragments are not modified.
+ *
+ * A token contained in a single fragment is reported pointing to the
+ * fragment. A token spanning several fragments is gathered in @a buf, of
+ * @a buf_size bytes. A string longer than @a buf_size is reported in
+ * chunks with the partial flag set on all but the last one, while a number
+ * longer than @a buf_size is an error. With a @a buf_size of 0, any token
+ * spanning several fragments is an error.
+ *
+ * The same liberties as json_obj_parse() are taken: strings are not
+ * unescaped, and no UTF-8 validation is performed.
+ *
+ * @param stream Parser state
+ * @param buf Buffer for tokens spanning several fragments
+ * @param buf_size Size of @a buf, in bytes
+ * @param cb Function called for each token
+ * @param user_data Data pointer to be passed to @a cb
+ */
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data);
+
+/**
+ * @brief Feed a fragment to the streaming parser
+ *
+ * @param stream Parser state
+ * @param data Fragment of the JSON-encoded value
+ * @param len Length of the fragment
+ *
+ * @return 0 if the fragment has been parsed. -EINVAL if the value is
+ * malformed, -ENOMEM if a number does not fit in the token buffer or a
+ * token spans fragments with a buffer of size 0, or the error returned by
+ * the callback. Once an error is returned, the
+ * parser must be initialized again.
+ */
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Signal the end of the value to the streaming parser
+ *
+ * @param stream Parser state
+ *
+ * @return 0 if a complete value has been parsed, or a negative error code
+ * as for json_stream_feed(). -EINVAL if the value is incomplete.
+ */
+int json_stream_finish(struct json_stream *stream);
+
+/**
+ * @brief Initialize a resumable object encoding
+ *
+ * The resumable encoder produces the same output as json_obj_encode(), in
+ * chunks of bounded size written by json_encoder_write(), so the whole
+ * encoded object never needs to be held in memory.
+ *
+ * @param enc Encoder state
+ * @param descr Pointer to the descriptor array
+ * @param descr_len Number of elements in the descriptor array
+ * @param val Struct holding the values, which must not change until the
+ * encoding is complete
+ */
+void json_obj_encoder_init(struct json_encoder *enc,
+			   const struct json_obj_descr *descr,
+			   size_t descr_len, const void *val);
+
+/**
+ * @brief Initialize a resumable array encoding
+ *
+ * Same as json_obj_encoder_init(), for the output of json_arr_encode().
+ *
+ * @param enc Encoder state
+ * @param descr Pointer to the descriptor array
+ * @param val Struct holding the values, which must not change until the
+ * encoding is complete
+ */
+void json_arr_encoder_init(struct json_encoder *enc,
+			   const struct json_obj_descr *descr,
+			   const void *val);
+
+/**
+ * @brief Write the next chunk of a resumable encoding
+ *
+ * The chunk is not NUL terminated.
+ *
+ * @param enc Encoder state
+ * @param buf Buffer to store the chunk
+ * @param buf_size Size of buffer, in bytes
+ *
+ * @return Number of bytes written, 0 once the encoding is complete, or a
+ * negative error code. -ENOMEM if the values are nested deeper than
+ * JSON_ENCODER_MAX_DEPTH.
+ */
+ssize_t json_encoder_write(struct json_encoder *enc, char *buf,
+			   size_t buf_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -31,6 +31,36 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage RAM index entry
+ *
+ * @param addr Address of the most recent allocation table entry of the id
+ * @param id Id of the entry
+ */
+struct nvs_index_entry {
+	uint32_t addr;
+	uint16_t id;
+};
+
+/**
+ * @brief Non-volatile Storage garbage collection state
+ *
+ * @param sec_addr Address of the sector being garbage collected
+ * @param addr Address of the next allocation table entry to collect
+ * @param stop_addr Address of the last allocation table entry to collect
+ * @param pending Space in the write sector needed by the entries still to be moved
+ * @param done Flag indicating if all allocation table entries were collected
+ * @param active Flag indicating if the garbage collection is in progress
+ */
+struct nvs_gc_state {
+	uint32_t sec_addr;
+	uint32_t addr;
+	uint32_t stop_addr;
+	uint32_t pending;
+	bool done;
+	bool active;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -44,6 +74,13 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param lookup_cache Lookup cache, with CONFIG_NVS_LOOKUP_CACHE
+ * @param index RAM index sorted by id, with CONFIG_NVS_RAM_INDEX
+ * @param index_cnt Number of entries in the RAM index
+ * @param index_complete Flag indicating if the RAM index holds all ids
+ * @param gc Pending garbage collection, with CONFIG_NVS_GC_INCREMENTAL
+ * @param gc_work Background garbage collection work item, with CONFIG_NVS_GC_WORK
+ * @param gc_sync Used to wait for the background garbage collection to stop
  */
 struct nvs_fs {
 	off_t offset;
@@ -58,6 +95,18 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_RAM_INDEX
+	struct nvs_index_entry index[CONFIG_NVS_RAM_INDEX_SIZE];
+	uint32_t index_cnt;
+	bool index_complete;
+#endif
+#if CONFIG_NVS_GC_INCREMENTAL
+	struct nvs_gc_state gc;
+#endif
+#if CONFIG_NVS_GC_WORK
+	struct k_work gc_work;
+	struct k_work_sync gc_sync;
+#endif
 };
 
 /**
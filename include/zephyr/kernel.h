@@ -2738,6 +2738,119 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 
 /** @} */
 
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_mpmcq_slot {
+	atomic_t seq;
+	void *data;
+};
+
+struct k_mpmcq {
+	atomic_t head;
+	atomic_t tail;
+	struct k_mpmcq_slot *slots;
+	uint32_t mask;
+	atomic_t waiters;
+	_wait_q_t wait_q;
+	struct k_spinlock lock;
+};
+
+#define Z_MPMCQ_INITIALIZER(obj, q_slots, q_num_entries) \
+	{ \
+	.slots = q_slots, \
+	.mask = (q_num_entries) - 1U, \
+	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup mpmcq_apis Lock-free MPMC Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Initialize a lock-free MPMC queue.
+ *
+ * This routine initializes a bounded multi-producer multi-consumer queue,
+ * prior to its first use. Items are passed through @a slots without taking
+ * a lock, so uncontended put and get operations never disable interrupts.
+ * Only supervisor threads and ISRs may use the queue.
+ *
+ * @param q Address of the queue.
+ * @param slots Array of @a num_entries slots used to hold the items.
+ * @param num_entries Maximum number of queued items, a power of two
+ *                    greater than 1.
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if @a num_entries is not a power of two greater than 1
+ */
+int k_mpmcq_init(struct k_mpmcq *q, struct k_mpmcq_slot *slots,
+		 uint32_t num_entries);
+
+/**
+ * @brief Add an item to a lock-free MPMC queue.
+ *
+ * The queue only stores the pointer, so unlike k_fifo_put() the item does
+ * not need a reserved first word. If a thread is waiting on the queue it
+ * is woken up to fetch the item.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ * @param data Item to add, must not be NULL.
+ *
+ * @retval 0 on success
+ * @retval -ENOMEM if the queue is full
+ */
+int k_mpmcq_put(struct k_mpmcq *q, void *data);
+
+/**
+ * @brief Get an item from a lock-free MPMC queue.
+ *
+ * This routine removes the oldest item from @a q in a "first in, first
+ * out" manner.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ * @param timeout Non-negative waiting period to obtain an item,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the item if successful; NULL if returned
+ * without waiting, or waiting period timed out.
+ */
+void *k_mpmcq_get(struct k_mpmcq *q, k_timeout_t timeout);
+
+/**
+ * @brief Statically define and initialize a lock-free MPMC queue.
+ *
+ * The queue can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_mpmcq <name>; @endcode
+ *
+ * @param name Name of the queue.
+ * @param q_num_entries Maximum number of queued items, a power of two
+ *                      greater than 1.
+ */
+#define K_MPMCQ_DEFINE(name, q_num_entries)                              \
+	BUILD_ASSERT((q_num_entries) > 1 &&                              \
+		     ((q_num_entries) & ((q_num_entries) - 1)) == 0,     \
+		     "MPMC queue size must be a power of two");          \
+	static struct k_mpmcq_slot _k_mpmcq_buf_##name[q_num_entries];  \
+	struct k_mpmcq name =                                            \
+		Z_MPMCQ_INITIALIZER(name, _k_mpmcq_buf_##name,           \
+				    q_num_entries)
+
+/** @} */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2745,6 +2858,7 @@ __syscall int k_stack_pop(struct k_stack *stack, stack_data_t *data,
 struct k_work;
 struct k_work_q;
 struct k_work_queue_config;
+struct k_work_q_worker;
 extern struct k_work_q k_sys_work_q;
 
 /**
@@ -3308,11 +3422,54 @@ void k_work_queue_start(struct k_work_q *queue,
 			k_thread_stack_t *stack, size_t stack_size,
 			int prio, const struct k_work_queue_config *cfg);
 
+/** @brief Start a work queue served by a pool of threads.
+ *
+ * This configures one thread per entry of @p workers and starts them
+ * running.  Each thread first takes the work items that were handed to it,
+ * and steals work handed to the other threads of the pool when it has none
+ * left.  Work submitted from a pool thread is handed to that thread, other
+ * submissions are spread over the pool.
+ *
+ * A work item is never run by two threads of the pool at the same time: a
+ * work item submitted while it is running is handed to the thread running
+ * it.  Flushing, cancelling and draining behave as for a single thread work
+ * queue, but separate work items may run concurrently and complete in any
+ * order.
+ *
+ * The function should not be re-invoked on a queue, and a queue started
+ * with this function must not be started with k_work_queue_start().
+ *
+ * @param queue pointer to the queue structure. It must be initialized
+ *        in zeroed/bss memory or with @ref k_work_queue_init before
+ *        use.
+ *
+ * @param workers array of @p num_workers worker structures.
+ *
+ * @param num_workers number of threads in the pool, at least one.
+ *
+ * @param stacks pointer to the first of @p num_workers thread stacks defined
+ *        with K_THREAD_STACK_ARRAY_DEFINE() using @p stack_size.
+ *
+ * @param stack_size size of each work thread stack area, in bytes.
+ *
+ * @param prio initial thread priority
+ *
+ * @param cfg optional additional configuration parameters.  Pass @c
+ * NULL if not required, to use the defaults documented in
+ * k_work_queue_config.
+ */
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers, size_t num_workers,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     int prio, const struct k_work_queue_config *cfg);
+
 /** @brief Access the thread that animates a work queue.
  *
  * This is necessary to grant a work queue thread access to things the work
  * items it will process are expected to use.
  *
+ * For a work queue pool this is the first thread of the pool.
+ *
  * @param queue pointer to the queue structure.
  *
  * @return the thread associated with the work queue.
@@ -3848,11 +4005,44 @@ struct k_work_queue_config {
 	 * control.
 	 */
 	bool no_yield;
+
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+	/** Control whether the threads of a work queue pool are pinned.
+	 *
+	 * Set this to @c true to pin worker @c i of a pool started with
+	 * k_work_queue_pool_start() to CPU @c i modulo the number of CPUs,
+	 * and to hand work submitted from a CPU to the worker pinned to it.
+	 * Requires @kconfig{CONFIG_SCHED_CPU_MASK}; ignored otherwise and for
+	 * single thread work queues.
+	 */
+	bool pin_workers;
+#endif
+};
+
+#if defined(CONFIG_WORKQUEUE_POOL) || defined(__DOXYGEN__)
+/** @brief A thread of a work queue pool.
+ *
+ * The contents are private to the work queue implementation.
+ */
+struct k_work_q_worker {
+	/* The thread that animates this worker. */
+	struct k_thread thread;
+
+	/* All the following fields must be accessed only while the
+	 * work module spinlock is held.
+	 */
+
+	/* List of k_work items handed to this worker. */
+	sys_slist_t pending;
+
+	/* The work item this worker is running, if any. */
+	struct k_work *active;
 };
+#endif
 
 /** @brief A structure used to hold work until it can be processed. */
 struct k_work_q {
-	/* The thread that animates the work. */
+	/* The thread that animates the work.  Unused by work queue pools. */
 	struct k_thread thread;
 
 	/* All the following fields must be accessed only while the
@@ -3870,6 +4060,23 @@ struct k_work_q {
 
 	/* Flags describing queue state. */
 	uint32_t flags;
+
+#ifdef CONFIG_WORKQUEUE_POOL
+	/* Threads of a work queue pool, or NULL for a single thread queue. */
+	struct k_work_q_worker *workers;
+
+	/* Number of entries in workers. */
+	uint16_t num_workers;
+
+	/* Number of workers that are running a work item. */
+	uint16_t num_active;
+
+	/* Worker that receives the next submission from outside the pool. */
+	uint16_t next_worker;
+
+	/* Whether workers are pinned, see k_work_queue_config. */
+	bool pinned;
+#endif
 };
 
 /* Provide the implementation for inline functions declared above */
@@ -3905,6 +4112,12 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->workers != NULL) {
+		return &queue->workers[0].thread;
+	}
+#endif
+
 	return &queue->thread;
 }
 
@@ -116,6 +116,11 @@ struct _thread_base {
 	/* Recursive count of irq_lock() calls */
 	uint8_t global_lock_count;
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* CPU index whose run queue holds the thread while queued */
+	uint8_t runq_cpu;
+#endif
+
 #endif
 
 #ifdef CONFIG_SCHED_CPU_MASK
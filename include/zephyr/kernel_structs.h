@@ -93,6 +93,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* number of threads in runq, used to pick a victim for stealing */
+	unsigned int num_queued;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -110,7 +115,7 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -166,7 +171,7 @@ struct z_kernel {
 	 * ready queue: can be big, keep after small fields, since some
 	 * assembly (e.g. ARC) are limited in the encoding of the offset
 	 */
-#ifndef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if !defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) && !defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -250,6 +255,16 @@ struct _timeout {
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_HEAP
+	/* With the heap backend dticks holds the absolute expiry tick
+	 * and node links siblings, see kernel/timeout.c
+	 */
+
+	/* leftmost child in the pairing heap */
+	struct _timeout *child;
+	/* arming order, breaks ties between equal expiries */
+	uint32_t seq;
+#endif
 };
 
 typedef void (*k_thread_timeslice_fn_t)(struct k_thread *thread, void *data);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_
+#define ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flash circular buffer logger backend
+ * @defgroup log_backend_fcb Flash circular buffer logger backend
+ * @ingroup logger
+ * @{
+ */
+
+/** Source ID of messages which have no source. */
+#define LOG_BACKEND_FCB_NO_SOURCE UINT16_MAX
+
+/** @brief Log message read back from flash. */
+struct log_backend_fcb_record {
+	/** Boot during which the message was stored. */
+	uint16_t boot;
+
+	/** Domain ID. */
+	uint8_t domain_id;
+
+	/** Severity level. */
+	uint8_t level;
+
+	/** Source ID within the domain or @ref LOG_BACKEND_FCB_NO_SOURCE. */
+	uint16_t source_id;
+
+	/** Time since boot in milliseconds. */
+	uint32_t timestamp_ms;
+
+	/** Message formatted when fetched, not null terminated. */
+	const char *text;
+
+	/** Length of @ref text. */
+	size_t text_len;
+
+	/** Hexdump data, possibly truncated. */
+	const uint8_t *data;
+
+	/** Length of @ref data. */
+	size_t data_len;
+};
+
+/** @brief Storage statistics. */
+struct log_backend_fcb_stats {
+	/** Number of blocks written since boot. */
+	uint32_t blocks;
+
+	/** Number of message bytes written since boot before compression. */
+	uint32_t raw_bytes;
+
+	/** Number of message bytes written since boot after compression. */
+	uint32_t stored_bytes;
+
+	/** Number of messages which did not fit in a block. */
+	uint32_t dropped;
+};
+
+/**
+ * @brief Callback called for each fetched message.
+ *
+ * @param record Message, valid only for the duration of the call.
+ * @param user_data User data passed to @ref log_backend_fcb_fetch.
+ *
+ * @return 0 to continue, any other value stops the fetch.
+ */
+typedef int (*log_backend_fcb_fetch_cb_t)(const struct log_backend_fcb_record *record,
+					  void *user_data);
+
+/**
+ * @brief Fetch messages stored within a time window.
+ *
+ * Messages buffered in RAM are written to flash first. Blocks and flash
+ * sectors which hold no message in the window or no message at the
+ * requested levels are skipped without being read or decompressed.
+ *
+ * @param boot Boot to fetch messages from, see @ref log_backend_fcb_boot_get.
+ * @param from_ms Start of the window, in milliseconds since boot.
+ * @param to_ms End of the window (inclusive), in milliseconds since boot.
+ * @param max_level Most verbose level to fetch.
+ * @param cb Callback called for each message, oldest first.
+ * @param user_data User data passed to @p cb.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if the flash storage is not available.
+ * @retval -EIO if stored data is corrupted.
+ * @return Other value returned by @p cb which stopped the fetch.
+ */
+int log_backend_fcb_fetch(uint16_t boot, uint32_t from_ms, uint32_t to_ms,
+			  uint8_t max_level, log_backend_fcb_fetch_cb_t cb,
+			  void *user_data);
+
+/**
+ * @brief Get the number of the current boot.
+ *
+ * The number is one more than the highest boot number found in the flash
+ * storage when the backend started.
+ *
+ * @return Boot number.
+ */
+uint16_t log_backend_fcb_boot_get(void);
+
+/**
+ * @brief Erase all stored messages.
+ *
+ * @retval 0 on success.
+ * @retval -ENODEV if the flash storage is not available.
+ * @return Other negative error code on flash failure.
+ */
+int log_backend_fcb_clear(void);
+
+/**
+ * @brief Get storage statistics.
+ *
+ * @param stats Location where statistics are written.
+ */
+void log_backend_fcb_stats_get(struct log_backend_fcb_stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_LOGGING_LOG_BACKEND_FCB_H_ */
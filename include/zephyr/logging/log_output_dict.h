@@ -47,6 +47,39 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/** Magic bytes starting every framed dictionary log record. */
+#define LOG_DICT_OUTPUT_FRAME_MAGIC0 'Z'
+#define LOG_DICT_OUTPUT_FRAME_MAGIC1 'L'
+
+/** Version of the frame header layout. */
+#define LOG_DICT_OUTPUT_FRAME_VERSION 1
+
+/**
+ * Header preceding each framed dictionary based log record.
+ *
+ * The payload is one record as output by @ref log_dict_output_msg_process
+ * or no payload at all for a frame which only carries updated counters.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t magic[2];
+	uint8_t version;
+	uint8_t reserved;
+	uint16_t len;
+	uint32_t seq;
+	uint32_t dropped;
+} __packed;
+
+/**
+ * State of a framed dictionary based output.
+ */
+struct log_dict_output_frame {
+	/** Sequence number of the next frame. */
+	uint32_t seq;
+
+	/** Total number of dropped messages. */
+	uint32_t dropped;
+};
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
@@ -68,6 +101,34 @@ void log_dict_output_msg_process(const struct log_output *log_output,
  */
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt);
 
+/** @brief Process log message for framed dictionary-based logging.
+ *
+ * The whole frame is assembled in the output buffer and passed to the output
+ * function in a single call, so a datagram oriented transport can send one
+ * frame per packet. Messages which do not fit in the output buffer are
+ * accounted as dropped.
+ *
+ * @param output Pointer to the log output instance.
+ * @param frame  Frame state of the output.
+ * @param msg    Log message.
+ */
+void log_dict_output_frame_msg_process(const struct log_output *output,
+				       struct log_dict_output_frame *frame,
+				       struct log_msg *msg);
+
+/** @brief Process dropped messages indication for framed dictionary-based logging.
+ *
+ * Adds @p cnt to the total number of dropped messages and outputs a frame
+ * without payload carrying the updated total.
+ *
+ * @param output Pointer to the log output instance.
+ * @param frame  Frame state of the output.
+ * @param cnt    Number of dropped messages.
+ */
+void log_dict_output_frame_dropped_process(const struct log_output *output,
+					   struct log_dict_output_frame *frame,
+					   uint32_t cnt);
+
 #ifdef __cplusplus
 }
 #endif
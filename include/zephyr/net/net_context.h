@@ -282,6 +282,11 @@ __net_socket struct net_context {
 		/** Mutex used by condition variable */
 		struct k_mutex *lock;
 	} cond;
+
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	/** Readiness watchers, e.g. epoll instances */
+	sys_slist_t poll_watchers;
+#endif
 #endif /* CONFIG_NET_SOCKETS */
 
 #if defined(CONFIG_NET_OFFLOAD)
@@ -322,6 +327,10 @@ __net_socket struct net_context {
 #endif
 #if defined(CONFIG_NET_CONTEXT_DSCP_ECN)
 		uint8_t dscp_ecn;
+#endif
+#if defined(CONFIG_NET_UDP_GSO)
+		/** Payload size of the datagrams a UDP send is split into */
+		uint16_t udp_segment;
 #endif
 	} options;
 
@@ -1000,6 +1009,33 @@ int net_context_sendmsg(struct net_context *context,
 			k_timeout_t timeout,
 			void *user_data);
 
+/**
+ * @brief Send a datagram whose payload is already in network buffers.
+ *
+ * @details Like net_context_sendto(), but the fragments in @a frags are
+ * appended to the packet after the protocol headers instead of being
+ * copied. On success the packet takes over the caller's reference to
+ * @a frags and releases it once the packet is freed, on error the
+ * reference stays with the caller. Only UDP contexts are supported.
+ *
+ * @param context The network context to use.
+ * @param frags Payload fragment chain
+ * @param dst_addr Destination address, NULL to use the connected peer.
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_frags(struct net_context *context,
+			     struct net_buf *frags,
+			     const struct sockaddr *dst_addr,
+			     socklen_t addrlen,
+			     net_context_send_cb_t cb,
+			     k_timeout_t timeout,
+			     void *user_data);
+
 /**
  * @brief Receive network data from a peer specified by context.
  *
@@ -1073,6 +1109,7 @@ enum net_context_option {
 	NET_OPT_RCVBUF		= 6,
 	NET_OPT_SNDBUF		= 7,
 	NET_OPT_DSCP_ECN	= 8,
+	NET_OPT_UDP_SEGMENT	= 9,
 };
 
 /**
@@ -149,6 +149,13 @@ int net_send_data(struct net_pkt *pkt);
 #define NET_TC_COUNT 0
 #endif /* CONFIG_NET_TC_TX_COUNT && CONFIG_NET_TC_RX_COUNT */
 
+/* Number of RX queues, each with its own thread, per traffic class */
+#if defined(CONFIG_NET_TC_RX_FLOW_QUEUES) && NET_TC_RX_COUNT > 0
+#define NET_TC_RX_QUEUES CONFIG_NET_TC_RX_FLOW_QUEUES
+#else
+#define NET_TC_RX_QUEUES 1
+#endif
+
 /* @endcond */
 
 /**
@@ -163,6 +163,15 @@ struct net_stats_tcp {
 
 	/** Number of connection attempts for closed ports, triggering a RST. */
 	net_stats_t connrst;
+
+	/** Number of times congestion control entered fast recovery. */
+	net_stats_t recovery;
+
+	/** Congestion window of the connection that last changed it. */
+	net_stats_t cwnd;
+
+	/** Slow start threshold of the connection that last changed it. */
+	net_stats_t ssthresh;
 };
 
 /**
@@ -275,6 +284,17 @@ struct net_stats_tc {
 };
 
 
+/**
+ * @brief RX queue statistics, kept when flows are steered over several
+ * queues per traffic class
+ */
+struct net_stats_rx_queue {
+	/** Packets steered to the queue */
+	net_stats_t pkts;
+	/** Bytes steered to the queue */
+	net_stats_t bytes;
+};
+
 /**
  * @brief Power management statistics
  */
@@ -347,6 +367,11 @@ struct net_stats {
 	struct net_stats_tc tc;
 #endif
 
+#if NET_TC_RX_QUEUES > 1
+	/** RX queue statistics, indexed by tc * NET_TC_RX_QUEUES + queue */
+	struct net_stats_rx_queue rxq[NET_TC_RX_COUNT * NET_TC_RX_QUEUES];
+#endif
+
 #if defined(CONFIG_NET_PKT_TXTIME_STATS)
 	/** Network packet TX time statistics */
 	struct net_stats_tx_time tx_time;
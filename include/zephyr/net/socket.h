@@ -63,6 +63,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: block only until the first datagram has been received */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -419,6 +421,54 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Send several messages with one call
+ *
+ * @details
+ * Works like calling zsock_sendmsg() for each element of @a msgvec, but
+ * the socket is looked up and locked only once for the whole batch. The
+ * number of bytes sent for each message is stored in its @a msg_len.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to send
+ * @param vlen Number of elements in @a msgvec
+ * @param flags Send flags, applied to every message
+ *
+ * @return Number of messages sent, or -1 with errno set if the first
+ *         message could not be sent
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
+/**
+ * @brief Receive several datagrams with one call
+ *
+ * @details
+ * Fills the elements of @a msgvec like recvmsg() would, storing the
+ * received length in @a msg_len and setting ZSOCK_MSG_TRUNC in
+ * @a msg_hdr.msg_flags if a datagram did not fit its buffers. The socket
+ * is looked up and locked only once for the whole batch.
+ *
+ * A blocking call waits until @a vlen datagrams have been received, or
+ * only for the first one if ZSOCK_MSG_WAITFORONE is set. Unlike on
+ * Linux there is no timeout argument, the SO_RCVTIMEO of the socket
+ * applies to each datagram instead. No ancillary data is returned.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:option:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ *
+ * @param sock Socket descriptor
+ * @param msgvec Messages to fill
+ * @param vlen Number of elements in @a msgvec
+ * @param flags Receive flags, applied to every message
+ *
+ * @return Number of messages received, or -1 with errno set if no
+ *         message could be received
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -437,6 +487,138 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+/* Also used by the system call stubs, which are generated regardless */
+struct k_poll_signal;
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY) || defined(__DOXYGEN__)
+struct net_buf;
+struct net_pkt;
+
+/**
+ * @brief Datagram lent to the application by zsock_recv_loan()
+ *
+ * The payload starts @a offset bytes into the data of @a frags and
+ * continues through the rest of the fragment chain for @a len bytes in
+ * total. The buffers belong to the network stack and must be handed back
+ * with zsock_recv_loan_return() once the application is done with them.
+ */
+struct zsock_rx_loan {
+	/** First fragment holding payload */
+	struct net_buf *frags;
+	/** Offset of the payload in the first fragment */
+	size_t offset;
+	/** Payload length */
+	size_t len;
+	/** @cond INTERNAL_HIDDEN */
+	struct net_pkt *pkt;
+	/** @endcond */
+};
+
+/**
+ * @brief Receive a datagram without copying it
+ *
+ * @details
+ * Works like zsock_recvfrom() on a native SOCK_DGRAM socket, but instead
+ * of copying the payload into a caller supplied buffer the network
+ * buffers the datagram was received in are lent to the caller. Only
+ * ZSOCK_MSG_DONTWAIT is supported in @a flags.
+ *
+ * This function is only available to supervisor threads: the lent buffers
+ * are in kernel memory, which user threads cannot access, so it is not a
+ * system call. User threads fail with errno EPERM and keep using
+ * zsock_recvfrom().
+ *
+ * @param sock Socket descriptor
+ * @param loan Filled with the received datagram
+ * @param flags Receive flags
+ * @param src_addr Optional source address of the datagram
+ * @param addrlen Value-result length of @a src_addr
+ *
+ * @return Payload length, or -1 with errno set on error. errno is EINVAL
+ * if @a loan is NULL or @a flags are not supported.
+ */
+ssize_t zsock_recv_loan(int sock, struct zsock_rx_loan *loan, int flags,
+			struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Give buffers lent by zsock_recv_loan() back to the stack
+ *
+ * @param loan Loan to return, it is cleared
+ */
+void zsock_recv_loan_return(struct zsock_rx_loan *loan);
+
+/**
+ * @brief Called when the stack no longer references a zero-copy buffer
+ *
+ * @param buf Buffer passed to zsock_sendto_zc()
+ * @param len Length passed to zsock_sendto_zc()
+ * @param user_data User data passed to zsock_sendto_zc()
+ */
+typedef void (*zsock_zc_done_cb_t)(const void *buf, size_t len,
+				   void *user_data);
+
+/**
+ * @brief Send a datagram without copying it
+ *
+ * @details
+ * Works like zsock_sendto() on a native UDP socket, but the payload is
+ * attached to the outgoing packet as it is instead of being copied into
+ * network buffers. The application must leave @a buf untouched until
+ * @a cb is called, which happens once the packet has been transmitted
+ * or dropped. The callback may run in the context of the network TX
+ * path or of the network driver and must not block.
+ *
+ * If -1 is returned, @a cb is not called and @a buf may be reused
+ * immediately.
+ *
+ * This function is only available to supervisor threads, since @a cb is
+ * called by the network stack. It is not a system call, user threads fail
+ * with errno EPERM and use zsock_sendto_zc_signal() instead.
+ *
+ * @param sock Socket descriptor
+ * @param buf Payload
+ * @param len Payload length
+ * @param flags Send flags
+ * @param dest_addr Destination address, NULL for a connected socket
+ * @param addrlen Length of @a dest_addr
+ * @param cb Completion callback
+ * @param user_data Passed to @a cb
+ *
+ * @return Number of bytes queued, or -1 with errno set on error.
+ */
+ssize_t zsock_sendto_zc(int sock, const void *buf, size_t len, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen,
+			zsock_zc_done_cb_t cb, void *user_data);
+
+/**
+ * @brief Send a datagram without copying it, signalling completion
+ *
+ * @details
+ * Works like zsock_sendto_zc(), but completion is reported by raising
+ * @a sig with a result of 0 instead of through a callback. Unlike
+ * zsock_sendto_zc() this is a system call, so user threads can use it
+ * as long as they can read @a buf and have been granted access to
+ * @a sig. Wait for @a sig with k_poll() before modifying or releasing
+ * @a buf, and use a separate signal for each transmission in flight.
+ *
+ * If -1 is returned, @a sig is not raised and @a buf may be reused
+ * immediately.
+ *
+ * @param sock Socket descriptor
+ * @param buf Payload
+ * @param len Payload length
+ * @param flags Send flags
+ * @param dest_addr Destination address, NULL for a connected socket
+ * @param addrlen Length of @a dest_addr
+ * @param sig Raised once the stack no longer references @a buf
+ *
+ * @return Number of bytes queued, or -1 with errno set on error.
+ */
+__syscall ssize_t zsock_sendto_zc_signal(int sock, const void *buf, size_t len,
+					 int flags, const struct sockaddr *dest_addr,
+					 socklen_t addrlen, struct k_poll_signal *sig);
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -778,6 +960,20 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+/** POSIX wrapper for @ref zsock_sendmmsg */
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
+/** POSIX wrapper for @ref zsock_recvmmsg */
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags);
+}
+
 /** POSIX wrapper for @ref zsock_recvfrom */
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
@@ -888,6 +1084,8 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 /** POSIX wrapper for @ref ZSOCK_MSG_WAITALL */
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+/** POSIX wrapper for @ref ZSOCK_MSG_WAITFORONE */
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 /** POSIX wrapper for @ref ZSOCK_SHUT_RD */
 #define SHUT_RD ZSOCK_SHUT_RD
@@ -989,6 +1187,12 @@ struct ifreq {
 /* Socket options for IPPROTO_TCP level */
 /** sockopt: Disable TCP buffering (ignored, for compatibility) */
 #define TCP_NODELAY 1
+/** sockopt: Congestion control algorithm name, e.g. "newreno" or "cubic" */
+#define TCP_CONGESTION 13
+
+/* Socket options for IPPROTO_UDP level */
+/** sockopt: Split each send into datagrams of this payload size (int) */
+#define UDP_SEGMENT 103
 
 /* Socket options for IPPROTO_IP level */
 /** sockopt: Set or receive the Type-Of-Service value for an outgoing packet. */
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+#define ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_
+
+#include <stdint.h>
+#include <zephyr/net/socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EPOLLIN      ZSOCK_POLLIN
+#define EPOLLPRI     ZSOCK_POLLPRI
+#define EPOLLOUT     ZSOCK_POLLOUT
+#define EPOLLERR     ZSOCK_POLLERR
+#define EPOLLHUP     ZSOCK_POLLHUP
+#define EPOLLONESHOT (1U << 30)
+#define EPOLLET      (1U << 31)
+
+#define EPOLL_CTL_ADD 1
+#define EPOLL_CTL_DEL 2
+#define EPOLL_CTL_MOD 3
+
+#define EPOLL_CLOEXEC 0x80000
+
+typedef union epoll_data {
+	void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t events;
+	epoll_data_t data;
+};
+
+/**
+ * @brief Create an epoll instance
+ *
+ * The returned file descriptor holds a set of file descriptors to watch,
+ * see epoll_ctl(), and can itself be passed to poll(). Sockets and
+ * eventfds can be watched.
+ *
+ * @param flags 0 or EPOLL_CLOEXEC, which is accepted and ignored
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create1(int flags);
+
+/**
+ * @brief Create an epoll instance
+ *
+ * @param size Ignored, but must be greater than zero
+ *
+ * @return New epoll file descriptor on success, -1 on error
+ */
+int epoll_create(int size);
+
+/**
+ * @brief Add, modify or remove a file descriptor of an epoll instance
+ *
+ * @param epfd Epoll file descriptor
+ * @param op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @param fd File descriptor to watch
+ * @param event Events of interest and the data to report them with,
+ *        ignored for EPOLL_CTL_DEL
+ *
+ * @return 0 on success, -1 on error
+ */
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+
+/**
+ * @brief Wait for events on an epoll instance
+ *
+ * Only the file descriptors which were signalled ready since the last
+ * call, plus level triggered ones which were still ready then, are
+ * examined, so the cost does not depend on the number of watched file
+ * descriptors.
+ *
+ * @param epfd Epoll file descriptor
+ * @param events Filled with the pending events
+ * @param maxevents Size of @a events
+ * @param timeout Timeout in milliseconds, -1 to wait forever
+ *
+ * @return Number of entries filled in @a events, 0 on timeout, -1 on error
+ */
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+	       int timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_POSIX_SYS_EPOLL_H_ */
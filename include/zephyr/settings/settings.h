@@ -228,6 +228,15 @@ int settings_subsys_init(void);
  */
 int settings_register(struct settings_handler *cf);
 
+/**
+ * Deregister a handler for settings items stored in RAM.
+ *
+ * @param cf Structure containing registration info.
+ *
+ * @return true on success, false if the handler was not registered.
+ */
+bool settings_deregister(struct settings_handler *cf);
+
 /**
  * Load serialized items from registered persistence sources. Handlers for
  * serialized item subtrees registered earlier will be called for encountered
@@ -308,7 +317,8 @@ int settings_save(void);
  * be transferred to the @ref settings_handler::h_export handler implementation.
  * @param val_len Length of the value.
  *
- * @return 0 on success, non-zero on failure.
+ * @return 0 on success, non-zero on failure. Inside a transaction -ENOMEM
+ * is returned when the value does not fit in the staging buffer.
  */
 int settings_save_one(const char *name, const void *value, size_t val_len);
 
@@ -324,6 +334,49 @@ int settings_save_one(const char *name, const void *value, size_t val_len);
  */
 int settings_delete(const char *name);
 
+#if defined(CONFIG_SETTINGS_TXN) || defined(__DOXYGEN__)
+/**
+ * Start a settings transaction.
+ *
+ * Until @ref settings_txn_commit or @ref settings_txn_abort is called, the
+ * values passed by the calling thread to @ref settings_save_one and
+ * @ref settings_delete are staged in RAM instead of being written to the
+ * storage. Saving a key which is already staged replaces the staged value.
+ * Other threads using the settings subsystem block until the transaction
+ * ends. Staged values are not visible to loads.
+ *
+ * @return 0 on success, -ENOENT if no destination is registered, -EBUSY if
+ * the calling thread already has a transaction open.
+ */
+int settings_txn_begin(void);
+
+/**
+ * Write all values staged by the transaction of the calling thread to the
+ * storage and end the transaction.
+ *
+ * The staged values are first stored together as a journal under the
+ * reserved settings/txn key, then written to their keys in the order they
+ * were last saved, and the journal is deleted. If the commit is interrupted
+ * once the journal is stored, the values are written again by the next load
+ * or transaction, so either all or none of them are changed. The transaction
+ * ends in any case.
+ *
+ * @return 0 on success, -EINVAL if the calling thread has no transaction
+ * open, or the backend error code. If the error occurred after the journal
+ * was stored, the values are written again by the next load or transaction.
+ */
+int settings_txn_commit(void);
+
+/**
+ * Drop all values staged by the transaction of the calling thread and end
+ * the transaction.
+ *
+ * @return 0 on success, -EINVAL if the calling thread has no transaction
+ * open.
+ */
+int settings_txn_abort(void);
+#endif /* CONFIG_SETTINGS_TXN */
+
 /**
  * Call commit for all settings handler. This should apply all
  * settings which has been set, but not applied yet.
@@ -439,6 +492,9 @@ struct settings_store_itf {
 	 *
 	 * Parameters:
 	 *  - cs - Corresponding backend handler node
+	 *
+	 * Returns 0, or a negative error code if the values saved since
+	 * csi_save_start could not be made persistent.
 	 */
 
 	/**< Get pointer to the storage instance used by the backend.
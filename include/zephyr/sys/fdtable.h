@@ -11,6 +11,7 @@
 /* FIXME: For native_posix ssize_t, off_t. */
 #include <zephyr/fs/fs.h>
 #include <zephyr/sys/mutex.h>
+#include <zephyr/sys/slist.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -148,8 +149,68 @@ enum {
 	ZFD_IOCTL_POLL_UPDATE,
 	ZFD_IOCTL_POLL_OFFLOAD,
 	ZFD_IOCTL_SET_LOCK,
+	ZFD_IOCTL_POLL_WATCH,
 };
 
+/**
+ * @brief Readiness watcher for a file descriptor object
+ *
+ * Objects which handle ZFD_IOCTL_POLL_WATCH keep a list of watchers and
+ * call z_poll_watch_notify() whenever one of the poll events may have
+ * become pending, e.g. when data is queued for reading. This lets a
+ * watcher learn about readiness without polling every object it is
+ * interested in. The notification is only a hint, the watcher is
+ * expected to confirm readiness with ZFD_IOCTL_POLL_PREPARE/UPDATE.
+ *
+ * ZFD_IOCTL_POLL_WATCH takes a struct z_poll_watch pointer and an int,
+ * non-zero to attach the watcher and zero to detach it. Objects must
+ * call z_poll_watch_close() with ZSOCK_POLLNVAL when they are closed.
+ */
+struct z_poll_watch {
+	sys_snode_t node;
+
+	/**
+	 * Called with the ZSOCK_POLL* events which may have become
+	 * pending. Runs with a spinlock held and possibly from the
+	 * network stack, so must not block.
+	 */
+	void (*notify)(struct z_poll_watch *watch, int events);
+};
+
+/**
+ * @brief Attach a watcher to an object's watcher list
+ *
+ * @param watchers Watcher list of the object
+ * @param watch Watcher to attach
+ */
+void z_poll_watch_add(sys_slist_t *watchers, struct z_poll_watch *watch);
+
+/**
+ * @brief Detach a watcher from an object's watcher list
+ *
+ * Once this returns the watcher is not notified any more.
+ *
+ * @param watchers Watcher list of the object
+ * @param watch Watcher to detach
+ */
+void z_poll_watch_remove(sys_slist_t *watchers, struct z_poll_watch *watch);
+
+/**
+ * @brief Notify all watchers of an object
+ *
+ * @param watchers Watcher list of the object
+ * @param events Events which may have become pending
+ */
+void z_poll_watch_notify(sys_slist_t *watchers, int events);
+
+/**
+ * @brief Notify and detach all watchers of an object being closed
+ *
+ * @param watchers Watcher list of the object
+ * @param events Events to report, normally ZSOCK_POLLNVAL
+ */
+void z_poll_watch_close(sys_slist_t *watchers, int events);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_SYS_SYS_HEAP_CACHE_H_
+#define ZEPHYR_INCLUDE_SYS_SYS_HEAP_CACHE_H_
+
+#include <zephyr/types.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/mem_stats.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Per-CPU caching front-end for sys_heap
+ *
+ * A sys_heap_cache sits in front of a (locked) sys_heap and keeps,
+ * for every CPU, a small "magazine" of free blocks for each of a set
+ * of power-of-two size classes.  Small allocations and frees are
+ * served from the calling CPU's magazine with only local interrupts
+ * masked, never touching the heap lock or the heap's free lists.
+ * When a magazine runs empty it is refilled with a batch of blocks
+ * taken from the heap under a single lock acquisition; when it
+ * overflows, half of it is returned to the heap the same way.
+ *
+ * The smallest class is 8 bytes (16 on 64 bit systems) and each
+ * following class doubles, CONFIG_SYS_HEAP_CACHE_CLASSES of them in
+ * total.  Requests larger than the biggest class, or requiring more
+ * than z_max_align_t alignment, go straight to the heap.
+ *
+ * Blocks sitting in magazines are allocated from the point of view of
+ * the backing heap.  sys_heap_cache_stats_get() reports them
+ * separately so fragmentation can still be assessed, and
+ * sys_heap_cache_flush() hands them back.  An allocation the heap
+ * cannot satisfy flushes the calling CPU's magazines and is retried
+ * once.
+ *
+ * All blocks remain ordinary sys_heap blocks: memory obtained through
+ * the cache may be freed directly to the heap (under its lock) and
+ * vice versa.
+ */
+
+#if defined(CONFIG_64BIT)
+#define SYS_HEAP_CACHE_MIN_SHIFT 4
+#else
+#define SYS_HEAP_CACHE_MIN_SHIFT 3
+#endif
+
+/** @cond INTERNAL_HIDDEN */
+
+struct sys_heap_cache_mag {
+	uint16_t count;
+	void *blocks[CONFIG_SYS_HEAP_CACHE_DEPTH];
+};
+
+struct sys_heap_cache_cpu {
+	struct sys_heap_cache_mag mags[CONFIG_SYS_HEAP_CACHE_CLASSES];
+	uint32_t hits;
+	uint32_t refills;
+	uint32_t drains;
+};
+
+/** @endcond */
+
+struct sys_heap_cache {
+	/* Backing heap and the lock serializing all access to it */
+	struct sys_heap *heap;
+	struct k_spinlock *heap_lock;
+
+	/* Used as heap_lock when none is supplied at init time */
+	struct k_spinlock lock;
+
+	struct sys_heap_cache_cpu cpu[CONFIG_MP_MAX_NUM_CPUS];
+};
+
+/** @brief Runtime statistics of a sys_heap_cache */
+struct sys_heap_cache_stats {
+	/** Allocations served from a magazine */
+	uint32_t hits;
+	/** Batched refills of a magazine from the heap */
+	uint32_t refills;
+	/** Batched returns of a full magazine to the heap */
+	uint32_t drains;
+	/** Usable bytes of the blocks held in magazines across all CPUs */
+	size_t cached_bytes;
+	/** Blocks held in magazines, per size class */
+	uint32_t cached_blocks[CONFIG_SYS_HEAP_CACHE_CLASSES];
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	/** Statistics of the backing heap (cached blocks count as allocated) */
+	struct sys_memory_stats heap;
+#endif
+};
+
+/**
+ * @brief Static initializer for a sys_heap_cache
+ *
+ * @param heap_ptr Pointer to the backing sys_heap
+ * @param lock_ptr Pointer to the spinlock protecting the heap
+ */
+#define SYS_HEAP_CACHE_INITIALIZER(heap_ptr, lock_ptr) \
+	{ .heap = (heap_ptr), .heap_lock = (lock_ptr) }
+
+/**
+ * @brief Initialize a sys_heap_cache
+ *
+ * The backing heap must already be initialized.  If the heap is also
+ * used directly by other code, that code must hold @a lock around its
+ * heap calls and pass the same lock here.  With a NULL @a lock the
+ * cache uses an internal one and must be the heap's only user.
+ *
+ * @param cache Cache to initialize
+ * @param heap Backing heap
+ * @param lock Lock protecting @a heap, or NULL
+ */
+void sys_heap_cache_init(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 struct k_spinlock *lock);
+
+/**
+ * @brief Allocate memory through a sys_heap_cache
+ *
+ * Like sys_heap_aligned_alloc(), but internally synchronized.  The
+ * returned memory is aligned to at least z_max_align_t.
+ *
+ * @param cache Cache from which to allocate
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_alloc(struct sys_heap_cache *cache, size_t bytes);
+
+/**
+ * @brief Allocate aligned memory through a sys_heap_cache
+ *
+ * Accepts the same @a align values as sys_heap_aligned_alloc().
+ * Power-of-two alignments no stricter than z_max_align_t may be
+ * served from the per-CPU magazines.
+ *
+ * @param cache Cache from which to allocate
+ * @param align Alignment in bytes
+ * @param bytes Number of bytes requested
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_aligned_alloc(struct sys_heap_cache *cache, size_t align,
+				   size_t bytes);
+
+/**
+ * @brief Reallocate memory through a sys_heap_cache
+ *
+ * Same semantics as sys_heap_aligned_realloc(), internally
+ * synchronized.  This always operates on the backing heap.
+ *
+ * @param cache Cache owning the block
+ * @param ptr Original pointer, or NULL
+ * @param align Alignment in bytes, must be a power of two
+ * @param bytes Number of bytes requested for the new block
+ * @return Pointer to memory the caller can now use, or NULL
+ */
+void *sys_heap_cache_aligned_realloc(struct sys_heap_cache *cache, void *ptr,
+				     size_t align, size_t bytes);
+
+/**
+ * @brief Free memory through a sys_heap_cache
+ *
+ * Blocks that fit a size class are kept in the calling CPU's
+ * magazine for reuse, others are returned to the heap.  NULL is
+ * accepted and ignored.
+ *
+ * @param cache Cache owning the block
+ * @param mem Pointer previously returned by the cache or the heap
+ */
+void sys_heap_cache_free(struct sys_heap_cache *cache, void *mem);
+
+/**
+ * @brief Return the calling CPU's cached blocks to the heap
+ *
+ * @param cache Cache to flush
+ */
+void sys_heap_cache_flush(struct sys_heap_cache *cache);
+
+/**
+ * @brief Get the runtime statistics of a sys_heap_cache
+ *
+ * Counters of other CPUs are sampled without synchronization, so the
+ * values are approximate while those CPUs are allocating.
+ *
+ * @param cache Cache to query
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int sys_heap_cache_stats_get(struct sys_heap_cache *cache,
+			     struct sys_heap_cache_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_SYS_SYS_HEAP_CACHE_H_ */
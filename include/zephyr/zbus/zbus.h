@@ -20,6 +20,43 @@ extern "C" {
  * @{
  */
 
+#if defined(CONFIG_ZBUS_MSG_RING) || defined(__DOXYGEN__)
+/**
+ * @brief Type used to represent the message ring of a channel.
+ *
+ * The ring keeps the last published messages of a channel, so readers consuming the channel at
+ * their own pace through a @ref zbus_ring_cursor do not miss messages published in between.
+ *
+ * @see ZBUS_CHAN_RING_DEFINE
+ */
+struct zbus_chan_ring {
+	/** Message storage. Holds len messages of the channel's message size. */
+	uint8_t *const buffer;
+
+	/** Number of messages kept by the ring. It is a power of two. */
+	const uint16_t len;
+
+	/** Sequence number of the next message to be published. */
+	uint32_t seq;
+};
+
+/**
+ * @brief Type used to represent the read position of a reader in a channel's message ring.
+ *
+ * Each reader of a ring owns a cursor, initialized with zbus_ring_cursor_init.
+ */
+struct zbus_ring_cursor {
+	/** The channel read by the cursor. */
+	const struct zbus_channel *chan;
+
+	/** Sequence number of the next message to be read. */
+	uint32_t seq;
+
+	/** Number of messages overwritten in the ring before the reader got to them. */
+	uint32_t lost;
+};
+#endif /* CONFIG_ZBUS_MSG_RING */
+
 /**
  * @brief Type used to represent a channel.
  *
@@ -60,6 +97,10 @@ struct zbus_channel {
 	 */
 	sys_slist_t *runtime_observers;
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE  */
+#if defined(CONFIG_ZBUS_MSG_RING) || defined(__DOXYGEN__)
+	/** Message ring. Keeps the last published messages, NULL for channels without ring. */
+	struct zbus_chan_ring *const ring;
+#endif /* CONFIG_ZBUS_MSG_RING */
 
 	/** Channel observer list. Represents the channel's observers list, it can be empty or
 	 * have listeners and subscribers mixed in any sequence.
@@ -67,6 +108,24 @@ struct zbus_channel {
 	const struct zbus_observer *const *observers;
 };
 
+#if defined(CONFIG_ZBUS_OBSERVER_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Type used to represent the execution time statistics of a listener.
+ *
+ * @see zbus_obs_stats_get
+ */
+struct zbus_observer_stats {
+	/** Number of callback executions. */
+	uint32_t count;
+
+	/** Longest callback execution, in cycles. */
+	uint32_t max_cycles;
+
+	/** Sum of all callback executions, in cycles. */
+	uint64_t total_cycles;
+};
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+
 /**
  * @brief Type used to represent an observer.
  *
@@ -94,6 +153,14 @@ struct zbus_observer {
 
 	/** Observer callback function. It turns the observer into a listener. */
 	void (*const callback)(const struct zbus_channel *chan);
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER) || defined(__DOXYGEN__)
+	/** Asynchronous flag. The listener's callback runs out of the publisher's context. */
+	const bool async;
+#endif
+#if defined(CONFIG_ZBUS_OBSERVER_STATS) || defined(__DOXYGEN__)
+	/** Execution time statistics. Only listeners have them. */
+	struct zbus_observer_stats *const stats;
+#endif
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -134,6 +201,14 @@ struct zbus_observer {
 #define ZBUS_RUNTIME_OBSERVERS_LIST_INIT(_slist_name) /* No runtime observers */
 #endif
 
+#if defined(CONFIG_ZBUS_OBSERVER_STATS)
+#define ZBUS_OBS_STATS_DECL(_name) static struct zbus_observer_stats _zbus_obs_stats_##_name;
+#define ZBUS_OBS_STATS_INIT(_name) .stats = &_zbus_obs_stats_##_name,
+#else
+#define ZBUS_OBS_STATS_DECL(_name)
+#define ZBUS_OBS_STATS_INIT(_name) /* No statistics */
+#endif
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS)
 #define _ZBUS_STRUCT_DECLARE(_type, _name) STRUCT_SECTION_ITERABLE(_type, _name)
 #else
@@ -147,6 +222,18 @@ struct zbus_observer {
 #define ZBUS_REF(_value) &(_value)
 
 k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
+
+#if defined(CONFIG_ZBUS_MSG_RING)
+void _zbus_ring_put(const struct zbus_channel *chan, const void *msg);
+#endif
+
+void _zbus_obs_callback_run(const struct zbus_observer *obs, const struct zbus_channel *chan);
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+int _zbus_async_listener_dispatch(const struct zbus_channel *chan,
+				  const struct zbus_observer *obs, k_timeout_t timeout);
+#endif
+
 /** @endcond */
 
 /**
@@ -209,6 +296,52 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
 			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
 		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
 
+#if defined(CONFIG_ZBUS_MSG_RING) || defined(__DOXYGEN__)
+/**
+ * @brief Zbus channel with message ring definition.
+ *
+ * This macro defines a channel which, besides the latest message, keeps the last @p _ring_len
+ * published messages in a ring. Readers consume the ring through a @ref zbus_ring_cursor, each
+ * at its own pace. Only messages published with zbus_chan_pub enter the ring.
+ *
+ * @param _name The channel's name.
+ * @param _type The Message type. It must be a struct or union.
+ * @param _validator The validator function.
+ * @param _user_data A pointer to the user data.
+ * @param _observers The observers list. The sequence indicates the priority of the observer. The
+ * first the highest priority.
+ * @param _init_val The message initialization.
+ * @param _ring_len Number of messages kept in the ring. It must be a power of two.
+ */
+#define ZBUS_CHAN_RING_DEFINE(_name, _type, _validator, _user_data, _observers, _init_val,    \
+			      _ring_len)                                                     \
+	BUILD_ASSERT(((_ring_len) > 0) && (((_ring_len) & ((_ring_len) - 1)) == 0) &&        \
+		     ((_ring_len) <= UINT16_MAX),                                            \
+		     "zbus ring length must be a power of two");                             \
+	static _type _CONCAT(_zbus_ring_buffer_, _name)[_ring_len];                          \
+	static struct zbus_chan_ring _CONCAT(_zbus_ring_, _name) = {                         \
+		.buffer = (uint8_t *)_CONCAT(_zbus_ring_buffer_, _name),                     \
+		.len = (_ring_len),                                                          \
+	};                                                                                   \
+	static _type _CONCAT(_zbus_message_, _name) = _init_val;                             \
+	static K_MUTEX_DEFINE(_CONCAT(_zbus_mutex_, _name));                                 \
+	ZBUS_RUNTIME_OBSERVERS_LIST_DECL(_CONCAT(_runtime_observers_, _name));               \
+	FOR_EACH_NONEMPTY_TERM(_ZBUS_OBS_EXTERN, (;), _observers)                            \
+	static const struct zbus_observer *const _CONCAT(_zbus_observers_, _name)[] = {      \
+	FOR_EACH_NONEMPTY_TERM(ZBUS_REF, (,), _observers) NULL};                             \
+	const _ZBUS_STRUCT_DECLARE(zbus_channel, _name) = {                                  \
+		ZBUS_CHANNEL_NAME_INIT(_name)		       /* Name */                    \
+		.message_size = sizeof(_type),	               /* Message size */            \
+		.user_data = _user_data,		       /* User data */               \
+		.message = &_CONCAT(_zbus_message_, _name),    /* Reference to the message */\
+		.validator = (_validator),		       /* Validator function */      \
+		.mutex = &_CONCAT(_zbus_mutex_, _name),	       /* Channel's Mutex */         \
+		ZBUS_RUNTIME_OBSERVERS_LIST_INIT(                                            \
+			_CONCAT(_runtime_observers_, _name))   /* Runtime observer list */   \
+		.ring = &_CONCAT(_zbus_ring_, _name),	       /* Message ring */            \
+		.observers = _CONCAT(_zbus_observers_, _name)} /* Static observer list */
+#endif /* CONFIG_ZBUS_MSG_RING */
+
 /**
  * @brief Initialize a message.
  *
@@ -252,11 +385,39 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks);
  * @param[in] _cb The callback function.
  */
 #define ZBUS_LISTENER_DEFINE(_name, _cb)                                                           \
+	ZBUS_OBS_STATS_DECL(_name)                                                                 \
 	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
 			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       ZBUS_OBS_STATS_INIT(_name)                          \
 					       .enabled = true,                                    \
 				       .queue = NULL, .callback = (_cb)}
 
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER) || defined(__DOXYGEN__)
+/**
+ * @brief Define and initialize an asynchronous listener.
+ *
+ * This macro defines an observer of listener type whose callback is not executed in the
+ * publisher's context. The publisher only queues the notification, and the callback is executed
+ * later by the zbus asynchronous listener executor, a work queue or a pool of zbus threads (see
+ * CONFIG_ZBUS_ASYNC_LISTENER_WORKQUEUE and CONFIG_ZBUS_ASYNC_LISTENER_THREADS). The notifications
+ * of a channel are executed in publishing order.
+ *
+ * The callback runs without the channel being claimed, so it must read the message with
+ * zbus_chan_read instead of zbus_chan_const_msg. The message read is the latest one, which may be
+ * newer than the one that caused the notification.
+ *
+ * @param[in] _name The listener's name.
+ * @param[in] _cb The callback function.
+ */
+#define ZBUS_ASYNC_LISTENER_DEFINE(_name, _cb)                                                     \
+	ZBUS_OBS_STATS_DECL(_name)                                                                 \
+	_ZBUS_STRUCT_DECLARE(zbus_observer,                                                        \
+			     _name) = {ZBUS_OBSERVER_NAME_INIT(_name) /* Name field */             \
+					       ZBUS_OBS_STATS_INIT(_name)                          \
+					       .enabled = true,                                    \
+				       .queue = NULL, .callback = (_cb), .async = true}
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
+
 /**
  *
  * @brief Publish to a channel
@@ -576,6 +737,131 @@ static inline const char *zbus_obs_name(const struct zbus_observer *obs)
 int zbus_sub_wait(const struct zbus_observer *sub, const struct zbus_channel **chan,
 		  k_timeout_t timeout);
 
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER_WORKQUEUE) || defined(__DOXYGEN__)
+/**
+ * @brief Set the work queue executing the asynchronous listeners.
+ *
+ * The system work queue is used by default. The work queue can only be changed before the first
+ * notification of an asynchronous listener, otherwise the execution order is not guaranteed.
+ *
+ * @param queue The work queue's reference.
+ */
+void zbus_async_listener_work_queue_set(struct k_work_q *queue);
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER_WORKQUEUE */
+
+#if defined(CONFIG_ZBUS_OBSERVER_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief Get the execution time statistics of a listener.
+ *
+ * This routine copies the execution time statistics of a listener's callback, both synchronous
+ * and asynchronous.
+ *
+ * @param obs The observer's reference.
+ * @param[out] stats Reference to the statistics where the function copies them to.
+ *
+ * @retval 0 Statistics copied.
+ * @retval -EINVAL The observer is not a listener.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_obs_stats_get(const struct zbus_observer *obs, struct zbus_observer_stats *stats);
+
+/**
+ * @brief Reset the execution time statistics of a listener.
+ *
+ * @param obs The observer's reference.
+ *
+ * @retval 0 Statistics reset.
+ * @retval -EINVAL The observer is not a listener.
+ * @retval -EFAULT A parameter is incorrect. The function only returns this value when the
+ * CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_obs_stats_reset(const struct zbus_observer *obs);
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+
+#if defined(CONFIG_ZBUS_MSG_RING) || defined(__DOXYGEN__)
+
+/**
+ * @brief Initialize a ring cursor.
+ *
+ * This routine attaches a cursor to the message ring of a channel. The cursor starts after the
+ * last published message, so the first message read is the next one to be published.
+ *
+ * @param[out] cursor The cursor's reference.
+ * @param[in] chan The channel's reference. The channel must have a message ring.
+ * @param[in] timeout Waiting period to access the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Cursor initialized.
+ * @retval -EINVAL The channel has no message ring.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_ring_cursor_init(struct zbus_ring_cursor *cursor, const struct zbus_channel *chan,
+			  k_timeout_t timeout);
+
+/**
+ * @brief Claim the next message of a ring.
+ *
+ * This routine gives direct access to the oldest message of the ring not read yet by the cursor,
+ * without copying it. The channel stays claimed until zbus_ring_finish is called, blocking
+ * publishers. When the reader fell behind by more than the ring length, the overwritten messages
+ * are skipped and added to the cursor's lost counter.
+ *
+ * @param[in,out] cursor The cursor's reference.
+ * @param[out] msg Reference to the message in the ring.
+ * @param[in] timeout Waiting period to claim the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed. zbus_ring_finish must be called.
+ * @retval -ENODATA The cursor already read all published messages. The channel is not claimed.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_ring_claim(struct zbus_ring_cursor *cursor, const void **msg, k_timeout_t timeout);
+
+/**
+ * @brief Finish reading a claimed ring message.
+ *
+ * This routine moves the cursor to the next message and finishes the channel claim taken by
+ * zbus_ring_claim.
+ *
+ * @param[in,out] cursor The cursor's reference.
+ *
+ * @retval 0 Message finished.
+ * @retval -EPERM The channel was claimed by other thread.
+ * @retval -EINVAL The channel's mutex is not locked.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_ring_finish(struct zbus_ring_cursor *cursor);
+
+/**
+ * @brief Read the next message of a ring.
+ *
+ * This routine copies the oldest message of the ring not read yet by the cursor and moves the
+ * cursor to the next message.
+ *
+ * @param[in,out] cursor The cursor's reference.
+ * @param[out] msg Reference to the message where the read function copies the message data to.
+ * @param[in] timeout Waiting period to read the channel,
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message read.
+ * @retval -ENODATA The cursor already read all published messages.
+ * @retval -EBUSY The channel is busy.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EFAULT A parameter is incorrect, or the function context is invalid (inside an ISR). The
+ * function only returns this value when the CONFIG_ZBUS_ASSERT_MOCK is enabled.
+ */
+int zbus_ring_read(struct zbus_ring_cursor *cursor, void *msg, k_timeout_t timeout);
+
+#endif /* CONFIG_ZBUS_MSG_RING */
+
 #if defined(CONFIG_ZBUS_STRUCTS_ITERABLE_ACCESS) || defined(__DOXYGEN__)
 /**
  *
@@ -9,6 +9,19 @@
 #include <zephyr/sys/math_extras.h>
 #include <zephyr/sys/util.h>
 
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+#include <zephyr/sys/sys_heap_cache.h>
+
+/* Small system heap blocks are recycled through per-CPU magazines.
+ * The system heap is only ever allocated from with K_NO_WAIT, so
+ * bypassing k_heap_free() (and its waiter wakeup) is safe.
+ */
+extern struct k_heap _system_heap;
+
+static struct sys_heap_cache system_heap_cache =
+	SYS_HEAP_CACHE_INITIALIZER(&_system_heap.heap, &_system_heap.lock);
+#endif
+
 static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size)
 {
 	void *mem;
@@ -26,7 +39,14 @@ static void *z_heap_aligned_alloc(struct k_heap *heap, size_t align, size_t size
 	}
 	__align = align | sizeof(heap_ref);
 
-	mem = k_heap_aligned_alloc(heap, __align, size, K_NO_WAIT);
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+	if (heap == &_system_heap) {
+		mem = sys_heap_cache_aligned_alloc(&system_heap_cache, __align, size);
+	} else
+#endif
+	{
+		mem = k_heap_aligned_alloc(heap, __align, size, K_NO_WAIT);
+	}
 	if (mem == NULL) {
 		return NULL;
 	}
@@ -50,7 +70,14 @@ void k_free(void *ptr)
 
 		SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap_sys, k_free, *heap_ref, heap_ref);
 
-		k_heap_free(*heap_ref, ptr);
+#ifdef CONFIG_HEAP_MEM_POOL_CACHE
+		if (*heap_ref == &_system_heap) {
+			sys_heap_cache_free(&system_heap_cache, ptr);
+		} else
+#endif
+		{
+			k_heap_free(*heap_ref, ptr);
+		}
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap_sys, k_free, *heap_ref, heap_ref);
 	}
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Bounded lock-free multi-producer multi-consumer queue object.
+ *
+ * The ring follows the classic per-slot sequence number scheme: a producer
+ * claims the slot at the tail position once its sequence number says it is
+ * free, a consumer claims the slot at the head position once its sequence
+ * number says it has been filled. Positions are claimed with a single
+ * compare-and-swap, so neither side ever takes the object lock unless a
+ * consumer has to block or a producer has to wake one up.
+ *
+ * Sequence numbers are stored relative to the slot index, which makes a
+ * zeroed slot array a valid empty ring and lets K_MPMCQ_DEFINE() work
+ * without any boot time initialization.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/kernel_structs.h>
+
+#include <zephyr/toolchain.h>
+#include <zephyr/wait_q.h>
+#include <ksched.h>
+#include <zephyr/sys/check.h>
+#include <zephyr/sys/util.h>
+
+int k_mpmcq_init(struct k_mpmcq *q, struct k_mpmcq_slot *slots,
+		 uint32_t num_entries)
+{
+	CHECKIF(num_entries < 2U || !is_power_of_two(num_entries)) {
+		return -EINVAL;
+	}
+
+	for (uint32_t i = 0; i < num_entries; i++) {
+		atomic_clear(&slots[i].seq);
+		slots[i].data = NULL;
+	}
+
+	q->slots = slots;
+	q->mask = num_entries - 1U;
+	atomic_clear(&q->head);
+	atomic_clear(&q->tail);
+	atomic_clear(&q->waiters);
+	q->lock = (struct k_spinlock) {};
+	z_waitq_init(&q->wait_q);
+
+	return 0;
+}
+
+/* Distance between the sequence number found in a slot and the one we
+ * expect, as a signed value so that wrap-around of the positions is harmless.
+ */
+static inline atomic_val_t slot_lag(struct k_mpmcq *q, atomic_val_t pos,
+				    atomic_val_t expected)
+{
+	struct k_mpmcq_slot *slot = &q->slots[pos & q->mask];
+	unsigned long seq = (unsigned long)atomic_get(&slot->seq) +
+			    (unsigned long)(pos & q->mask);
+
+	return (atomic_val_t)(seq - (unsigned long)expected);
+}
+
+static inline void slot_publish(struct k_mpmcq *q, atomic_val_t pos,
+				atomic_val_t seq)
+{
+	struct k_mpmcq_slot *slot = &q->slots[pos & q->mask];
+
+	(void)atomic_set(&slot->seq, (atomic_val_t)((unsigned long)seq -
+						    (unsigned long)(pos & q->mask)));
+}
+
+static bool mpmcq_enqueue(struct k_mpmcq *q, void *data)
+{
+	atomic_val_t pos = atomic_get(&q->tail);
+	atomic_val_t lag;
+
+	for (;;) {
+		lag = slot_lag(q, pos, pos);
+		if (lag == 0) {
+			if (atomic_cas(&q->tail, pos, pos + 1)) {
+				break;
+			}
+		} else if (lag < 0) {
+			/* Slot still holds an item from the previous lap */
+			return false;
+		}
+
+		pos = atomic_get(&q->tail);
+	}
+
+	q->slots[pos & q->mask].data = data;
+	slot_publish(q, pos, pos + 1);
+
+	return true;
+}
+
+static void *mpmcq_dequeue(struct k_mpmcq *q)
+{
+	atomic_val_t pos = atomic_get(&q->head);
+	atomic_val_t lag;
+	void *data;
+
+	for (;;) {
+		lag = slot_lag(q, pos, pos + 1);
+		if (lag == 0) {
+			if (atomic_cas(&q->head, pos, pos + 1)) {
+				break;
+			}
+		} else if (lag < 0) {
+			/* Slot not filled yet, the ring is empty */
+			return NULL;
+		}
+
+		pos = atomic_get(&q->head);
+	}
+
+	data = q->slots[pos & q->mask].data;
+	slot_publish(q, pos, pos + (atomic_val_t)q->mask + 1);
+
+	return data;
+}
+
+int k_mpmcq_put(struct k_mpmcq *q, void *data)
+{
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+	if (!mpmcq_enqueue(q, data)) {
+		return -ENOMEM;
+	}
+
+	/* The item is published before the waiter count is sampled and a
+	 * consumer bumps the count before its last look at the ring, so at
+	 * least one side always sees the other.
+	 */
+	if (atomic_get(&q->waiters) == 0) {
+		return 0;
+	}
+
+	key = k_spin_lock(&q->lock);
+	thread = z_unpend_first_thread(&q->wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+		z_reschedule(&q->lock, key);
+	} else {
+		k_spin_unlock(&q->lock, key);
+	}
+
+	return 0;
+}
+
+void *k_mpmcq_get(struct k_mpmcq *q, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	int64_t now, end;
+	void *data;
+
+	data = mpmcq_dequeue(q);
+	if (data != NULL || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return data;
+	}
+
+	__ASSERT(!arch_is_in_isr(), "");
+
+	end = K_TIMEOUT_EQ(timeout, K_FOREVER) ? INT64_MAX :
+	      sys_clock_timeout_end_calc(timeout);
+
+	for (;;) {
+		key = k_spin_lock(&q->lock);
+
+		atomic_inc(&q->waiters);
+
+		/* A producer may have slipped in before we were counted */
+		data = mpmcq_dequeue(q);
+		if (data != NULL) {
+			atomic_dec(&q->waiters);
+			k_spin_unlock(&q->lock, key);
+			break;
+		}
+
+		now = sys_clock_tick_get();
+		if ((end - now) <= 0) {
+			atomic_dec(&q->waiters);
+			k_spin_unlock(&q->lock, key);
+			break;
+		}
+
+		/* Woken up threads race with the fast path of other
+		 * consumers, so just go round again on wakeup.
+		 */
+		(void)z_pend_curr(&q->lock, key, &q->wait_q,
+				  K_TIMEOUT_EQ(timeout, K_FOREVER) ?
+				  K_FOREVER : K_TICKS(end - now));
+
+		atomic_dec(&q->waiters);
+
+		data = mpmcq_dequeue(q);
+		if (data != NULL) {
+			break;
+		}
+	}
+
+	return data;
+}
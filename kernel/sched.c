@@ -198,6 +198,54 @@ static ALWAYS_INLINE void z_priq_dumb_add(sys_dlist_t *pq,
 }
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+static inline bool cpu_allowed(struct k_thread *thread, int cpu)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	return (thread->base.cpu_mask & BIT(cpu)) != 0;
+#else
+	return true;
+#endif
+}
+
+/* Choose the CPU whose run queue a newly runnable thread goes into.
+ * Prefer the CPU it last ran on (its cache is likely still warm),
+ * unless that CPU already has queued work and some other allowed CPU
+ * is sitting idle with an empty queue.
+ */
+static int runq_home_cpu(struct k_thread *thread)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	int cpu = thread->base.cpu;
+
+	if ((cpu >= num_cpus) || !cpu_allowed(thread, cpu)) {
+		cpu = -1;
+	} else if (_kernel.cpus[cpu].ready_q.num_queued == 0U) {
+		return cpu;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		struct _cpu *c = &_kernel.cpus[i];
+
+		if (!cpu_allowed(thread, i)) {
+			continue;
+		}
+		if ((c->ready_q.num_queued == 0U) &&
+		    (c->current == c->idle_thread)) {
+			return i;
+		}
+		if (cpu < 0) {
+			cpu = i;
+		}
+	}
+
+	/* Edge case: a thread with all CPUs masked off is legal to
+	 * "make runnable" per the API, it just never gets picked.
+	 */
+	return (cpu < 0) ? 0 : cpu;
+}
+#endif
+
 static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 {
 #ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
@@ -212,6 +260,8 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	return &_kernel.cpus[thread->base.runq_cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -219,7 +269,7 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
@@ -228,17 +278,81 @@ static ALWAYS_INLINE void *curr_cpu_runq(void)
 
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	thread->base.runq_cpu = runq_home_cpu(thread);
+	_kernel.cpus[thread->base.runq_cpu].ready_q.num_queued++;
+#endif
 	_priq_run_add(thread_runq(thread), thread);
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	_kernel.cpus[thread->base.runq_cpu].ready_q.num_queued--;
+#endif
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Best thread for the current CPU across the per-CPU run queues.
+ * The local queue is always consulted first.  In strict mode the
+ * heads of all sibling queues compete with it on priority; otherwise
+ * siblings are only looked at when the local queue has nothing to
+ * offer, in which case we steal from the busiest one that holds a
+ * thread we're allowed to run.  Either way the pick is dequeued by
+ * the caller from whatever queue it lives in (see runq_remove()).
+ */
+static struct k_thread *runq_best_percpu(void)
+{
+	struct k_thread *thread = _priq_run_best(curr_cpu_runq());
+	unsigned int num_cpus = arch_num_cpus();
+	int curr = _current_cpu->id;
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ_STRICT
+	for (int i = 0; i < num_cpus; i++) {
+		struct k_thread *t;
+
+		if ((i == curr) || (_kernel.cpus[i].ready_q.num_queued == 0U)) {
+			continue;
+		}
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if ((t != NULL) &&
+		    ((thread == NULL) || (z_sched_prio_cmp(t, thread) > 0))) {
+			thread = t;
+		}
+	}
+#else
+	unsigned int busiest = 0U;
+
+	if (thread != NULL) {
+		return thread;
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		unsigned int n = _kernel.cpus[i].ready_q.num_queued;
+		struct k_thread *t;
+
+		if ((i == curr) || (n <= busiest)) {
+			continue;
+		}
+		t = _priq_run_best(&_kernel.cpus[i].ready_q.runq);
+		if (t != NULL) {
+			thread = t;
+			busiest = n;
+		}
+	}
+#endif
+	return thread;
+}
+#endif
+
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	return runq_best_percpu();
+#else
 	return _priq_run_best(curr_cpu_runq());
+#endif
 }
 
 /* _current is never in the run queue until context switch on
@@ -1286,17 +1400,20 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
 	sys_dlist_init(&rq->runq);
 #endif
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	rq->num_queued = 0U;
+#endif
 }
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	unsigned int num_cpus = arch_num_cpus();
 
 	for (int i = 0; i < num_cpus; i++) {
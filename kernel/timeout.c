@@ -14,7 +14,9 @@
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_HEAP
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +38,144 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_HEAP
+/* Pending timeouts are kept in a pairing heap ordered by absolute
+ * expiry tick (stored in dticks) and then by arming sequence.  The
+ * embedded dlist node is reused for the heap links: node.next points
+ * to the next sibling and node.prev to the previous sibling, or to
+ * the parent for a leftmost child.  The end of a sibling chain is
+ * marked with heap_end rather than NULL so that sys_dnode_is_linked()
+ * keeps meaning "pending" for every timeout in the heap.
+ */
+static sys_dnode_t heap_end;
+
+static struct _timeout *heap_root;
+
+static uint32_t heap_seq;
+
+static inline struct _timeout *heap_node(sys_dnode_t *n)
+{
+	return (n == NULL || n == &heap_end)
+		? NULL : CONTAINER_OF(n, struct _timeout, node);
+}
+
+static inline sys_dnode_t *heap_link(struct _timeout *t)
+{
+	return t == NULL ? &heap_end : &t->node;
+}
+
+static bool heap_before(struct _timeout *a, struct _timeout *b)
+{
+	if (a->dticks != b->dticks) {
+		return a->dticks < b->dticks;
+	}
+	return (int32_t)(a->seq - b->seq) < 0;
+}
+
+/* Join two detached trees, the loser becoming the leftmost child
+ * of the winner.  Returns the new root.
+ */
+static struct _timeout *heap_meld(struct _timeout *a, struct _timeout *b)
+{
+	if (a == NULL) {
+		a = b;
+	} else if (b != NULL) {
+		if (heap_before(b, a)) {
+			struct _timeout *tmp = a;
+
+			a = b;
+			b = tmp;
+		}
+
+		b->node.next = heap_link(a->child);
+		b->node.prev = &a->node;
+		if (a->child != NULL) {
+			a->child->node.prev = &b->node;
+		}
+		a->child = b;
+	}
+
+	if (a != NULL) {
+		a->node.next = &heap_end;
+		a->node.prev = NULL;
+	}
+
+	return a;
+}
+
+/* Standard two pass pairing of a sibling chain, done iteratively so
+ * the stack depth doesn't depend on the number of timeouts.  The
+ * first pass melds siblings pairwise left to right, pushing each
+ * result on a stack threaded through node.prev; the second pops
+ * and melds them right to left.
+ */
+static struct _timeout *heap_merge_pairs(struct _timeout *t)
+{
+	struct _timeout *stack = NULL, *root = NULL;
+
+	while (t != NULL) {
+		struct _timeout *a = t, *b = heap_node(a->node.next);
+
+		t = (b == NULL) ? NULL : heap_node(b->node.next);
+		a = heap_meld(a, b);
+		a->node.prev = (stack == NULL) ? NULL : &stack->node;
+		stack = a;
+	}
+
+	while (stack != NULL) {
+		struct _timeout *a = stack;
+
+		stack = heap_node(a->node.prev);
+		root = heap_meld(root, a);
+	}
+
+	return root;
+}
+
+static void heap_insert(struct _timeout *to)
+{
+	to->child = NULL;
+	to->seq = heap_seq++;
+	heap_root = heap_meld(heap_root, to);
+}
+
+static struct _timeout *first(void)
+{
+	return heap_root;
+}
+
+/* Ticks until expiry, relative to curr_tick */
+static k_ticks_t timeout_dticks(struct _timeout *t)
+{
+	return t->dticks - (k_ticks_t)curr_tick;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	struct _timeout *sub = heap_merge_pairs(t->child);
+
+	if (t == heap_root) {
+		heap_root = sub;
+	} else {
+		struct _timeout *p = heap_node(t->node.prev);
+		struct _timeout *s = heap_node(t->node.next);
+
+		if (p->child == t) {
+			p->child = s;
+		} else {
+			p->node.next = heap_link(s);
+		}
+		if (s != NULL) {
+			s->node.prev = &p->node;
+		}
+
+		heap_root = heap_meld(heap_root, sub);
+	}
+
+	t->child = NULL;
+	sys_dnode_init(&t->node);
+}
+#else
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +190,11 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+static k_ticks_t timeout_dticks(struct _timeout *t)
+{
+	return t->dticks;
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -58,6 +203,7 @@ static void remove_timeout(struct _timeout *t)
 
 	sys_dlist_remove(&t->node);
 }
+#endif /* CONFIG_TIMEOUT_HEAP */
 
 static int32_t elapsed(void)
 {
@@ -71,10 +217,10 @@ static int32_t next_timeout(void)
 	int32_t ret;
 
 	if ((to == NULL) ||
-	    ((int64_t)(to->dticks - ticks_elapsed) > (int64_t)INT_MAX)) {
+	    ((int64_t)(timeout_dticks(to) - ticks_elapsed) > (int64_t)INT_MAX)) {
 		ret = MAX_WAIT;
 	} else {
-		ret = MAX(0, to->dticks - ticks_elapsed);
+		ret = MAX(0, timeout_dticks(to) - ticks_elapsed);
 	}
 
 #ifdef CONFIG_TIMESLICING
@@ -100,8 +246,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -111,6 +255,12 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
+#ifdef CONFIG_TIMEOUT_HEAP
+		to->dticks += curr_tick;
+		heap_insert(to);
+#else
+		struct _timeout *t;
+
 		for (t = first(); t != NULL; t = next(t)) {
 			if (t->dticks > to->dticks) {
 				t->dticks -= to->dticks;
@@ -123,6 +273,7 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		if (t == NULL) {
 			sys_dlist_append(&timeout_list, &to->node);
 		}
+#endif
 
 		if (to == first()) {
 #if CONFIG_TIMESLICING
@@ -170,12 +321,16 @@ static k_ticks_t timeout_rem(const struct _timeout *timeout)
 		return 0;
 	}
 
+#ifdef CONFIG_TIMEOUT_HEAP
+	ticks = timeout_dticks((struct _timeout *)timeout);
+#else
 	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
 		ticks += t->dticks;
 		if (timeout == t) {
 			break;
 		}
 	}
+#endif
 
 	return ticks - elapsed();
 }
@@ -261,9 +416,9 @@ void sys_clock_announce(int32_t ticks)
 	struct _timeout *t = first();
 
 	for (t = first();
-	     (t != NULL) && (t->dticks <= announce_remaining);
+	     (t != NULL) && (timeout_dticks(t) <= announce_remaining);
 	     t = first()) {
-		int dt = t->dticks;
+		int dt = timeout_dticks(t);
 
 		curr_tick += dt;
 		t->dticks = 0;
@@ -275,9 +430,11 @@ void sys_clock_announce(int32_t ticks)
 		announce_remaining -= dt;
 	}
 
+#ifndef CONFIG_TIMEOUT_HEAP
 	if (t != NULL) {
 		t->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
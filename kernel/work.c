@@ -157,6 +157,223 @@ int k_work_busy_get(const struct k_work *work)
 	return ret;
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Find the pool worker that is running a work item.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker, or NULL if no worker of the pool runs @p work.
+ */
+static struct k_work_q_worker *pool_active_worker(struct k_work_q *queue,
+						  struct k_work *work)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (queue->workers[i].active == work) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Find the pool worker animated by the current thread.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the worker, or NULL if the current thread is not part of the pool.
+ */
+static struct k_work_q_worker *pool_current_worker(struct k_work_q *queue)
+{
+	if (k_is_in_isr()) {
+		return NULL;
+	}
+
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (_current == &queue->workers[i].thread) {
+			return &queue->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Hand a work item to a worker of a pool.
+ *
+ * A work item that is running stays with the worker running it, so it
+ * cannot run concurrently with itself.  Work submitted from a worker stays
+ * with that worker, and other work goes to the worker pinned to the current
+ * CPU or to each worker in turn.
+ *
+ * Invoked with work lock held.
+ */
+static void pool_submit_locked(struct k_work_q *queue, struct k_work *work)
+{
+	struct k_work_q_worker *worker = NULL;
+	size_t idx;
+
+	if (flag_test(&work->flags, K_WORK_RUNNING_BIT)) {
+		worker = pool_active_worker(queue, work);
+		__ASSERT_NO_MSG(worker != NULL);
+	}
+
+	if (worker == NULL) {
+		worker = pool_current_worker(queue);
+	}
+
+	if (worker == NULL) {
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (queue->pinned) {
+			idx = _current_cpu->id % queue->num_workers;
+		} else
+#endif
+		{
+			idx = queue->next_worker;
+			queue->next_worker = (idx + 1U) % queue->num_workers;
+		}
+
+		worker = &queue->workers[idx];
+	}
+
+	sys_slist_append(&worker->pending, &work->node);
+}
+
+/* Add a flusher work item behind a work item of a pool.
+ *
+ * The flusher goes right behind the work item if it is queued, or at the
+ * head of the worker running it otherwise.  Flushers are never stolen on
+ * their own, so they run on the worker that runs the item they wait for.
+ *
+ * Invoked with work lock held.
+ */
+static void pool_flusher_locked(struct k_work_q *queue,
+				struct k_work *work,
+				struct z_work_flusher *flusher)
+{
+	struct k_work_q_worker *worker;
+	struct k_work *wn;
+
+	init_flusher(flusher);
+
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		worker = &queue->workers[i];
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&worker->pending, wn, node) {
+			if (wn == work) {
+				sys_slist_insert(&worker->pending, &work->node,
+						 &flusher->work.node);
+				return;
+			}
+		}
+	}
+
+	worker = pool_active_worker(queue, work);
+	__ASSERT_NO_MSG(worker != NULL);
+
+	sys_slist_prepend(&worker->pending, &flusher->work.node);
+}
+
+/* Remove a queued work item from whichever worker of a pool holds it.
+ *
+ * Invoked with work lock held.
+ */
+static void pool_remove_locked(struct k_work_q *queue, struct k_work *work)
+{
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (sys_slist_find_and_remove(&queue->workers[i].pending,
+					      &work->node)) {
+			return;
+		}
+	}
+}
+
+/* Steal a work item from another worker of a pool.
+ *
+ * Takes the oldest item of @p victim that is neither running nor a
+ * flusher.  The flushers queued right behind the stolen item wait for it,
+ * so they move to @p thief along with it.
+ *
+ * Invoked with work lock held.
+ *
+ * @return the stolen work item, or NULL if there is nothing to steal.
+ */
+static struct k_work *pool_steal_locked(struct k_work_q_worker *victim,
+					struct k_work_q_worker *thief)
+{
+	sys_snode_t *prev = NULL;
+	sys_snode_t *node;
+	struct k_work *work;
+
+	SYS_SLIST_FOR_EACH_NODE(&victim->pending, node) {
+		work = CONTAINER_OF(node, struct k_work, node);
+
+		if (!flag_test(&work->flags, K_WORK_RUNNING_BIT) &&
+		    (work->handler != handle_flush)) {
+			break;
+		}
+
+		prev = node;
+	}
+
+	if (node == NULL) {
+		return NULL;
+	}
+
+	sys_slist_remove(&victim->pending, prev, node);
+
+	while (true) {
+		struct k_work *flush;
+
+		node = (prev != NULL) ? sys_slist_peek_next(prev)
+				      : sys_slist_peek_head(&victim->pending);
+		if (node == NULL) {
+			break;
+		}
+
+		flush = CONTAINER_OF(node, struct k_work, node);
+		if (flush->handler != handle_flush) {
+			break;
+		}
+
+		sys_slist_remove(&victim->pending, prev, node);
+		sys_slist_append(&thief->pending, node);
+	}
+
+	return work;
+}
+
+/* Take the next work item for a worker of a pool: the oldest item handed
+ * to the worker itself, or else an item stolen from the next busy worker.
+ *
+ * Invoked with work lock held.
+ */
+static struct k_work *pool_take_locked(struct k_work_q *queue,
+				       struct k_work_q_worker *worker)
+{
+	size_t self = worker - queue->workers;
+	sys_snode_t *node;
+	struct k_work *work;
+
+	/* Items running elsewhere are never handed to another worker, and
+	 * flushers here were queued for items this worker ran or stole.
+	 */
+	node = sys_slist_get(&worker->pending);
+	if (node != NULL) {
+		return CONTAINER_OF(node, struct k_work, node);
+	}
+
+	for (size_t i = 1; i < queue->num_workers; i++) {
+		size_t idx = (self + i) % queue->num_workers;
+
+		work = pool_steal_locked(&queue->workers[idx], worker);
+		if (work != NULL) {
+			return work;
+		}
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 /* Add a flusher work item to the queue.
  *
  * Invoked with work lock held.
@@ -175,6 +392,13 @@ static void queue_flusher_locked(struct k_work_q *queue,
 	bool in_list = false;
 	struct k_work *wn;
 
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->workers != NULL) {
+		pool_flusher_locked(queue, work, flusher);
+		return;
+	}
+#endif
+
 	/* Determine whether the work item is still queued. */
 	SYS_SLIST_FOR_EACH_CONTAINER(&queue->pending, wn, node) {
 		if (wn == work) {
@@ -203,10 +427,48 @@ static inline void queue_remove_locked(struct k_work_q *queue,
 				       struct k_work *work)
 {
 	if (flag_test_and_clear(&work->flags, K_WORK_QUEUED_BIT)) {
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue->workers != NULL) {
+			pool_remove_locked(queue, work);
+			return;
+		}
+#endif
 		(void)sys_slist_find_and_remove(&queue->pending, &work->node);
 	}
 }
 
+/* Determine whether the current thread animates the given queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_is_current_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	if (queue->workers != NULL) {
+		return pool_current_worker(queue) != NULL;
+	}
+#endif
+
+	return (_current == &queue->thread) && !k_is_in_isr();
+}
+
+/* Determine whether any work item is waiting on the given queue.
+ *
+ * Invoked with work lock held.
+ */
+static inline bool queue_has_pending_locked(struct k_work_q *queue)
+{
+#ifdef CONFIG_WORKQUEUE_POOL
+	for (size_t i = 0; i < queue->num_workers; i++) {
+		if (!sys_slist_is_empty(&queue->workers[i].pending)) {
+			return true;
+		}
+	}
+#endif
+
+	return !sys_slist_is_empty(&queue->pending);
+}
+
 /* Potentially notify a queue that it needs to look for pending work.
  *
  * This may make the work queue thread ready, but as the lock is held it
@@ -256,7 +518,7 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	}
 
 	int ret = -EBUSY;
-	bool chained = (_current == &queue->thread) && !k_is_in_isr();
+	bool chained = queue_is_current_locked(queue);
 	bool draining = flag_test(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 	bool plugged = flag_test(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
 
@@ -274,7 +536,15 @@ static inline int queue_submit_locked(struct k_work_q *queue,
 	} else if (plugged && !draining) {
 		ret = -EBUSY;
 	} else {
+#ifdef CONFIG_WORKQUEUE_POOL
+		if (queue->workers != NULL) {
+			pool_submit_locked(queue, work);
+		} else {
+			sys_slist_append(&queue->pending, &work->node);
+		}
+#else
 		sys_slist_append(&queue->pending, &work->node);
+#endif
 		ret = 1;
 		(void)notify_queue_locked(queue);
 	}
@@ -692,6 +962,92 @@ static void work_queue_main(void *workq_ptr, void *p2, void *p3)
 	}
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+/* Loop executed by each thread of a work queue pool.
+ *
+ * @param worker_ptr pointer to the worker structure
+ * @param workq_ptr pointer to the work queue structure
+ */
+static void work_queue_pool_main(void *worker_ptr, void *workq_ptr, void *p3)
+{
+	struct k_work_q_worker *worker = (struct k_work_q_worker *)worker_ptr;
+	struct k_work_q *queue = (struct k_work_q *)workq_ptr;
+
+	while (true) {
+		struct k_work *work;
+		k_work_handler_t handler = NULL;
+		k_spinlock_key_t key = k_spin_lock(&lock);
+		bool yield;
+
+		/* Check for and prepare any new work, our own first. */
+		work = pool_take_locked(queue, worker);
+		if (work != NULL) {
+			/* Mark that there's some work active that's
+			 * not on any pending list.
+			 */
+			queue->num_active++;
+			flag_set(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+			worker->active = work;
+			flag_set(&work->flags, K_WORK_RUNNING_BIT);
+			flag_clear(&work->flags, K_WORK_QUEUED_BIT);
+			handler = work->handler;
+		} else if ((queue->num_active == 0U) &&
+			   !queue_has_pending_locked(queue) &&
+			   flag_test_and_clear(&queue->flags,
+					       K_WORK_QUEUE_DRAIN_BIT)) {
+			/* No worker is busy and nothing is pending on any
+			 * worker list: release the threads waiting for the
+			 * drain, as the single thread loop does.  Items this
+			 * worker may not steal, such as flushers bound to
+			 * another worker, keep the drain going until their
+			 * owner has run them and finds the queue empty.
+			 */
+			(void)z_sched_wake_all(&queue->drainq, 1, NULL);
+		} else {
+			/* No work is available and no queue state requires
+			 * special handling.
+			 */
+			;
+		}
+
+		if (work == NULL) {
+			(void)z_sched_wait(&lock, key, &queue->notifyq,
+					   K_FOREVER, NULL);
+			continue;
+		}
+
+		k_spin_unlock(&lock, key);
+
+		__ASSERT_NO_MSG(handler != NULL);
+		handler(work);
+
+		/* Mark the work item as no longer running and deal
+		 * with any cancellation issued while it was running.
+		 * Clear the BUSY flag once no worker is running an item
+		 * and optionally yield to prevent starving other threads.
+		 */
+		key = k_spin_lock(&lock);
+
+		flag_clear(&work->flags, K_WORK_RUNNING_BIT);
+		if (flag_test(&work->flags, K_WORK_CANCELING_BIT)) {
+			finalize_cancel_locked(work);
+		}
+
+		worker->active = NULL;
+		if (--queue->num_active == 0U) {
+			flag_clear(&queue->flags, K_WORK_QUEUE_BUSY_BIT);
+		}
+
+		yield = !flag_test(&queue->flags, K_WORK_QUEUE_NO_YIELD_BIT);
+		k_spin_unlock(&lock, key);
+
+		if (yield) {
+			k_yield();
+		}
+	}
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 void k_work_queue_init(struct k_work_q *queue)
 {
 	__ASSERT_NO_MSG(queue != NULL);
@@ -743,6 +1099,72 @@ void k_work_queue_start(struct k_work_q *queue,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
 }
 
+#ifdef CONFIG_WORKQUEUE_POOL
+void k_work_queue_pool_start(struct k_work_q *queue,
+			     struct k_work_q_worker *workers, size_t num_workers,
+			     k_thread_stack_t *stacks, size_t stack_size,
+			     int prio, const struct k_work_queue_config *cfg)
+{
+	__ASSERT_NO_MSG(queue);
+	__ASSERT_NO_MSG(workers);
+	__ASSERT_NO_MSG((num_workers > 0U) && (num_workers <= UINT16_MAX));
+	__ASSERT_NO_MSG(stacks);
+	__ASSERT_NO_MSG(!flag_test(&queue->flags, K_WORK_QUEUE_STARTED_BIT));
+	uint32_t flags = K_WORK_QUEUE_STARTED;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_work_queue, start, queue);
+
+	sys_slist_init(&queue->pending);
+	z_waitq_init(&queue->notifyq);
+	z_waitq_init(&queue->drainq);
+
+	queue->workers = workers;
+	queue->num_workers = num_workers;
+	queue->num_active = 0U;
+	queue->next_worker = 0U;
+	queue->pinned = IS_ENABLED(CONFIG_SCHED_CPU_MASK) &&
+			(cfg != NULL) && cfg->pin_workers;
+
+	if ((cfg != NULL) && cfg->no_yield) {
+		flags |= K_WORK_QUEUE_NO_YIELD;
+	}
+
+	for (size_t i = 0; i < num_workers; i++) {
+		struct k_work_q_worker *worker = &workers[i];
+		k_thread_stack_t *stack = stacks + i * K_THREAD_STACK_LEN(stack_size);
+
+		sys_slist_init(&worker->pending);
+		worker->active = NULL;
+
+		(void)k_thread_create(&worker->thread, stack, stack_size,
+				      work_queue_pool_main, worker, queue, NULL,
+				      prio, 0, K_FOREVER);
+
+		if ((cfg != NULL) && (cfg->name != NULL)) {
+			k_thread_name_set(&worker->thread, cfg->name);
+		}
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (queue->pinned) {
+			(void)k_thread_cpu_pin(&worker->thread,
+					       i % arch_num_cpus());
+		}
+#endif
+	}
+
+	/* As for a single thread queue, submissions are accepted from here
+	 * on and wait for the workers to get control.
+	 */
+	flags_set(&queue->flags, flags);
+
+	for (size_t i = 0; i < num_workers; i++) {
+		k_thread_start(&workers[i].thread);
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_work_queue, start, queue);
+}
+#endif /* CONFIG_WORKQUEUE_POOL */
+
 int k_work_queue_drain(struct k_work_q *queue,
 		       bool plug)
 {
@@ -757,7 +1179,7 @@ int k_work_queue_drain(struct k_work_q *queue,
 	if (((flags_get(&queue->flags)
 	      & (K_WORK_QUEUE_BUSY | K_WORK_QUEUE_DRAIN)) != 0U)
 	    || plug
-	    || !sys_slist_is_empty(&queue->pending)) {
+	    || queue_has_pending_locked(queue)) {
 		flag_set(&queue->flags, K_WORK_QUEUE_DRAIN_BIT);
 		if (plug) {
 			flag_set(&queue->flags, K_WORK_QUEUE_PLUGGED_BIT);
@@ -35,21 +35,51 @@ Z_GENERIC_SECTION(POOL_SECTION) static struct sys_heap z_malloc_heap;
 Z_GENERIC_SECTION(POOL_SECTION) struct sys_mutex z_malloc_heap_mutex;
 Z_GENERIC_SECTION(POOL_SECTION) static char z_malloc_heap_mem[HEAP_BYTES];
 
-void *malloc(size_t size)
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_CACHE
+#include <zephyr/sys/sys_heap_cache.h>
+
+/* The cache serializes heap access itself, the mutex is unused */
+static struct sys_heap_cache z_malloc_heap_cache;
+
+#define malloc_lock() do {} while (false)
+#define malloc_unlock() do {} while (false)
+#define heap_aligned_alloc(align, size) \
+	sys_heap_cache_aligned_alloc(&z_malloc_heap_cache, align, size)
+#define heap_aligned_realloc(ptr, align, size) \
+	sys_heap_cache_aligned_realloc(&z_malloc_heap_cache, ptr, align, size)
+#define heap_free(ptr) sys_heap_cache_free(&z_malloc_heap_cache, ptr)
+#else
+static inline void malloc_lock(void)
 {
 	int lock_ret;
 
 	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
 	__ASSERT_NO_MSG(lock_ret == 0);
+}
+
+static inline void malloc_unlock(void)
+{
+	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+}
+
+#define heap_aligned_alloc(align, size) \
+	sys_heap_aligned_alloc(&z_malloc_heap, align, size)
+#define heap_aligned_realloc(ptr, align, size) \
+	sys_heap_aligned_realloc(&z_malloc_heap, ptr, align, size)
+#define heap_free(ptr) sys_heap_free(&z_malloc_heap, ptr)
+#endif /* CONFIG_MINIMAL_LIBC_MALLOC_CACHE */
+
+void *malloc(size_t size)
+{
+	malloc_lock();
+
+	void *ret = heap_aligned_alloc(__alignof__(z_max_align_t), size);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   __alignof__(z_max_align_t),
-					   size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
 
-	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+	malloc_unlock();
 
 	return ret;
 }
@@ -58,19 +88,15 @@ void *malloc(size_t size)
 #if __STDC_VERSION__ >= 201112L
 void *aligned_alloc(size_t alignment, size_t size)
 {
-	int lock_ret;
+	malloc_lock();
 
-	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
-	__ASSERT_NO_MSG(lock_ret == 0);
+	void *ret = heap_aligned_alloc(alignment, size);
 
-	void *ret = sys_heap_aligned_alloc(&z_malloc_heap,
-					   alignment,
-					   size);
 	if (ret == NULL && size != 0) {
 		errno = ENOMEM;
 	}
 
-	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+	malloc_unlock();
 
 	return ret;
 }
@@ -82,38 +108,34 @@ static int malloc_prepare(const struct device *unused)
 
 	sys_heap_init(&z_malloc_heap, z_malloc_heap_mem, HEAP_BYTES);
 	sys_mutex_init(&z_malloc_heap_mutex);
+#ifdef CONFIG_MINIMAL_LIBC_MALLOC_CACHE
+	sys_heap_cache_init(&z_malloc_heap_cache, &z_malloc_heap, NULL);
+#endif
 
 	return 0;
 }
 
 void *realloc(void *ptr, size_t requested_size)
 {
-	int lock_ret;
-
-	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
-	__ASSERT_NO_MSG(lock_ret == 0);
+	malloc_lock();
 
-	void *ret = sys_heap_aligned_realloc(&z_malloc_heap, ptr,
-					     __alignof__(z_max_align_t),
-					     requested_size);
+	void *ret = heap_aligned_realloc(ptr, __alignof__(z_max_align_t),
+					 requested_size);
 
 	if (ret == NULL && requested_size != 0) {
 		errno = ENOMEM;
 	}
 
-	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+	malloc_unlock();
 
 	return ret;
 }
 
 void free(void *ptr)
 {
-	int lock_ret;
-
-	lock_ret = sys_mutex_lock(&z_malloc_heap_mutex, K_FOREVER);
-	__ASSERT_NO_MSG(lock_ret == 0);
-	sys_heap_free(&z_malloc_heap, ptr);
-	(void) sys_mutex_unlock(&z_malloc_heap_mutex);
+	malloc_lock();
+	heap_free(ptr);
+	malloc_unlock();
 }
 
 SYS_INIT(malloc_prepare, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
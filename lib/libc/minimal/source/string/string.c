@@ -10,6 +10,152 @@
 #include <stdint.h>
 #include <sys/types.h>
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+
+#define MEM_WORD_SIZE	sizeof(mem_word_t)
+#define MEM_WORD_MASK	(MEM_WORD_SIZE - 1)
+
+/* 0x01 and 0x80 repeated in each byte of a word */
+#define MEM_WORD_ONES	((mem_word_t)-1 / 0xff)
+#define MEM_WORD_HIGHS	(MEM_WORD_ONES << 7)
+
+/*
+ * With CONFIG_MINIMAL_LIBC_ARCH_STRING, memcpy, memset, memcmp, memchr and
+ * strlen come from an architecture specific file instead, e.g. string_sse2.c.
+ *
+ * The string functions below read whole aligned words. An aligned word never
+ * crosses a page or MPU region boundary, so the bytes read past the end of a
+ * string or buffer are always accessible.
+ */
+
+/* Non-zero if any byte of <w> is zero */
+static inline mem_word_t mem_word_has_zero(mem_word_t w)
+{
+	return (w - MEM_WORD_ONES) & ~w & MEM_WORD_HIGHS;
+}
+
+/*
+ * Build the word starting <shift> bits into <lo>, <hi> being the word that
+ * follows <lo> in memory. This lets a misaligned buffer be read with aligned
+ * accesses only.
+ */
+static inline mem_word_t mem_word_merge(mem_word_t lo, mem_word_t hi,
+					unsigned int shift)
+{
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	return (lo << shift) | (hi >> (Z_MEM_WORD_T_WIDTH - shift));
+#else
+	return (lo >> shift) | (hi << (Z_MEM_WORD_T_WIDTH - shift));
+#endif
+}
+
+/*
+ * Copy <n> bytes forward with aligned word stores, the source being read with
+ * aligned word loads whatever its alignment. Safe when the buffers overlap
+ * with <d> below <s>, as each source word is loaded before the destination
+ * words it could overlap are stored.
+ */
+static void mem_copy_forward(unsigned char *d_byte, const unsigned char *s_byte,
+			     size_t n)
+{
+	if (n >= 2 * MEM_WORD_SIZE) {
+		while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		uintptr_t off = ((uintptr_t)s_byte) & MEM_WORD_MASK;
+
+		if (off == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+			while (n >= MEM_WORD_SIZE) {
+				*(d_word++) = *(s_word++);
+				n -= MEM_WORD_SIZE;
+			}
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			const mem_word_t *s_word = (const mem_word_t *)(s_byte - off);
+			unsigned int shift = off * 8U;
+			mem_word_t lo = *(s_word++);
+			mem_word_t hi;
+
+			while (n >= MEM_WORD_SIZE) {
+				hi = *(s_word++);
+				*(d_word++) = mem_word_merge(lo, hi, shift);
+				lo = hi;
+				n -= MEM_WORD_SIZE;
+			}
+
+			s_byte = (const unsigned char *)s_word - MEM_WORD_SIZE + off;
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+}
+
+/*
+ * Copy <n> bytes backward, from the end of the buffers. Safe when the buffers
+ * overlap with <d> above <s>.
+ */
+static void mem_copy_backward(unsigned char *d_byte, const unsigned char *s_byte,
+			      size_t n)
+{
+	d_byte += n;
+	s_byte += n;
+
+	if (n >= 2 * MEM_WORD_SIZE) {
+		while (((uintptr_t)d_byte) & MEM_WORD_MASK) {
+			*(--d_byte) = *(--s_byte);
+			n--;
+		}
+
+		mem_word_t *d_word = (mem_word_t *)d_byte;
+		uintptr_t off = ((uintptr_t)s_byte) & MEM_WORD_MASK;
+
+		if (off == 0) {
+			const mem_word_t *s_word = (const mem_word_t *)s_byte;
+
+			while (n >= MEM_WORD_SIZE) {
+				*(--d_word) = *(--s_word);
+				n -= MEM_WORD_SIZE;
+			}
+
+			s_byte = (const unsigned char *)s_word;
+		} else {
+			const mem_word_t *s_word = (const mem_word_t *)(s_byte - off);
+			unsigned int shift = off * 8U;
+			mem_word_t hi = *s_word;
+			mem_word_t lo;
+
+			while (n >= MEM_WORD_SIZE) {
+				lo = *(--s_word);
+				*(--d_word) = mem_word_merge(lo, hi, shift);
+				hi = lo;
+				n -= MEM_WORD_SIZE;
+			}
+
+			s_byte = (const unsigned char *)s_word + off;
+		}
+
+		d_byte = (unsigned char *)d_word;
+	}
+
+	while (n > 0) {
+		*(--d_byte) = *(--s_byte);
+		n--;
+	}
+}
+
+#endif /* !CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE */
+
 /**
  *
  * @brief Copy a string
@@ -97,6 +243,7 @@ char *strrchr(const char *s, int c)
 	return match;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRING)
 /**
  *
  * @brief Get string length
@@ -106,15 +253,34 @@ char *strrchr(const char *s, int c)
 
 size_t strlen(const char *s)
 {
-	size_t n = 0;
+	const char *p = s;
 
-	while (*s != '\0') {
-		s++;
-		n++;
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	while (((uintptr_t)p) & MEM_WORD_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
 	}
 
-	return n;
+	/* find the word holding the terminator, then the terminator */
+
+	const mem_word_t *p_word = (const mem_word_t *)p;
+
+	while (!mem_word_has_zero(*p_word)) {
+		p_word++;
+	}
+
+	p = (const char *)p_word;
+#endif
+
+	while (*p != '\0') {
+		p++;
+	}
+
+	return p - s;
 }
+#endif /* !CONFIG_MINIMAL_LIBC_ARCH_STRING */
 
 /**
  *
@@ -144,6 +310,34 @@ size_t strnlen(const char *s, size_t maxlen)
 
 int strcmp(const char *s1, const char *s2)
 {
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/*
+	 * Compare whole words only if the strings have identical alignment:
+	 * reading a misaligned string word by word could go past its
+	 * terminator into the next word.
+	 */
+	if ((((uintptr_t)s1 ^ (uintptr_t)s2) & MEM_WORD_MASK) == 0) {
+		while ((((uintptr_t)s1) & MEM_WORD_MASK) &&
+		       (*s1 == *s2) && (*s1 != '\0')) {
+			s1++;
+			s2++;
+		}
+
+		if ((((uintptr_t)s1) & MEM_WORD_MASK) == 0) {
+			const mem_word_t *w1 = (const mem_word_t *)s1;
+			const mem_word_t *w2 = (const mem_word_t *)s2;
+
+			while ((*w1 == *w2) && !mem_word_has_zero(*w1)) {
+				w1++;
+				w2++;
+			}
+
+			s1 = (const char *)w1;
+			s2 = (const char *)w2;
+		}
+	}
+#endif
+
 	while ((*s1 == *s2) && (*s1 != '\0')) {
 		s1++;
 		s2++;
@@ -230,6 +424,7 @@ char *strncat(char *ZRESTRICT dest, const char *ZRESTRICT src,
 	return orig_dest;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRING)
 /**
  *
  * @brief Compare two memory areas
@@ -245,6 +440,59 @@ int memcmp(const void *m1, const void *m2, size_t n)
 		return 0;
 	}
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	if (n >= 2 * MEM_WORD_SIZE) {
+		while (((uintptr_t)c1) & MEM_WORD_MASK) {
+			if (*c1 != *c2) {
+				return *c1 - *c2;
+			}
+			c1++;
+			c2++;
+			n--;
+		}
+
+		/*
+		 * Skip the equal words, keeping at least one byte for the
+		 * byte-sized comparison to report the difference.
+		 */
+
+		const mem_word_t *w1 = (const mem_word_t *)c1;
+		uintptr_t off = ((uintptr_t)c2) & MEM_WORD_MASK;
+
+		if (off == 0) {
+			const mem_word_t *w2 = (const mem_word_t *)c2;
+
+			while ((n > MEM_WORD_SIZE) && (*w1 == *w2)) {
+				w1++;
+				w2++;
+				n -= MEM_WORD_SIZE;
+			}
+
+			c2 = (const char *)w2;
+		} else {
+			const mem_word_t *w2 = (const mem_word_t *)(c2 - off);
+			unsigned int shift = off * 8U;
+			mem_word_t lo = *(w2++);
+			mem_word_t hi;
+
+			while (n > MEM_WORD_SIZE) {
+				hi = *w2;
+				if (*w1 != mem_word_merge(lo, hi, shift)) {
+					break;
+				}
+				w1++;
+				w2++;
+				lo = hi;
+				n -= MEM_WORD_SIZE;
+			}
+
+			c2 = (const char *)w2 - MEM_WORD_SIZE + off;
+		}
+
+		c1 = (const char *)w1;
+	}
+#endif
+
 	while ((--n > 0) && (*c1 == *c2)) {
 		c1++;
 		c2++;
@@ -252,6 +500,7 @@ int memcmp(const void *m1, const void *m2, size_t n)
 
 	return *c1 - *c2;
 }
+#endif /* !CONFIG_MINIMAL_LIBC_ARCH_STRING */
 
 /**
  *
@@ -271,23 +520,34 @@ void *memmove(void *d, const void *s, size_t n)
 		 * Copy backwards to prevent the premature corruption of <src>.
 		 */
 
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+		mem_copy_backward((unsigned char *)dest,
+				  (const unsigned char *)src, n);
+#else
 		while (n > 0) {
 			n--;
 			dest[n] = src[n];
 		}
+#endif
 	} else {
 		/* It is safe to perform a forward-copy */
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+		mem_copy_forward((unsigned char *)dest,
+				 (const unsigned char *)src, n);
+#else
 		while (n > 0) {
 			*dest = *src;
 			dest++;
 			src++;
 			n--;
 		}
+#endif
 	}
 
 	return d;
 }
 
+#if !defined(CONFIG_MINIMAL_LIBC_ARCH_STRING)
 /**
  *
  * @brief Copy bytes in memory
@@ -297,47 +557,21 @@ void *memmove(void *d, const void *s, size_t n)
 
 void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
 {
-	/* attempt word-sized copying only if buffers have identical alignment */
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	/* word-sized copying, whatever the alignment of the buffers */
 
+	mem_copy_forward((unsigned char *)d, (const unsigned char *)s, n);
+#else
 	unsigned char *d_byte = (unsigned char *)d;
 	const unsigned char *s_byte = (const unsigned char *)s;
 
-#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
-	const uintptr_t mask = sizeof(mem_word_t) - 1;
-
-	if ((((uintptr_t)d ^ (uintptr_t)s_byte) & mask) == 0) {
-
-		/* do byte-sized copying until word-aligned or finished */
-
-		while (((uintptr_t)d_byte) & mask) {
-			if (n == 0) {
-				return d;
-			}
-			*(d_byte++) = *(s_byte++);
-			n--;
-		}
-
-		/* do word-sized copying as long as possible */
-
-		mem_word_t *d_word = (mem_word_t *)d_byte;
-		const mem_word_t *s_word = (const mem_word_t *)s_byte;
-
-		while (n >= sizeof(mem_word_t)) {
-			*(d_word++) = *(s_word++);
-			n -= sizeof(mem_word_t);
-		}
-
-		d_byte = (unsigned char *)d_word;
-		s_byte = (unsigned char *)s_word;
-	}
-#endif
-
 	/* do byte-sized copying until finished */
 
 	while (n > 0) {
 		*(d_byte++) = *(s_byte++);
 		n--;
 	}
+#endif
 
 	return d;
 }
@@ -403,9 +637,34 @@ void *memset(void *buf, int c, size_t n)
 
 void *memchr(const void *s, int c, size_t n)
 {
-	if (n != 0) {
-		const unsigned char *p = s;
+	const unsigned char *p = s;
+
+#if !defined(CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE)
+	if (n >= 2 * MEM_WORD_SIZE) {
+		while (((uintptr_t)p) & MEM_WORD_MASK) {
+			if (*p == (unsigned char)c) {
+				return (void *)p;
+			}
+			p++;
+			n--;
+		}
+
+		/* find the word holding the byte, then the byte */
+
+		const mem_word_t *p_word = (const mem_word_t *)p;
+		mem_word_t c_word = MEM_WORD_ONES * (unsigned char)c;
+
+		while ((n >= MEM_WORD_SIZE) &&
+		       !mem_word_has_zero(*p_word ^ c_word)) {
+			p_word++;
+			n -= MEM_WORD_SIZE;
+		}
 
+		p = (const unsigned char *)p_word;
+	}
+#endif
+
+	if (n != 0) {
 		do {
 			if (*p++ == (unsigned char)c) {
 				return ((void *)(p - 1));
@@ -416,3 +675,4 @@ void *memchr(const void *s, int c, size_t n)
 
 	return NULL;
 }
+#endif /* !CONFIG_MINIMAL_LIBC_ARCH_STRING */
@@ -0,0 +1,227 @@
+/* string_neon.c - NEON string routines for arm64 */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replaces the generic memcpy, memset, memcmp, memchr and strlen of string.c
+ * when CONFIG_MINIMAL_LIBC_ARCH_STRING is enabled. The NEON registers are
+ * handed to threads and exceptions by the lazy FPU context switch, hence the
+ * dependency on CONFIG_FPU_SHARING.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <arm_neon.h>
+
+#define VEC_SIZE	sizeof(uint8x16_t)
+#define VEC_MASK	(VEC_SIZE - 1)
+
+/*
+ * Narrow the result of a byte compare to four bits per byte, so the index of
+ * the first matching byte is the number of trailing zeros divided by four.
+ */
+static inline uint64_t vec_match_mask(uint8x16_t eq)
+{
+	uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+
+	return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0);
+}
+
+static inline unsigned int vec_match_index(uint64_t mask)
+{
+	return (unsigned int)__builtin_ctzll(mask) / 4U;
+}
+
+/**
+ *
+ * @brief Get string length
+ *
+ * @return number of bytes in string <s>
+ */
+
+size_t strlen(const char *s)
+{
+	const char *p = s;
+
+	while (((uintptr_t)p) & VEC_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/* aligned loads never cross a page boundary */
+
+	uint64_t mask;
+
+	while ((mask = vec_match_mask(
+			vceqzq_u8(vld1q_u8((const uint8_t *)p)))) == 0U) {
+		p += VEC_SIZE;
+	}
+
+	return (p - s) + vec_match_index(mask);
+}
+
+/**
+ *
+ * @brief Compare two memory areas
+ *
+ * @return negative # if <m1> < <m2>, 0 if <m1> == <m2>, else positive #
+ */
+int memcmp(const void *m1, const void *m2, size_t n)
+{
+	const char *c1 = m1;
+	const char *c2 = m2;
+
+	if (!n) {
+		return 0;
+	}
+
+	while (n >= VEC_SIZE) {
+		uint8x16_t ne = vmvnq_u8(vceqq_u8(vld1q_u8((const uint8_t *)c1),
+						  vld1q_u8((const uint8_t *)c2)));
+		uint64_t mask = vec_match_mask(ne);
+
+		if (mask != 0U) {
+			unsigned int i = vec_match_index(mask);
+
+			return c1[i] - c2[i];
+		}
+		c1 += VEC_SIZE;
+		c2 += VEC_SIZE;
+		n -= VEC_SIZE;
+	}
+
+	if (!n) {
+		return 0;
+	}
+
+	while ((--n > 0) && (*c1 == *c2)) {
+		c1++;
+		c2++;
+	}
+
+	return *c1 - *c2;
+}
+
+/**
+ *
+ * @brief Copy bytes in memory
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)d;
+	const unsigned char *s_byte = (const unsigned char *)s;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)d_byte) & VEC_MASK) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		/* aligned stores, the source being read with unaligned loads */
+
+		while (n >= VEC_SIZE) {
+			vst1q_u8(d_byte, vld1q_u8(s_byte));
+			d_byte += VEC_SIZE;
+			s_byte += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+
+/**
+ *
+ * @brief Set bytes in memory
+ *
+ * @return pointer to start of buffer
+ */
+
+void *memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)buf;
+	unsigned char c_byte = (unsigned char)c;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)d_byte) & VEC_MASK) {
+			*(d_byte++) = c_byte;
+			n--;
+		}
+
+		const uint8x16_t c_vec = vdupq_n_u8(c_byte);
+
+		while (n >= VEC_SIZE) {
+			vst1q_u8(d_byte, c_vec);
+			d_byte += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	return buf;
+}
+
+/**
+ *
+ * @brief Scan byte in memory
+ *
+ * @return pointer to start of found byte
+ */
+
+void *memchr(const void *s, int c, size_t n)
+{
+	const unsigned char *p = s;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)p) & VEC_MASK) {
+			if (*p == (unsigned char)c) {
+				return (void *)p;
+			}
+			p++;
+			n--;
+		}
+
+		/* aligned loads never cross a page boundary */
+
+		const uint8x16_t c_vec = vdupq_n_u8((unsigned char)c);
+
+		while (n >= VEC_SIZE) {
+			uint64_t mask = vec_match_mask(vceqq_u8(vld1q_u8(p),
+								c_vec));
+
+			if (mask != 0U) {
+				return (void *)(p + vec_match_index(mask));
+			}
+			p += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	return NULL;
+}
@@ -0,0 +1,220 @@
+/* string_sse2.c - SSE2 string routines for x86_64 */
+
+/*
+ * Copyright (c) 2026 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Replaces the generic memcpy, memset, memcmp, memchr and strlen of string.c
+ * when CONFIG_MINIMAL_LIBC_ARCH_STRING is enabled. x86_64 always has SSE2 and
+ * saves the SSE registers on every interrupt and context switch, so these can
+ * be called from any context.
+ */
+
+#include <string.h>
+#include <stdint.h>
+#include <emmintrin.h>
+
+#define VEC_SIZE	sizeof(__m128i)
+#define VEC_MASK	(VEC_SIZE - 1)
+
+/* One bit per byte of <a> equal to the matching byte of <b> */
+static inline unsigned int vec_eq_mask(__m128i a, __m128i b)
+{
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+}
+
+/**
+ *
+ * @brief Get string length
+ *
+ * @return number of bytes in string <s>
+ */
+
+size_t strlen(const char *s)
+{
+	const char *p = s;
+
+	while (((uintptr_t)p) & VEC_MASK) {
+		if (*p == '\0') {
+			return p - s;
+		}
+		p++;
+	}
+
+	/* aligned loads never cross a page boundary */
+
+	const __m128i zero = _mm_setzero_si128();
+	unsigned int mask;
+
+	while ((mask = vec_eq_mask(_mm_load_si128((const __m128i *)p),
+				   zero)) == 0U) {
+		p += VEC_SIZE;
+	}
+
+	return (p - s) + __builtin_ctz(mask);
+}
+
+/**
+ *
+ * @brief Compare two memory areas
+ *
+ * @return negative # if <m1> < <m2>, 0 if <m1> == <m2>, else positive #
+ */
+int memcmp(const void *m1, const void *m2, size_t n)
+{
+	const char *c1 = m1;
+	const char *c2 = m2;
+
+	if (!n) {
+		return 0;
+	}
+
+	while (n >= VEC_SIZE) {
+		unsigned int mask = vec_eq_mask(
+			_mm_loadu_si128((const __m128i *)c1),
+			_mm_loadu_si128((const __m128i *)c2));
+
+		if (mask != 0xffffU) {
+			unsigned int i = __builtin_ctz(~mask);
+
+			return c1[i] - c2[i];
+		}
+		c1 += VEC_SIZE;
+		c2 += VEC_SIZE;
+		n -= VEC_SIZE;
+	}
+
+	if (!n) {
+		return 0;
+	}
+
+	while ((--n > 0) && (*c1 == *c2)) {
+		c1++;
+		c2++;
+	}
+
+	return *c1 - *c2;
+}
+
+/**
+ *
+ * @brief Copy bytes in memory
+ *
+ * @return pointer to start of destination buffer
+ */
+
+void *memcpy(void *ZRESTRICT d, const void *ZRESTRICT s, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)d;
+	const unsigned char *s_byte = (const unsigned char *)s;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)d_byte) & VEC_MASK) {
+			*(d_byte++) = *(s_byte++);
+			n--;
+		}
+
+		/* aligned stores, the source being read with unaligned loads */
+
+		while (n >= VEC_SIZE) {
+			__m128i v = _mm_loadu_si128((const __m128i *)s_byte);
+
+			_mm_store_si128((__m128i *)d_byte, v);
+			d_byte += VEC_SIZE;
+			s_byte += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		*(d_byte++) = *(s_byte++);
+		n--;
+	}
+
+	return d;
+}
+
+/**
+ *
+ * @brief Set bytes in memory
+ *
+ * @return pointer to start of buffer
+ */
+
+void *memset(void *buf, int c, size_t n)
+{
+	unsigned char *d_byte = (unsigned char *)buf;
+	unsigned char c_byte = (unsigned char)c;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)d_byte) & VEC_MASK) {
+			*(d_byte++) = c_byte;
+			n--;
+		}
+
+		const __m128i c_vec = _mm_set1_epi8((char)c_byte);
+
+		while (n >= VEC_SIZE) {
+			_mm_store_si128((__m128i *)d_byte, c_vec);
+			d_byte += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		*(d_byte++) = c_byte;
+		n--;
+	}
+
+	return buf;
+}
+
+/**
+ *
+ * @brief Scan byte in memory
+ *
+ * @return pointer to start of found byte
+ */
+
+void *memchr(const void *s, int c, size_t n)
+{
+	const unsigned char *p = s;
+
+	if (n >= 2 * VEC_SIZE) {
+		while (((uintptr_t)p) & VEC_MASK) {
+			if (*p == (unsigned char)c) {
+				return (void *)p;
+			}
+			p++;
+			n--;
+		}
+
+		/* aligned loads never cross a page boundary */
+
+		const __m128i c_vec = _mm_set1_epi8((char)c);
+
+		while (n >= VEC_SIZE) {
+			unsigned int mask = vec_eq_mask(
+				_mm_load_si128((const __m128i *)p), c_vec);
+
+			if (mask != 0U) {
+				return (void *)(p + __builtin_ctz(mask));
+			}
+			p += VEC_SIZE;
+			n -= VEC_SIZE;
+		}
+	}
+
+	while (n > 0) {
+		if (*p == (unsigned char)c) {
+			return (void *)p;
+		}
+		p++;
+		n--;
+	}
+
+	return NULL;
+}
@@ -224,6 +224,58 @@ int z_alloc_fd(void *obj, const struct fd_op_vtable *vtable)
 	return fd;
 }
 
+#ifdef CONFIG_FDTABLE_POLL_WATCH
+/* A single lock for all watcher lists, so that notifications may come
+ * from contexts which do not hold the fd lock (e.g. the TCP stack).
+ */
+static struct k_spinlock poll_watch_lock;
+
+void z_poll_watch_add(sys_slist_t *watchers, struct z_poll_watch *watch)
+{
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	sys_slist_append(watchers, &watch->node);
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void z_poll_watch_remove(sys_slist_t *watchers, struct z_poll_watch *watch)
+{
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	(void)sys_slist_find_and_remove(watchers, &watch->node);
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void z_poll_watch_notify(sys_slist_t *watchers, int events)
+{
+	struct z_poll_watch *watch;
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(watchers, watch, node) {
+		watch->notify(watch, events);
+	}
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+
+void z_poll_watch_close(sys_slist_t *watchers, int events)
+{
+	sys_snode_t *node;
+	k_spinlock_key_t key = k_spin_lock(&poll_watch_lock);
+
+	while ((node = sys_slist_get(watchers)) != NULL) {
+		struct z_poll_watch *watch =
+			CONTAINER_OF(node, struct z_poll_watch, node);
+
+		watch->notify(watch, events);
+	}
+
+	k_spin_unlock(&poll_watch_lock, key);
+}
+#endif /* CONFIG_FDTABLE_POLL_WATCH */
+
 #ifdef CONFIG_POSIX_API
 
 ssize_t read(int fd, void *buf, size_t sz)
@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/__assert.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/sys/math_extras.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/sys_heap_cache.h>
+
+#define NUM_CLASSES CONFIG_SYS_HEAP_CACHE_CLASSES
+#define MIN_SIZE BIT(SYS_HEAP_CACHE_MIN_SHIFT)
+#define MAX_SIZE BIT(SYS_HEAP_CACHE_MIN_SHIFT + NUM_CLASSES - 1)
+#define BLOCK_ALIGN __alignof__(z_max_align_t)
+
+/* Number of blocks moved between a magazine and the heap at once */
+#define BATCH MAX(CONFIG_SYS_HEAP_CACHE_DEPTH / 2, 1)
+
+BUILD_ASSERT(CONFIG_SYS_HEAP_CACHE_DEPTH <= UINT16_MAX);
+
+static inline struct k_spinlock *heap_lock(struct sys_heap_cache *cache)
+{
+	return cache->heap_lock != NULL ? cache->heap_lock : &cache->lock;
+}
+
+static inline size_t class_size(int cls)
+{
+	return MIN_SIZE << cls;
+}
+
+/* Smallest class that can hold a request of the given size */
+static inline int alloc_class(size_t bytes)
+{
+	if (bytes <= MIN_SIZE) {
+		return 0;
+	}
+
+	return 32 - u32_count_leading_zeros((uint32_t)bytes - 1)
+		- SYS_HEAP_CACHE_MIN_SHIFT;
+}
+
+/* Biggest class whose requests a block of this usable size can
+ * satisfy, or -1 if it is not cacheable.
+ */
+static inline int free_class(size_t usable)
+{
+	int cls;
+
+	if (usable < MIN_SIZE) {
+		return -1;
+	}
+
+	if (usable >= MAX_SIZE) {
+		return usable < 2 * MAX_SIZE ? NUM_CLASSES - 1 : -1;
+	}
+
+	cls = 31 - u32_count_leading_zeros((uint32_t)usable)
+		- SYS_HEAP_CACHE_MIN_SHIFT;
+
+	return cls;
+}
+
+/* Per-CPU state may only be touched with local interrupts masked,
+ * which also keeps us from migrating to another CPU in the middle.
+ */
+static inline struct sys_heap_cache_cpu *local_cpu(struct sys_heap_cache *cache)
+{
+#ifdef CONFIG_SMP
+	return &cache->cpu[arch_curr_cpu()->id];
+#else
+	return &cache->cpu[0];
+#endif
+}
+
+static void *heap_alloc_locked(struct sys_heap_cache *cache, size_t align,
+			       size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+	void *ret = sys_heap_aligned_alloc(cache->heap, align, bytes);
+
+	k_spin_unlock(heap_lock(cache), key);
+
+	return ret;
+}
+
+static void heap_free_locked(struct sys_heap_cache *cache, void *mem)
+{
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+
+	sys_heap_free(cache->heap, mem);
+	k_spin_unlock(heap_lock(cache), key);
+}
+
+/* Fill an empty magazine with up to BATCH blocks (the last of which
+ * is handed to the caller instead) under one heap lock.
+ */
+static void *refill(struct sys_heap_cache *cache, struct sys_heap_cache_mag *mag,
+		    size_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+	void *ret = sys_heap_aligned_alloc(cache->heap, BLOCK_ALIGN, size);
+
+	while (ret != NULL && mag->count < BATCH - 1) {
+		void *mem = sys_heap_aligned_alloc(cache->heap, BLOCK_ALIGN, size);
+
+		if (mem == NULL) {
+			break;
+		}
+		mag->blocks[mag->count++] = mem;
+	}
+
+	k_spin_unlock(heap_lock(cache), key);
+
+	return ret;
+}
+
+/* Return the n oldest blocks of a magazine to the heap under one lock */
+static void drain(struct sys_heap_cache *cache, struct sys_heap_cache_mag *mag,
+		  int n)
+{
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+
+	for (int i = 0; i < n; i++) {
+		sys_heap_free(cache->heap, mag->blocks[i]);
+	}
+
+	k_spin_unlock(heap_lock(cache), key);
+
+	mag->count -= n;
+	memmove(&mag->blocks[0], &mag->blocks[n], mag->count * sizeof(void *));
+}
+
+/* Blocks held in the calling CPU's magazines may be what keeps a
+ * request from being satisfied: return them to the heap and retry.
+ * Blocks cached by other CPUs are left alone, only their owner can
+ * touch them.
+ */
+static void *alloc_flushed(struct sys_heap_cache *cache, size_t align,
+			   size_t bytes)
+{
+	sys_heap_cache_flush(cache);
+
+	return heap_alloc_locked(cache, align, bytes);
+}
+
+void sys_heap_cache_init(struct sys_heap_cache *cache, struct sys_heap *heap,
+			 struct k_spinlock *lock)
+{
+	memset(cache, 0, sizeof(*cache));
+	cache->heap = heap;
+	cache->heap_lock = lock;
+}
+
+void *sys_heap_cache_aligned_alloc(struct sys_heap_cache *cache, size_t align,
+				   size_t bytes)
+{
+	struct sys_heap_cache_cpu *cpu;
+	struct sys_heap_cache_mag *mag;
+	unsigned int key;
+	void *ret;
+	int cls;
+
+	/* Alignment values with rewind bits (see sys_heap_aligned_alloc())
+	 * or stricter than what cached blocks provide bypass the cache.
+	 */
+	if (bytes == 0 || bytes > MAX_SIZE || align > BLOCK_ALIGN ||
+	    (align & (align - 1)) != 0) {
+		ret = heap_alloc_locked(cache, align, bytes);
+		if (ret == NULL && bytes != 0) {
+			ret = alloc_flushed(cache, align, bytes);
+		}
+
+		return ret;
+	}
+
+	cls = alloc_class(bytes);
+
+	key = arch_irq_lock();
+	cpu = local_cpu(cache);
+	mag = &cpu->mags[cls];
+
+	if (mag->count > 0) {
+		ret = mag->blocks[--mag->count];
+		cpu->hits++;
+	} else {
+		ret = refill(cache, mag, class_size(cls));
+		cpu->refills++;
+	}
+
+	arch_irq_unlock(key);
+
+	if (ret == NULL) {
+		ret = alloc_flushed(cache, align, bytes);
+	}
+
+	return ret;
+}
+
+void *sys_heap_cache_alloc(struct sys_heap_cache *cache, size_t bytes)
+{
+	return sys_heap_cache_aligned_alloc(cache, BLOCK_ALIGN, bytes);
+}
+
+void *sys_heap_cache_aligned_realloc(struct sys_heap_cache *cache, void *ptr,
+				     size_t align, size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+	void *ret = sys_heap_aligned_realloc(cache->heap, ptr, align, bytes);
+
+	k_spin_unlock(heap_lock(cache), key);
+
+	if (ret == NULL && bytes != 0) {
+		sys_heap_cache_flush(cache);
+
+		key = k_spin_lock(heap_lock(cache));
+		ret = sys_heap_aligned_realloc(cache->heap, ptr, align, bytes);
+		k_spin_unlock(heap_lock(cache), key);
+	}
+
+	return ret;
+}
+
+void sys_heap_cache_free(struct sys_heap_cache *cache, void *mem)
+{
+	struct sys_heap_cache_cpu *cpu;
+	struct sys_heap_cache_mag *mag;
+	unsigned int key;
+	int cls;
+
+	if (mem == NULL) {
+		return;
+	}
+
+	/* The size of an allocated chunk is only ever changed by its
+	 * owner, so it can be read without the heap lock.
+	 */
+	cls = free_class(sys_heap_usable_size(cache->heap, mem));
+	if (cls < 0 || ((uintptr_t)mem & (BLOCK_ALIGN - 1)) != 0) {
+		heap_free_locked(cache, mem);
+		return;
+	}
+
+	key = arch_irq_lock();
+	cpu = local_cpu(cache);
+	mag = &cpu->mags[cls];
+
+	if (mag->count == CONFIG_SYS_HEAP_CACHE_DEPTH) {
+		drain(cache, mag, BATCH);
+		cpu->drains++;
+	}
+	mag->blocks[mag->count++] = mem;
+
+	arch_irq_unlock(key);
+}
+
+void sys_heap_cache_flush(struct sys_heap_cache *cache)
+{
+	unsigned int key = arch_irq_lock();
+	struct sys_heap_cache_cpu *cpu = local_cpu(cache);
+
+	for (int i = 0; i < NUM_CLASSES; i++) {
+		if (cpu->mags[i].count > 0) {
+			drain(cache, &cpu->mags[i], cpu->mags[i].count);
+		}
+	}
+
+	arch_irq_unlock(key);
+}
+
+int sys_heap_cache_stats_get(struct sys_heap_cache *cache,
+			     struct sys_heap_cache_stats *stats)
+{
+	if ((cache == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	memset(stats, 0, sizeof(*stats));
+
+	for (int c = 0; c < CONFIG_MP_MAX_NUM_CPUS; c++) {
+		struct sys_heap_cache_cpu *cpu = &cache->cpu[c];
+
+		stats->hits += cpu->hits;
+		stats->refills += cpu->refills;
+		stats->drains += cpu->drains;
+
+		for (int i = 0; i < NUM_CLASSES; i++) {
+			struct sys_heap_cache_mag *mag = &cpu->mags[i];
+			uint16_t n = mag->count;
+
+			stats->cached_blocks[i] += n;
+
+			/* A cached block may be bigger than its class, and
+			 * the padding is just as unavailable to the heap.
+			 */
+			for (int j = 0; j < n; j++) {
+				stats->cached_bytes +=
+					sys_heap_usable_size(cache->heap,
+							     mag->blocks[j]);
+			}
+		}
+	}
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	k_spinlock_key_t key = k_spin_lock(heap_lock(cache));
+
+	sys_heap_runtime_stats_get(cache->heap, &stats->heap);
+	k_spin_unlock(heap_lock(cache), key);
+#endif
+
+	return 0;
+}
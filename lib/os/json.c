@@ -1096,3 +1096,725 @@ ssize_t json_calc_encoded_len(const struct json_obj_descr *descr,
 
 	return total;
 }
+
+enum json_stream_expect {
+	JSON_STREAM_VALUE,
+	JSON_STREAM_VALUE_OR_END,
+	JSON_STREAM_KEY,
+	JSON_STREAM_KEY_OR_END,
+	JSON_STREAM_COLON,
+	JSON_STREAM_COMMA_OR_END,
+	JSON_STREAM_DONE,
+	JSON_STREAM_ERROR,
+};
+
+enum json_stream_lex {
+	JSON_STREAM_LEX_NONE,
+	JSON_STREAM_LEX_STRING,
+	JSON_STREAM_LEX_ESCAPE,
+	JSON_STREAM_LEX_UNICODE,
+	JSON_STREAM_LEX_NUMBER,
+	JSON_STREAM_LEX_LITERAL,
+};
+
+void json_stream_init(struct json_stream *stream, char *buf, size_t buf_size,
+		      json_stream_cb_t cb, void *user_data)
+{
+	memset(stream, 0, sizeof(*stream));
+
+	stream->cb = cb;
+	stream->user_data = user_data;
+	stream->buf = buf;
+	stream->buf_size = buf_size;
+	stream->expect = JSON_STREAM_VALUE;
+}
+
+static int stream_emit(struct json_stream *stream, enum json_tokens type,
+		       const char *start, size_t len, bool partial)
+{
+	struct json_stream_token tok = {
+		.type = type,
+		.start = start,
+		.len = len,
+		.depth = stream->depth,
+		.key = stream->key,
+		.partial = partial,
+	};
+
+	return stream->cb(&tok, stream->user_data);
+}
+
+static bool stream_in_object(struct json_stream *stream)
+{
+	return stream->depth > 0 &&
+	       (stream->objects & BIT(stream->depth - 1)) != 0;
+}
+
+static void stream_value_done(struct json_stream *stream)
+{
+	stream->expect = stream->depth > 0 ? JSON_STREAM_COMMA_OR_END
+					   : JSON_STREAM_DONE;
+}
+
+static bool stream_value_expected(struct json_stream *stream)
+{
+	return stream->expect == JSON_STREAM_VALUE ||
+	       stream->expect == JSON_STREAM_VALUE_OR_END;
+}
+
+/* Keep the part of a token contained in the current fragment, flushing the
+ * strings which do not fit in the buffer.
+ */
+static int stream_save(struct json_stream *stream, const char *data, size_t len)
+{
+	size_t room;
+	int ret;
+
+	while (len > 0) {
+		room = stream->buf_size - stream->buf_used;
+		if (room == 0) {
+			if (stream->lex == JSON_STREAM_LEX_NUMBER ||
+			    stream->buf_used == 0) {
+				/* Nothing to flush without a buffer */
+				return -ENOMEM;
+			}
+
+			ret = stream_emit(stream, JSON_TOK_STRING, stream->buf,
+					  stream->buf_used, true);
+			if (ret < 0) {
+				return ret;
+			}
+
+			stream->buf_used = 0;
+			stream->partial = true;
+			continue;
+		}
+
+		room = MIN(room, len);
+		memcpy(stream->buf + stream->buf_used, data, room);
+		stream->buf_used += room;
+		data += room;
+		len -= room;
+	}
+
+	return 0;
+}
+
+static int stream_token_end(struct json_stream *stream, enum json_tokens type,
+			    const char *start, const char *end)
+{
+	int ret;
+
+	if (stream->buf_used == 0 && !stream->partial) {
+		/* The whole token is in the current fragment */
+		ret = stream_emit(stream, type, start, end - start, false);
+	} else {
+		ret = stream_save(stream, start, end - start);
+		if (ret < 0) {
+			return ret;
+		}
+
+		ret = stream_emit(stream, type, stream->buf, stream->buf_used,
+				  false);
+	}
+
+	stream->buf_used = 0;
+	stream->partial = false;
+	stream->lex = JSON_STREAM_LEX_NONE;
+
+	if (stream->key) {
+		stream->key = false;
+		stream->expect = JSON_STREAM_COLON;
+	} else {
+		stream_value_done(stream);
+	}
+
+	return ret;
+}
+
+static const char *stream_literal(enum json_tokens type)
+{
+	switch (type) {
+	case JSON_TOK_TRUE:
+		return "true";
+	case JSON_TOK_FALSE:
+		return "false";
+	default:
+		return "null";
+	}
+}
+
+static bool stream_number_char(int chr)
+{
+	return isdigit(chr) || chr == '.' || chr == 'e' || chr == 'E' ||
+	       chr == '+' || chr == '-';
+}
+
+static int stream_structural(struct json_stream *stream, char chr)
+{
+	int ret;
+
+	switch (chr) {
+	case '{':
+	case '[':
+		if (!stream_value_expected(stream) ||
+		    stream->depth >= JSON_STREAM_MAX_DEPTH) {
+			return -EINVAL;
+		}
+
+		if (chr == '{') {
+			stream->objects |= BIT(stream->depth);
+		} else {
+			stream->objects &= ~BIT(stream->depth);
+		}
+
+		stream->expect = chr == '{' ? JSON_STREAM_KEY_OR_END
+					    : JSON_STREAM_VALUE_OR_END;
+
+		/* The container is reported at the level of its parent */
+		ret = stream_emit(stream, (enum json_tokens)chr, NULL, 0, false);
+		stream->depth++;
+
+		return ret;
+	case '}':
+	case ']':
+		if (stream_in_object(stream) != (chr == '}')) {
+			return -EINVAL;
+		}
+
+		if (stream->expect != JSON_STREAM_COMMA_OR_END &&
+		    stream->expect != (chr == '}' ? JSON_STREAM_KEY_OR_END
+						  : JSON_STREAM_VALUE_OR_END)) {
+			return -EINVAL;
+		}
+
+		stream->depth--;
+		stream_value_done(stream);
+
+		return stream_emit(stream, (enum json_tokens)chr, NULL, 0, false);
+	case ':':
+		if (stream->expect != JSON_STREAM_COLON) {
+			return -EINVAL;
+		}
+
+		stream->expect = JSON_STREAM_VALUE;
+		return 0;
+	case ',':
+		if (stream->expect != JSON_STREAM_COMMA_OR_END) {
+			return -EINVAL;
+		}
+
+		stream->expect = stream_in_object(stream) ? JSON_STREAM_KEY
+							  : JSON_STREAM_VALUE;
+		return 0;
+	case '"':
+		if (stream->expect == JSON_STREAM_KEY ||
+		    stream->expect == JSON_STREAM_KEY_OR_END) {
+			stream->key = true;
+		} else if (!stream_value_expected(stream)) {
+			return -EINVAL;
+		}
+
+		stream->lex = JSON_STREAM_LEX_STRING;
+		return 0;
+	case 't':
+	case 'f':
+	case 'n':
+		if (!stream_value_expected(stream)) {
+			return -EINVAL;
+		}
+
+		stream->lex = JSON_STREAM_LEX_LITERAL;
+		stream->lit = chr;
+		stream->lex_count = 1;
+		return 0;
+	default:
+		if (isspace((unsigned char)chr)) {
+			return 0;
+		}
+
+		if ((chr != '-' && !isdigit((unsigned char)chr)) ||
+		    !stream_value_expected(stream)) {
+			return -EINVAL;
+		}
+
+		stream->lex = JSON_STREAM_LEX_NUMBER;
+		return 0;
+	}
+}
+
+static int stream_parse(struct json_stream *stream, const char *data, size_t len)
+{
+	const char *end = data + len;
+	const char *pos = data;
+	const char *tok = data;
+	const char *lit;
+	int ret;
+
+	while (pos < end) {
+		switch (stream->lex) {
+		case JSON_STREAM_LEX_STRING:
+			while (pos < end && *pos != '"' && *pos != '\\') {
+				pos++;
+			}
+
+			if (pos == end) {
+				break;
+			}
+
+			if (*pos++ == '\\') {
+				stream->lex = JSON_STREAM_LEX_ESCAPE;
+				break;
+			}
+
+			ret = stream_token_end(stream, JSON_TOK_STRING, tok, pos - 1);
+			if (ret < 0) {
+				return ret;
+			}
+			break;
+		case JSON_STREAM_LEX_ESCAPE:
+			switch (*pos++) {
+			case '"':
+			case '\\':
+			case '/':
+			case 'b':
+			case 'f':
+			case 'n':
+			case 'r':
+			case 't':
+				stream->lex = JSON_STREAM_LEX_STRING;
+				break;
+			case 'u':
+				stream->lex = JSON_STREAM_LEX_UNICODE;
+				stream->lex_count = 4;
+				break;
+			default:
+				return -EINVAL;
+			}
+			break;
+		case JSON_STREAM_LEX_UNICODE:
+			if (!isxdigit((unsigned char)*pos++)) {
+				return -EINVAL;
+			}
+
+			if (--stream->lex_count == 0) {
+				stream->lex = JSON_STREAM_LEX_STRING;
+			}
+			break;
+		case JSON_STREAM_LEX_NUMBER:
+			if (stream_number_char(*pos)) {
+				pos++;
+				break;
+			}
+
+			ret = stream_token_end(stream, JSON_TOK_NUMBER, tok, pos);
+			if (ret < 0) {
+				return ret;
+			}
+			break;
+		case JSON_STREAM_LEX_LITERAL:
+			lit = stream_literal(stream->lit);
+			if (*pos++ != lit[stream->lex_count]) {
+				return -EINVAL;
+			}
+
+			if (lit[++stream->lex_count] == '\0') {
+				stream->lex = JSON_STREAM_LEX_NONE;
+				stream_value_done(stream);
+
+				ret = stream_emit(stream, stream->lit, lit,
+						  stream->lex_count, false);
+				if (ret < 0) {
+					return ret;
+				}
+			}
+			break;
+		default:
+			if (stream->expect == JSON_STREAM_DONE &&
+			    !isspace((unsigned char)*pos)) {
+				return -EINVAL;
+			}
+
+			ret = stream_structural(stream, *pos);
+			if (ret < 0) {
+				return ret;
+			}
+
+			pos++;
+			if (stream->lex == JSON_STREAM_LEX_STRING) {
+				tok = pos;
+			} else if (stream->lex == JSON_STREAM_LEX_NUMBER) {
+				tok = pos - 1;
+			}
+			break;
+		}
+	}
+
+	switch (stream->lex) {
+	case JSON_STREAM_LEX_STRING:
+	case JSON_STREAM_LEX_ESCAPE:
+	case JSON_STREAM_LEX_UNICODE:
+	case JSON_STREAM_LEX_NUMBER:
+		/* The token continues in the next fragment */
+		return stream_save(stream, tok, end - tok);
+	default:
+		return 0;
+	}
+}
+
+int json_stream_feed(struct json_stream *stream, const char *data, size_t len)
+{
+	int ret;
+
+	if (stream->expect == JSON_STREAM_ERROR) {
+		return -EINVAL;
+	}
+
+	ret = stream_parse(stream, data, len);
+	if (ret < 0) {
+		stream->expect = JSON_STREAM_ERROR;
+	}
+
+	return ret;
+}
+
+int json_stream_finish(struct json_stream *stream)
+{
+	int ret;
+
+	if (stream->expect == JSON_STREAM_ERROR) {
+		return -EINVAL;
+	}
+
+	if (stream->lex == JSON_STREAM_LEX_NUMBER) {
+		/* A top-level number only ends with the value */
+		ret = stream_token_end(stream, JSON_TOK_NUMBER, NULL, NULL);
+		if (ret < 0) {
+			stream->expect = JSON_STREAM_ERROR;
+			return ret;
+		}
+	}
+
+	if (stream->lex != JSON_STREAM_LEX_NONE ||
+	    stream->expect != JSON_STREAM_DONE) {
+		stream->expect = JSON_STREAM_ERROR;
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+enum json_encoder_step {
+	JSON_ENCODER_OPEN,
+	JSON_ENCODER_KEY,
+	JSON_ENCODER_VALUE,
+	JSON_ENCODER_NEXT,
+	JSON_ENCODER_CLOSE,
+};
+
+/* Each piece of output is regenerated identically when the encoding
+ * resumes, and piece_off tells how much of it was already written. The
+ * functions below return 1 once the piece is complete, or 0 when the output
+ * is full.
+ */
+static int encoder_put(struct json_encoder *enc, const char *bytes, size_t len)
+{
+	size_t skip = enc->piece_off;
+	size_t n = MIN(len - skip, enc->out_size - enc->out_used);
+
+	memcpy(enc->out + enc->out_used, bytes + skip, n);
+	enc->out_used += n;
+
+	if (skip + n < len) {
+		enc->piece_off = skip + n;
+		return 0;
+	}
+
+	enc->piece_off = 0;
+	return 1;
+}
+
+static int encoder_put_escaped(struct json_encoder *enc, const char *str)
+{
+	size_t produced = 0;
+	char bytes[2];
+	size_t len;
+
+	for (; *str; str++) {
+		char escaped = escape_as(*str);
+
+		if (escaped) {
+			bytes[0] = '\\';
+			bytes[1] = escaped;
+			len = 2;
+		} else {
+			bytes[0] = *str;
+			len = 1;
+		}
+
+		for (size_t i = 0; i < len; i++, produced++) {
+			if (produced < enc->piece_off) {
+				continue;
+			}
+
+			if (enc->out_used == enc->out_size) {
+				enc->piece_off = produced;
+				return 0;
+			}
+
+			enc->out[enc->out_used++] = bytes[i];
+		}
+	}
+
+	enc->piece_off = 0;
+	return 1;
+}
+
+/* Writes '"', the string and then the closing bytes, as three pieces */
+static int encoder_put_string(struct json_encoder *enc, const char *str,
+			      size_t len, bool escape, const char *close)
+{
+	int ret;
+
+	switch (enc->sub) {
+	case 0:
+		ret = encoder_put(enc, "\"", 1);
+		if (ret <= 0) {
+			return ret;
+		}
+
+		enc->sub = 1;
+		__fallthrough;
+	case 1:
+		if (escape) {
+			ret = encoder_put_escaped(enc, str);
+		} else {
+			ret = encoder_put(enc, str, len);
+		}
+		if (ret <= 0) {
+			return ret;
+		}
+
+		enc->sub = 2;
+		__fallthrough;
+	default:
+		ret = encoder_put(enc, close, strlen(close));
+		if (ret <= 0) {
+			return ret;
+		}
+
+		enc->sub = 0;
+		return 1;
+	}
+}
+
+static int encoder_put_value(struct json_encoder *enc, enum json_tokens type,
+			     const void *ptr)
+{
+	const struct json_obj_token *token = ptr;
+	char buf[3 * sizeof(int32_t)];
+	int ret;
+
+	switch (type) {
+	case JSON_TOK_FALSE:
+	case JSON_TOK_TRUE:
+		if (*(const bool *)ptr) {
+			return encoder_put(enc, "true", 4);
+		}
+
+		return encoder_put(enc, "false", 5);
+	case JSON_TOK_STRING:
+		return encoder_put_string(enc, *(const char **)ptr, 0, true, "\"");
+	case JSON_TOK_NUMBER:
+		ret = snprintk(buf, sizeof(buf), "%d", *(const int32_t *)ptr);
+		if (ret < 0) {
+			return ret;
+		}
+		if (ret >= (int)sizeof(buf)) {
+			return -ENOMEM;
+		}
+
+		return encoder_put(enc, buf, (size_t)ret);
+	case JSON_TOK_FLOAT:
+		return encoder_put(enc, token->start, token->length);
+	case JSON_TOK_OPAQUE:
+		return encoder_put_string(enc, token->start, token->length,
+					  false, "\"");
+	default:
+		return -EINVAL;
+	}
+}
+
+static int encoder_push(struct json_encoder *enc, bool array,
+			const struct json_obj_descr *descr, size_t len,
+			const void *val)
+{
+	struct json_encoder_frame *frame;
+
+	if (enc->depth >= JSON_ENCODER_MAX_DEPTH) {
+		return -ENOMEM;
+	}
+
+	frame = &enc->stack[enc->depth++];
+	frame->descr = descr;
+	frame->val = val;
+	frame->len = len;
+	frame->idx = 0;
+	frame->step = JSON_ENCODER_OPEN;
+	frame->array = array;
+
+	return 1;
+}
+
+static int encoder_push_array(struct json_encoder *enc,
+			      const struct json_obj_descr *descr,
+			      const char *parent)
+{
+	const struct json_obj_descr *elem_descr = descr->array.element_descr;
+	/* See arr_encode() for how the number of elements is found */
+	size_t n_elem = *(const size_t *)(parent + elem_descr->offset);
+
+	return encoder_push(enc, true, elem_descr, n_elem,
+			    parent + descr->offset);
+}
+
+static int encoder_value(struct json_encoder *enc,
+			 struct json_encoder_frame *frame)
+{
+	const struct json_obj_descr *descr;
+	const char *parent;
+
+	if (frame->array) {
+		/* Same trick as arr_encode(): the element lies about its parent */
+		descr = frame->descr;
+		parent = frame->val - descr->offset;
+	} else {
+		descr = &frame->descr[frame->idx];
+		parent = frame->val;
+	}
+
+	switch (descr->type) {
+	case JSON_TOK_OBJECT_START:
+		frame->step = JSON_ENCODER_NEXT;
+		return encoder_push(enc, false, descr->object.sub_descr,
+				    descr->object.sub_descr_len,
+				    parent + descr->offset);
+	case JSON_TOK_ARRAY_START:
+		frame->step = JSON_ENCODER_NEXT;
+		return encoder_push_array(enc, descr, parent);
+	default:
+		return encoder_put_value(enc, descr->type, parent + descr->offset);
+	}
+}
+
+static int encoder_step(struct json_encoder *enc,
+			struct json_encoder_frame *frame)
+{
+	int ret;
+
+	switch (frame->step) {
+	case JSON_ENCODER_OPEN:
+		ret = encoder_put(enc, frame->array ? "[" : "{", 1);
+		if (ret <= 0) {
+			return ret;
+		}
+
+		if (frame->len == 0) {
+			frame->step = JSON_ENCODER_CLOSE;
+		} else {
+			frame->step = frame->array ? JSON_ENCODER_VALUE
+						   : JSON_ENCODER_KEY;
+		}
+		return 1;
+	case JSON_ENCODER_KEY:
+		ret = encoder_put_string(enc, frame->descr[frame->idx].field_name,
+					 0, true, "\":");
+		if (ret <= 0) {
+			return ret;
+		}
+
+		frame->step = JSON_ENCODER_VALUE;
+		return 1;
+	case JSON_ENCODER_VALUE:
+		ret = encoder_value(enc, frame);
+		if (ret <= 0) {
+			return ret;
+		}
+
+		/* Containers pushed a frame and already moved to the next step */
+		frame->step = JSON_ENCODER_NEXT;
+		return 1;
+	case JSON_ENCODER_NEXT:
+		if (frame->idx + 1 >= frame->len) {
+			frame->step = JSON_ENCODER_CLOSE;
+			return 1;
+		}
+
+		ret = encoder_put(enc, ",", 1);
+		if (ret <= 0) {
+			return ret;
+		}
+
+		frame->idx++;
+		if (frame->array) {
+			frame->val += get_elem_size(frame->descr);
+			frame->step = JSON_ENCODER_VALUE;
+		} else {
+			frame->step = JSON_ENCODER_KEY;
+		}
+		return 1;
+	default:
+		ret = encoder_put(enc, frame->array ? "]" : "}", 1);
+		if (ret <= 0) {
+			return ret;
+		}
+
+		enc->depth--;
+		return 1;
+	}
+}
+
+void json_obj_encoder_init(struct json_encoder *enc,
+			   const struct json_obj_descr *descr,
+			   size_t descr_len, const void *val)
+{
+	memset(enc, 0, sizeof(*enc));
+
+	(void)encoder_push(enc, false, descr, descr_len, val);
+}
+
+void json_arr_encoder_init(struct json_encoder *enc,
+			   const struct json_obj_descr *descr,
+			   const void *val)
+{
+	memset(enc, 0, sizeof(*enc));
+
+	(void)encoder_push_array(enc, descr, val);
+}
+
+ssize_t json_encoder_write(struct json_encoder *enc, char *buf,
+			   size_t buf_size)
+{
+	int ret;
+
+	if (buf_size == 0) {
+		return -EINVAL;
+	}
+
+	enc->out = buf;
+	enc->out_size = buf_size;
+	enc->out_used = 0;
+
+	while (enc->depth > 0) {
+		ret = encoder_step(enc, &enc->stack[enc->depth - 1]);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (ret == 0) {
+			break;
+		}
+	}
+
+	return enc->out_used;
+}
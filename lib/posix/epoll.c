@@ -0,0 +1,623 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* epoll on top of the fdtable poll watchers. Every watched file
+ * descriptor gets an item which is attached to the object as a
+ * z_poll_watch. When the object reports it may have become ready, the
+ * item is put on the ready list of its epoll instance and the instance
+ * signal is raised. epoll_wait() only looks at items on the ready list
+ * and confirms their state with the regular poll ioctls. Level
+ * triggered items which are still ready go back on the list, edge
+ * triggered ones wait for the next notification.
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/fdtable.h>
+#include <zephyr/posix/sys/epoll.h>
+
+/* Poll events a single fd may need, see ZFD_IOCTL_POLL_PREPARE */
+#define EPOLL_ITEM_POLL_EVENTS 4
+
+struct epoll;
+
+struct epoll_item {
+	struct z_poll_watch watch;
+	sys_dnode_t ready_node;
+	struct epoll *ep;
+	const struct fd_op_vtable *vtable;
+	void *obj;
+	struct k_mutex *lock;
+	struct epoll_event event;
+	int fd;
+	bool in_use;
+	/* On the ready list, or about to be put back on it */
+	bool queued;
+	/* Fired with EPOLLONESHOT, waiting for EPOLL_CTL_MOD */
+	bool disabled;
+	/* The file descriptor was closed */
+	bool closed;
+};
+
+struct epoll {
+	/* Serializes epoll_ctl() and the collection of events */
+	struct k_mutex mtx;
+	/* Protects the ready list and the item flags */
+	struct k_spinlock lock;
+	sys_dlist_t ready;
+	/* Raised while the ready list is not empty */
+	struct k_poll_signal sig;
+	bool in_use;
+};
+
+static K_MUTEX_DEFINE(epoll_mtx);
+static struct epoll epolls[CONFIG_EPOLL_MAX];
+static struct epoll_item epoll_items[CONFIG_EPOLL_MAX_ITEMS];
+
+static const struct fd_op_vtable epoll_fd_vtable;
+
+/* Called with ep->lock held */
+static void epoll_queue(struct epoll *ep, struct epoll_item *item)
+{
+	if (!item->queued) {
+		sys_dlist_append(&ep->ready, &item->ready_node);
+		item->queued = true;
+	}
+
+	k_poll_signal_raise(&ep->sig, 0);
+}
+
+static void epoll_notify(struct z_poll_watch *watch, int events)
+{
+	struct epoll_item *item = CONTAINER_OF(watch, struct epoll_item, watch);
+	struct epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	/* The mask and the disabled flag are changed by EPOLL_CTL_MOD and
+	 * epoll_wait() under the lock.
+	 */
+	key = k_spin_lock(&ep->lock);
+
+	if (events & ZSOCK_POLLNVAL) {
+		/* The object is being closed and has already dropped us */
+		item->closed = true;
+	} else if (item->disabled ||
+		   !(events & (item->event.events | EPOLLERR | EPOLLHUP))) {
+		k_spin_unlock(&ep->lock, key);
+		return;
+	}
+
+	epoll_queue(ep, item);
+	k_spin_unlock(&ep->lock, key);
+}
+
+static struct epoll_item *epoll_item_alloc(struct epoll *ep)
+{
+	struct epoll_item *item = NULL;
+
+	(void)k_mutex_lock(&epoll_mtx, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		if (!epoll_items[i].in_use) {
+			item = &epoll_items[i];
+			memset(item, 0, sizeof(*item));
+			item->in_use = true;
+			item->ep = ep;
+			item->watch.notify = epoll_notify;
+			break;
+		}
+	}
+
+	k_mutex_unlock(&epoll_mtx);
+
+	return item;
+}
+
+static void epoll_item_free(struct epoll_item *item)
+{
+	struct epoll *ep = item->ep;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&ep->lock);
+	if (item->queued && sys_dnode_is_linked(&item->ready_node)) {
+		sys_dlist_remove(&item->ready_node);
+	}
+	item->queued = false;
+	k_spin_unlock(&ep->lock, key);
+
+	(void)k_mutex_lock(&epoll_mtx, K_FOREVER);
+	item->in_use = false;
+	k_mutex_unlock(&epoll_mtx);
+}
+
+static int epoll_item_watch(struct epoll_item *item, bool add)
+{
+	int ret;
+
+	(void)k_mutex_lock(item->lock, K_FOREVER);
+
+	if (item->closed) {
+		/* Already dropped by the object */
+		ret = add ? -1 : 0;
+	} else {
+		ret = z_fdtable_call_ioctl(item->vtable, item->obj,
+					   ZFD_IOCTL_POLL_WATCH,
+					   &item->watch, (int)add);
+	}
+
+	k_mutex_unlock(item->lock);
+
+	return ret;
+}
+
+/* Lookup is linear, but only epoll_ctl() needs it */
+static struct epoll_item *epoll_item_find(struct epoll *ep, int fd)
+{
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		struct epoll_item *item = &epoll_items[i];
+
+		if (!item->in_use || item->ep != ep || item->fd != fd) {
+			continue;
+		}
+
+		if (item->closed) {
+			/* Stale entry of a closed fd whose number got reused */
+			epoll_item_free(item);
+			continue;
+		}
+
+		return item;
+	}
+
+	return NULL;
+}
+
+/* Current events of the item's fd, or -1 if it was closed */
+static int epoll_item_poll(struct epoll_item *item)
+{
+	struct k_poll_event poll_events[EPOLL_ITEM_POLL_EVENTS];
+	struct k_poll_event *pev = poll_events;
+	struct zsock_pollfd pfd = {
+		.fd = item->fd,
+		.events = item->event.events & (EPOLLIN | EPOLLPRI | EPOLLOUT),
+	};
+	int ret;
+
+	(void)k_mutex_lock(item->lock, K_FOREVER);
+
+	if (item->closed) {
+		k_mutex_unlock(item->lock);
+		return -1;
+	}
+
+	memset(poll_events, 0, sizeof(poll_events));
+
+	ret = z_fdtable_call_ioctl(item->vtable, item->obj,
+				   ZFD_IOCTL_POLL_PREPARE, &pfd, &pev,
+				   poll_events + ARRAY_SIZE(poll_events));
+	if (ret < 0 && ret != -EALREADY) {
+		k_mutex_unlock(item->lock);
+		return EPOLLERR;
+	}
+
+	if (pev > poll_events) {
+		(void)k_poll(poll_events, pev - poll_events, K_NO_WAIT);
+	}
+
+	pev = poll_events;
+	(void)z_fdtable_call_ioctl(item->vtable, item->obj,
+				   ZFD_IOCTL_POLL_UPDATE, &pfd, &pev);
+
+	k_mutex_unlock(item->lock);
+
+	return pfd.revents;
+}
+
+/* Queue the item if its fd is ready already, used after (re)arming it */
+static void epoll_item_check(struct epoll *ep, struct epoll_item *item)
+{
+	int revents = epoll_item_poll(item);
+	k_spinlock_key_t key;
+
+	if (revents < 0 ||
+	    (revents & (item->event.events | EPOLLERR | EPOLLHUP)) != 0) {
+		key = k_spin_lock(&ep->lock);
+		epoll_queue(ep, item);
+		k_spin_unlock(&ep->lock, key);
+	}
+}
+
+/* Move ready items to @a events, at most @a maxevents of them */
+static int epoll_collect(struct epoll *ep, struct epoll_event *events,
+			 int maxevents)
+{
+	sys_dlist_t requeue;
+	sys_dnode_t *node;
+	k_spinlock_key_t key;
+	int n = 0;
+
+	sys_dlist_init(&requeue);
+
+	(void)k_mutex_lock(&ep->mtx, K_FOREVER);
+
+	while (n < maxevents) {
+		struct epoll_item *item;
+		int revents;
+
+		key = k_spin_lock(&ep->lock);
+		node = sys_dlist_get(&ep->ready);
+		if (node != NULL) {
+			item = CONTAINER_OF(node, struct epoll_item, ready_node);
+			item->queued = false;
+		}
+		k_spin_unlock(&ep->lock, key);
+
+		if (node == NULL) {
+			break;
+		}
+
+		revents = epoll_item_poll(item);
+		if (revents < 0) {
+			epoll_item_free(item);
+			continue;
+		}
+
+		revents &= item->event.events | EPOLLERR | EPOLLHUP;
+		if (revents == 0 || item->disabled) {
+			continue;
+		}
+
+		events[n].events = revents;
+		events[n].data = item->event.data;
+		n++;
+
+		if (item->event.events & EPOLLONESHOT) {
+			key = k_spin_lock(&ep->lock);
+			item->disabled = true;
+			k_spin_unlock(&ep->lock, key);
+		} else if (!(item->event.events & EPOLLET)) {
+			/* Level triggered: report again until not ready */
+			key = k_spin_lock(&ep->lock);
+			if (!item->queued) {
+				sys_dlist_append(&requeue, &item->ready_node);
+				item->queued = true;
+			}
+			k_spin_unlock(&ep->lock, key);
+		}
+	}
+
+	key = k_spin_lock(&ep->lock);
+
+	while ((node = sys_dlist_get(&requeue)) != NULL) {
+		sys_dlist_append(&ep->ready, node);
+	}
+
+	if (sys_dlist_is_empty(&ep->ready)) {
+		k_poll_signal_reset(&ep->sig);
+	} else {
+		k_poll_signal_raise(&ep->sig, 0);
+	}
+
+	k_spin_unlock(&ep->lock, key);
+
+	k_mutex_unlock(&ep->mtx);
+
+	return n;
+}
+
+static ssize_t epoll_read_op(void *obj, void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static ssize_t epoll_write_op(void *obj, const void *buf, size_t sz)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(buf);
+	ARG_UNUSED(sz);
+
+	errno = EINVAL;
+	return -1;
+}
+
+static int epoll_close_op(void *obj)
+{
+	struct epoll *ep = obj;
+
+	(void)k_mutex_lock(&ep->mtx, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epoll_items); i++) {
+		struct epoll_item *item = &epoll_items[i];
+
+		if (item->in_use && item->ep == ep) {
+			(void)epoll_item_watch(item, false);
+			epoll_item_free(item);
+		}
+	}
+
+	k_mutex_unlock(&ep->mtx);
+
+	(void)k_mutex_lock(&epoll_mtx, K_FOREVER);
+	ep->in_use = false;
+	k_mutex_unlock(&epoll_mtx);
+
+	return 0;
+}
+
+static int epoll_ioctl_op(void *obj, unsigned int request, va_list args)
+{
+	struct epoll *ep = obj;
+
+	switch (request) {
+	case ZFD_IOCTL_POLL_PREPARE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+		struct k_poll_event *pev_end;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+		pev_end = va_arg(args, struct k_poll_event *);
+
+		if (pfd->events & ZSOCK_POLLIN) {
+			if (*pev == pev_end) {
+				errno = ENOMEM;
+				return -1;
+			}
+
+			(*pev)->obj = &ep->sig;
+			(*pev)->type = K_POLL_TYPE_SIGNAL;
+			(*pev)->mode = K_POLL_MODE_NOTIFY_ONLY;
+			(*pev)->state = K_POLL_STATE_NOT_READY;
+			(*pev)++;
+		}
+
+		return 0;
+	}
+
+	case ZFD_IOCTL_POLL_UPDATE: {
+		struct zsock_pollfd *pfd;
+		struct k_poll_event **pev;
+
+		pfd = va_arg(args, struct zsock_pollfd *);
+		pev = va_arg(args, struct k_poll_event **);
+
+		if (pfd->events & ZSOCK_POLLIN) {
+			if ((*pev)->state != K_POLL_STATE_NOT_READY) {
+				pfd->revents |= ZSOCK_POLLIN;
+			}
+			(*pev)++;
+		}
+
+		return 0;
+	}
+
+	default:
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+}
+
+static const struct fd_op_vtable epoll_fd_vtable = {
+	.read = epoll_read_op,
+	.write = epoll_write_op,
+	.close = epoll_close_op,
+	.ioctl = epoll_ioctl_op,
+};
+
+int epoll_create1(int flags)
+{
+	struct epoll *ep = NULL;
+	int fd = -1;
+
+	if (flags & ~EPOLL_CLOEXEC) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&epoll_mtx, K_FOREVER);
+
+	for (int i = 0; i < ARRAY_SIZE(epolls); i++) {
+		if (!epolls[i].in_use) {
+			ep = &epolls[i];
+			break;
+		}
+	}
+
+	if (ep == NULL) {
+		errno = ENOMEM;
+		goto exit_mtx;
+	}
+
+	fd = z_reserve_fd();
+	if (fd < 0) {
+		goto exit_mtx;
+	}
+
+	ep->in_use = true;
+	k_mutex_init(&ep->mtx);
+	sys_dlist_init(&ep->ready);
+	k_poll_signal_init(&ep->sig);
+
+	z_finalize_fd(fd, ep, &epoll_fd_vtable);
+
+exit_mtx:
+	k_mutex_unlock(&epoll_mtx);
+
+	return fd;
+}
+
+int epoll_create(int size)
+{
+	if (size <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	return epoll_create1(0);
+}
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event)
+{
+	const struct fd_op_vtable *vtable;
+	struct epoll_item *item;
+	struct k_mutex *lock;
+	k_spinlock_key_t key;
+	struct epoll *ep;
+	void *obj;
+	int ret = 0;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (fd == epfd) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	if (op != EPOLL_CTL_DEL && event == NULL) {
+		errno = EFAULT;
+		return -1;
+	}
+
+	(void)k_mutex_lock(&ep->mtx, K_FOREVER);
+
+	item = epoll_item_find(ep, fd);
+
+	switch (op) {
+	case EPOLL_CTL_ADD:
+		if (item != NULL) {
+			errno = EEXIST;
+			ret = -1;
+			break;
+		}
+
+		obj = z_get_fd_obj_and_vtable(fd, &vtable, &lock);
+		if (obj == NULL) {
+			ret = -1;
+			break;
+		}
+
+		item = epoll_item_alloc(ep);
+		if (item == NULL) {
+			errno = ENOMEM;
+			ret = -1;
+			break;
+		}
+
+		item->fd = fd;
+		item->obj = obj;
+		item->vtable = vtable;
+		item->lock = lock;
+		item->event = *event;
+
+		if (epoll_item_watch(item, true) < 0) {
+			/* The object cannot tell when it becomes ready */
+			epoll_item_free(item);
+			errno = EPERM;
+			ret = -1;
+			break;
+		}
+
+		/* Report whatever is already pending */
+		epoll_item_check(ep, item);
+		break;
+
+	case EPOLL_CTL_MOD:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		key = k_spin_lock(&ep->lock);
+		item->event = *event;
+		item->disabled = false;
+		k_spin_unlock(&ep->lock, key);
+
+		epoll_item_check(ep, item);
+		break;
+
+	case EPOLL_CTL_DEL:
+		if (item == NULL) {
+			errno = ENOENT;
+			ret = -1;
+			break;
+		}
+
+		(void)epoll_item_watch(item, false);
+		epoll_item_free(item);
+		break;
+
+	default:
+		errno = EINVAL;
+		ret = -1;
+		break;
+	}
+
+	k_mutex_unlock(&ep->mtx);
+
+	return ret;
+}
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents,
+	       int timeout)
+{
+	k_timeout_t wait = timeout < 0 ? K_FOREVER : K_MSEC(timeout);
+	struct k_poll_event poll_event;
+	struct epoll *ep;
+	uint64_t end;
+	int ret;
+
+	ep = z_get_fd_obj(epfd, &epoll_fd_vtable, EINVAL);
+	if (ep == NULL) {
+		return -1;
+	}
+
+	if (events == NULL || maxevents <= 0) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	end = sys_clock_timeout_end_calc(wait);
+
+	for (;;) {
+		ret = epoll_collect(ep, events, maxevents);
+		if (ret > 0 || K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			return ret;
+		}
+
+		if (!K_TIMEOUT_EQ(wait, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				return 0;
+			}
+
+			wait = Z_TIMEOUT_TICKS(remaining);
+		}
+
+		k_poll_event_init(&poll_event, K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &ep->sig);
+
+		ret = k_poll(&poll_event, 1, wait);
+		if (ret == -EAGAIN) {
+			return 0;
+		} else if (ret != 0) {
+			errno = -ret;
+			return -1;
+		}
+	}
+}
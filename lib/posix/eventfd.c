@@ -17,6 +17,9 @@ struct eventfd {
 	_wait_q_t wait_q;
 	eventfd_t cnt;
 	int flags;
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	sys_slist_t watchers;
+#endif
 };
 
 K_MUTEX_DEFINE(eventfd_mtx);
@@ -79,6 +82,15 @@ static int eventfd_poll_update(struct eventfd *efd,
 	return 0;
 }
 
+static inline void eventfd_notify(struct eventfd *efd, int events)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	if (events != 0) {
+		z_poll_watch_notify(&efd->watchers, events);
+	}
+#endif
+}
+
 static ssize_t eventfd_read_op(void *obj, void *buf, size_t sz)
 {
 	struct eventfd *efd = obj;
@@ -108,6 +120,7 @@ static ssize_t eventfd_read_op(void *obj, void *buf, size_t sz)
 			break;
 		}
 	}
+	eventfd_notify(efd, result == 0 ? ZSOCK_POLLOUT : 0);
 	if (z_unpend_all(&efd->wait_q) != 0) {
 		z_reschedule(&efd->lock, key);
 	} else {
@@ -165,6 +178,7 @@ static ssize_t eventfd_write_op(void *obj, const void *buf, size_t sz)
 			break;
 		}
 	}
+	eventfd_notify(efd, result == 0 ? ZSOCK_POLLIN : 0);
 	if (z_unpend_all(&efd->wait_q) != 0) {
 		z_reschedule(&efd->lock, key);
 	} else {
@@ -185,6 +199,10 @@ static int eventfd_close_op(void *obj)
 
 	efd->flags = 0;
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	z_poll_watch_close(&efd->watchers, ZSOCK_POLLNVAL);
+#endif
+
 	return 0;
 }
 
@@ -233,6 +251,24 @@ static int eventfd_ioctl_op(void *obj, unsigned int request, va_list args)
 		return eventfd_poll_update(obj, pfd, pev);
 	}
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	case ZFD_IOCTL_POLL_WATCH: {
+		struct z_poll_watch *watch;
+		int add;
+
+		watch = va_arg(args, struct z_poll_watch *);
+		add = va_arg(args, int);
+
+		if (add) {
+			z_poll_watch_add(&efd->watchers, watch);
+		} else {
+			z_poll_watch_remove(&efd->watchers, watch);
+		}
+
+		return 0;
+	}
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
@@ -282,6 +318,9 @@ int eventfd(unsigned int initval, int flags)
 	k_poll_signal_init(&efd->write_sig);
 	k_poll_signal_init(&efd->read_sig);
 	z_waitq_init(&efd->wait_q);
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	sys_slist_init(&efd->watchers);
+#endif
 
 	if (initval != 0) {
 		k_poll_signal_raise(&efd->read_sig, 0);
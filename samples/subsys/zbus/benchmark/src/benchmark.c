@@ -25,32 +25,38 @@ LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
 #define CONSUMER_STACK_SIZE (CONFIG_IDLE_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 #define PRODUCER_STACK_SIZE (CONFIG_MAIN_STACK_SIZE + CONFIG_BM_MESSAGE_SIZE)
 
+#if (CONFIG_BM_ONE_TO == 1LLU)
+#define BM_OBSERVERS s1
+#elif (CONFIG_BM_ONE_TO == 2LLU)
+#define BM_OBSERVERS s1, s2
+#elif (CONFIG_BM_ONE_TO <= 4LLU)
+#define BM_OBSERVERS s1, s2, s3, s4
+#elif (CONFIG_BM_ONE_TO <= 8LLU)
+#define BM_OBSERVERS s1, s2, s3, s4, s5, s6, s7, s8
+#else
+#define BM_OBSERVERS s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12, s13, s14, s15, s16
+#endif
+
+#if defined(CONFIG_BM_RING)
+ZBUS_CHAN_RING_DEFINE(bm_channel,	  /* Name */
+		      struct bm_ring_msg, /* Message type */
+
+		      NULL,				/* Validator */
+		      NULL,				/* User data */
+		      ZBUS_OBSERVERS(BM_OBSERVERS),	/* observers */
+		      ZBUS_MSG_INIT(0),			/* Initial value {0} */
+		      CONFIG_BM_RING_SIZE		/* Ring length */
+);
+#else
 ZBUS_CHAN_DEFINE(bm_channel,		   /* Name */
 		 struct external_data_msg, /* Message type */
 
-		 NULL, /* Validator */
-		 NULL, /* User data */
-		 ZBUS_OBSERVERS(s1
-
-#if (CONFIG_BM_ONE_TO >= 2LLU)
-				,
-				s2
-#if (CONFIG_BM_ONE_TO > 2LLU)
-				,
-				s3, s4
-#if (CONFIG_BM_ONE_TO > 4LLU)
-				,
-				s5, s6, s7, s8
-#if (CONFIG_BM_ONE_TO > 8LLU)
-				,
-				s9, s10, s11, s12, s13, s14, s15, s16
-#endif
-#endif
-#endif
-#endif
-				), /* observers */
-		 ZBUS_MSG_INIT(0)  /* Initial value {0} */
+		 NULL,				/* Validator */
+		 NULL,				/* User data */
+		 ZBUS_OBSERVERS(BM_OBSERVERS),	/* observers */
+		 ZBUS_MSG_INIT(0)		/* Initial value {0} */
 );
+#endif
 
 #define BYTES_TO_BE_SENT (256LLU * 1024LLU)
 static atomic_t count;
@@ -81,6 +87,56 @@ ZBUS_SUBSCRIBER_DEFINE(s16, 4);
 #endif
 #endif
 
+#if defined(CONFIG_BM_RING)
+static atomic_t lost;
+static struct k_spinlock latency_lock;
+static uint64_t latency_sum;
+static uint32_t latency_max;
+static uint32_t latency_count;
+
+static void ring_drain(struct zbus_ring_cursor *cursor)
+{
+	const struct bm_ring_msg *msg;
+	struct bm_msg msg_received;
+	uint32_t lost_before = cursor->lost;
+	uint32_t latency;
+	k_spinlock_key_t key;
+
+	while (!zbus_ring_claim(cursor, (const void **)&msg, K_FOREVER)) {
+		memcpy(&msg_received, &msg->data, sizeof(struct bm_msg));
+		latency = GET_ARCH_TIME_NS() - msg->pub_ns;
+
+		zbus_ring_finish(cursor);
+
+		key = k_spin_lock(&latency_lock);
+		latency_sum += latency;
+		latency_max = MAX(latency_max, latency);
+		latency_count++;
+		k_spin_unlock(&latency_lock, key);
+
+		atomic_add(&count, CONFIG_BM_MESSAGE_SIZE);
+	}
+
+	atomic_add(&lost, cursor->lost - lost_before);
+}
+
+#define S_TASK(name)                                                                               \
+	void name##_task(void)                                                                     \
+	{                                                                                          \
+		const struct zbus_channel *chan;                                                   \
+		struct zbus_ring_cursor cursor;                                                    \
+                                                                                                   \
+		zbus_ring_cursor_init(&cursor, &bm_channel, K_FOREVER);                            \
+                                                                                                   \
+		while (!zbus_sub_wait(&name, &chan, K_FOREVER)) {                                  \
+			ring_drain(&cursor);                                                       \
+		}                                                                                  \
+	}                                                                                          \
+                                                                                                   \
+	K_THREAD_DEFINE(name##_id, CONSUMER_STACK_SIZE, name##_task, NULL, NULL, NULL, 3, 0, 0);
+
+#else /* Dynamic memory */
+
 #define S_TASK(name)                                                                               \
 	void name##_task(void)                                                                     \
 	{                                                                                          \
@@ -105,6 +161,8 @@ ZBUS_SUBSCRIBER_DEFINE(s16, 4);
                                                                                                    \
 	K_THREAD_DEFINE(name##_id, CONSUMER_STACK_SIZE, name##_task, NULL, NULL, NULL, 3, 0, 0);
 
+#endif /* CONFIG_BM_RING */
+
 S_TASK(s1)
 #if (CONFIG_BM_ONE_TO >= 2LLU)
 S_TASK(s2)
@@ -174,9 +232,17 @@ static void s_cb(const struct zbus_channel *chan)
 
 static void producer_thread(void)
 {
-	LOG_INF("Benchmark 1 to %d: Dynamic memory, %sSYNC transmission and message size %u",
-		CONFIG_BM_ONE_TO, IS_ENABLED(CONFIG_BM_ASYNC) ? "A" : "", CONFIG_BM_MESSAGE_SIZE);
+	LOG_INF("Benchmark 1 to %d: %s, %sSYNC transmission and message size %u",
+		CONFIG_BM_ONE_TO, IS_ENABLED(CONFIG_BM_RING) ? "Message ring" : "Dynamic memory",
+		IS_ENABLED(CONFIG_BM_ASYNC) ? "A" : "", CONFIG_BM_MESSAGE_SIZE);
 
+#if defined(CONFIG_BM_RING)
+	static struct bm_ring_msg ring_msg;
+
+	for (uint64_t i = (CONFIG_BM_MESSAGE_SIZE - 1); i > 0; --i) {
+		ring_msg.data.bytes[i] = i;
+	}
+#else
 	struct bm_msg msg;
 	struct external_data_msg *actual_message_data;
 
@@ -193,11 +259,17 @@ static void producer_thread(void)
 	__ASSERT_NO_MSG(actual_message_data->size > 0);
 
 	zbus_chan_finish(&bm_channel);
+#endif /* CONFIG_BM_RING */
 
 	uint32_t start_ns = GET_ARCH_TIME_NS();
 
 	for (uint64_t internal_count = BYTES_TO_BE_SENT / CONFIG_BM_ONE_TO; internal_count > 0;
 	     internal_count -= CONFIG_BM_MESSAGE_SIZE) {
+#if defined(CONFIG_BM_RING)
+		ring_msg.pub_ns = GET_ARCH_TIME_NS();
+
+		zbus_chan_pub(&bm_channel, &ring_msg, K_MSEC(200));
+#else
 		zbus_chan_claim(&bm_channel, K_NO_WAIT);
 
 		actual_message_data = zbus_chan_msg(&bm_channel);
@@ -207,6 +279,7 @@ static void producer_thread(void)
 		zbus_chan_finish(&bm_channel);
 
 		zbus_chan_notify(&bm_channel, K_MSEC(200));
+#endif
 	}
 
 	uint32_t end_ns = GET_ARCH_TIME_NS();
@@ -224,6 +297,16 @@ static void producer_thread(void)
 	LOG_INF("Average data rate: %llu.%lluMB/s", i, f);
 	LOG_INF("Duration: %u.%uus", duration / NSEC_PER_USEC, duration % NSEC_PER_USEC);
 
+#if defined(CONFIG_BM_RING)
+	k_spinlock_key_t key = k_spin_lock(&latency_lock);
+	uint32_t latency_avg = latency_count ? (uint32_t)(latency_sum / latency_count) : 0;
+
+	k_spin_unlock(&latency_lock, key);
+
+	LOG_INF("Latency: average %uns, max %uns, lost %ld", latency_avg, latency_max,
+		atomic_get(&lost));
+#endif
+
 	printk("\n@%u\n", duration);
 }
 
@@ -16,4 +16,9 @@ struct bm_msg {
 	uint8_t bytes[CONFIG_BM_MESSAGE_SIZE];
 };
 
+struct bm_ring_msg {
+	uint32_t pub_ns;
+	struct bm_msg data;
+};
+
 #endif /* _MESSAGES_H_ */
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Streaming Log Parser for framed Dictionary-based Logging
+
+This decodes framed dictionary based log data, as output by the file system
+and network logging backends, while it is being produced. Log data can be
+read from a file which is followed as it grows, or received over UDP.
+
+Each frame carries a sequence number and the total number of messages
+dropped on the target, so lost frames and dropped messages are reported
+in line with the decoded log messages.
+"""
+
+import argparse
+import logging
+import os
+import socket
+import struct
+import sys
+import time
+
+import dictionary_parser
+from dictionary_parser.log_database import LogDatabase
+
+
+LOGGER_FORMAT = "%(message)s"
+logger = logging.getLogger("parser")
+
+FRAME_MAGIC = b"ZL"
+FRAME_VERSION = 1
+
+# Frame header:
+# magic (2 bytes), version, reserved, payload length, sequence number,
+# total number of dropped messages
+FMT_FRAME_HDR = "2sBBHII"
+
+# Largest payload which can be announced by a frame header
+MAX_PAYLOAD_LEN = 0xFFFF
+
+
+class FrameDecoder():
+    """Reassemble frames from a byte stream and decode their payloads"""
+    def __init__(self, log_parser, little_endian, debug=False):
+        self.log_parser = log_parser
+        self.fmt_hdr = ("<" if little_endian else ">") + FMT_FRAME_HDR
+        self.hdr_len = struct.calcsize(self.fmt_hdr)
+        self.debug = debug
+        self.buf = bytearray()
+        self.next_seq = None
+        self.dropped = None
+
+    def __check_counters(self, seq, dropped):
+        if self.next_seq is not None:
+            gap = (seq - self.next_seq) & 0xFFFFFFFF
+            if gap > 0x7FFFFFFF:
+                print("--- stream restarted ---")
+                self.dropped = None
+            elif gap != 0:
+                print(f"--- {gap} frames lost ---")
+
+        if self.dropped is not None:
+            num_dropped = (dropped - self.dropped) & 0xFFFFFFFF
+            if num_dropped != 0:
+                print(f"--- {num_dropped} messages dropped ---")
+        elif dropped != 0:
+            print(f"--- {dropped} messages dropped ---")
+
+        self.next_seq = (seq + 1) & 0xFFFFFFFF
+        self.dropped = dropped
+
+    def feed(self, data):
+        """Add data to the stream and decode all complete frames"""
+        self.buf += data
+
+        while True:
+            start = self.buf.find(FRAME_MAGIC)
+            if start < 0:
+                # Keep a possible first half of the magic
+                del self.buf[:max(len(self.buf) - 1, 0)]
+                return
+
+            if start > 0:
+                logger.debug("# Skipping %d bytes of garbage", start)
+                del self.buf[:start]
+
+            if len(self.buf) < self.hdr_len:
+                return
+
+            _, version, _, length, seq, dropped = \
+                struct.unpack_from(self.fmt_hdr, self.buf, 0)
+
+            if version != FRAME_VERSION:
+                # Not a frame, look for the next magic
+                del self.buf[:len(FRAME_MAGIC)]
+                continue
+
+            if len(self.buf) < self.hdr_len + length:
+                return
+
+            payload = bytes(self.buf[self.hdr_len:self.hdr_len + length])
+            del self.buf[:self.hdr_len + length]
+
+            self.__check_counters(seq, dropped)
+
+            if length != 0 and \
+               not self.log_parser.parse_log_data(payload, debug=self.debug):
+                logger.error("ERROR: cannot decode frame %d", seq)
+
+
+def follow_file(filename, decoder, follow, interval):
+    """Decode a log file, waiting for more data if following it"""
+    try:
+        logfile = open(filename, "rb")
+    except OSError:
+        logger.error("ERROR: Cannot open binary log data file: %s, exiting...", filename)
+        sys.exit(1)
+
+    with logfile:
+        while True:
+            data = logfile.read()
+            if data:
+                decoder.feed(data)
+                sys.stdout.flush()
+            elif not follow:
+                return
+            else:
+                # Start over if the file was truncated or recreated
+                try:
+                    if os.stat(filename).st_size < logfile.tell():
+                        logfile.seek(0)
+                except FileNotFoundError:
+                    pass
+
+                time.sleep(interval)
+
+
+def receive_udp(address, decoder):
+    """Decode datagrams received on a UDP socket"""
+    host, _, port = address.rpartition(":")
+    host = host.strip("[]") or "::"
+
+    family = socket.AF_INET6 if ":" in host else socket.AF_INET
+    sock = socket.socket(family, socket.SOCK_DGRAM)
+    sock.bind((host, int(port)))
+
+    with sock:
+        while True:
+            data, _ = sock.recvfrom(MAX_PAYLOAD_LEN)
+            decoder.feed(data)
+            sys.stdout.flush()
+
+
+def parse_args():
+    """Parse command line arguments"""
+    argparser = argparse.ArgumentParser(allow_abbrev=False)
+
+    argparser.add_argument("dbfile", help="Dictionary Logging Database file")
+
+    source = argparser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--file", help="Framed log data file")
+    source.add_argument("--udp", metavar="[HOST:]PORT",
+                        help="Receive framed log data over UDP")
+
+    argparser.add_argument("--follow", action="store_true",
+                           help="Keep reading the log data file as it grows")
+    argparser.add_argument("--interval", type=float, default=0.2,
+                           help="Polling interval in seconds when following a file")
+    argparser.add_argument("--debug", action="store_true",
+                           help="Print extra debugging information")
+
+    return argparser.parse_args()
+
+
+def main():
+    """Main function of streaming log parser"""
+    args = parse_args()
+
+    # Setup logging for parser
+    logging.basicConfig(format=LOGGER_FORMAT)
+    if args.debug:
+        logger.setLevel(logging.DEBUG)
+    else:
+        logger.setLevel(logging.INFO)
+
+    # Read from database file
+    database = LogDatabase.read_json_database(args.dbfile)
+    if database is None:
+        logger.error("ERROR: Cannot open database file: %s, exiting...", args.dbfile)
+        sys.exit(1)
+
+    log_parser = dictionary_parser.get_parser(database)
+    if log_parser is None:
+        logger.error("ERROR: Cannot find a suitable parser matching database version!")
+        sys.exit(1)
+
+    decoder = FrameDecoder(log_parser, database.is_tgt_little_endian(), args.debug)
+
+    try:
+        if args.udp:
+            receive_udp(args.udp, decoder)
+        else:
+            follow_file(args.file, decoder, args.follow, args.interval)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
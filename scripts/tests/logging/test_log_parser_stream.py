@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2023 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Tests for the frame decoder of log_parser_stream.py"""
+
+import os
+import struct
+import sys
+
+import pytest
+
+sys.path.insert(0, os.path.join(os.environ["ZEPHYR_BASE"], "scripts", "logging", "dictionary"))
+import log_parser_stream as iut  # Implementation Under Test
+
+
+class FakeLogParser():
+    """Records the payloads passed for decoding"""
+    def __init__(self):
+        self.payloads = []
+
+    def parse_log_data(self, payload, debug=False):
+        """Accept any payload"""
+        self.payloads.append(payload)
+        return True
+
+
+def frame(seq, dropped, payload=b"", little_endian=True):
+    """Frame as output by the target"""
+    fmt = ("<" if little_endian else ">") + iut.FMT_FRAME_HDR
+    return struct.pack(fmt, iut.FRAME_MAGIC, iut.FRAME_VERSION, 0, len(payload),
+                       seq, dropped) + payload
+
+
+def payload(num):
+    """Payload of frame num, not containing the frame magic"""
+    return bytes([0x80 + num]) * (8 + num)
+
+
+def decoder():
+    """Decoder of little endian frames with a fake log parser"""
+    return iut.FrameDecoder(FakeLogParser(), True)
+
+
+def test_frame_header_len():
+    """The frame header is 14 bytes long on every target"""
+    assert decoder().hdr_len == 14
+    assert iut.FrameDecoder(FakeLogParser(), False).hdr_len == 14
+
+
+@pytest.mark.parametrize("little_endian", [True, False])
+def test_decode(capsys, little_endian):
+    """Frames are decoded in order, frames without payload only update counters"""
+    dec = iut.FrameDecoder(FakeLogParser(), little_endian)
+    data = frame(0, 0, payload(0), little_endian) + \
+        frame(1, 0, payload(1), little_endian) + \
+        frame(2, 0, b"", little_endian) + \
+        frame(3, 0, payload(3), little_endian)
+
+    dec.feed(data)
+
+    assert dec.log_parser.payloads == [payload(0), payload(1), payload(3)]
+    assert capsys.readouterr().out == ""
+    assert not dec.buf
+
+
+def test_decode_split():
+    """Frames split over several reads or datagrams are reassembled"""
+    dec = decoder()
+    data = b"".join(frame(n, 0, payload(n)) for n in range(4))
+
+    for i in range(len(data)):
+        dec.feed(data[i:i + 1])
+
+    assert dec.log_parser.payloads == [payload(n) for n in range(4)]
+
+
+def test_resync_garbage(capsys):
+    """Data before a frame magic, or not followed by a frame, is skipped"""
+    dec = decoder()
+    not_frame = iut.FRAME_MAGIC + bytes([iut.FRAME_VERSION + 1]) + b"\x00" * 12
+
+    dec.feed(b"\x01\x02Z" + frame(0, 0, payload(0)) + b"LZ" + not_frame +
+             frame(1, 0, payload(1)))
+
+    assert dec.log_parser.payloads == [payload(0), payload(1)]
+    assert capsys.readouterr().out == ""
+
+
+def test_magic_across_reads():
+    """Half a magic at the end of a read is kept for the next one"""
+    dec = decoder()
+    data = frame(0, 0, payload(0))
+
+    dec.feed(b"garbage" + data[:1])
+    dec.feed(data[1:])
+
+    assert dec.log_parser.payloads == [payload(0)]
+
+
+def test_lost_frames(capsys):
+    """Gaps in the sequence numbers are reported"""
+    dec = decoder()
+
+    dec.feed(frame(0, 0, payload(0)) + frame(1, 0, payload(1)) +
+             frame(4, 0, payload(4)) + frame(5, 0, payload(5)))
+
+    assert dec.log_parser.payloads == [payload(n) for n in (0, 1, 4, 5)]
+    assert capsys.readouterr().out == "--- 2 frames lost ---\n"
+
+
+def test_dropped_messages(capsys):
+    """Messages dropped on the target are reported once"""
+    dec = decoder()
+
+    dec.feed(frame(0, 0, payload(0)) + frame(1, 3) + frame(2, 3, payload(2)) +
+             frame(3, 5, payload(3)))
+
+    assert dec.log_parser.payloads == [payload(0), payload(2), payload(3)]
+    assert capsys.readouterr().out == \
+        "--- 3 messages dropped ---\n--- 2 messages dropped ---\n"
+
+
+def test_first_frame(capsys):
+    """Decoding may start in the middle of a stream"""
+    dec = decoder()
+    data = frame(6, 0, payload(6)) + frame(7, 2, payload(7)) + \
+        frame(8, 2, payload(8))
+
+    dec.feed(data[5:])
+
+    assert dec.log_parser.payloads == [payload(7), payload(8)]
+    assert capsys.readouterr().out == "--- 2 messages dropped ---\n"
+
+
+def test_resync_truncated(capsys):
+    """Frames following a truncated one are decoded again"""
+    dec = decoder()
+    truncated = frame(1, 0, payload(1))[:-3]
+
+    dec.feed(frame(0, 0, payload(0)) + truncated + frame(2, 0, payload(2)) +
+             frame(3, 1, payload(3)) + frame(4, 1, payload(4)))
+
+    # The truncated frame took the start of the next one as payload
+    assert dec.log_parser.payloads[0] == payload(0)
+    assert dec.log_parser.payloads[-2:] == [payload(3), payload(4)]
+    assert capsys.readouterr().out == \
+        "--- 1 frames lost ---\n--- 1 messages dropped ---\n"
+
+
+def test_restart(capsys):
+    """A target restarting its sequence numbers is reported"""
+    dec = decoder()
+
+    dec.feed(frame(0, 0, payload(0)) + frame(1, 4, payload(1)) +
+             frame(2, 4, payload(2))[:-1])
+    dec.feed(frame(0, 0, payload(0)) + frame(1, 1, payload(1)))
+
+    assert dec.log_parser.payloads[:2] == [payload(0), payload(1)]
+    assert dec.log_parser.payloads[-1] == payload(1)
+    assert capsys.readouterr().out == \
+        "--- 4 messages dropped ---\n--- stream restarted ---\n" \
+        "--- 1 messages dropped ---\n"
@@ -1247,7 +1247,6 @@ static uint8_t err_to_att(int err)
 
 struct read_type_data {
 	struct bt_att_chan *chan;
-	struct bt_uuid *uuid;
 	struct net_buf *buf;
 	struct bt_att_read_type_rsp *rsp;
 	struct bt_att_data *item;
@@ -1341,11 +1340,6 @@ static uint8_t read_type_cb(const struct bt_gatt_attr *attr, uint16_t handle,
 	struct bt_conn *conn = chan->chan.chan.conn;
 	ssize_t read;
 
-	/* Skip if doesn't match */
-	if (bt_uuid_cmp(attr->uuid, data->uuid)) {
-		return BT_GATT_ITER_CONTINUE;
-	}
-
 	LOG_DBG("handle 0x%04x", handle);
 
 	/*
@@ -1407,14 +1401,15 @@ static uint8_t att_read_type_rsp(struct bt_att_chan *chan, struct bt_uuid *uuid,
 	}
 
 	data.chan = chan;
-	data.uuid = uuid;
 	data.rsp = net_buf_add(data.buf, sizeof(*data.rsp));
 	data.rsp->len = 0U;
 
 	/* Pre-set error if no attr will be found in handle */
 	data.err = BT_ATT_ERR_ATTRIBUTE_NOT_FOUND;
 
-	bt_gatt_foreach_attr(start_handle, end_handle, read_type_cb, &data);
+	/* Only the attributes of the requested type are visited */
+	bt_gatt_foreach_attr_type(start_handle, end_handle, uuid, NULL, 0,
+				  read_type_cb, &data);
 
 	if (data.err) {
 		tx_meta_data_free(bt_att_tx_meta_data(data.buf));
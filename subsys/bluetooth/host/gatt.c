@@ -1176,6 +1176,130 @@ BT_GATT_SERVICE_DEFINE(_1_gatt_svc,
 #endif /* CONFIG_BT_GATT_SERVICE_CHANGED */
 );
 
+#if CONFIG_BT_GATT_DB_INDEX_SIZE > 0
+static struct {
+	/* Attribute of each handle, starting from handle 0x0001 */
+	const struct bt_gatt_attr *attrs[CONFIG_BT_GATT_DB_INDEX_SIZE];
+	/* Handles of the attributes, sorted by type and then by handle */
+	uint16_t types[CONFIG_BT_GATT_DB_INDEX_SIZE];
+	uint16_t count;
+	uint16_t last_handle;
+	/* Whether the index covers the whole database */
+	bool valid;
+} db_index;
+
+/* The Base UUID, UUIDs matching it in all but the value are compared by
+ * bt_uuid_cmp() as if they were 16 or 32-bit UUIDs.
+ */
+static const uint8_t uuid_base[] = {
+	BT_UUID_128_ENCODE(0x00000000, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB)
+};
+
+static bool uuid_short_val(const struct bt_uuid *uuid, uint32_t *val)
+{
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		*val = BT_UUID_16(uuid)->val;
+		return true;
+	case BT_UUID_TYPE_32:
+		*val = BT_UUID_32(uuid)->val;
+		return true;
+	default:
+		if (memcmp(BT_UUID_128(uuid)->val, uuid_base, 12)) {
+			return false;
+		}
+
+		*val = sys_get_le32(&BT_UUID_128(uuid)->val[12]);
+		return true;
+	}
+}
+
+/* Total order of the UUIDs, equal UUIDs according to bt_uuid_cmp() compare
+ * equal, whatever their type.
+ */
+static int db_index_uuid_cmp(const struct bt_uuid *u1, const struct bt_uuid *u2)
+{
+	uint32_t val1, val2;
+	bool short1 = uuid_short_val(u1, &val1);
+	bool short2 = uuid_short_val(u2, &val2);
+
+	if (short1 != short2) {
+		return short1 ? -1 : 1;
+	}
+
+	if (!short1) {
+		return memcmp(BT_UUID_128(u1)->val, BT_UUID_128(u2)->val, 16);
+	}
+
+	if (val1 != val2) {
+		return val1 < val2 ? -1 : 1;
+	}
+
+	return 0;
+}
+
+static int db_index_type_cmp(const void *a, const void *b)
+{
+	uint16_t handle1 = *(const uint16_t *)a;
+	uint16_t handle2 = *(const uint16_t *)b;
+	int cmp;
+
+	cmp = db_index_uuid_cmp(db_index.attrs[handle1 - 1]->uuid,
+				db_index.attrs[handle2 - 1]->uuid);
+	if (cmp) {
+		return cmp;
+	}
+
+	return (int)handle1 - (int)handle2;
+}
+
+static uint8_t db_index_add(const struct bt_gatt_attr *attr, uint16_t handle,
+			    void *user_data)
+{
+	bool *full = user_data;
+
+	if (handle > ARRAY_SIZE(db_index.attrs)) {
+		*full = true;
+		return BT_GATT_ITER_STOP;
+	}
+
+	db_index.attrs[handle - 1] = attr;
+	db_index.types[db_index.count++] = handle;
+	db_index.last_handle = handle;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+/* Must be called whenever services are registered or unregistered */
+static void db_index_build(void)
+{
+	bool full = false;
+
+	/* Walk the services instead of the stale index */
+	db_index.valid = false;
+
+	(void)memset(db_index.attrs, 0, sizeof(db_index.attrs));
+	db_index.count = 0U;
+	db_index.last_handle = 0U;
+
+	bt_gatt_foreach_attr(0x0001, 0xffff, db_index_add, &full);
+	if (full) {
+		LOG_WRN("Database exceeds %u handles, not indexed",
+			CONFIG_BT_GATT_DB_INDEX_SIZE);
+		return;
+	}
+
+	qsort(db_index.types, db_index.count, sizeof(db_index.types[0]),
+	      db_index_type_cmp);
+
+	db_index.valid = true;
+}
+#else
+static inline void db_index_build(void)
+{
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX_SIZE > 0 */
+
 #if defined(CONFIG_BT_GATT_DYNAMIC_DB)
 static uint8_t found_attr(const struct bt_gatt_attr *attr, uint16_t handle,
 			  void *user_data)
@@ -1257,6 +1381,7 @@ populate:
 	}
 
 	gatt_insert(svc, last_handle);
+	db_index_build();
 
 	return 0;
 }
@@ -1479,6 +1604,8 @@ static void bt_gatt_service_init(void)
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
 		last_static_handle += svc->attr_count;
 	}
+
+	db_index_build();
 }
 
 void bt_gatt_init(void)
@@ -1656,6 +1783,8 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+	db_index_build();
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -2009,6 +2138,74 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+#if CONFIG_BT_GATT_DB_INDEX_SIZE > 0
+/* Position of the first attribute of type uuid from start_handle onwards */
+static size_t db_index_type_find(const struct bt_uuid *uuid, uint16_t start_handle)
+{
+	size_t lo = 0;
+	size_t hi = db_index.count;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		uint16_t handle = db_index.types[mid];
+		int cmp;
+
+		cmp = db_index_uuid_cmp(db_index.attrs[handle - 1]->uuid, uuid);
+		if (cmp < 0 || (!cmp && handle < start_handle)) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void foreach_attr_type_index(uint16_t start_handle, uint16_t end_handle,
+				    const struct bt_uuid *uuid,
+				    const void *attr_data, uint16_t num_matches,
+				    bt_gatt_attr_func_t func, void *user_data)
+{
+	const struct bt_gatt_attr *attr;
+	uint32_t handle;
+	size_t i;
+
+	if (uuid) {
+		/* Only visit the attributes of the requested type */
+		for (i = db_index_type_find(uuid, start_handle);
+		     i < db_index.count; i++) {
+			handle = db_index.types[i];
+			attr = db_index.attrs[handle - 1];
+
+			if (db_index_uuid_cmp(attr->uuid, uuid) ||
+			    gatt_foreach_iter(attr, handle, start_handle,
+					      end_handle, uuid, attr_data,
+					      &num_matches, func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return;
+			}
+		}
+
+		return;
+	}
+
+	end_handle = MIN(end_handle, db_index.last_handle);
+
+	for (handle = MAX(start_handle, 1U); handle <= end_handle; handle++) {
+		attr = db_index.attrs[handle - 1];
+		if (!attr) {
+			continue;
+		}
+
+		if (gatt_foreach_iter(attr, handle, start_handle, end_handle,
+				      NULL, attr_data, &num_matches, func,
+				      user_data) == BT_GATT_ITER_STOP) {
+			return;
+		}
+	}
+}
+#endif /* CONFIG_BT_GATT_DB_INDEX_SIZE > 0 */
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
@@ -2020,6 +2217,14 @@ void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 		num_matches = UINT16_MAX;
 	}
 
+#if CONFIG_BT_GATT_DB_INDEX_SIZE > 0
+	if (db_index.valid) {
+		foreach_attr_type_index(start_handle, end_handle, uuid, attr_data,
+					num_matches, func, user_data);
+		return;
+	}
+#endif /* CONFIG_BT_GATT_DB_INDEX_SIZE > 0 */
+
 	if (start_handle <= last_static_handle) {
 		uint16_t handle = 1;
 
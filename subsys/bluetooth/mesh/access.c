@@ -48,10 +48,52 @@ struct mod_pub_val {
 		 cred:1;
 };
 
+/* Opcode dispatch index entry: the model of an element that handles an
+ * opcode. The model is SIG or vendor depending on the opcode length.
+ */
+struct op_index_entry {
+	uint32_t opcode;
+	uint8_t  elem_idx;
+	uint8_t  mod_idx;
+	uint16_t op_idx;
+};
+
+/* Group address subscription index entry, unused if addr is unassigned. */
+struct sub_index_entry {
+	uint16_t addr;
+	uint8_t  elem_idx;
+	uint8_t  mod_idx;
+	bool     vnd;
+};
+
+#define OP_INDEX_SIZE CONFIG_BT_MESH_ACCESS_OP_INDEX_SIZE
+#define SUB_INDEX_CNT CONFIG_BT_MESH_ACCESS_SUB_INDEX_SIZE
+
+#if SUB_INDEX_CNT > 0
+/* Keep the hash table at most half full */
+#define SUB_INDEX_BITS (32 - __builtin_clz(2 * SUB_INDEX_CNT - 1))
+#define SUB_INDEX_SIZE BIT(SUB_INDEX_BITS)
+#endif
+
 static const struct bt_mesh_comp *dev_comp;
 static uint16_t dev_primary_addr;
 static void (*msg_cb)(uint32_t opcode, struct bt_mesh_msg_ctx *ctx, struct net_buf_simple *buf);
 
+#if OP_INDEX_SIZE > 0
+/* Sorted by opcode and element, at most one entry per opcode and element */
+static struct op_index_entry op_index[OP_INDEX_SIZE];
+static size_t op_index_cnt;
+/* Whether op_index covers the whole composition */
+static bool op_index_valid;
+#endif
+
+#if SUB_INDEX_CNT > 0
+static struct sub_index_entry sub_index[SUB_INDEX_SIZE];
+static size_t sub_index_cnt;
+/* Whether sub_index covers all model subscriptions */
+static bool sub_index_valid;
+#endif
+
 void bt_mesh_model_foreach(void (*func)(struct bt_mesh_model *mod,
 					struct bt_mesh_elem *elem,
 					bool vnd, bool primary,
@@ -365,6 +407,97 @@ static void mod_init(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 	}
 }
 
+#if OP_INDEX_SIZE > 0
+static int op_index_cmp(const struct op_index_entry *entry, uint32_t opcode,
+			uint8_t elem_idx)
+{
+	if (entry->opcode != opcode) {
+		return entry->opcode < opcode ? -1 : 1;
+	}
+
+	return (int)entry->elem_idx - (int)elem_idx;
+}
+
+/* Index of the first entry not ordered before opcode and elem_idx */
+static size_t op_index_lower_bound(uint32_t opcode, uint8_t elem_idx)
+{
+	size_t lo = 0;
+	size_t hi = op_index_cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (op_index_cmp(&op_index[mid], opcode, elem_idx) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void op_index_add_mod(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+			     bool vnd, bool primary, void *user_data)
+{
+	const struct bt_mesh_model_op *op;
+	size_t i;
+
+	if (!op_index_valid) {
+		return;
+	}
+
+	for (op = mod->op; op->func; op++) {
+		/* SIG models only receive SIG opcodes, vendor models only
+		 * vendor opcodes, see find_op().
+		 */
+		if (vnd != (BT_MESH_MODEL_OP_LEN(op->opcode) == 3)) {
+			continue;
+		}
+
+		if (vnd && IS_ENABLED(CONFIG_BT_MESH_MODEL_VND_MSG_CID_FORCE) &&
+		    (op->opcode & 0xffff) != mod->vnd.company) {
+			continue;
+		}
+
+		i = op_index_lower_bound(op->opcode, mod->elem_idx);
+		if (i < op_index_cnt &&
+		    !op_index_cmp(&op_index[i], op->opcode, mod->elem_idx)) {
+			/* Models are visited in the order find_op() walks
+			 * them, the first model with the opcode receives it.
+			 */
+			continue;
+		}
+
+		if (op_index_cnt == OP_INDEX_SIZE || op - mod->op > UINT16_MAX) {
+			LOG_WRN("Opcode index full, using linear lookup");
+			op_index_valid = false;
+			return;
+		}
+
+		memmove(&op_index[i + 1], &op_index[i],
+			(op_index_cnt - i) * sizeof(op_index[0]));
+		op_index[i].opcode = op->opcode;
+		op_index[i].elem_idx = mod->elem_idx;
+		op_index[i].mod_idx = mod->mod_idx;
+		op_index[i].op_idx = op - mod->op;
+		op_index_cnt++;
+	}
+}
+#endif
+
+static void op_index_build(void)
+{
+#if OP_INDEX_SIZE > 0
+	op_index_cnt = 0;
+	op_index_valid = true;
+
+	bt_mesh_model_foreach(op_index_add_mod, NULL);
+
+	LOG_DBG("%zu opcodes indexed", op_index_cnt);
+#endif
+}
+
 int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 {
 	int err;
@@ -378,8 +511,14 @@ int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 
 	err = 0;
 	bt_mesh_model_foreach(mod_init, &err);
+	if (err) {
+		return err;
+	}
 
-	return err;
+	op_index_build();
+	bt_mesh_model_sub_index_rebuild();
+
+	return 0;
 }
 
 void bt_mesh_comp_provision(uint16_t addr)
@@ -425,6 +564,79 @@ static uint16_t *model_group_get(struct bt_mesh_model *mod, uint16_t addr)
 	return NULL;
 }
 
+#if SUB_INDEX_CNT > 0
+static inline uint32_t sub_hash(uint16_t addr)
+{
+	return ((uint32_t)addr * 0x9e3779b1U) >> (32 - SUB_INDEX_BITS);
+}
+
+/* Next entry for addr in the probe sequence starting at *i */
+static struct sub_index_entry *sub_index_next(uint16_t addr, uint32_t *i)
+{
+	struct sub_index_entry *entry;
+
+	while (sub_index[*i].addr != BT_MESH_ADDR_UNASSIGNED) {
+		entry = &sub_index[*i];
+		*i = (*i + 1) & (SUB_INDEX_SIZE - 1);
+
+		if (entry->addr == addr) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static struct bt_mesh_model *sub_index_model(const struct sub_index_entry *entry)
+{
+	struct bt_mesh_elem *elem = &dev_comp->elem[entry->elem_idx];
+
+	return entry->vnd ? &elem->vnd_models[entry->mod_idx] :
+			    &elem->models[entry->mod_idx];
+}
+
+static void sub_index_add_mod(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+			      bool vnd, bool primary, void *user_data)
+{
+	uint32_t j;
+	int i;
+
+	for (i = 0; i < mod->groups_cnt && sub_index_valid; i++) {
+		if (mod->groups[i] == BT_MESH_ADDR_UNASSIGNED) {
+			continue;
+		}
+
+		if (sub_index_cnt == SUB_INDEX_CNT) {
+			LOG_WRN("Subscription index full, using linear lookup");
+			sub_index_valid = false;
+			return;
+		}
+
+		for (j = sub_hash(mod->groups[i]);
+		     sub_index[j].addr != BT_MESH_ADDR_UNASSIGNED;
+		     j = (j + 1) & (SUB_INDEX_SIZE - 1)) {
+		}
+
+		sub_index[j].addr = mod->groups[i];
+		sub_index[j].elem_idx = mod->elem_idx;
+		sub_index[j].mod_idx = mod->mod_idx;
+		sub_index[j].vnd = vnd;
+		sub_index_cnt++;
+	}
+}
+#endif
+
+void bt_mesh_model_sub_index_rebuild(void)
+{
+#if SUB_INDEX_CNT > 0
+	(void)memset(sub_index, 0, sizeof(sub_index));
+	sub_index_cnt = 0;
+	sub_index_valid = true;
+
+	bt_mesh_model_foreach(sub_index_add_mod, NULL);
+#endif
+}
+
 struct find_group_visitor_ctx {
 	uint16_t *entry;
 	struct bt_mesh_model *mod;
@@ -518,6 +730,17 @@ bool bt_mesh_has_addr(uint16_t addr)
 		return true;
 	}
 
+#if SUB_INDEX_CNT > 0
+	/* Free subscription slots match the unassigned address, the index
+	 * only holds the used ones.
+	 */
+	if (sub_index_valid && addr != BT_MESH_ADDR_UNASSIGNED) {
+		uint32_t i = sub_hash(addr);
+
+		return sub_index_next(addr, &i) != NULL;
+	}
+#endif
+
 	for (index = 0; index < dev_comp->elem_count; index++) {
 		struct bt_mesh_elem *elem = &dev_comp->elem[index];
 
@@ -577,12 +800,62 @@ bool bt_mesh_model_has_key(struct bt_mesh_model *mod, uint16_t key)
 	return false;
 }
 
+#if SUB_INDEX_CNT > 0
+static enum bt_mesh_walk find_mod_visitor(struct bt_mesh_model *mod, void *user_data)
+{
+	struct bt_mesh_model **match = user_data;
+
+	if (mod == *match) {
+		*match = NULL;
+		return BT_MESH_WALK_STOP;
+	}
+
+	return BT_MESH_WALK_CONTINUE;
+}
+
+/* Same result as bt_mesh_model_find_group(), but only visits the models that
+ * subscribe to the group address instead of every subscription list of the
+ * extension tree.
+ */
+static bool model_sub_index_has_group(struct bt_mesh_model *mod, uint16_t addr)
+{
+	struct sub_index_entry *entry;
+	struct bt_mesh_model *match;
+	uint32_t i = sub_hash(addr);
+
+	while ((entry = sub_index_next(addr, &i))) {
+		if (entry->elem_idx != mod->elem_idx) {
+			continue;
+		}
+
+		match = sub_index_model(entry);
+		if (match == mod) {
+			return true;
+		}
+
+		if (IS_ENABLED(CONFIG_BT_MESH_MODEL_EXTENSIONS)) {
+			bt_mesh_model_extensions_walk(mod, find_mod_visitor, &match);
+			if (!match) {
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+#endif
+
 static bool model_has_dst(struct bt_mesh_model *mod, uint16_t dst)
 {
 	if (BT_MESH_ADDR_IS_UNICAST(dst)) {
 		return (dev_comp->elem[mod->elem_idx].addr == dst);
 	} else if (BT_MESH_ADDR_IS_GROUP(dst) || BT_MESH_ADDR_IS_VIRTUAL(dst) ||
 		  (BT_MESH_ADDR_IS_FIXED_GROUP(dst) &&  mod->elem_idx != 0)) {
+#if SUB_INDEX_CNT > 0
+		if (sub_index_valid) {
+			return model_sub_index_has_group(mod, dst);
+		}
+#endif
 		return !!bt_mesh_model_find_group(&mod, dst);
 	}
 
@@ -677,6 +950,69 @@ static int get_opcode(struct net_buf_simple *buf, uint32_t *opcode)
 	CODE_UNREACHABLE;
 }
 
+static void model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf,
+		       struct bt_mesh_model *model, const struct bt_mesh_model_op *op,
+		       uint32_t opcode)
+{
+	struct net_buf_simple_state state;
+
+	if (!bt_mesh_model_has_key(model, rx->ctx.app_idx)) {
+		return;
+	}
+
+	if (!model_has_dst(model, rx->ctx.recv_dst)) {
+		return;
+	}
+
+	if ((op->len >= 0) && (buf->len < (size_t)op->len)) {
+		LOG_ERR("Too short message for OpCode 0x%08x", opcode);
+		return;
+	} else if ((op->len < 0) && (buf->len != (size_t)(-op->len))) {
+		LOG_ERR("Invalid message size for OpCode 0x%08x", opcode);
+		return;
+	}
+
+	/* The callback will likely parse the buffer, so
+	 * store the parsing state in case multiple models
+	 * receive the message.
+	 */
+	net_buf_simple_save(buf, &state);
+	(void)op->func(model, &rx->ctx, buf);
+	net_buf_simple_restore(buf, &state);
+}
+
+/* Dispatch through the opcode index, returns false if there is none */
+static bool op_index_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf,
+			  uint32_t opcode)
+{
+#if OP_INDEX_SIZE > 0
+	struct bt_mesh_model *model;
+	struct bt_mesh_elem *elem;
+	size_t i;
+
+	if (!op_index_valid) {
+		return false;
+	}
+
+	for (i = op_index_lower_bound(opcode, 0);
+	     i < op_index_cnt && op_index[i].opcode == opcode; i++) {
+		elem = &dev_comp->elem[op_index[i].elem_idx];
+
+		if (BT_MESH_MODEL_OP_LEN(opcode) < 3) {
+			model = &elem->models[op_index[i].mod_idx];
+		} else {
+			model = &elem->vnd_models[op_index[i].mod_idx];
+		}
+
+		model_recv(rx, buf, model, &model->op[op_index[i].op_idx], opcode);
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 {
 	struct bt_mesh_model *model;
@@ -695,38 +1031,16 @@ void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 
 	LOG_DBG("OpCode 0x%08x", opcode);
 
-	for (i = 0; i < dev_comp->elem_count; i++) {
-		struct net_buf_simple_state state;
-
-		op = find_op(&dev_comp->elem[i], opcode, &model);
-		if (!op) {
-			LOG_DBG("No OpCode 0x%08x for elem %d", opcode, i);
-			continue;
-		}
-
-		if (!bt_mesh_model_has_key(model, rx->ctx.app_idx)) {
-			continue;
-		}
+	if (!op_index_recv(rx, buf, opcode)) {
+		for (i = 0; i < dev_comp->elem_count; i++) {
+			op = find_op(&dev_comp->elem[i], opcode, &model);
+			if (!op) {
+				LOG_DBG("No OpCode 0x%08x for elem %d", opcode, i);
+				continue;
+			}
 
-		if (!model_has_dst(model, rx->ctx.recv_dst)) {
-			continue;
+			model_recv(rx, buf, model, op, opcode);
 		}
-
-		if ((op->len >= 0) && (buf->len < (size_t)op->len)) {
-			LOG_ERR("Too short message for OpCode 0x%08x", opcode);
-			continue;
-		} else if ((op->len < 0) && (buf->len != (size_t)(-op->len))) {
-			LOG_ERR("Invalid message size for OpCode 0x%08x", opcode);
-			continue;
-		}
-
-		/* The callback will likely parse the buffer, so
-		 * store the parsing state in case multiple models
-		 * receive the message.
-		 */
-		net_buf_simple_save(buf, &state);
-		(void)op->func(model, &rx->ctx, buf);
-		net_buf_simple_restore(buf, &state);
 	}
 
 	if (IS_ENABLED(CONFIG_BT_MESH_ACCESS_LAYER_MSG) && msg_cb) {
@@ -1272,5 +1586,8 @@ static void commit_mod(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 
 void bt_mesh_model_settings_commit(void)
 {
+	/* Subscriptions may have been restored from storage */
+	bt_mesh_model_sub_index_rebuild();
+
 	bt_mesh_model_foreach(commit_mod, NULL);
 }
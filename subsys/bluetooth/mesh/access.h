@@ -27,6 +27,9 @@ void bt_mesh_model_extensions_walk(struct bt_mesh_model *root,
 
 uint16_t *bt_mesh_model_find_group(struct bt_mesh_model **mod, uint16_t addr);
 
+/* Must be called whenever the subscription lists of the models change */
+void bt_mesh_model_sub_index_rebuild(void);
+
 void bt_mesh_model_foreach(void (*func)(struct bt_mesh_model *mod,
 					struct bt_mesh_elem *elem,
 					bool vnd, bool primary,
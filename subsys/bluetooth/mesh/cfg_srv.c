@@ -1050,6 +1050,7 @@ static int mod_sub_add(struct bt_mesh_model *model,
 	}
 
 	*entry = sub_addr;
+	bt_mesh_model_sub_index_rebuild();
 	status = STATUS_SUCCESS;
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -1126,6 +1127,7 @@ static int mod_sub_del(struct bt_mesh_model *model,
 	match = bt_mesh_model_find_group(&mod, sub_addr);
 	if (match) {
 		*match = BT_MESH_ADDR_UNASSIGNED;
+		bt_mesh_model_sub_index_rebuild();
 
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 			bt_mesh_model_sub_store(mod);
@@ -1200,6 +1202,7 @@ static int mod_sub_overwrite(struct bt_mesh_model *model,
 		bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
 
 		mod->groups[0] = sub_addr;
+		bt_mesh_model_sub_index_rebuild();
 		status = STATUS_SUCCESS;
 
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
@@ -1260,6 +1263,7 @@ static int mod_sub_del_all(struct bt_mesh_model *model,
 	}
 
 	bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
+	bt_mesh_model_sub_index_rebuild();
 
 	if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		bt_mesh_model_sub_store(mod);
@@ -1487,6 +1491,7 @@ static int mod_sub_va_add(struct bt_mesh_model *model,
 	}
 
 	*entry = sub_addr;
+	bt_mesh_model_sub_index_rebuild();
 
 	if (IS_ENABLED(CONFIG_BT_MESH_LOW_POWER)) {
 		bt_mesh_lpn_group_add(sub_addr);
@@ -1561,6 +1566,7 @@ static int mod_sub_va_del(struct bt_mesh_model *model,
 	match = bt_mesh_model_find_group(&mod, sub_addr);
 	if (match) {
 		*match = BT_MESH_ADDR_UNASSIGNED;
+		bt_mesh_model_sub_index_rebuild();
 
 		if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 			bt_mesh_model_sub_store(mod);
@@ -1626,6 +1632,7 @@ static int mod_sub_va_overwrite(struct bt_mesh_model *model,
 		if (status == STATUS_SUCCESS) {
 			bt_mesh_model_extensions_walk(mod, mod_sub_clear_visitor, NULL);
 			mod->groups[0] = sub_addr;
+			bt_mesh_model_sub_index_rebuild();
 
 			if (IS_ENABLED(CONFIG_BT_SETTINGS)) {
 				bt_mesh_model_sub_store(mod);
@@ -2544,4 +2551,5 @@ static void mod_reset(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 void bt_mesh_model_reset(void)
 {
 	bt_mesh_model_foreach(mod_reset, NULL);
+	bt_mesh_model_sub_index_rebuild();
 }
@@ -278,19 +278,26 @@ static void create_net_nonce(uint8_t nonce[13], const uint8_t *pdu,
 	sys_put_be32(iv_index, &nonce[9]);
 }
 
+static void create_priv_rand(uint8_t priv_rand[16], const uint8_t *pdu,
+			     uint32_t iv_index)
+{
+	(void)memset(priv_rand, 0, 5);
+	sys_put_be32(iv_index, &priv_rand[5]);
+	memcpy(&priv_rand[9], &pdu[7], 7);
+
+	LOG_DBG("PrivacyRandom %s", bt_hex(priv_rand, 16));
+}
+
 int bt_mesh_net_obfuscate(uint8_t *pdu, uint32_t iv_index,
 			  const uint8_t privacy_key[16])
 {
-	uint8_t priv_rand[16] = { 0x00, 0x00, 0x00, 0x00, 0x00, };
+	uint8_t priv_rand[16];
 	uint8_t tmp[16];
 	int err, i;
 
 	LOG_DBG("IVIndex %u, PrivacyKey %s", iv_index, bt_hex(privacy_key, 16));
 
-	sys_put_be32(iv_index, &priv_rand[5]);
-	memcpy(&priv_rand[9], &pdu[7], 7);
-
-	LOG_DBG("PrivacyRandom %s", bt_hex(priv_rand, 16));
+	create_priv_rand(priv_rand, pdu, iv_index);
 
 	err = bt_encrypt_be(privacy_key, priv_rand, tmp);
 	if (err) {
@@ -304,6 +311,40 @@ int bt_mesh_net_obfuscate(uint8_t *pdu, uint32_t iv_index,
 	return 0;
 }
 
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+int bt_mesh_privacy_key_expand(const uint8_t privacy_key[16],
+			       struct tc_aes_key_sched_struct *sched)
+{
+	if (tc_aes128_set_encrypt_key(sched, privacy_key) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int bt_mesh_net_obfuscate_sched(uint8_t *pdu, uint32_t iv_index,
+				const struct tc_aes_key_sched_struct *sched)
+{
+	uint8_t priv_rand[16];
+	uint8_t tmp[16];
+	int i;
+
+	LOG_DBG("IVIndex %u", iv_index);
+
+	create_priv_rand(priv_rand, pdu, iv_index);
+
+	if (tc_aes_encrypt(tmp, priv_rand, sched) == TC_CRYPTO_FAIL) {
+		return -EINVAL;
+	}
+
+	for (i = 0; i < 6; i++) {
+		pdu[1 + i] ^= tmp[i];
+	}
+
+	return 0;
+}
+#endif /* CONFIG_BT_MESH_PRIVACY_KEY_CACHE */
+
 int bt_mesh_net_encrypt(const uint8_t key[16], struct net_buf_simple *buf,
 			uint32_t iv_index, bool proxy)
 {
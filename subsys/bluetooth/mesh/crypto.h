@@ -83,6 +83,16 @@ int bt_mesh_prov_salt(const uint8_t conf_salt[16], const uint8_t prov_rand[16],
 int bt_mesh_net_obfuscate(uint8_t *pdu, uint32_t iv_index,
 			  const uint8_t privacy_key[16]);
 
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+struct tc_aes_key_sched_struct;
+
+int bt_mesh_privacy_key_expand(const uint8_t privacy_key[16],
+			       struct tc_aes_key_sched_struct *sched);
+
+int bt_mesh_net_obfuscate_sched(uint8_t *pdu, uint32_t iv_index,
+				const struct tc_aes_key_sched_struct *sched);
+#endif
+
 int bt_mesh_net_encrypt(const uint8_t key[16], struct net_buf_simple *buf,
 			uint32_t iv_index, bool proxy);
 
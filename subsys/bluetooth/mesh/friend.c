@@ -519,7 +519,7 @@ static int encrypt_friend_pdu(struct bt_mesh_friend *frnd, struct net_buf *buf,
 		return -EINVAL;
 	}
 
-	if (bt_mesh_net_obfuscate(buf->data, iv_index, cred->privacy)) {
+	if (bt_mesh_net_cred_obfuscate(cred, buf->data, iv_index)) {
 		LOG_ERR("Obfuscating failed");
 		return -EINVAL;
 	}
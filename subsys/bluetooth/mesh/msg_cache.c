@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <string.h>
+#include <stdbool.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "msg_cache.h"
+
+/* The cache is a ring of the last received messages, in which the oldest
+ * message is replaced by the new one. Each message is also linked in one of
+ * the hash buckets, so that the cache is searched in a few steps whatever its
+ * size. Indexes are stored plus one, 0 ending a bucket.
+ */
+#define MSG_CACHE_BITS (32 - __builtin_clz(CONFIG_BT_MESH_MSG_CACHE_SIZE - 1))
+#define MSG_CACHE_BUCKETS BIT(MSG_CACHE_BITS)
+
+static struct {
+	uint32_t src : 15, /* MSb of source is always 0 */
+		 seq : 17;
+	uint16_t next;
+} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+static uint16_t msg_cache_next;
+static uint16_t msg_cache_buckets[MSG_CACHE_BUCKETS];
+
+static inline uint32_t msg_cache_hash(uint16_t src, uint32_t seq)
+{
+	uint32_t key = ((uint32_t)src << 17) | (seq & BIT_MASK(17));
+
+	return (key * 0x9e3779b1U) >> (32 - MSG_CACHE_BITS);
+}
+
+static void msg_cache_unlink(uint16_t idx)
+{
+	uint16_t *link = &msg_cache_buckets[msg_cache_hash(msg_cache[idx].src,
+							   msg_cache[idx].seq)];
+
+	while (*link != idx + 1) {
+		link = &msg_cache[*link - 1].next;
+	}
+
+	*link = msg_cache[idx].next;
+}
+
+void bt_mesh_msg_cache_clear(void)
+{
+	(void)memset(msg_cache, 0, sizeof(msg_cache));
+	(void)memset(msg_cache_buckets, 0, sizeof(msg_cache_buckets));
+	msg_cache_next = 0U;
+}
+
+bool bt_mesh_msg_cache_match(uint16_t src, uint32_t seq)
+{
+	uint16_t i;
+
+	seq &= BIT_MASK(17);
+
+	for (i = msg_cache_buckets[msg_cache_hash(src, seq)]; i;
+	     i = msg_cache[i - 1].next) {
+		if (msg_cache[i - 1].src == src && msg_cache[i - 1].seq == seq) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void bt_mesh_msg_cache_add(uint16_t src, uint32_t seq)
+{
+	uint16_t *bucket;
+	uint16_t idx;
+
+	msg_cache_next %= ARRAY_SIZE(msg_cache);
+	idx = msg_cache_next++;
+
+	if (msg_cache[idx].src != BT_MESH_ADDR_UNASSIGNED) {
+		msg_cache_unlink(idx);
+	}
+
+	msg_cache[idx].src = src;
+	msg_cache[idx].seq = seq;
+
+	bucket = &msg_cache_buckets[msg_cache_hash(src, seq)];
+	msg_cache[idx].next = *bucket;
+	*bucket = idx + 1;
+}
+
+void bt_mesh_msg_cache_rewind(void)
+{
+	/* Rewind the next index now that we're not using this entry */
+	uint16_t idx = --msg_cache_next;
+
+	msg_cache_unlink(idx);
+	msg_cache[idx].src = BT_MESH_ADDR_UNASSIGNED;
+}
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @brief Forget all the cached network messages. */
+void bt_mesh_msg_cache_clear(void);
+
+/** @brief Check whether a network message has been seen recently.
+ *
+ *  @param src Source address of the message.
+ *  @param seq Sequence number of the message.
+ *
+ *  @return true if the message is in the cache.
+ */
+bool bt_mesh_msg_cache_match(uint16_t src, uint32_t seq);
+
+/** @brief Add a network message to the cache, evicting the oldest one if the
+ *  cache is full.
+ *
+ *  @param src Source address of the message.
+ *  @param seq Sequence number of the message.
+ */
+void bt_mesh_msg_cache_add(uint16_t src, uint32_t seq);
+
+/** @brief Remove the message added last, so that it is accepted again. */
+void bt_mesh_msg_cache_rewind(void);
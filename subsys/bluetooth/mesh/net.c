@@ -23,6 +23,7 @@
 #include "adv.h"
 #include "mesh.h"
 #include "net.h"
+#include "msg_cache.h"
 #include "rpl.h"
 #include "lpn.h"
 #include "friend.h"
@@ -79,12 +80,6 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-	      seq : 17;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
-
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
 	.local_queue = SYS_SLIST_STATIC_INIT(&bt_mesh.local_queue),
@@ -139,35 +134,6 @@ static bool check_dup(struct net_buf_simple *data)
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
-{
-	uint16_t i;
-
-	for (i = msg_cache_next; i > 0U;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
-	}
-
-	for (i = ARRAY_SIZE(msg_cache); i > msg_cache_next;) {
-		if (msg_cache[--i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
-	}
-
-	return false;
-}
-
-static void msg_cache_add(struct bt_mesh_net_rx *rx)
-{
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
-	msg_cache[msg_cache_next].src = rx->ctx.addr;
-	msg_cache[msg_cache_next].seq = rx->seq;
-	msg_cache_next++;
-}
-
 static void store_iv(bool only_duration)
 {
 	bt_mesh_settings_store_schedule(BT_MESH_SETTINGS_IV_PENDING);
@@ -208,8 +174,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	bt_mesh_msg_cache_clear();
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -466,7 +431,7 @@ static int net_encrypt(struct net_buf_simple *buf,
 		return err;
 	}
 
-	return bt_mesh_net_obfuscate(buf->data, iv_index, cred->privacy);
+	return bt_mesh_net_cred_obfuscate(cred, buf->data, iv_index);
 }
 
 int bt_mesh_net_encode(struct bt_mesh_net_tx *tx, struct net_buf_simple *buf,
@@ -621,8 +586,8 @@ static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	net_buf_simple_reset(out);
 	net_buf_simple_add_mem(out, in->data, in->len);
 
-	if (bt_mesh_net_obfuscate(out->data, BT_MESH_NET_IVI_RX(rx),
-				  cred->privacy)) {
+	if (bt_mesh_net_cred_obfuscate(cred, out->data,
+				       BT_MESH_NET_IVI_RX(rx))) {
 		return false;
 	}
 
@@ -637,7 +602,8 @@ static bool net_decrypt(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 		return false;
 	}
 
-	if (rx->net_if == BT_MESH_NET_IF_ADV && msg_cache_match(out)) {
+	if (rx->net_if == BT_MESH_NET_IF_ADV &&
+	    bt_mesh_msg_cache_match(rx->ctx.addr, SEQ(out->data))) {
 		LOG_DBG("Duplicate found in Network Message Cache");
 		return false;
 	}
@@ -810,7 +776,7 @@ int bt_mesh_net_decode(struct net_buf_simple *in, enum bt_mesh_net_if net_if,
 	LOG_DBG("src 0x%04x dst 0x%04x ttl %u", rx->ctx.addr, rx->ctx.recv_dst, rx->ctx.recv_ttl);
 	LOG_DBG("PDU: %s", bt_hex(out->data, out->len));
 
-	msg_cache_add(rx);
+	bt_mesh_msg_cache_add(rx->ctx.addr, rx->seq);
 
 	return 0;
 }
@@ -859,7 +825,7 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		LOG_WRN("Removing rejected message from Network Message Cache");
 		/* Rewind the next index now that we're not using this entry */
-		msg_cache[--msg_cache_next].src = BT_MESH_ADDR_UNASSIGNED;
+		bt_mesh_msg_cache_rewind();
 		dup_cache[--dup_cache_next] = 0;
 	}
 
@@ -873,6 +839,72 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	}
 }
 
+#if defined(CONFIG_BT_MESH_NET_RX_WORKQ)
+struct net_rx_pdu {
+	int8_t rssi;
+	uint8_t len;
+	uint8_t data[BT_MESH_NET_MAX_PDU_LEN];
+};
+
+K_MSGQ_DEFINE(net_rx_msgq, sizeof(struct net_rx_pdu),
+	      CONFIG_BT_MESH_NET_RX_WORKQ_QUEUE_SIZE, 1);
+static K_KERNEL_STACK_DEFINE(net_rx_stack,
+			     CONFIG_BT_MESH_NET_RX_WORKQ_STACK_SIZE);
+static struct k_work_q net_rx_workq;
+static struct k_work net_rx_work;
+
+static void net_rx_work_handler(struct k_work *work)
+{
+	struct net_buf_simple buf;
+	struct net_rx_pdu pdu;
+
+	/* Handle everything that got queued since the last run in one batch,
+	 * so a burst of PDUs only costs a single work item dispatch.
+	 */
+	while (!k_msgq_get(&net_rx_msgq, &pdu, K_NO_WAIT)) {
+		net_buf_simple_init_with_data(&buf, pdu.data, pdu.len);
+		bt_mesh_net_recv(&buf, pdu.rssi, BT_MESH_NET_IF_ADV);
+	}
+}
+
+void bt_mesh_net_recv_deferred(struct net_buf_simple *data, int8_t rssi)
+{
+	struct net_rx_pdu pdu;
+
+	if (!bt_mesh_is_provisioned()) {
+		return;
+	}
+
+	if (data->len > sizeof(pdu.data)) {
+		LOG_WRN("Dropping too long mesh packet (len %u)", data->len);
+		return;
+	}
+
+	pdu.rssi = rssi;
+	pdu.len = data->len;
+	memcpy(pdu.data, data->data, data->len);
+
+	if (k_msgq_put(&net_rx_msgq, &pdu, K_NO_WAIT)) {
+		LOG_WRN("Network RX queue full, dropping packet");
+		return;
+	}
+
+	k_work_submit_to_queue(&net_rx_workq, &net_rx_work);
+}
+
+static void net_rx_workq_init(void)
+{
+	const struct k_work_queue_config cfg = { .name = "BT Mesh net rx" };
+
+	k_work_init(&net_rx_work, net_rx_work_handler);
+
+	k_work_queue_init(&net_rx_workq);
+	k_work_queue_start(&net_rx_workq, net_rx_stack,
+			   K_KERNEL_STACK_SIZEOF(net_rx_stack),
+			   K_PRIO_COOP(CONFIG_BT_MESH_NET_RX_WORKQ_PRIO), &cfg);
+}
+#endif /* CONFIG_BT_MESH_NET_RX_WORKQ */
+
 static void ivu_refresh(struct k_work *work)
 {
 	if (!bt_mesh_is_provisioned()) {
@@ -919,6 +951,10 @@ void bt_mesh_net_init(void)
 	k_work_init_delayable(&bt_mesh.ivu_timer, ivu_refresh);
 
 	k_work_init(&bt_mesh.local_work, bt_mesh_net_local);
+
+#if defined(CONFIG_BT_MESH_NET_RX_WORKQ)
+	net_rx_workq_init();
+#endif
 }
 
 static int net_set(const char *name, size_t len_rd, settings_read_cb read_cb,
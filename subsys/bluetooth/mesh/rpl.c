@@ -35,7 +35,18 @@ struct rpl_val {
 	      old_iv:1;
 };
 
+/* The RPL entries are found by source address through an open addressing
+ * hash table of entry indexes plus one (0 is an empty bucket), kept at most
+ * half full so that lookups on the RX path take a few probes whatever the
+ * capacity of the RPL.
+ */
+#define RPL_INDEX_BITS (32 - __builtin_clz(2 * CONFIG_BT_MESH_CRPL - 1))
+#define RPL_INDEX_SIZE BIT(RPL_INDEX_BITS)
+
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_index[RPL_INDEX_SIZE];
+/* No free entry below this one */
+static uint16_t rpl_free_hint;
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 static atomic_t clear;
 
@@ -44,6 +55,101 @@ static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 	return rpl - &replay_list[0];
 }
 
+static inline uint32_t rpl_hash(uint16_t src)
+{
+	/* Fibonacci hashing, unicast addresses are often allocated in sequence */
+	return ((uint32_t)src * 0x9e3779b1U) >> (32 - RPL_INDEX_BITS);
+}
+
+static struct bt_mesh_rpl *rpl_index_find(uint16_t src)
+{
+	for (uint32_t i = rpl_hash(src); rpl_index[i];
+	     i = (i + 1) & (RPL_INDEX_SIZE - 1)) {
+		if (replay_list[rpl_index[i] - 1].src == src) {
+			return &replay_list[rpl_index[i] - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	uint32_t i = rpl_hash(rpl->src);
+
+	while (rpl_index[i]) {
+		i = (i + 1) & (RPL_INDEX_SIZE - 1);
+	}
+
+	rpl_index[i] = rpl_idx(rpl) + 1;
+}
+
+static void rpl_index_del(struct bt_mesh_rpl *rpl)
+{
+	uint32_t i = rpl_hash(rpl->src);
+	uint32_t j, home;
+
+	while (rpl_index[i] != rpl_idx(rpl) + 1) {
+		if (!rpl_index[i]) {
+			return;
+		}
+
+		i = (i + 1) & (RPL_INDEX_SIZE - 1);
+	}
+
+	/* Move back the following entries of the probe sequence, so that no
+	 * lookup stops early at the hole.
+	 */
+	for (j = (i + 1) & (RPL_INDEX_SIZE - 1); rpl_index[j];
+	     j = (j + 1) & (RPL_INDEX_SIZE - 1)) {
+		home = rpl_hash(replay_list[rpl_index[j] - 1].src);
+
+		if (((j - home) & (RPL_INDEX_SIZE - 1)) >=
+		    ((j - i) & (RPL_INDEX_SIZE - 1))) {
+			rpl_index[i] = rpl_index[j];
+			i = j;
+		}
+	}
+
+	rpl_index[i] = 0U;
+}
+
+static void rpl_index_rebuild(void)
+{
+	(void)memset(rpl_index, 0, sizeof(rpl_index));
+	rpl_free_hint = 0U;
+
+	for (int i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_index_add(&replay_list[i]);
+		}
+	}
+}
+
+/* Must be called before the entry is cleared */
+static void rpl_index_release(struct bt_mesh_rpl *rpl)
+{
+	if (!rpl->src) {
+		return;
+	}
+
+	rpl_index_del(rpl);
+	rpl_free_hint = MIN(rpl_free_hint, rpl_idx(rpl));
+}
+
+static struct bt_mesh_rpl *rpl_free_entry(void)
+{
+	while (rpl_free_hint < ARRAY_SIZE(replay_list)) {
+		if (!replay_list[rpl_free_hint].src) {
+			return &replay_list[rpl_free_hint];
+		}
+
+		rpl_free_hint++;
+	}
+
+	return NULL;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -61,6 +167,7 @@ static void clear_rpl(struct bt_mesh_rpl *rpl)
 		LOG_DBG("Cleared RPL");
 	}
 
+	rpl_index_release(rpl);
 	(void)memset(rpl, 0, sizeof(*rpl));
 	atomic_clear_bit(store, rpl_idx(rpl));
 }
@@ -88,7 +195,12 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		rpl_index_release(rpl);
+		rpl->src = rx->ctx.addr;
+		rpl_index_add(rpl);
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -105,7 +217,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -117,11 +229,16 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	rpl = rpl_index_find(rx->ctx.addr);
+
+	/* Existing slot for given address */
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -129,31 +246,25 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	/* Empty slot */
+	rpl = rpl_free_entry();
+	if (!rpl) {
+		LOG_ERR("RPL is full!");
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
-		}
+	if (match) {
+		*match = rpl;
+	} else {
+		bt_mesh_rpl_update(rpl, rx);
 	}
 
-	LOG_ERR("RPL is full!");
-	return true;
+	return false;
 }
 
 void bt_mesh_rpl_clear(void)
@@ -162,6 +273,7 @@ void bt_mesh_rpl_clear(void)
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS)) {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_index_rebuild();
 		return;
 	}
 
@@ -172,29 +284,19 @@ void bt_mesh_rpl_clear(void)
 
 static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
 {
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
+	return rpl_index_find(src);
 }
 
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl = rpl_free_entry();
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	if (rpl) {
+		rpl->src = src;
+		rpl_index_add(rpl);
 	}
 
-	return NULL;
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -234,6 +336,9 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	/* The entries have moved */
+	rpl_index_rebuild();
 }
 
 static int rpl_set(const char *name, size_t len_rd,
@@ -255,6 +360,7 @@ static int rpl_set(const char *name, size_t len_rd,
 	if (len_rd == 0) {
 		LOG_DBG("val (null)");
 		if (entry) {
+			rpl_index_release(entry);
 			(void)memset(entry, 0, sizeof(*entry));
 		} else {
 			LOG_WRN("Unable to find RPL entry for 0x%04x", src);
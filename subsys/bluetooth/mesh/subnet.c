@@ -67,11 +67,42 @@ static struct bt_mesh_subnet subnets[CONFIG_BT_MESH_SUBNET_COUNT] = {
 	},
 };
 
+#if defined(CONFIG_BT_MESH_NET_CRED_INDEX)
+#if defined(CONFIG_BT_MESH_FRIEND)
+#define CRED_INDEX_FRND_COUNT (CONFIG_BT_MESH_FRIEND_LPN_COUNT * 2)
+#else
+#define CRED_INDEX_FRND_COUNT 0
+#endif
+#define CRED_INDEX_COUNT (CRED_INDEX_FRND_COUNT + CONFIG_BT_MESH_SUBNET_COUNT * 2)
+
+/* Network credentials bucketed by NID. A credential is referred to by its
+ * position in the walk over all friendship credentials followed by all subnet
+ * credentials, and each bucket keeps that order. The index is rebuilt lazily
+ * on the first lookup after credentials have been created or moved; entries
+ * that have since been deleted or invalidated are skipped on lookup.
+ */
+static struct {
+	uint16_t start[BIT(7) + 1];
+	uint16_t ref[CRED_INDEX_COUNT];
+	bool valid;
+} cred_index;
+
+static void cred_index_invalidate(void)
+{
+	cred_index.valid = false;
+}
+#else
+static inline void cred_index_invalidate(void) {}
+#endif /* CONFIG_BT_MESH_NET_CRED_INDEX */
+
 static void subnet_evt(struct bt_mesh_subnet *sub, enum bt_mesh_key_evt evt)
 {
 	STRUCT_SECTION_FOREACH(bt_mesh_subnet_cb, cb) {
 		cb->evt_handler(sub, evt);
 	}
+
+	/* Handlers may have moved credentials around */
+	cred_index_invalidate();
 }
 
 static void clear_net_key(uint16_t net_idx)
@@ -282,7 +313,20 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 static int msg_cred_create(struct bt_mesh_net_cred *cred, const uint8_t *p,
 			   size_t p_len, const uint8_t key[16])
 {
-	return bt_mesh_k2(key, p, p_len, &cred->nid, cred->enc, cred->privacy);
+	int err;
+
+	cred_index_invalidate();
+
+	err = bt_mesh_k2(key, p, p_len, &cred->nid, cred->enc, cred->privacy);
+	if (err) {
+		return err;
+	}
+
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+	err = bt_mesh_privacy_key_expand(cred->privacy, &cred->privacy_sched);
+#endif
+
+	return err;
 }
 
 static int net_keys_create(struct bt_mesh_subnet_keys *keys,
@@ -708,6 +752,93 @@ void bt_mesh_net_keys_reset(void)
 	}
 }
 
+int bt_mesh_net_cred_obfuscate(const struct bt_mesh_net_cred *cred,
+			       uint8_t *pdu, uint32_t iv_index)
+{
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+	return bt_mesh_net_obfuscate_sched(pdu, iv_index, &cred->privacy_sched);
+#else
+	return bt_mesh_net_obfuscate(pdu, iv_index, cred->privacy);
+#endif
+}
+
+#if defined(CONFIG_BT_MESH_NET_CRED_INDEX)
+/* Resolve a credential index reference, returning NULL if the credential is
+ * not currently valid.
+ */
+static const struct bt_mesh_net_cred *cred_ref_get(uint16_t ref,
+						   struct bt_mesh_subnet **sub,
+						   bool *new_key,
+						   bool *friend_cred)
+{
+	uint16_t j = ref % 2;
+
+	*new_key = (j > 0);
+
+#if defined(CONFIG_BT_MESH_FRIEND)
+	if (ref < CRED_INDEX_FRND_COUNT) {
+		struct bt_mesh_friend *frnd = &bt_mesh.frnd[ref / 2];
+
+		if (!frnd->subnet || !frnd->subnet->keys[j].valid) {
+			return NULL;
+		}
+
+		*sub = frnd->subnet;
+		*friend_cred = true;
+		return &frnd->cred[j];
+	}
+#endif
+
+	ref -= CRED_INDEX_FRND_COUNT;
+	*sub = &subnets[ref / 2];
+	*friend_cred = false;
+
+	if ((*sub)->net_idx == BT_MESH_KEY_UNUSED || !(*sub)->keys[j].valid) {
+		return NULL;
+	}
+
+	return &(*sub)->keys[j].msg;
+}
+
+static void cred_index_build(void)
+{
+	const struct bt_mesh_net_cred *cred;
+	struct bt_mesh_subnet *sub;
+	bool new_key, friend_cred;
+	uint16_t ref;
+	int nid;
+
+	(void)memset(cred_index.start, 0, sizeof(cred_index.start));
+
+	/* Counting sort on the NID, which keeps the walk order in each bucket */
+	for (ref = 0; ref < CRED_INDEX_COUNT; ref++) {
+		cred = cred_ref_get(ref, &sub, &new_key, &friend_cred);
+		if (cred) {
+			cred_index.start[cred->nid + 1]++;
+		}
+	}
+
+	for (nid = 0; nid < BIT(7); nid++) {
+		cred_index.start[nid + 1] += cred_index.start[nid];
+	}
+
+	for (ref = 0; ref < CRED_INDEX_COUNT; ref++) {
+		cred = cred_ref_get(ref, &sub, &new_key, &friend_cred);
+		if (cred) {
+			cred_index.ref[cred_index.start[cred->nid]++] = ref;
+		}
+	}
+
+	/* The placement pass advanced every bucket start to the next one */
+	for (nid = BIT(7); nid > 0; nid--) {
+		cred_index.start[nid] = cred_index.start[nid - 1];
+	}
+
+	cred_index.start[0] = 0;
+	cred_index.valid = true;
+}
+#endif /* CONFIG_BT_MESH_NET_CRED_INDEX */
+
 bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 			   struct net_buf_simple *out,
 			   bool (*cb)(struct bt_mesh_net_rx *rx,
@@ -715,7 +846,9 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 				      struct net_buf_simple *out,
 				      const struct bt_mesh_net_cred *cred))
 {
-	int i, j;
+	__maybe_unused uint8_t nid;
+	__maybe_unused int j;
+	int i;
 
 	LOG_DBG("");
 
@@ -743,6 +876,31 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	}
 #endif
 
+#if defined(CONFIG_BT_MESH_NET_CRED_INDEX)
+	if (!cred_index.valid) {
+		cred_index_build();
+	}
+
+	nid = in->data[0] & BIT_MASK(7);
+
+	for (i = cred_index.start[nid]; i < cred_index.start[nid + 1]; i++) {
+		const struct bt_mesh_net_cred *cred;
+		bool new_key, friend_cred;
+
+		cred = cred_ref_get(cred_index.ref[i], &rx->sub, &new_key,
+				    &friend_cred);
+		if (!cred) {
+			continue;
+		}
+
+		if (cb(rx, in, out, cred)) {
+			rx->new_key = new_key;
+			rx->friend_cred = friend_cred;
+			rx->ctx.net_idx = rx->sub->net_idx;
+			return true;
+		}
+	}
+#else
 #if defined(CONFIG_BT_MESH_FRIEND)
 	/** Each friendship has unique friendship credentials */
 	for (i = 0; i < ARRAY_SIZE(bt_mesh.frnd); i++) {
@@ -788,6 +946,7 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 			}
 		}
 	}
+#endif /* CONFIG_BT_MESH_NET_CRED_INDEX */
 
 	return false;
 }
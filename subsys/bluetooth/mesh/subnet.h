@@ -12,6 +12,10 @@
 #include <zephyr/net/buf.h>
 #include <zephyr/kernel.h>
 
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+#include <tinycrypt/aes.h>
+#endif
+
 #define BT_MESH_NET_FLAG_KR       BIT(0)
 #define BT_MESH_NET_FLAG_IVU      BIT(1)
 
@@ -31,6 +35,10 @@ struct bt_mesh_net_cred {
 	uint8_t nid;         /* NID */
 	uint8_t enc[16];     /* EncKey */
 	uint8_t privacy[16]; /* PrivacyKey */
+#if defined(CONFIG_BT_MESH_PRIVACY_KEY_CACHE)
+	/* Expanded PrivacyKey */
+	struct tc_aes_key_sched_struct privacy_sched;
+#endif
 };
 
 /** Subnet instance. */
@@ -151,7 +159,22 @@ int bt_mesh_friend_cred_create(struct bt_mesh_net_cred *cred,
 			       uint16_t lpn_counter, uint16_t frnd_counter,
 			       const uint8_t key[16]);
 
-/** @brief Iterate through all valid network credentials to decrypt a message.
+/** @brief Obfuscate or deobfuscate a Network PDU header.
+ *
+ *  @param cred Network credentials holding the PrivacyKey.
+ *  @param pdu Network PDU to (de)obfuscate in place.
+ *  @param iv_index IV Index to use.
+ *
+ *  @returns 0 on success, or (negative) error code on failure.
+ */
+int bt_mesh_net_cred_obfuscate(const struct bt_mesh_net_cred *cred,
+			       uint8_t *pdu, uint32_t iv_index);
+
+/** @brief Iterate through the valid network credentials to decrypt a message.
+ *
+ *  Friendship credentials are tried before subnet credentials. Credentials
+ *  whose NID does not match the NID of the message in @c in may be skipped
+ *  without calling the callback.
  *
  *  @param rx Network RX parameters, passed to the callback.
  *  @param in Input message buffer, passed to the callback.
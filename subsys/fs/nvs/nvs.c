@@ -88,6 +88,135 @@ static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t sector)
 
 #endif /* CONFIG_NVS_LOOKUP_CACHE */
 
+#ifdef CONFIG_NVS_RAM_INDEX
+
+/* nvs_index_pos returns the position of id in the index, or the position
+ * where it should be inserted if it is not in the index.
+ */
+static size_t nvs_index_pos(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t lo = 0U, hi = fs->index_cnt, mid;
+
+	while (lo < hi) {
+		mid = lo + (hi - lo) / 2U;
+		if (fs->index[mid].id < id) {
+			lo = mid + 1U;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static uint32_t nvs_index_get(const struct nvs_fs *fs, uint16_t id)
+{
+	size_t pos = nvs_index_pos(fs, id);
+
+	if ((pos < fs->index_cnt) && (fs->index[pos].id == id)) {
+		return fs->index[pos].addr;
+	}
+
+	return NVS_LOOKUP_CACHE_NO_ADDR;
+}
+
+static void nvs_index_set(struct nvs_fs *fs, uint16_t id, uint32_t addr)
+{
+	size_t pos = nvs_index_pos(fs, id);
+
+	if ((pos < fs->index_cnt) && (fs->index[pos].id == id)) {
+		fs->index[pos].addr = addr;
+		return;
+	}
+
+	if (fs->index_cnt == CONFIG_NVS_RAM_INDEX_SIZE) {
+		/* ids missing from the index have to be searched for */
+		fs->index_complete = false;
+		return;
+	}
+
+	memmove(&fs->index[pos + 1], &fs->index[pos],
+		(fs->index_cnt - pos) * sizeof(fs->index[0]));
+	fs->index[pos].id = id;
+	fs->index[pos].addr = addr;
+	fs->index_cnt++;
+}
+
+/* nvs_index_lookup returns in addr the address to start searching for the
+ * most recent ate of id from, or -ENOENT if there is no such ate.
+ */
+static int nvs_index_lookup(struct nvs_fs *fs, uint16_t id, uint32_t *addr)
+{
+	uint32_t ate_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+	int rc = 0;
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* 0xFFFF is a special-purpose identifier and is never indexed */
+	if (id != 0xFFFF) {
+		ate_addr = nvs_index_get(fs, id);
+	}
+
+	if (ate_addr != NVS_LOOKUP_CACHE_NO_ADDR) {
+		*addr = ate_addr;
+	} else if ((id != 0xFFFF) && fs->index_complete) {
+		rc = -ENOENT;
+	} else {
+		*addr = fs->ate_wra;
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+}
+
+static int nvs_index_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	struct nvs_ate ate;
+
+	fs->index_cnt = 0U;
+	fs->index_complete = true;
+	addr = fs->ate_wra;
+
+	while (true) {
+		/* Make a copy of 'addr' as it will be advanced by nvs_prev_ate() */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+
+		if (rc) {
+			return rc;
+		}
+
+		if (ate.id != 0xFFFF && nvs_ate_valid(fs, &ate) &&
+		    nvs_index_get(fs, ate.id) == NVS_LOOKUP_CACHE_NO_ADDR) {
+			nvs_index_set(fs, ate.id, ate_addr);
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+static void nvs_index_invalidate(struct nvs_fs *fs, uint32_t sector)
+{
+	uint32_t i, cnt = 0U;
+
+	for (i = 0U; i < fs->index_cnt; i++) {
+		if ((fs->index[i].addr >> ADDR_SECT_SHIFT) != sector) {
+			fs->index[cnt++] = fs->index[i];
+		}
+	}
+
+	fs->index_cnt = cnt;
+}
+
+#endif /* CONFIG_NVS_RAM_INDEX */
+
 /* basic routines */
 /* nvs_al_size returns size aligned to fs->write_block_size */
 static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
@@ -172,6 +301,14 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 	if (entry->id != 0xFFFF) {
 		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
 	}
+#endif
+#ifdef CONFIG_NVS_RAM_INDEX
+	/* Only index entries that made it to flash, the index is trusted
+	 * to hold the most recent valid ate.
+	 */
+	if (!rc && entry->id != 0xFFFF) {
+		nvs_index_set(fs, entry->id, fs->ate_wra);
+	}
 #endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
@@ -305,6 +442,9 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 
 #ifdef CONFIG_NVS_LOOKUP_CACHE
 	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
+#endif
+#ifdef CONFIG_NVS_RAM_INDEX
+	nvs_index_invalidate(fs, addr >> ADDR_SECT_SHIFT);
 #endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
@@ -576,26 +716,71 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* nvs_ate_latest checks if the valid ate at addr is the most recent valid
+ * ate with its id: returns 1 if it is, 0 if not, errcode on error.
+ */
+static int nvs_ate_latest(struct nvs_fs *fs, uint32_t addr,
+			  const struct nvs_ate *ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+#ifdef CONFIG_NVS_RAM_INDEX
+	uint32_t index_addr = NVS_LOOKUP_CACHE_NO_ADDR;
+
+	if (ate->id != 0xFFFF) {
+		index_addr = nvs_index_get(fs, ate->id);
+		if (fs->index_complete ||
+		    (index_addr != NVS_LOOKUP_CACHE_NO_ADDR)) {
+			return index_addr == addr;
+		}
+	}
+#endif
+
+	wlk_addr = fs->ate_wra;
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	return wlk_prev_addr == addr;
+}
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
+ *
+ * nvs_gc_start sets up gc to walk through the ates of that sector.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, struct nvs_gc_state *gc)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	gc->sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &gc->sec_addr);
+	gc->addr = gc->sec_addr + fs->sector_size - ate_size;
+	gc->stop_addr = gc->addr - ate_size;
+	gc->done = false;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, gc->addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -603,76 +788,89 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		gc->done = true;
+		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
-
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
-	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
-		if (rc) {
-			return rc;
-		}
+		gc->addr &= ADDR_SECT_MASK;
+		gc->addr += close_ate.offset;
+		return 0;
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
-		if (rc) {
-			return rc;
-		}
+	return nvs_recover_last_ate(fs, &gc->addr);
+}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
-		}
+/* nvs_gc_next collects the next ate of the gc'ed sector, its data is moved
+ * to the write sector if it is the most recent data of its id. moved is set
+ * to the space that this took in the write sector.
+ */
+static int nvs_gc_next(struct nvs_fs *fs, struct nvs_gc_state *gc,
+		       size_t *moved)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_prev_addr, data_addr;
+	size_t ate_size, data_size;
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	*moved = 0U;
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+	gc_prev_addr = gc->addr;
+	rc = nvs_prev_ate(fs, &gc->addr, &gc_ate);
+	if (rc) {
+		return rc;
+	}
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	if (gc_prev_addr == gc->stop_addr) {
+		gc->done = true;
+	}
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+	/* deleted items are not copied */
+	if (!nvs_ate_valid(fs, &gc_ate) || !gc_ate.len) {
+		return 0;
+	}
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+	rc = nvs_ate_latest(fs, gc_prev_addr, &gc_ate);
+	if (rc <= 0) {
+		return rc;
+	}
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
-		}
-	} while (gc_prev_addr != stop_addr);
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+
+	data_size = nvs_al_size(fs, gc_ate.len);
+	if (fs->ate_wra < (fs->data_wra + data_size)) {
+		return -ENOSPC;
+	}
 
-gc_done:
+	data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate.offset;
+
+	gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(&gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
+	if (rc) {
+		return rc;
+	}
+
+	rc = nvs_flash_ate_wrt(fs, &gc_ate);
+	if (rc) {
+		return rc;
+	}
+
+	*moved = data_size + ate_size;
+
+	return 0;
+}
+
+static int nvs_gc_finish(struct nvs_fs *fs, struct nvs_gc_state *gc)
+{
+	int rc;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -688,10 +886,171 @@ gc_done:
 	}
 
 	/* Erase the gc'ed sector */
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	return nvs_flash_erase_sector(fs, gc->sec_addr);
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_gc_state gc;
+	size_t moved;
+
+	rc = nvs_gc_start(fs, &gc);
+	while (!rc && !gc.done) {
+		rc = nvs_gc_next(fs, &gc, &moved);
+	}
+
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_gc_finish(fs, &gc);
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+
+/* nvs_gc_begin starts an incremental gc of the sector after the write
+ * sector. The space needed for the data that will be moved is counted in
+ * fs->gc.pending, writes keep this space free until the gc is finished.
+ */
+static int nvs_gc_begin(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_gc_state scan;
+	struct nvs_ate ate;
+	uint32_t ate_addr;
+	size_t ate_size;
+
+	if (!fs->index_complete) {
+		/* finding the data to move takes a walk per ate, do not
+		 * spread it over several writes.
+		 */
+		return nvs_gc(fs);
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	rc = nvs_gc_start(fs, &fs->gc);
+	if (rc) {
+		return rc;
+	}
+
+	fs->gc.pending = 0U;
+	scan = fs->gc;
+	while (!scan.done) {
+		ate_addr = scan.addr;
+		rc = nvs_prev_ate(fs, &scan.addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (ate_addr == scan.stop_addr) {
+			scan.done = true;
+		}
+
+		if (!nvs_ate_valid(fs, &ate) || !ate.len) {
+			continue;
+		}
+
+		rc = nvs_ate_latest(fs, ate_addr, &ate);
+		if (rc < 0) {
+			return rc;
+		}
+		if (rc) {
+			fs->gc.pending += nvs_al_size(fs, ate.len) + ate_size;
+		}
+	}
+
+	fs->gc.active = true;
+
+#ifdef CONFIG_NVS_GC_WORK
+	(void)k_work_submit(&fs->gc_work);
+#endif
+
+	return 0;
+}
+
+/* nvs_gc_step collects at most cnt ates of the pending gc. The gc'ed sector
+ * is only erased, ending the gc, when erase is set.
+ */
+static int nvs_gc_step(struct nvs_fs *fs, uint32_t cnt, bool erase)
+{
+	int rc;
+	size_t moved;
+
+	while (cnt && !fs->gc.done) {
+		rc = nvs_gc_next(fs, &fs->gc, &moved);
+		if (rc) {
+			return rc;
+		}
+		fs->gc.pending -= MIN(moved, fs->gc.pending);
+		cnt--;
+	}
+
+	if (!fs->gc.done || !erase) {
+		return 0;
+	}
+
+	rc = nvs_gc_finish(fs, &fs->gc);
 	if (rc) {
 		return rc;
 	}
+
+	fs->gc.active = false;
+	fs->gc.pending = 0U;
+
+	return 0;
+}
+
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
+
+#ifdef CONFIG_NVS_GC_WORK
+
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+	bool active;
+	int rc = 0;
+
+	do {
+		/* Release the lock after each step to let writes through */
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+		if (fs->ready && fs->gc.active) {
+			rc = nvs_gc_step(fs, CONFIG_NVS_GC_STEP_COUNT, true);
+		}
+		active = fs->ready && fs->gc.active;
+		k_mutex_unlock(&fs->nvs_lock);
+	} while (active && !rc);
+
+	if (rc) {
+		LOG_ERR("Background gc failed: %d", rc);
+	}
+}
+
+#endif /* CONFIG_NVS_GC_WORK */
+
+/* possible data write after last ate write, update data_wra */
+static int nvs_recover_data_wra(struct nvs_fs *fs)
+{
+	int rc;
+	size_t empty_len;
+
+	while (fs->ate_wra > fs->data_wra) {
+		empty_len = fs->ate_wra - fs->data_wra;
+
+		rc = nvs_flash_cmp_const(fs, fs->data_wra,
+					 fs->flash_parameters->erase_value,
+					 empty_len);
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
+			break;
+		}
+
+		fs->data_wra += fs->flash_parameters->write_block_size;
+	}
+
 	return 0;
 }
 
@@ -699,7 +1058,7 @@ static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate last_ate;
-	size_t ate_size, empty_len;
+	size_t ate_size;
 	/* Initialize addr to 0 for the case fs->sector_count == 0. This
 	 * should never happen as this is verified in nvs_mount() but both
 	 * Coverity and GCC believe the contrary.
@@ -710,6 +1069,15 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_RAM_INDEX
+	fs->index_cnt = 0U;
+	fs->index_complete = false;
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.active = false;
+	fs->gc.pending = 0U;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can write.
@@ -846,6 +1214,21 @@ static int nvs_startup(struct nvs_fs *fs)
 			rc = nvs_flash_erase_sector(fs, addr);
 			goto end;
 		}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		/* Entries may have been written next to the moved ones while
+		 * gc was in progress, resume gc instead of restarting it.
+		 * Data that was already moved is not moved again.
+		 */
+		LOG_INF("No GC Done marker found: resuming gc");
+		rc = nvs_recover_data_wra(fs);
+		if (rc) {
+			goto end;
+		}
+		rc = nvs_index_rebuild(fs);
+		if (rc) {
+			goto end;
+		}
+#else
 		LOG_INF("No GC Done marker found: restarting gc");
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
@@ -854,24 +1237,14 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra &= ADDR_SECT_MASK;
 		fs->ate_wra += (fs->sector_size - 2 * ate_size);
 		fs->data_wra = (fs->ate_wra & ADDR_SECT_MASK);
+#endif
 		rc = nvs_gc(fs);
 		goto end;
 	}
 
-	/* possible data write after last ate write, update data_wra */
-	while (fs->ate_wra > fs->data_wra) {
-		empty_len = fs->ate_wra - fs->data_wra;
-
-		rc = nvs_flash_cmp_const(fs, fs->data_wra, erase_value,
-				empty_len);
-		if (rc < 0) {
-			goto end;
-		}
-		if (!rc) {
-			break;
-		}
-
-		fs->data_wra += fs->flash_parameters->write_block_size;
+	rc = nvs_recover_data_wra(fs);
+	if (rc) {
+		goto end;
 	}
 
 	/* If the ate_wra is pointing to the first ate write location in a
@@ -893,6 +1266,11 @@ end:
 	if (!rc) {
 		rc = nvs_lookup_cache_rebuild(fs);
 	}
+#endif
+#ifdef CONFIG_NVS_RAM_INDEX
+	if (!rc) {
+		rc = nvs_index_rebuild(fs);
+	}
 #endif
 	/* If the sector is empty add a gc done ate to avoid having insufficient
 	 * space when doing gc.
@@ -916,18 +1294,36 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	fs->gc.active = false;
+	k_mutex_unlock(&fs->nvs_lock);
+#endif
+#ifdef CONFIG_NVS_GC_WORK
+	/* The handler stops at its next step now that the gc is inactive,
+	 * wait for it before erasing the sectors it works on.
+	 */
+	(void)k_work_cancel_sync(&fs->gc_work, &fs->gc_sync);
+#endif
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
 		if (rc) {
-			return rc;
+			goto end;
 		}
 	}
 
 	/* nvs needs to be reinitialized after clearing */
 	fs->ready = false;
+	rc = 0;
 
-	return 0;
+end:
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
 }
 
 int nvs_mount(struct nvs_fs *fs)
@@ -937,7 +1333,23 @@ int nvs_mount(struct nvs_fs *fs)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_WORK
+	/* On a remount the background gc of the previous mount may still be
+	 * queued or running. Stop it before its work item and the lock it
+	 * takes are initialized again.
+	 */
+	if (k_work_busy_get(&fs->gc_work)) {
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+		fs->ready = false;
+		k_mutex_unlock(&fs->nvs_lock);
+		(void)k_work_cancel_sync(&fs->gc_work, &fs->gc_sync);
+	}
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
+#ifdef CONFIG_NVS_GC_WORK
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
 	if (fs->flash_parameters == NULL) {
@@ -992,7 +1404,7 @@ int nvs_mount(struct nvs_fs *fs)
 ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 {
 	int rc, gc_count;
-	size_t ate_size, data_size;
+	size_t ate_size, data_size, reserved_space = 0U;
 	struct nvs_ate wlk_ate;
 	uint32_t wlk_addr, rd_addr;
 	uint16_t required_space = 0U; /* no space, appropriate for delete ate */
@@ -1017,9 +1429,14 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 
 	/* find latest entry with same id */
 	wlk_addr = fs->ate_wra;
+#ifdef CONFIG_NVS_RAM_INDEX
+	rc = nvs_index_lookup(fs, id, &wlk_addr);
+#else
+	rc = 0;
+#endif
 	rd_addr = wlk_addr;
 
-	while (1) {
+	while (rc == 0) {
 		rd_addr = wlk_addr;
 		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
 		if (rc) {
@@ -1080,7 +1497,21 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			goto end;
 		}
 
-		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		if (fs->gc.active) {
+			/* Move a few entries of the pending gc, the gc'ed
+			 * sector is erased by the work item if there is one.
+			 */
+			rc = nvs_gc_step(fs, CONFIG_NVS_GC_STEP_COUNT,
+					 !IS_ENABLED(CONFIG_NVS_GC_WORK));
+			if (rc) {
+				goto end;
+			}
+		}
+		reserved_space = fs->gc.active ? fs->gc.pending : 0U;
+#endif
+
+		if (fs->ate_wra >= (fs->data_wra + required_space + reserved_space)) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
 			if (rc) {
@@ -1089,13 +1520,29 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			break;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		if (fs->gc.active) {
+			/* The space left is needed by the pending gc, finish
+			 * it before closing the sector.
+			 */
+			rc = nvs_gc_step(fs, UINT32_MAX, true);
+			if (rc) {
+				goto end;
+			}
+			continue;
+		}
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		rc = nvs_gc_begin(fs);
+#else
 		rc = nvs_gc(fs);
+#endif
 		if (rc) {
 			goto end;
 		}
@@ -1141,6 +1588,11 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 		rc = -ENOENT;
 		goto err;
 	}
+#elif defined(CONFIG_NVS_RAM_INDEX)
+	rc = nvs_index_lookup(fs, id, &wlk_addr);
+	if (rc) {
+		goto err;
+	}
 #else
 	wlk_addr = fs->ate_wra;
 #endif
@@ -17,6 +17,17 @@ backend = FS
 backend-str = fs
 source "subsys/logging/Kconfig.template.log_format_config"
 
+config LOG_BACKEND_FS_DICT_FRAMED
+	bool "Frame dictionary based output"
+	default y
+	help
+	  When enabled and the backend uses dictionary based output, each log
+	  message is written as a frame carrying a sequence number and the
+	  total number of dropped messages. Framed log files can be decoded
+	  while they are still growing with
+	  scripts/logging/dictionary/log_parser_stream.py. When disabled, raw
+	  dictionary based records are written as by the UART backend.
+
 config LOG_BACKEND_FS_AUTOSTART
 	bool "Automatically start fs backend"
 	default y
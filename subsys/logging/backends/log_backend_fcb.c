@@ -0,0 +1,918 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Log messages are packed into a RAM block as self-contained cbprintf
+ * packages, along with their source ID and timestamp, and are only formatted
+ * when fetched. A full block, or one which has not been flushed for a while,
+ * is compressed and appended to a flash circular buffer as one element. Each
+ * element starts with a header holding the time span and the levels of the
+ * messages in it, and a RAM index keeps the same summary per flash sector, so
+ * that fetching a time window only reads and decompresses the blocks which
+ * may hold matching messages. When the flash is full the oldest sector is
+ * erased, which spreads the wear over the whole partition.
+ */
+
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_backend_fcb.h>
+#include <zephyr/logging/log_core.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/cbprintf.h>
+#include <zephyr/sys/util.h>
+
+#if DT_HAS_CHOSEN(zephyr_log_partition)
+#define LOG_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_log_partition))
+#else
+#define LOG_PARTITION FIXED_PARTITION_ID(storage_partition)
+#endif
+
+#define LOG_FCB_VERSION 2
+#define BLOCK_SIZE CONFIG_LOG_BACKEND_FCB_BLOCK_SIZE
+#define MAX_MSG_LEN CONFIG_LOG_BACKEND_FCB_MAX_MSG_LEN
+#define NUM_SECTORS CONFIG_LOG_BACKEND_FCB_NUM_SECTORS
+
+/* Flash write block sizes up to this value are supported. */
+#define MAX_WRITE_ALIGN 16
+
+#define BLOCK_FLAG_COMPRESSED BIT(0)
+
+/* Strings are copied into the stored package so it can be formatted later. */
+#define PKG_CONVERT_FLAGS (CBPRINTF_PACKAGE_CONVERT_RO_STR | \
+			   CBPRINTF_PACKAGE_CONVERT_RW_STR)
+
+/* Header of a block, stored at the start of each FCB element. */
+struct block_hdr {
+	uint8_t version;
+	uint8_t flags;
+	uint16_t boot;
+	uint16_t raw_len;
+	uint16_t stored_len;
+	uint16_t msg_cnt;
+	uint8_t level_mask;
+	uint8_t reserved;
+	uint32_t first_ms;
+	uint32_t last_ms;
+} __packed;
+
+/*
+ * Header of a message within an uncompressed block. It is followed by the
+ * cbprintf package, or by the formatted text if the package was too long
+ * (text set), and then by the hexdump data.
+ */
+struct rec_hdr {
+	uint32_t timestamp_ms;
+	uint16_t source_id;
+	uint8_t level: 3;
+	uint8_t domain_id: 3;
+	uint8_t text: 1;
+	uint8_t reserved: 1;
+	uint8_t msg_len;
+	uint8_t data_len;
+} __packed;
+
+/* Time span of the blocks stored in a flash sector. */
+struct sector_idx {
+	uint64_t first;
+	uint64_t last;
+	uint8_t level_mask;
+	bool used;
+};
+
+BUILD_ASSERT(sizeof(struct block_hdr) + BLOCK_SIZE <= FCB_MAX_LEN);
+BUILD_ASSERT(sizeof(struct rec_hdr) + MAX_MSG_LEN <= BLOCK_SIZE,
+	     "Block must fit a message of maximum length");
+BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
+	     "Immediate logging is not supported by LOG FCB backend.");
+
+static struct flash_sector fcb_sectors[NUM_SECTORS];
+static struct fcb log_fcb = {
+	.f_magic = CONFIG_LOG_BACKEND_FCB_MAGIC,
+	.f_version = LOG_FCB_VERSION,
+	.f_sectors = fcb_sectors,
+};
+static struct sector_idx sector_idx[NUM_SECTORS];
+
+/* Protects the RAM block, the index and the FCB position. */
+static K_MUTEX_DEFINE(lock);
+static bool storage_ready;
+static bool storage_failed;
+static bool panic_mode;
+static uint16_t boot;
+static struct log_backend_fcb_stats stats;
+
+/* Block being filled. */
+static uint8_t block[BLOCK_SIZE];
+static struct block_hdr block_hdr;
+static size_t block_len;
+
+/* Block header and payload as written to flash. */
+static uint8_t __aligned(4) flash_buf[ROUND_UP(sizeof(struct block_hdr) + BLOCK_SIZE,
+					       MAX_WRITE_ALIGN)];
+
+/* Block read back from flash and decompressed when fetching. */
+static uint8_t fetch_raw[BLOCK_SIZE];
+
+/* Package of a fetched message, aligned for formatting, and its text. */
+static uint8_t __aligned(CBPRINTF_PACKAGE_ALIGNMENT) fetch_pkg[MAX_MSG_LEN];
+static char fetch_text[MAX_MSG_LEN];
+
+static inline uint64_t idx_key(uint16_t boot_nr, uint32_t ms)
+{
+	return ((uint64_t)boot_nr << 32) | ms;
+}
+
+static inline struct sector_idx *sector_idx_get(struct flash_sector *sector)
+{
+	return &sector_idx[sector - fcb_sectors];
+}
+
+static void sector_idx_update(struct flash_sector *sector, const struct block_hdr *hdr)
+{
+	struct sector_idx *idx = sector_idx_get(sector);
+
+	/* Blocks are appended in time order, so the first one sets the start. */
+	if (!idx->used) {
+		idx->first = idx_key(hdr->boot, hdr->first_ms);
+		idx->level_mask = 0;
+		idx->used = true;
+	}
+
+	idx->last = idx_key(hdr->boot, hdr->last_ms);
+	idx->level_mask |= hdr->level_mask;
+}
+
+/*
+ * LZSS compression. Every group of up to eight items is preceded by a flag
+ * byte where a set bit marks a back reference and a cleared bit a literal.
+ * A back reference takes two bytes: a 12 bit distance and a 4 bit length.
+ */
+#define LZ_MIN_MATCH 3
+#define LZ_MAX_MATCH (LZ_MIN_MATCH + 15)
+#define LZ_WINDOW 4096
+#define LZ_HASH_BITS 8
+
+BUILD_ASSERT(BLOCK_SIZE < UINT16_MAX);
+
+/* Last position + 1 of each hashed 3 byte sequence, 0 if none. */
+static uint16_t lz_hash_tbl[BIT(LZ_HASH_BITS)];
+
+static inline uint32_t lz_hash(const uint8_t *p)
+{
+	uint32_t v = ((uint32_t)p[0] << 16) | ((uint32_t)p[1] << 8) | p[2];
+
+	return (v * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+/* Returns compressed length or 0 if the result does not fit in @p out_size. */
+static size_t lz_compress(const uint8_t *in, size_t len, uint8_t *out, size_t out_size)
+{
+	size_t ip = 0;
+	size_t op = 0;
+	size_t flag_pos = 0;
+	uint8_t bit = 8;
+
+	memset(lz_hash_tbl, 0, sizeof(lz_hash_tbl));
+
+	while (ip < len) {
+		size_t mlen = 0;
+		size_t dist = 0;
+
+		if (bit == 8) {
+			if (op >= out_size) {
+				return 0;
+			}
+			flag_pos = op++;
+			out[flag_pos] = 0;
+			bit = 0;
+		}
+
+		if ((ip + LZ_MIN_MATCH) <= len) {
+			uint32_t h = lz_hash(&in[ip]);
+			size_t cand = lz_hash_tbl[h];
+
+			lz_hash_tbl[h] = (uint16_t)(ip + 1);
+			if ((cand != 0U) && ((ip - (cand - 1)) <= LZ_WINDOW)) {
+				size_t max = MIN(LZ_MAX_MATCH, len - ip);
+
+				cand--;
+				while ((mlen < max) && (in[cand + mlen] == in[ip + mlen])) {
+					mlen++;
+				}
+				dist = ip - cand;
+			}
+		}
+
+		if (mlen >= LZ_MIN_MATCH) {
+			if ((op + 2) > out_size) {
+				return 0;
+			}
+			out[flag_pos] |= BIT(bit);
+			out[op++] = (uint8_t)((dist - 1) >> 4);
+			out[op++] = (uint8_t)((((dist - 1) & 0xF) << 4) | (mlen - LZ_MIN_MATCH));
+			ip += mlen;
+		} else {
+			if (op >= out_size) {
+				return 0;
+			}
+			out[op++] = in[ip++];
+		}
+
+		bit++;
+	}
+
+	return op;
+}
+
+static int lz_decompress(const uint8_t *in, size_t len, uint8_t *out, size_t out_size)
+{
+	size_t ip = 0;
+	size_t op = 0;
+	uint8_t flags = 0;
+	uint8_t bit = 8;
+
+	while (ip < len) {
+		if (bit == 8) {
+			flags = in[ip++];
+			bit = 0;
+			continue;
+		}
+
+		if (flags & BIT(bit)) {
+			size_t dist, mlen;
+
+			if ((ip + 2) > len) {
+				return -EIO;
+			}
+
+			dist = (((size_t)in[ip] << 4) | (in[ip + 1] >> 4)) + 1;
+			mlen = (in[ip + 1] & 0xF) + LZ_MIN_MATCH;
+			ip += 2;
+
+			if ((dist > op) || ((op + mlen) > out_size)) {
+				return -EIO;
+			}
+
+			/* Byte by byte as the reference may overlap the output. */
+			for (size_t i = 0; i < mlen; i++, op++) {
+				out[op] = out[op - dist];
+			}
+		} else {
+			if (op >= out_size) {
+				return -EIO;
+			}
+			out[op++] = in[ip++];
+		}
+
+		bit++;
+	}
+
+	return (int)op;
+}
+
+static int idx_build_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
+{
+	struct block_hdr hdr;
+	int rc;
+
+	ARG_UNUSED(arg);
+
+	rc = flash_area_read(entry_ctx->fap, FCB_ENTRY_FA_DATA_OFF(entry_ctx->loc),
+			     &hdr, sizeof(hdr));
+	if ((rc != 0) || (hdr.version != LOG_FCB_VERSION)) {
+		return 0;
+	}
+
+	sector_idx_update(entry_ctx->loc.fe_sector, &hdr);
+
+	if ((uint16_t)(hdr.boot + 1) > boot) {
+		boot = hdr.boot + 1;
+	}
+
+	return 0;
+}
+
+static int storage_init(void)
+{
+	const struct flash_area *fap;
+	uint32_t cnt = ARRAY_SIZE(fcb_sectors);
+	int rc;
+
+	if (storage_ready) {
+		return 0;
+	}
+
+	if (storage_failed) {
+		return -ENODEV;
+	}
+
+	rc = flash_area_get_sectors(LOG_PARTITION, &cnt, fcb_sectors);
+	if ((rc != 0) && (rc != -ENOMEM)) {
+		goto fail;
+	}
+
+	log_fcb.f_sector_cnt = (uint8_t)cnt;
+
+	rc = fcb_init(LOG_PARTITION, &log_fcb);
+	if (rc != 0) {
+		/* Not a log storage yet or corrupted beyond repair, start over. */
+		rc = flash_area_open(LOG_PARTITION, &fap);
+		if (rc != 0) {
+			goto fail;
+		}
+
+		rc = flash_area_erase(fap, 0, fap->fa_size);
+		flash_area_close(fap);
+		if (rc != 0) {
+			goto fail;
+		}
+
+		rc = fcb_init(LOG_PARTITION, &log_fcb);
+		if (rc != 0) {
+			goto fail;
+		}
+	}
+
+	if (log_fcb.f_align > MAX_WRITE_ALIGN) {
+		rc = -ENOTSUP;
+		goto fail;
+	}
+
+	memset(sector_idx, 0, sizeof(sector_idx));
+	boot = 0;
+	(void)fcb_walk(&log_fcb, NULL, idx_build_cb, NULL);
+
+	storage_ready = true;
+
+	return 0;
+
+fail:
+	storage_failed = true;
+
+	return rc;
+}
+
+static int block_write(const uint8_t *data, size_t len)
+{
+	struct fcb_entry loc;
+	size_t flash_len = ROUND_UP(len, log_fcb.f_align);
+	int rc;
+
+	memset(&flash_buf[len], 0, flash_len - len);
+
+	rc = fcb_append(&log_fcb, (uint16_t)flash_len, &loc);
+	if (rc == -ENOSPC) {
+		/* Erase the oldest sector and drop it from the index. */
+		sector_idx_get(log_fcb.f_oldest)->used = false;
+
+		rc = fcb_rotate(&log_fcb);
+		if (rc == 0) {
+			rc = fcb_append(&log_fcb, (uint16_t)flash_len, &loc);
+		}
+	}
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = flash_area_write(log_fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc), data, flash_len);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = fcb_append_finish(&log_fcb, &loc);
+	if (rc != 0) {
+		return rc;
+	}
+
+	sector_idx_update(loc.fe_sector, &block_hdr);
+
+	return 0;
+}
+
+/* Compress and store the current block. Called with the lock held. */
+static void block_flush(void)
+{
+	size_t stored_len;
+
+	if (block_len == 0) {
+		return;
+	}
+
+	if (storage_init() != 0) {
+		stats.dropped += block_hdr.msg_cnt;
+		goto out;
+	}
+
+	block_hdr.version = LOG_FCB_VERSION;
+	block_hdr.boot = boot;
+	block_hdr.raw_len = (uint16_t)block_len;
+
+	stored_len = IS_ENABLED(CONFIG_LOG_BACKEND_FCB_COMPRESSION) ?
+		     lz_compress(block, block_len, &flash_buf[sizeof(block_hdr)],
+				 block_len - 1) : 0;
+	if (stored_len != 0) {
+		block_hdr.flags = BLOCK_FLAG_COMPRESSED;
+	} else {
+		/* Not compressible, store it as is. */
+		block_hdr.flags = 0;
+		stored_len = block_len;
+		memcpy(&flash_buf[sizeof(block_hdr)], block, block_len);
+	}
+
+	block_hdr.stored_len = (uint16_t)stored_len;
+	memcpy(flash_buf, &block_hdr, sizeof(block_hdr));
+
+	if (block_write(flash_buf, sizeof(block_hdr) + stored_len) == 0) {
+		stats.blocks++;
+		stats.raw_bytes += block_len;
+		stats.stored_bytes += stored_len;
+	} else {
+		stats.dropped += block_hdr.msg_cnt;
+	}
+
+out:
+	block_len = 0;
+	memset(&block_hdr, 0, sizeof(block_hdr));
+}
+
+static void flush_work_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+	block_flush();
+	k_mutex_unlock(&lock);
+}
+
+static K_WORK_DELAYABLE_DEFINE(flush_work, flush_work_handler);
+
+struct text_ctx {
+	char *buf;
+	size_t len;
+	size_t max;
+};
+
+static int text_out(int c, void *ctx)
+{
+	struct text_ctx *text = ctx;
+
+	if (text->len < text->max) {
+		text->buf[text->len++] = (char)c;
+	}
+
+	return 0;
+}
+
+static size_t pkg_format(char *buf, size_t max, void *package)
+{
+	struct text_ctx text = {
+		.buf = buf,
+		.max = max,
+	};
+
+	(void)cbpprintf(text_out, &text, package);
+
+	return text.len;
+}
+
+/*
+ * Store @p package at @p dst with all its strings copied into it. A package
+ * which does not fit is formatted and truncated instead. Returns the number
+ * of bytes used.
+ */
+static size_t pkg_store(struct rec_hdr *rec, uint8_t *dst, uint8_t *package, size_t plen)
+{
+	uint16_t strl[4];
+	int len;
+
+	len = cbprintf_package_copy(package, plen, NULL, 0, PKG_CONVERT_FLAGS,
+				    strl, ARRAY_SIZE(strl));
+	if ((len > 0) && (len <= MAX_MSG_LEN)) {
+		len = cbprintf_package_copy(package, plen, dst, MAX_MSG_LEN,
+					    PKG_CONVERT_FLAGS, strl, ARRAY_SIZE(strl));
+		if (len > 0) {
+			return len;
+		}
+	}
+
+	rec->text = 1;
+
+	return pkg_format((char *)dst, MAX_MSG_LEN, package);
+}
+
+static void block_add(struct log_msg *msg)
+{
+	uint8_t level = log_msg_get_level(msg);
+	uint8_t domain_id = log_msg_get_domain(msg);
+	void *source = (void *)log_msg_get_source(msg);
+	uint32_t ms = (uint32_t)(log_output_timestamp_to_us(log_msg_get_timestamp(msg)) /
+				 USEC_PER_MSEC);
+	struct rec_hdr rec = {
+		.timestamp_ms = ms,
+		.source_id = LOG_BACKEND_FCB_NO_SOURCE,
+		.level = level,
+		.domain_id = domain_id,
+	};
+	size_t plen, dlen;
+	size_t len = 0;
+	uint8_t *package = log_msg_get_package(msg, &plen);
+	uint8_t *data = log_msg_get_data(msg, &dlen);
+
+	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && (domain_id != Z_LOG_LOCAL_DOMAIN_ID)) {
+		/* Remote domain is converting source pointer to ID */
+		rec.source_id = (uint16_t)(uintptr_t)source;
+	} else if (source != NULL) {
+		rec.source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+				log_dynamic_source_id(source) :
+				log_const_source_id(source);
+	}
+
+	if ((block_len + sizeof(rec) + MAX_MSG_LEN) > BLOCK_SIZE) {
+		block_flush();
+	}
+
+	if (plen > 0) {
+		len = pkg_store(&rec, &block[block_len + sizeof(rec)], package, plen);
+	}
+
+	rec.msg_len = (uint8_t)len;
+	rec.data_len = (uint8_t)MIN(dlen, MAX_MSG_LEN - len);
+	if (rec.data_len > 0) {
+		memcpy(&block[block_len + sizeof(rec) + len], data, rec.data_len);
+	}
+	memcpy(&block[block_len], &rec, sizeof(rec));
+
+	if (block_hdr.msg_cnt == 0) {
+		block_hdr.first_ms = ms;
+		if (!panic_mode) {
+			k_work_schedule(&flush_work,
+					K_MSEC(CONFIG_LOG_BACKEND_FCB_FLUSH_TIMEOUT_MS));
+		}
+	}
+
+	block_hdr.last_ms = ms;
+	block_hdr.level_mask |= BIT(level);
+	block_hdr.msg_cnt++;
+	block_len += sizeof(rec) + rec.msg_len + rec.data_len;
+}
+
+static void process(const struct log_backend *const backend,
+		    union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	if (panic_mode) {
+		/* Nothing else runs, store each message right away. */
+		block_add(&msg->log);
+		block_flush();
+		return;
+	}
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+	block_add(&msg->log);
+	k_mutex_unlock(&lock);
+}
+
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	stats.dropped += cnt;
+}
+
+static void panic(struct log_backend const *const backend)
+{
+	ARG_UNUSED(backend);
+
+	panic_mode = true;
+	(void)k_work_cancel_delayable(&flush_work);
+	block_flush();
+}
+
+struct fetch_ctx {
+	uint64_t from;
+	uint64_t to;
+	uint8_t level_mask;
+	log_backend_fcb_fetch_cb_t cb;
+	void *user_data;
+	int err;
+};
+
+static int fetch_block(const struct block_hdr *hdr, const uint8_t *raw, size_t raw_len,
+		       struct fetch_ctx *ctx)
+{
+	struct log_backend_fcb_record record = {
+		.boot = hdr->boot,
+	};
+	struct rec_hdr rec;
+	size_t off = 0;
+	uint64_t key;
+	int rc;
+
+	while ((off + sizeof(rec)) <= raw_len) {
+		memcpy(&rec, &raw[off], sizeof(rec));
+		off += sizeof(rec);
+
+		if ((off + rec.msg_len + rec.data_len) > raw_len) {
+			return -EIO;
+		}
+
+		key = idx_key(hdr->boot, rec.timestamp_ms);
+		if ((key >= ctx->from) && (key <= ctx->to) &&
+		    (ctx->level_mask & BIT(rec.level))) {
+			record.domain_id = rec.domain_id;
+			record.level = rec.level;
+			record.source_id = rec.source_id;
+			record.timestamp_ms = rec.timestamp_ms;
+			if (rec.text || (rec.msg_len == 0)) {
+				record.text = (const char *)&raw[off];
+				record.text_len = rec.msg_len;
+			} else {
+				union cbprintf_package_hdr *pkg_hdr = (void *)fetch_pkg;
+
+				memcpy(fetch_pkg, &raw[off], rec.msg_len);
+				if ((pkg_hdr->desc.len * sizeof(int)) > rec.msg_len) {
+					return -EIO;
+				}
+
+				record.text = fetch_text;
+				record.text_len = pkg_format(fetch_text, sizeof(fetch_text),
+							     fetch_pkg);
+			}
+			record.data = &raw[off + rec.msg_len];
+			record.data_len = rec.data_len;
+
+			rc = ctx->cb(&record, ctx->user_data);
+			if (rc != 0) {
+				return rc;
+			}
+		}
+
+		off += rec.msg_len + rec.data_len;
+	}
+
+	return 0;
+}
+
+static int fetch_cb(struct fcb_entry_ctx *entry_ctx, void *arg)
+{
+	struct fetch_ctx *ctx = arg;
+	off_t off = FCB_ENTRY_FA_DATA_OFF(entry_ctx->loc);
+	struct block_hdr hdr;
+	int rc;
+
+	rc = flash_area_read(entry_ctx->fap, off, &hdr, sizeof(hdr));
+	if (rc != 0) {
+		ctx->err = -EIO;
+		return 1;
+	}
+
+	/* Decide from the header alone if the block is worth reading. */
+	if ((hdr.version != LOG_FCB_VERSION) ||
+	    (idx_key(hdr.boot, hdr.last_ms) < ctx->from) ||
+	    (idx_key(hdr.boot, hdr.first_ms) > ctx->to) ||
+	    !(hdr.level_mask & ctx->level_mask)) {
+		return 0;
+	}
+
+	if ((hdr.raw_len > BLOCK_SIZE) || (hdr.stored_len > hdr.raw_len) ||
+	    ((sizeof(hdr) + hdr.stored_len) > entry_ctx->loc.fe_data_len)) {
+		ctx->err = -EIO;
+		return 1;
+	}
+
+	/* The write buffer is free while the lock is held. */
+	if (hdr.flags & BLOCK_FLAG_COMPRESSED) {
+		rc = flash_area_read(entry_ctx->fap, off + sizeof(hdr), flash_buf,
+				     hdr.stored_len);
+		if (rc == 0) {
+			rc = lz_decompress(flash_buf, hdr.stored_len, fetch_raw, hdr.raw_len);
+			rc = (rc == hdr.raw_len) ? 0 : -EIO;
+		}
+	} else {
+		rc = flash_area_read(entry_ctx->fap, off + sizeof(hdr), fetch_raw, hdr.raw_len);
+	}
+
+	if (rc != 0) {
+		ctx->err = -EIO;
+		return 1;
+	}
+
+	rc = fetch_block(&hdr, fetch_raw, hdr.raw_len, ctx);
+	if (rc != 0) {
+		ctx->err = rc;
+		return 1;
+	}
+
+	return 0;
+}
+
+int log_backend_fcb_fetch(uint16_t boot_nr, uint32_t from_ms, uint32_t to_ms,
+			  uint8_t max_level, log_backend_fcb_fetch_cb_t cb,
+			  void *user_data)
+{
+	struct fetch_ctx ctx = {
+		.from = idx_key(boot_nr, from_ms),
+		.to = idx_key(boot_nr, to_ms),
+		.level_mask = (uint8_t)BIT_MASK(max_level + 1),
+		.cb = cb,
+		.user_data = user_data,
+	};
+	struct flash_sector *sector;
+	struct sector_idx *idx;
+	int rc;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	block_flush();
+
+	rc = storage_init();
+	if (rc != 0) {
+		k_mutex_unlock(&lock);
+		return -ENODEV;
+	}
+
+	sector = log_fcb.f_oldest;
+	for (int i = 0; (i < log_fcb.f_sector_cnt) && (ctx.err == 0); i++) {
+		idx = sector_idx_get(sector);
+
+		if (idx->used && (idx->last >= ctx.from) && (idx->first <= ctx.to) &&
+		    (idx->level_mask & ctx.level_mask)) {
+			(void)fcb_walk(&log_fcb, sector, fetch_cb, &ctx);
+		}
+
+		if (sector == log_fcb.f_active.fe_sector) {
+			break;
+		}
+
+		sector = (sector == &fcb_sectors[log_fcb.f_sector_cnt - 1]) ?
+			 &fcb_sectors[0] : sector + 1;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return ctx.err;
+}
+
+uint16_t log_backend_fcb_boot_get(void)
+{
+	uint16_t boot_nr;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+	(void)storage_init();
+	boot_nr = boot;
+	k_mutex_unlock(&lock);
+
+	return boot_nr;
+}
+
+int log_backend_fcb_clear(void)
+{
+	int rc;
+
+	(void)k_mutex_lock(&lock, K_FOREVER);
+
+	block_len = 0;
+	memset(&block_hdr, 0, sizeof(block_hdr));
+
+	rc = storage_init();
+	if (rc == 0) {
+		rc = fcb_clear(&log_fcb);
+		memset(sector_idx, 0, sizeof(sector_idx));
+	} else {
+		rc = -ENODEV;
+	}
+
+	k_mutex_unlock(&lock);
+
+	return rc;
+}
+
+void log_backend_fcb_stats_get(struct log_backend_fcb_stats *out)
+{
+	(void)k_mutex_lock(&lock, K_FOREVER);
+	*out = stats;
+	k_mutex_unlock(&lock);
+}
+
+static const struct log_backend_api log_backend_fcb_api = {
+	.process = process,
+	.panic = panic,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(log_backend_fcb, log_backend_fcb_api,
+		   IS_ENABLED(CONFIG_LOG_BACKEND_FCB_AUTOSTART));
+
+#if defined(CONFIG_LOG_BACKEND_FCB_SHELL)
+#include <zephyr/shell/shell.h>
+
+static const char *const level_str[] = { "", "err", "wrn", "inf", "dbg" };
+
+static int shell_print_record(const struct log_backend_fcb_record *record, void *user_data)
+{
+	const struct shell *sh = user_data;
+	uint32_t ms = record->timestamp_ms;
+	const char *sname = (record->source_id != LOG_BACKEND_FCB_NO_SOURCE) ?
+			    log_source_name_get(record->domain_id, record->source_id) : NULL;
+
+	shell_fprintf(sh, SHELL_NORMAL, "[%02u:%02u:%02u.%03u] <%s> %s: %.*s\n",
+		      ms / 3600000U, (ms / 60000U) % 60U, (ms / 1000U) % 60U, ms % 1000U,
+		      level_str[MIN(record->level, ARRAY_SIZE(level_str) - 1)],
+		      (sname != NULL) ? sname : "", (int)record->text_len, record->text);
+
+	if (record->data_len > 0) {
+		shell_hexdump(sh, record->data, record->data_len);
+	}
+
+	return 0;
+}
+
+static int cmd_log_fcb_fetch(const struct shell *sh, size_t argc, char **argv)
+{
+	uint32_t from_ms = 0;
+	uint32_t to_ms = UINT32_MAX;
+	uint8_t max_level = LOG_LEVEL_DBG;
+	uint16_t boot_nr = log_backend_fcb_boot_get();
+	int err = 0;
+	int rc;
+
+	if (argc > 1) {
+		from_ms = (uint32_t)shell_strtoul(argv[1], 0, &err);
+	}
+	if (argc > 2) {
+		to_ms = (uint32_t)shell_strtoul(argv[2], 0, &err);
+	}
+	if (argc > 3) {
+		max_level = (uint8_t)shell_strtoul(argv[3], 0, &err);
+	}
+	if (argc > 4) {
+		boot_nr = (uint16_t)shell_strtoul(argv[4], 0, &err);
+	}
+
+	if (err != 0) {
+		shell_error(sh, "Invalid argument");
+		return err;
+	}
+
+	rc = log_backend_fcb_fetch(boot_nr, from_ms, to_ms, max_level,
+				   shell_print_record, (void *)sh);
+	if (rc != 0) {
+		shell_error(sh, "Fetch failed (%d)", rc);
+	}
+
+	return rc;
+}
+
+static int cmd_log_fcb_stats(const struct shell *sh, size_t argc, char **argv)
+{
+	struct log_backend_fcb_stats s;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	log_backend_fcb_stats_get(&s);
+
+	shell_print(sh, "boot:          %u", log_backend_fcb_boot_get());
+	shell_print(sh, "blocks:        %u", s.blocks);
+	shell_print(sh, "raw bytes:     %u", s.raw_bytes);
+	shell_print(sh, "stored bytes:  %u", s.stored_bytes);
+	shell_print(sh, "dropped:       %u", s.dropped);
+
+	return 0;
+}
+
+static int cmd_log_fcb_clear(const struct shell *sh, size_t argc, char **argv)
+{
+	int rc;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	rc = log_backend_fcb_clear();
+	if (rc != 0) {
+		shell_error(sh, "Clear failed (%d)", rc);
+	}
+
+	return rc;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_log_fcb,
+	SHELL_CMD_ARG(fetch, NULL,
+		      "Print stored messages: [<from_ms> [<to_ms> [<max_level> [<boot>]]]]",
+		      cmd_log_fcb_fetch, 1, 4),
+	SHELL_CMD_ARG(stats, NULL, "Print storage statistics", cmd_log_fcb_stats, 1, 0),
+	SHELL_CMD_ARG(clear, NULL, "Erase stored messages", cmd_log_fcb_clear, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(log_fcb, &sub_log_fcb, "Flash log storage commands", NULL);
+#endif /* CONFIG_LOG_BACKEND_FCB_SHELL */
@@ -453,6 +453,14 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
 LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
+static struct log_dict_output_frame dict_frame;
+
+static bool dict_framed(void)
+{
+	return IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	       IS_ENABLED(CONFIG_LOG_BACKEND_FS_DICT_FRAMED) &&
+	       (log_format_current == LOG_OUTPUT_DICT);
+}
 
 static void log_backend_fs_init(const struct log_backend *const backend)
 {
@@ -470,7 +478,9 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
-	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
+	if (dict_framed()) {
+		log_dict_output_frame_dropped_process(&log_output, &dict_frame, cnt);
+	} else if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
 		log_dict_output_dropped_process(&log_output, cnt);
 	} else {
 		log_backend_std_dropped(&log_output, cnt);
@@ -482,6 +492,11 @@ static void process(const struct log_backend *const backend,
 {
 	uint32_t flags = log_backend_std_get_flags();
 
+	if (dict_framed()) {
+		log_dict_output_frame_msg_process(&log_output, &dict_frame, &msg->log);
+		return;
+	}
+
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
 	log_output_func(&log_output, &msg->log, flags);
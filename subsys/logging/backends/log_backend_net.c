@@ -10,6 +10,7 @@ LOG_MODULE_REGISTER(log_backend_net, CONFIG_LOG_DEFAULT_LEVEL);
 #include <zephyr/logging/log_backend.h>
 #include <zephyr/logging/log_core.h>
 #include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_context.h>
 
@@ -35,6 +36,7 @@ static bool net_init_done;
 struct sockaddr server_addr;
 static bool panic_mode;
 static uint32_t log_format_current = CONFIG_LOG_BACKEND_NET_OUTPUT_DEFAULT;
+static struct log_dict_output_frame dict_frame;
 
 const struct log_backend *log_backend_net_get(void);
 
@@ -185,11 +187,34 @@ static void process(const struct log_backend *const backend,
 		net_init_done = true;
 	}
 
+	/* Dictionary based records are sent one frame per datagram so that
+	 * lost or reordered packets can be detected by the receiver.
+	 */
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    log_format_current == LOG_OUTPUT_DICT) {
+		log_dict_output_frame_msg_process(&log_output_net, &dict_frame, &msg->log);
+		return;
+	}
+
 	log_format_func_t log_output_func = log_format_func_t_get(log_format_current);
 
 	log_output_func(&log_output_net, &msg->log, flags);
 }
 
+static void dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	if (panic_mode) {
+		return;
+	}
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_SUPPORT) &&
+	    log_format_current == LOG_OUTPUT_DICT) {
+		log_dict_output_frame_dropped_process(&log_output_net, &dict_frame, cnt);
+	}
+}
+
 static int format_set(const struct log_backend *const backend, uint32_t log_type)
 {
 	log_format_current = log_type;
@@ -223,6 +248,7 @@ const struct log_backend_api log_backend_net_api = {
 	.panic = panic,
 	.init = init_net,
 	.process = process,
+	.dropped = dropped,
 	.format_set = format_set,
 };
 
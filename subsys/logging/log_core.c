@@ -21,6 +21,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/logging/log_output_custom.h>
 #include <zephyr/linker/utils.h>
+#include "log_cpu_buf.h"
 
 LOG_MODULE_REGISTER(log);
 
@@ -129,6 +130,20 @@ static const struct mpsc_pbuf_buffer_config mpsc_config = {
 		  MPSC_PBUF_MAX_UTILIZATION : 0)
 };
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Buffer memory is split evenly between CPUs. */
+#define LOG_CPU_BUF_WLEN \
+	ROUND_DOWN(ARRAY_SIZE(buf32) / CONFIG_MP_MAX_NUM_CPUS, \
+		   MAX(1, Z_LOG_MSG2_ALIGNMENT / sizeof(int)))
+
+#define LOG_CURRENT_CPU COND_CODE_1(CONFIG_SMP, (arch_curr_cpu()->id), (0))
+
+static struct log_cpu_buf cpu_bufs[CONFIG_MP_MAX_NUM_CPUS];
+
+/* Oldest message claimed from each CPU buffer, not processed yet. */
+static union log_msg_generic *cpu_buf_msgs[CONFIG_MP_MAX_NUM_CPUS];
+#endif
+
 /* Check that default tag can fit in tag buffer. */
 COND_CODE_0(CONFIG_LOG_TAG_MAX_LEN, (),
 	(BUILD_ASSERT(sizeof(CONFIG_LOG_TAG_DEFAULT) <= CONFIG_LOG_TAG_MAX_LEN + 1,
@@ -581,6 +596,13 @@ bool z_log_dropped_pending(void)
 
 void z_log_msg_init(void)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		log_cpu_buf_init(&cpu_bufs[i], &buf32[i * LOG_CPU_BUF_WLEN],
+				 LOG_CPU_BUF_WLEN, log_msg_generic_get_wlen);
+		cpu_buf_msgs[i] = NULL;
+	}
+#endif
 	mpsc_pbuf_init(&log_buffer, &mpsc_config);
 	curr_log_buffer = &log_buffer;
 }
@@ -595,9 +617,32 @@ static struct log_msg *msg_alloc(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
 }
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+static struct log_cpu_buf *cpu_buf_get(const void *msg)
+{
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (log_cpu_buf_contains(&cpu_bufs[i], msg)) {
+			return &cpu_bufs[i];
+		}
+	}
+
+	__ASSERT(0, "Message %p not in any CPU buffer", msg);
+
+	return NULL;
+}
+#endif
+
 struct log_msg *z_log_msg_alloc(uint32_t wlen)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	/* The CPU may change right after reading the id if the caller gets
+	 * migrated; that is harmless as the buffer allows concurrent producers,
+	 * it only costs some contention.
+	 */
+	return (struct log_msg *)log_cpu_buf_alloc(&cpu_bufs[LOG_CURRENT_CPU], wlen);
+#else
 	return msg_alloc(&log_buffer, wlen);
+#endif
 }
 
 static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
@@ -610,6 +655,14 @@ static void msg_commit(struct mpsc_pbuf_buffer *buffer, struct log_msg *msg)
 		return;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (buffer == &log_buffer) {
+		log_cpu_buf_commit(&m->buf);
+		z_log_msg_post_finalize();
+
+		return;
+	}
+#endif
 	mpsc_pbuf_commit(buffer, &m->buf);
 	z_log_msg_post_finalize();
 }
@@ -625,9 +678,56 @@ union log_msg_generic *z_log_msg_local_claim(void)
 	return (union log_msg_generic *)mpsc_pbuf_claim(&log_buffer);
 }
 
-/* If there are buffers dedicated for each link, claim the oldest message (lowest timestamp). */
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+/* Merge per-CPU buffers by claiming the message with the lowest timestamp. */
+static union log_msg_generic *cpu_buf_claim_oldest(void)
+{
+	union log_msg_generic *msg = NULL;
+	log_timestamp_t t_min = sizeof(log_timestamp_t) > sizeof(uint32_t) ?
+				UINT64_MAX : UINT32_MAX;
+	int chosen = 0;
+
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (cpu_buf_msgs[i] == NULL) {
+			cpu_buf_msgs[i] =
+				(union log_msg_generic *)log_cpu_buf_claim(&cpu_bufs[i]);
+		}
+
+		if (cpu_buf_msgs[i]) {
+			log_timestamp_t t = log_msg_get_timestamp(&cpu_buf_msgs[i]->log);
+
+			if (t < t_min) {
+				t_min = t;
+				msg = cpu_buf_msgs[i];
+				chosen = i;
+			}
+		}
+	}
+
+	if (msg) {
+		cpu_buf_msgs[chosen] = NULL;
+
+		if (t_min < prev_timestamp) {
+			atomic_inc(&unordered_cnt);
+		}
+
+		prev_timestamp = t_min;
+	}
+
+	return msg;
+}
+#endif
+
+/* If there are buffers dedicated for each link or CPU, claim the oldest message
+ * (lowest timestamp).
+ */
 union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	ARG_UNUSED(backoff);
+
+	return cpu_buf_claim_oldest();
+#else
 	union log_msg_generic *msg = NULL;
 	struct log_msg_ptr *chosen;
 	log_timestamp_t t_min = sizeof(log_timestamp_t) > sizeof(uint32_t) ?
@@ -688,6 +788,7 @@ union log_msg_generic *z_log_msg_claim_oldest(k_timeout_t *backoff)
 	prev_timestamp = t_min;
 
 	return msg;
+#endif /* CONFIG_LOG_PER_CPU_BUFFERS */
 }
 
 union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
@@ -697,7 +798,8 @@ union log_msg_generic *z_log_msg_claim(k_timeout_t *backoff)
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	/* Use only one buffer if others are not registered. */
-	if (IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) {
+	if ((IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) && len > 1) ||
+	    IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS)) {
 		return z_log_msg_claim_oldest(backoff);
 	}
 
@@ -711,6 +813,11 @@ static void msg_free(struct mpsc_pbuf_buffer *buffer, const union log_msg_generi
 
 void z_log_msg_free(union log_msg_generic *msg)
 {
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	log_cpu_buf_free(cpu_buf_get(msg), &msg->buf);
+
+	return;
+#endif
 	msg_free(curr_log_buffer, msg);
 }
 
@@ -724,6 +831,16 @@ bool z_log_msg_pending(void)
 	size_t len;
 	int i = 0;
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	for (i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		if (cpu_buf_msgs[i] || log_cpu_buf_is_pending(&cpu_bufs[i])) {
+			return true;
+		}
+	}
+
+	return false;
+#endif
+
 	STRUCT_SECTION_COUNT(log_mpsc_pbuf, &len);
 
 	if (!IS_ENABLED(CONFIG_LOG_MULTIDOMAIN) || (len == 1)) {
@@ -806,7 +923,16 @@ int log_mem_get_usage(uint32_t *buf_size, uint32_t *usage)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	*buf_size = 0;
+	*usage = 0;
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		*buf_size += cpu_bufs[i].size * sizeof(int);
+		*usage += log_cpu_buf_get_usage(&cpu_bufs[i]) * sizeof(int);
+	}
+#else
 	mpsc_pbuf_get_utilization(&log_buffer, buf_size, usage);
+#endif
 
 	return 0;
 }
@@ -819,7 +945,21 @@ int log_mem_get_max_usage(uint32_t *max)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_LOG_PER_CPU_BUFFERS
+	if (!IS_ENABLED(CONFIG_LOG_MEM_UTILIZATION)) {
+		return -ENOTSUP;
+	}
+
+	/* Sum of per-CPU maxima, an upper bound of the total. */
+	*max = 0;
+	for (int i = 0; i < CONFIG_MP_MAX_NUM_CPUS; i++) {
+		*max += cpu_bufs[i].max_usage * sizeof(int);
+	}
+
+	return 0;
+#else
 	return mpsc_pbuf_get_max_utilization(&log_buffer, max);
+#endif
 }
 
 static void log_backend_notify_all(enum log_backend_evt event,
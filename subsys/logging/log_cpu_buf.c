@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+#include "log_cpu_buf.h"
+
+static inline uint32_t idx_inc(struct log_cpu_buf *cb, uint32_t idx, uint32_t val)
+{
+	uint32_t i = idx + val;
+
+	return (i >= 2U * cb->size) ? i - 2U * cb->size : i;
+}
+
+static inline uint32_t idx_offset(struct log_cpu_buf *cb, uint32_t idx)
+{
+	return (idx >= cb->size) ? idx - cb->size : idx;
+}
+
+static inline uint32_t idx_used(struct log_cpu_buf *cb, uint32_t wr, uint32_t rd)
+{
+	return (wr >= rd) ? wr - rd : wr + 2U * cb->size - rd;
+}
+
+void log_cpu_buf_init(struct log_cpu_buf *cb, uint32_t *buf, uint32_t size,
+		      mpsc_pbuf_get_wlen get_wlen)
+{
+	cb->buf = buf;
+	cb->size = size;
+	cb->get_wlen = get_wlen;
+	cb->max_usage = 0;
+	memset(buf, 0, size * sizeof(uint32_t));
+	atomic_clear(&cb->wr_idx);
+	atomic_clear(&cb->rd_idx);
+}
+
+union mpsc_pbuf_generic *log_cpu_buf_alloc(struct log_cpu_buf *cb, uint32_t wlen)
+{
+	uint32_t wr, off, pad, used;
+
+	if (wlen > cb->size) {
+		return NULL;
+	}
+
+	do {
+		wr = (uint32_t)atomic_get(&cb->wr_idx);
+		off = idx_offset(cb, wr);
+		/* Packet does not fit before the end, pad it to the start. */
+		pad = (cb->size - off < wlen) ? cb->size - off : 0U;
+		used = idx_used(cb, wr, (uint32_t)atomic_get(&cb->rd_idx)) + pad + wlen;
+
+		if (used > cb->size) {
+			return NULL;
+		}
+	} while (!atomic_cas(&cb->wr_idx, (atomic_val_t)wr,
+			     (atomic_val_t)idx_inc(cb, wr, pad + wlen)));
+
+	if (pad) {
+		union mpsc_pbuf_generic skip = {
+			.skip = { .valid = 0, .busy = 1, .len = pad }
+		};
+
+		cb->buf[off] = skip.raw;
+		off = 0;
+	}
+
+	/* Racy but only used for statistics. */
+	if (used > cb->max_usage) {
+		cb->max_usage = used;
+	}
+
+	return (union mpsc_pbuf_generic *)&cb->buf[off];
+}
+
+void log_cpu_buf_commit(union mpsc_pbuf_generic *item)
+{
+	/* Packet content must be visible before the valid bit. */
+	__sync_synchronize();
+	item->hdr.valid = 1;
+}
+
+union mpsc_pbuf_generic *log_cpu_buf_claim(struct log_cpu_buf *cb)
+{
+	union mpsc_pbuf_generic *item;
+	uint32_t rd;
+
+	for (;;) {
+		rd = (uint32_t)atomic_get(&cb->rd_idx);
+		if (rd == (uint32_t)atomic_get(&cb->wr_idx)) {
+			return NULL;
+		}
+
+		item = (union mpsc_pbuf_generic *)&cb->buf[idx_offset(cb, rd)];
+		if (item->hdr.valid) {
+			__sync_synchronize();
+			return item;
+		}
+
+		if (!item->hdr.busy) {
+			/* Reserved but not committed yet. */
+			return NULL;
+		}
+
+		/* Padding before wrapping around. */
+		uint32_t len = item->skip.len;
+
+		item->raw = 0;
+		__sync_synchronize();
+		(void)atomic_set(&cb->rd_idx, (atomic_val_t)idx_inc(cb, rd, len));
+	}
+}
+
+void log_cpu_buf_free(struct log_cpu_buf *cb, union mpsc_pbuf_generic *item)
+{
+	uint32_t wlen = cb->get_wlen(item);
+	uint32_t rd = (uint32_t)atomic_get(&cb->rd_idx);
+
+	__ASSERT_NO_MSG((uint32_t *)item == &cb->buf[idx_offset(cb, rd)]);
+
+	/* Zeroed space reads as not committed once it is reserved again. */
+	memset(item, 0, wlen * sizeof(uint32_t));
+	__sync_synchronize();
+	(void)atomic_set(&cb->rd_idx, (atomic_val_t)idx_inc(cb, rd, wlen));
+}
+
+uint32_t log_cpu_buf_get_usage(struct log_cpu_buf *cb)
+{
+	return idx_used(cb, (uint32_t)atomic_get(&cb->wr_idx),
+			(uint32_t)atomic_get(&cb->rd_idx));
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_SUBSYS_LOGGING_LOG_CPU_BUF_H_
+#define ZEPHYR_SUBSYS_LOGGING_LOG_CPU_BUF_H_
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mpsc_packet.h>
+#include <zephyr/sys/mpsc_pbuf.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Lock-free packet buffer used for one CPU.
+ *
+ * Space is reserved with a compare-and-swap on the write index so producers
+ * never take a lock or mask interrupts. Indexes run over twice the buffer size
+ * to tell a full buffer from an empty one. Packets are consumed in reservation
+ * order by a single consumer which may hold at most one claimed packet at a
+ * time. Consumed space is zeroed, so a reserved packet reads as not committed
+ * until its producer sets the valid bit.
+ */
+struct log_cpu_buf {
+	/** Reservation index. */
+	atomic_t wr_idx;
+
+	/** Read index, moved when the claimed packet is freed. */
+	atomic_t rd_idx;
+
+	/** Callback for getting packet length. */
+	mpsc_pbuf_get_wlen get_wlen;
+
+	/** Buffer. */
+	uint32_t *buf;
+
+	/** Buffer size in 32 bit words. */
+	uint32_t size;
+
+	/** Maximum usage in 32 bit words. */
+	uint32_t max_usage;
+};
+
+/** @brief Initialize the buffer.
+ *
+ * @param cb Buffer.
+ * @param buf Memory used for storing packets.
+ * @param size Size of @p buf in 32 bit words.
+ * @param get_wlen Callback for getting packet length.
+ */
+void log_cpu_buf_init(struct log_cpu_buf *cb, uint32_t *buf, uint32_t size,
+		      mpsc_pbuf_get_wlen get_wlen);
+
+/** @brief Reserve space for a packet.
+ *
+ * Can be called from any context, including concurrently on several CPUs.
+ *
+ * @param cb Buffer.
+ * @param wlen Packet length in 32 bit words.
+ *
+ * @return Pointer to the packet or NULL if there is no space.
+ */
+union mpsc_pbuf_generic *log_cpu_buf_alloc(struct log_cpu_buf *cb, uint32_t wlen);
+
+/** @brief Commit a packet, making it visible to the consumer.
+ *
+ * @param item Packet returned by @ref log_cpu_buf_alloc.
+ */
+void log_cpu_buf_commit(union mpsc_pbuf_generic *item);
+
+/** @brief Claim the oldest packet.
+ *
+ * Repeated calls return the same packet until it is freed.
+ *
+ * @param cb Buffer.
+ *
+ * @return Pointer to the packet or NULL if the oldest one is not committed yet
+ *	   or the buffer is empty.
+ */
+union mpsc_pbuf_generic *log_cpu_buf_claim(struct log_cpu_buf *cb);
+
+/** @brief Free the packet returned by @ref log_cpu_buf_claim.
+ *
+ * @param cb Buffer.
+ * @param item Claimed packet.
+ */
+void log_cpu_buf_free(struct log_cpu_buf *cb, union mpsc_pbuf_generic *item);
+
+/** @brief Check if the buffer holds any reserved packet.
+ *
+ * @param cb Buffer.
+ *
+ * @return True if there is a packet, possibly not committed yet.
+ */
+static inline bool log_cpu_buf_is_pending(struct log_cpu_buf *cb)
+{
+	return atomic_get(&cb->wr_idx) != atomic_get(&cb->rd_idx);
+}
+
+/** @brief Check if a packet belongs to the buffer.
+ *
+ * @param cb Buffer.
+ * @param item Packet.
+ *
+ * @return True if @p item is located in the buffer memory.
+ */
+static inline bool log_cpu_buf_contains(struct log_cpu_buf *cb, const void *item)
+{
+	return ((const uint32_t *)item >= cb->buf) &&
+	       ((const uint32_t *)item < &cb->buf[cb->size]);
+}
+
+/** @brief Get current usage in 32 bit words.
+ *
+ * @param cb Buffer.
+ *
+ * @return Number of reserved words.
+ */
+uint32_t log_cpu_buf_get_usage(struct log_cpu_buf *cb);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_SUBSYS_LOGGING_LOG_CPU_BUF_H_ */
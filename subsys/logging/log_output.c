@@ -588,7 +588,7 @@ void log_output_timestamp_freq_set(uint32_t frequency)
 	freq = frequency;
 }
 
-uint64_t log_output_timestamp_to_us(uint32_t timestamp)
+uint64_t log_output_timestamp_to_us(log_timestamp_t timestamp)
 {
 	timestamp /= timestamp_div;
 
@@ -11,6 +11,7 @@
 #include <zephyr/logging/log_output_dict.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/util.h>
+#include <string.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 			 void *ctx)
@@ -24,25 +25,35 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
-void log_dict_output_msg_process(const struct log_output *output,
-				 struct log_msg *msg, uint32_t flags)
+static void msg_hdr_fill(struct log_dict_output_normal_msg_hdr_t *output_hdr,
+			 struct log_msg *msg)
 {
-	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg_get_source(msg);
 
+	/* Unused bits of the header are output as well */
+	(void)memset(output_hdr, 0, sizeof(*output_hdr));
+
 	/* Keep sync with header in struct log_msg */
-	output_hdr.type = MSG_NORMAL;
-	output_hdr.domain = msg->hdr.desc.domain;
-	output_hdr.level = msg->hdr.desc.level;
-	output_hdr.package_len = msg->hdr.desc.package_len;
-	output_hdr.data_len = msg->hdr.desc.data_len;
-	output_hdr.timestamp = msg->hdr.timestamp;
-
-	output_hdr.source = (source != NULL) ?
+	output_hdr->type = MSG_NORMAL;
+	output_hdr->domain = msg->hdr.desc.domain;
+	output_hdr->level = msg->hdr.desc.level;
+	output_hdr->package_len = msg->hdr.desc.package_len;
+	output_hdr->data_len = msg->hdr.desc.data_len;
+	output_hdr->timestamp = msg->hdr.timestamp;
+
+	output_hdr->source = (source != NULL) ?
 				(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
 					log_dynamic_source_id(source) :
 					log_const_source_id(source)) :
 				0U;
+}
+
+void log_dict_output_msg_process(const struct log_output *output,
+				 struct log_msg *msg, uint32_t flags)
+{
+	struct log_dict_output_normal_msg_hdr_t output_hdr;
+
+	msg_hdr_fill(&output_hdr, msg);
 
 	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
 		     (void *)output);
@@ -72,3 +83,77 @@ void log_dict_output_dropped_process(const struct log_output *output, uint32_t c
 	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
 		     (void *)output);
 }
+
+/* Start a frame with @p len bytes of payload in the output buffer.
+ *
+ * Returns a pointer to the payload or NULL if the frame does not fit.
+ */
+static uint8_t *frame_start(const struct log_output *output,
+			    struct log_dict_output_frame *frame, size_t len)
+{
+	struct log_dict_output_frame_hdr_t hdr = {
+		.magic = { LOG_DICT_OUTPUT_FRAME_MAGIC0, LOG_DICT_OUTPUT_FRAME_MAGIC1 },
+		.version = LOG_DICT_OUTPUT_FRAME_VERSION,
+		.len = (uint16_t)len,
+	};
+
+	if ((sizeof(hdr) + len) > output->size) {
+		return NULL;
+	}
+
+	if (output->control_block->offset != 0) {
+		log_output_flush(output);
+	}
+
+	hdr.seq = frame->seq++;
+	hdr.dropped = frame->dropped;
+	memcpy(output->buf, &hdr, sizeof(hdr));
+
+	return output->buf + sizeof(hdr);
+}
+
+static void frame_end(const struct log_output *output, size_t len)
+{
+	output->control_block->offset = sizeof(struct log_dict_output_frame_hdr_t) + len;
+	log_output_flush(output);
+}
+
+void log_dict_output_frame_msg_process(const struct log_output *output,
+				       struct log_dict_output_frame *frame,
+				       struct log_msg *msg)
+{
+	struct log_dict_output_normal_msg_hdr_t output_hdr;
+	size_t pkg_len, data_len;
+	uint8_t *pkg = log_msg_get_package(msg, &pkg_len);
+	uint8_t *data = log_msg_get_data(msg, &data_len);
+	size_t len = sizeof(output_hdr) + pkg_len + data_len;
+	uint8_t *payload = frame_start(output, frame, len);
+
+	if (payload == NULL) {
+		frame->dropped++;
+		return;
+	}
+
+	msg_hdr_fill(&output_hdr, msg);
+	memcpy(payload, &output_hdr, sizeof(output_hdr));
+	payload += sizeof(output_hdr);
+	memcpy(payload, pkg, pkg_len);
+	payload += pkg_len;
+	memcpy(payload, data, data_len);
+
+	frame_end(output, len);
+}
+
+void log_dict_output_frame_dropped_process(const struct log_output *output,
+					   struct log_dict_output_frame *frame,
+					   uint32_t cnt)
+{
+	frame->dropped += cnt;
+
+	/* Counters are carried by every frame, an empty one reports them
+	 * without waiting for the next message.
+	 */
+	if (frame_start(output, frame, 0) != NULL) {
+		frame_end(output, 0);
+	}
+}
@@ -64,6 +64,113 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+#define CONN_HASH_MASK (CONFIG_NET_CONN_HASH_BUCKETS - 1)
+
+BUILD_ASSERT((CONFIG_NET_CONN_HASH_BUCKETS & CONN_HASH_MASK) == 0,
+	     "CONFIG_NET_CONN_HASH_BUCKETS must be a power of two");
+
+/* IP connection handlers are additionally linked, through hash_node,
+ * either into the bucket of their protocol and local port or, if they
+ * do not specify a local port, into the wildcard chain. Packet sockets
+ * and CAN handlers are only found in conn_used.
+ */
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+static sys_slist_t conn_wildcard;
+static uint32_t conn_seq;
+
+/* The port is hashed in network byte order, as found in the packet */
+static inline sys_slist_t *conn_hash_bucket(uint16_t proto, uint16_t port)
+{
+	uint32_t hash = (((uint32_t)proto << 16) | port) * 0x9e3779b1U;
+
+	return &conn_hash[(hash ^ (hash >> 16)) & CONN_HASH_MASK];
+}
+
+static inline bool conn_is_hashed(struct net_conn *conn)
+{
+	return conn->family == AF_INET || conn->family == AF_INET6 ||
+	       conn->family == AF_UNSPEC;
+}
+
+static sys_slist_t *conn_hash_chain(struct net_conn *conn)
+{
+	uint16_t port = net_sin(&conn->local_addr)->sin_port;
+
+	return port ? conn_hash_bucket(conn->proto, port) : &conn_wildcard;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
+/* Iterator over the connection handlers that may match a packet */
+struct conn_iter {
+	sys_snode_t *next;
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_snode_t *next_wildcard;
+	bool hashed;
+#endif
+};
+
+static void conn_iter_init(struct conn_iter *iter, uint8_t family,
+			   uint8_t proto, uint16_t dst_port)
+{
+#if defined(CONFIG_NET_CONN_HASH)
+	iter->hashed = (family == AF_INET || family == AF_INET6);
+	if (iter->hashed) {
+		iter->next = sys_slist_peek_head(conn_hash_bucket(proto, dst_port));
+		iter->next_wildcard = sys_slist_peek_head(&conn_wildcard);
+		return;
+	}
+#else
+	ARG_UNUSED(family);
+	ARG_UNUSED(proto);
+	ARG_UNUSED(dst_port);
+#endif
+
+	iter->next = sys_slist_peek_head(&conn_used);
+}
+
+static struct net_conn *conn_iter_next(struct conn_iter *iter)
+{
+	struct net_conn *conn;
+
+#if defined(CONFIG_NET_CONN_HASH)
+	if (iter->hashed) {
+		struct net_conn *wild;
+
+		/* Like conn_used, both chains are kept newest first.
+		 * Merge them on the registration sequence number so the
+		 * handlers are visited in the same order as without the
+		 * hash, as the ranking in net_conn_input() depends on it.
+		 */
+		conn = iter->next == NULL ? NULL :
+			CONTAINER_OF(iter->next, struct net_conn, hash_node);
+		wild = iter->next_wildcard == NULL ? NULL :
+			CONTAINER_OF(iter->next_wildcard, struct net_conn, hash_node);
+
+		if (wild != NULL &&
+		    (conn == NULL || (int32_t)(wild->seq - conn->seq) > 0)) {
+			iter->next_wildcard = sys_slist_peek_next(&wild->hash_node);
+			return wild;
+		}
+
+		if (conn != NULL) {
+			iter->next = sys_slist_peek_next(&conn->hash_node);
+		}
+
+		return conn;
+	}
+#endif
+
+	if (iter->next == NULL) {
+		return NULL;
+	}
+
+	conn = CONTAINER_OF(iter->next, struct net_conn, node);
+	iter->next = sys_slist_peek_next(iter->next);
+
+	return conn;
+}
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -141,6 +248,14 @@ static void conn_set_used(struct net_conn *conn)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_prepend(&conn_used, &conn->node);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	if (conn_is_hashed(conn)) {
+		conn->seq = conn_seq++;
+		sys_slist_prepend(conn_hash_chain(conn), &conn->hash_node);
+	}
+#endif
+
 	k_mutex_unlock(&conn_lock);
 }
 
@@ -397,6 +512,13 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	k_mutex_lock(&conn_lock, K_FOREVER);
 	sys_slist_find_and_remove(&conn_used, &conn->node);
+
+#if defined(CONFIG_NET_CONN_HASH)
+	if (conn_is_hashed(conn)) {
+		sys_slist_find_and_remove(conn_hash_chain(conn), &conn->hash_node);
+	}
+#endif
+
 	k_mutex_unlock(&conn_lock);
 
 	conn_set_unused(conn);
@@ -617,6 +739,7 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 	bool raw_pkt_delivered = false;
 	bool raw_pkt_continue = false;
 	struct net_conn *conn;
+	struct conn_iter iter;
 
 	if (IS_ENABLED(CONFIG_NET_IP)) {
 		/* If we receive a packet with multicast destination address, we might
@@ -634,7 +757,9 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
+	conn_iter_init(&iter, pkt_family, proto, dst_port);
+
+	while ((conn = conn_iter_next(&iter)) != NULL) {
 		/* Is the candidate connection matching the packet's interface? */
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -857,6 +982,14 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+
+	sys_slist_init(&conn_wildcard);
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -54,6 +54,14 @@ struct net_conn {
 	/** Internal slist node */
 	sys_snode_t node;
 
+#if defined(CONFIG_NET_CONN_HASH)
+	/** Internal node in the port hash bucket or wildcard chain */
+	sys_snode_t hash_node;
+
+	/** Registration order, used to merge the lookup chains */
+	uint32_t seq;
+#endif
+
 	/** Remote socket address */
 	struct sockaddr remote_addr;
 
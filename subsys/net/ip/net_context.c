@@ -28,6 +28,7 @@ LOG_MODULE_REGISTER(net_ctx, CONFIG_NET_CONTEXT_LOG_LEVEL);
 #include <zephyr/net/ethernet.h>
 #include <zephyr/net/socketcan.h>
 #include <zephyr/net/ieee802154.h>
+#include <zephyr/sys/fdtable.h>
 
 #include "connection.h"
 #include "net_private.h"
@@ -1287,6 +1288,22 @@ static int get_context_dscp_ecn(struct net_context *context,
 #endif
 }
 
+static int get_context_udp_segment(struct net_context *context,
+				   void *value, size_t *len)
+{
+#if defined(CONFIG_NET_UDP_GSO)
+	*((int *)value) = context->options.udp_segment;
+
+	if (len) {
+		*len = sizeof(int);
+	}
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
  * to net_pkt from msghdr.
  */
@@ -1324,6 +1341,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *frags,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1365,6 +1383,15 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
+	if (frags) {
+		/* Payload is attached as it is, the packet takes over the
+		 * caller's reference.
+		 */
+		net_pkt_append_buffer(pkt, frags);
+
+		return 0;
+	}
+
 	ret = context_write_data(pkt, buf, len, msg);
 	if (ret) {
 		return ret;
@@ -1373,6 +1400,31 @@ static int context_setup_udp_packet(struct net_context *context,
 	return 0;
 }
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH) && defined(CONFIG_NET_SOCKETS)
+void net_context_notify_writable(struct net_context *context)
+{
+	z_poll_watch_notify(&context->poll_watchers, ZSOCK_POLLOUT);
+}
+#endif
+
+static void context_detach_frags(struct net_pkt *pkt, struct net_buf *frags)
+{
+	struct net_buf *buf = pkt->buffer;
+
+	if (buf == frags) {
+		pkt->buffer = NULL;
+		return;
+	}
+
+	while (buf && buf->frags != frags) {
+		buf = buf->frags;
+	}
+
+	if (buf) {
+		buf->frags = NULL;
+	}
+}
+
 static void context_finalize_packet(struct net_context *context,
 				    struct net_pkt *pkt)
 {
@@ -1445,11 +1497,146 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+#if defined(CONFIG_NET_UDP_GSO)
+/* Write @a len bytes of the data to be sent, starting at @a offset */
+static int context_write_data_range(struct net_pkt *pkt, const void *buf,
+				    const struct msghdr *msghdr,
+				    size_t offset, size_t len)
+{
+	if (!msghdr) {
+		return net_pkt_write(pkt, (const uint8_t *)buf + offset, len);
+	}
+
+	for (size_t i = 0; i < msghdr->msg_iovlen && len > 0; i++) {
+		size_t iov_len = msghdr->msg_iov[i].iov_len;
+		size_t chunk;
+		int ret;
+
+		if (offset >= iov_len) {
+			offset -= iov_len;
+			continue;
+		}
+
+		chunk = MIN(iov_len - offset, len);
+
+		ret = net_pkt_write(pkt,
+				    (uint8_t *)msghdr->msg_iov[i].iov_base + offset,
+				    chunk);
+		if (ret < 0) {
+			return ret;
+		}
+
+		offset = 0;
+		len -= chunk;
+	}
+
+	return 0;
+}
+
+static int context_send_udp_segment(struct net_context *context,
+				    const void *buf,
+				    const struct msghdr *msghdr,
+				    size_t offset,
+				    size_t len,
+				    const struct sockaddr *dst_addr,
+				    socklen_t addrlen)
+{
+	struct net_pkt *pkt;
+	uint16_t mtu;
+	int ret;
+
+	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	if (!pkt) {
+		NET_ERR("Failed to allocate net_pkt");
+		return -ENOBUFS;
+	}
+
+	if (net_pkt_available_payload_buffer(pkt, IPPROTO_UDP) < len) {
+		ret = -ENOMEM;
+		goto fail;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_CONTEXT_PRIORITY)) {
+		uint8_t priority;
+
+		get_context_priority(context, &priority, NULL);
+		net_pkt_set_priority(pkt, priority);
+	}
+
+	ret = context_setup_udp_packet(context, pkt, NULL, 0, NULL, NULL,
+				       dst_addr, addrlen);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	ret = context_write_data_range(pkt, buf, msghdr, offset, len);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	mtu = net_if_get_mtu(net_pkt_iface(pkt));
+	if (mtu > 0 && net_pkt_get_len(pkt) > mtu) {
+		NET_ERR("Segment (%zu) does not fit the MTU",
+			net_pkt_get_len(pkt));
+		ret = -EMSGSIZE;
+		goto fail;
+	}
+
+	context_finalize_packet(context, pkt);
+
+	ret = net_send_data(pkt);
+	if (ret < 0) {
+		goto fail;
+	}
+
+	return 0;
+fail:
+	net_pkt_unref(pkt);
+
+	return ret;
+}
+
+/* Send the data as a train of datagrams of at most the UDP_SEGMENT size,
+ * reusing the address checks done once by context_sendto(). Returns the
+ * number of bytes sent, which is short if a later datagram failed.
+ */
+static int context_sendto_segmented(struct net_context *context,
+				    const void *buf,
+				    size_t len,
+				    const struct msghdr *msghdr,
+				    const struct sockaddr *dst_addr,
+				    socklen_t addrlen)
+{
+	size_t segment = context->options.udp_segment;
+	size_t offset = 0;
+	int ret = 0;
+
+	if (DIV_ROUND_UP(len, segment) > CONFIG_NET_UDP_GSO_MAX_SEGMENTS) {
+		return -EMSGSIZE;
+	}
+
+	while (offset < len) {
+		size_t seg_len = MIN(segment, len - offset);
+
+		ret = context_send_udp_segment(context, buf, msghdr, offset,
+					       seg_len, dst_addr, addrlen);
+		if (ret < 0) {
+			break;
+		}
+
+		offset += seg_len;
+	}
+
+	return offset > 0 ? (int)offset : ret;
+}
+#endif /* CONFIG_NET_UDP_GSO */
+
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
+			  struct net_buf *frags,
 			  net_context_send_cb_t cb,
 			  k_timeout_t timeout,
 			  void *user_data,
@@ -1666,7 +1853,32 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+#if defined(CONFIG_NET_UDP_GSO)
+	if (!frags && context->options.udp_segment > 0 &&
+	    len > context->options.udp_segment &&
+	    net_context_get_proto(context) == IPPROTO_UDP &&
+	    !(IS_ENABLED(CONFIG_NET_OFFLOAD) && iface &&
+	      net_if_is_ip_offloaded(iface))) {
+		context->send_cb = cb;
+		context->user_data = user_data;
+
+		return context_sendto_segmented(context, buf, len, msghdr,
+						dst_addr, addrlen);
+	}
+#endif
+
+	if (frags) {
+		if (net_context_get_proto(context) != IPPROTO_UDP ||
+		    (IS_ENABLED(CONFIG_NET_OFFLOAD) && iface &&
+		     net_if_is_ip_offloaded(iface))) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(frags);
+	}
+
+	/* With caller supplied fragments only the headers need space */
+	pkt = context_alloc_pkt(context, frags ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		NET_ERR("Failed to allocate net_pkt");
 		return -ENOBUFS;
@@ -1674,7 +1886,7 @@ static int context_sendto(struct net_context *context,
 
 	tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_proto(context));
-	if (tmp_len < len) {
+	if (!frags && tmp_len < len) {
 		if (net_context_get_type(context) == SOCK_DGRAM) {
 			NET_ERR("Available payload buffer (%zu) is not enough for requested DGRAM (%zu)",
 				tmp_len, len);
@@ -1728,11 +1940,19 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_proto(context) == IPPROTO_UDP) {
 		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+					       frags, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
 
+		if (frags && net_if_get_mtu(net_pkt_iface(pkt)) > 0 &&
+		    net_pkt_get_len(pkt) > net_if_get_mtu(net_pkt_iface(pkt))) {
+			NET_ERR("Datagram (%zu) does not fit the MTU",
+				net_pkt_get_len(pkt));
+			ret = -EMSGSIZE;
+			goto fail;
+		}
+
 		context_finalize_packet(context, pkt);
 
 		ret = net_send_data(pkt);
@@ -1804,6 +2024,11 @@ static int context_sendto(struct net_context *context,
 
 	return len;
 fail:
+	if (frags) {
+		/* On error the fragments stay with the caller */
+		context_detach_frags(pkt, frags);
+	}
+
 	net_pkt_unref(pkt);
 
 	return ret;
@@ -1845,7 +2070,7 @@ int net_context_send(struct net_context *context,
 	}
 
 	ret = context_sendto(context, buf, len, &context->remote,
-			     addrlen, cb, timeout, user_data, false);
+			     addrlen, NULL, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
 
@@ -1863,7 +2088,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, 0, NULL,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1884,7 +2109,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, dst_addr, addrlen, NULL,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1892,6 +2117,42 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendto_frags(struct net_context *context,
+			     struct net_buf *frags,
+			     const struct sockaddr *dst_addr,
+			     socklen_t addrlen,
+			     net_context_send_cb_t cb,
+			     k_timeout_t timeout,
+			     void *user_data)
+{
+	int ret;
+
+	if (!frags) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    !net_sin(&context->remote)->sin_port) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = net_context_get_family(context) == AF_INET6 ?
+			sizeof(struct sockaddr_in6) : sizeof(struct sockaddr_in);
+	}
+
+	ret = context_sendto(context, NULL, 0, dst_addr, addrlen, frags,
+			     cb, timeout, user_data, true);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -2345,6 +2606,32 @@ static int set_context_dscp_ecn(struct net_context *context,
 #endif
 }
 
+static int set_context_udp_segment(struct net_context *context,
+				   const void *value, size_t len)
+{
+#if defined(CONFIG_NET_UDP_GSO)
+	int segment = *((int *)value);
+
+	if (len != sizeof(int)) {
+		return -EINVAL;
+	}
+
+	if (net_context_get_proto(context) != IPPROTO_UDP) {
+		return -EOPNOTSUPP;
+	}
+
+	if ((segment < 0) || (segment > UINT16_MAX)) {
+		return -EINVAL;
+	}
+
+	context->options.udp_segment = (uint16_t)segment;
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
+
 int net_context_set_option(struct net_context *context,
 			   enum net_context_option option,
 			   const void *value, size_t len)
@@ -2384,6 +2671,9 @@ int net_context_set_option(struct net_context *context,
 	case NET_OPT_DSCP_ECN:
 		ret = set_context_dscp_ecn(context, value, len);
 		break;
+	case NET_OPT_UDP_SEGMENT:
+		ret = set_context_udp_segment(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
@@ -2430,6 +2720,9 @@ int net_context_get_option(struct net_context *context,
 	case NET_OPT_DSCP_ECN:
 		ret = get_context_dscp_ecn(context, value, len);
 		break;
+	case NET_OPT_UDP_SEGMENT:
+		ret = get_context_udp_segment(context, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&context->lock);
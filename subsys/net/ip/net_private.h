@@ -88,6 +88,15 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 	return NET_CONTINUE;
 }
 #endif
+#if defined(CONFIG_FDTABLE_POLL_WATCH) && defined(CONFIG_NET_SOCKETS)
+/* Tell socket readiness watchers that the context can take more data */
+extern void net_context_notify_writable(struct net_context *context);
+#else
+static inline void net_context_notify_writable(struct net_context *context)
+{
+	ARG_UNUSED(context);
+}
+#endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
@@ -1167,6 +1167,26 @@ static void print_tc_rx_stats(const struct shell *sh, struct net_if *iface)
 #endif /* NET_TC_RX_COUNT > 1 */
 }
 
+static void print_rx_queue_stats(const struct shell *sh, struct net_if *iface)
+{
+#if NET_TC_RX_QUEUES > 1
+	int i;
+
+	PR("RX queue statistics:\n");
+	PR("TC.Q   Recv pkts\tbytes\n");
+
+	for (i = 0; i < NET_TC_RX_COUNT * NET_TC_RX_QUEUES; i++) {
+		PR("[%d.%d]  %d\t\t%d\n", i / NET_TC_RX_QUEUES,
+		   i % NET_TC_RX_QUEUES,
+		   GET_STAT(iface, rxq[i].pkts),
+		   GET_STAT(iface, rxq[i].bytes));
+	}
+#else
+	ARG_UNUSED(sh);
+	ARG_UNUSED(iface);
+#endif /* NET_TC_RX_QUEUES > 1 */
+}
+
 static void print_net_pm_stats(const struct shell *sh, struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
@@ -1283,6 +1303,12 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 	   GET_STAT(iface, tcp.conndrop),
 	   GET_STAT(iface, tcp.connrst));
 	PR("TCP pkt drop   %d\n", GET_STAT(iface, tcp.drop));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	PR("TCP recovery   %d\tcwnd\t%u\tssthresh\t%u\n",
+	   GET_STAT(iface, tcp.recovery),
+	   GET_STAT(iface, tcp.cwnd),
+	   GET_STAT(iface, tcp.ssthresh));
+#endif
 #endif
 
 	PR("Bytes received %u\n", GET_STAT(iface, bytes.received));
@@ -1291,6 +1317,7 @@ static void net_shell_print_statistics(struct net_if *iface, void *user_data)
 
 	print_tc_tx_stats(sh, iface);
 	print_tc_rx_stats(sh, iface);
+	print_rx_queue_stats(sh, iface);
 
 #if defined(CONFIG_NET_STATISTICS_ETHERNET) && \
 					defined(CONFIG_NET_STATISTICS_USER_API)
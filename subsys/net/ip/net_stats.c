@@ -152,6 +152,12 @@ static inline void stats(struct net_if *iface)
 		NET_INFO("TCP conn drop  %d\tconnrst\t%d",
 			 GET_STAT(iface, tcp.conndrop),
 			 GET_STAT(iface, tcp.connrst));
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+		NET_INFO("TCP recovery   %d\tcwnd\t%u\tssthresh\t%u",
+			 GET_STAT(iface, tcp.recovery),
+			 GET_STAT(iface, tcp.cwnd),
+			 GET_STAT(iface, tcp.ssthresh));
+#endif
 #endif
 
 		NET_INFO("Bytes received %u", GET_STAT(iface, bytes.received));
@@ -191,6 +197,18 @@ static inline void stats(struct net_if *iface)
 		ARG_UNUSED(i);
 #endif /* NET_TC_COUNT > 1 */
 
+#if NET_TC_RX_QUEUES > 1
+		NET_INFO("RX queue statistics:");
+		NET_INFO("TC.Q   Recv pkts\tbytes");
+
+		for (i = 0; i < NET_TC_RX_COUNT * NET_TC_RX_QUEUES; i++) {
+			NET_INFO("[%d.%d]  %d\t\t%d", i / NET_TC_RX_QUEUES,
+				 i % NET_TC_RX_QUEUES,
+				 GET_STAT(iface, rxq[i].pkts),
+				 GET_STAT(iface, rxq[i].bytes));
+		}
+#endif
+
 #if defined(CONFIG_NET_STATISTICS_POWER_MANAGEMENT)
 		NET_INFO("Power management statistics:");
 		NET_INFO("Last suspend time: %u ms",
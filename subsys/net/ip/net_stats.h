@@ -258,6 +258,18 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 {
 	UPDATE_STAT(iface, stats.tcp.rexmit++);
 }
+
+static inline void net_stats_update_tcp_recovery(struct net_if *iface)
+{
+	UPDATE_STAT(iface, stats.tcp.recovery++);
+}
+
+static inline void net_stats_update_tcp_cwnd(struct net_if *iface,
+					     uint32_t cwnd, uint32_t ssthresh)
+{
+	UPDATE_STAT(iface, stats.tcp.cwnd = cwnd);
+	UPDATE_STAT(iface, stats.tcp.ssthresh = ssthresh);
+}
 #else
 #define net_stats_update_tcp_sent(iface, bytes)
 #define net_stats_update_tcp_resent(iface, bytes)
@@ -273,6 +285,8 @@ static inline void net_stats_update_tcp_seg_rexmit(struct net_if *iface)
 #define net_stats_update_tcp_seg_ackerr(iface)
 #define net_stats_update_tcp_seg_rsterr(iface)
 #define net_stats_update_tcp_seg_rexmit(iface)
+#define net_stats_update_tcp_recovery(iface)
+#define net_stats_update_tcp_cwnd(iface, cwnd, ssthresh)
 #endif /* CONFIG_NET_STATISTICS_TCP */
 
 static inline void net_stats_update_per_proto_recv(struct net_if *iface,
@@ -411,6 +425,18 @@ static inline void net_stats_update_rx_time_detail(struct net_if *iface,
 #define net_stats_update_rx_time_detail(iface, detail_stat)
 #endif /* NET_PKT_RXTIME_STATS_DETAIL */
 
+#if (NET_TC_RX_QUEUES > 1) && defined(CONFIG_NET_STATISTICS) \
+	&& defined(CONFIG_NET_NATIVE)
+static inline void net_stats_update_rx_queue(struct net_if *iface,
+					     uint8_t queue, size_t bytes)
+{
+	UPDATE_STAT(iface, stats.rxq[queue].pkts++);
+	UPDATE_STAT(iface, stats.rxq[queue].bytes += bytes);
+}
+#else
+#define net_stats_update_rx_queue(iface, queue, bytes)
+#endif
+
 #if (NET_TC_COUNT > 1) && defined(CONFIG_NET_STATISTICS) \
 	&& defined(CONFIG_NET_NATIVE)
 static inline void net_stats_update_tc_sent_pkt(struct net_if *iface, uint8_t tc)
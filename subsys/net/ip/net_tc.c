@@ -13,6 +13,8 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 #include <zephyr/net/net_core.h>
 #include <zephyr/net/net_pkt.h>
 #include <zephyr/net/net_stats.h>
+#include <zephyr/net/ethernet.h>
+#include <zephyr/sys/byteorder.h>
 
 #include "net_private.h"
 #include "net_stats.h"
@@ -21,15 +23,19 @@ LOG_MODULE_REGISTER(net_tc, CONFIG_NET_TC_LOG_LEVEL);
 /* Template for thread name. The "xx" is either "TX" denoting transmit thread,
  * or "RX" denoting receive thread. The "q[y]" denotes the traffic class queue
  * where y indicates the traffic class id. The value of y can be from 0 to 7.
+ * With several RX queues per traffic class, ".z" is the queue of the class.
  */
-#define MAX_NAME_LEN sizeof("xx_q[y]")
+#define MAX_NAME_LEN sizeof("xx_q[y.z]")
+
+/* Total number of RX queues, NET_TC_RX_QUEUES for each traffic class */
+#define NET_TC_RX_QUEUE_COUNT (NET_TC_RX_COUNT * NET_TC_RX_QUEUES)
 
 /* Stacks for TX work queue */
 K_KERNEL_STACK_ARRAY_DEFINE(tx_stack, NET_TC_TX_COUNT,
 			    CONFIG_NET_TX_STACK_SIZE);
 
 /* Stacks for RX work queue */
-K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
+K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_QUEUE_COUNT,
 			    CONFIG_NET_RX_STACK_SIZE);
 
 #if NET_TC_TX_COUNT > 0
@@ -37,9 +43,136 @@ static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
 #if NET_TC_RX_COUNT > 0
-static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct net_traffic_class rx_classes[NET_TC_RX_QUEUE_COUNT];
 #endif
 
+#if NET_TC_RX_QUEUES > 1
+/* FNV-1a, the fields are not aligned in the frame */
+static uint32_t rx_flow_hash_add(uint32_t hash, const uint8_t *data,
+				 size_t len)
+{
+	while (len--) {
+		hash = (hash ^ *data++) * 16777619U;
+	}
+
+	return hash;
+}
+
+/* Hash addresses, protocol and, for TCP and UDP, ports of an IP packet */
+static uint32_t rx_flow_hash(const uint8_t *data, size_t len)
+{
+	uint32_t hash = 2166136261U;
+	size_t hdr_len;
+	uint8_t proto;
+
+	if (len == 0) {
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_IPV4) && (data[0] >> 4) == 4) {
+		const struct net_ipv4_hdr *hdr = (const void *)data;
+
+		if (len < sizeof(*hdr)) {
+			return 0;
+		}
+
+		hash = rx_flow_hash_add(hash, hdr->src, sizeof(hdr->src));
+		hash = rx_flow_hash_add(hash, hdr->dst, sizeof(hdr->dst));
+		proto = hdr->proto;
+		hdr_len = (hdr->vhl & 0x0f) * 4U;
+
+		/* Only the first fragment has the ports, keep all of
+		 * them on the same queue.
+		 */
+		if ((sys_get_be16(hdr->offset) &
+		     (NET_IPV4_FRAGH_OFFSET_MASK | NET_IPV4_MORE_FRAG_MASK)) != 0) {
+			proto = 0;
+		}
+	} else if (IS_ENABLED(CONFIG_NET_IPV6) && (data[0] >> 4) == 6) {
+		const struct net_ipv6_hdr *hdr = (const void *)data;
+
+		if (len < sizeof(*hdr)) {
+			return 0;
+		}
+
+		hash = rx_flow_hash_add(hash, hdr->src, sizeof(hdr->src));
+		hash = rx_flow_hash_add(hash, hdr->dst, sizeof(hdr->dst));
+		/* Extension headers are not walked, such packets are
+		 * hashed on the addresses only.
+		 */
+		proto = hdr->nexthdr;
+		hdr_len = sizeof(*hdr);
+	} else {
+		return 0;
+	}
+
+	hash = rx_flow_hash_add(hash, &proto, sizeof(proto));
+
+	if ((proto == IPPROTO_TCP || proto == IPPROTO_UDP) &&
+	    len >= hdr_len + 2 * sizeof(uint16_t)) {
+		/* Source and destination port */
+		hash = rx_flow_hash_add(hash, data + hdr_len,
+					2 * sizeof(uint16_t));
+	}
+
+	return hash;
+}
+
+/* Select the queue of a traffic class for a packet. The packet has not
+ * been through L2 yet, so the headers are looked up in its first buffer,
+ * which is enough for Ethernet and for L2s passing bare IP packets.
+ * Anything else goes to the first queue.
+ */
+static uint8_t rx_flow_queue(struct net_pkt *pkt)
+{
+	const uint8_t *data;
+	size_t len;
+
+	if (pkt->buffer == NULL) {
+		return 0;
+	}
+
+	data = pkt->buffer->data;
+	len = pkt->buffer->len;
+
+#if defined(CONFIG_NET_L2_ETHERNET)
+	if (net_if_l2(net_pkt_iface(pkt)) == &NET_L2_GET_NAME(ETHERNET)) {
+		const struct net_eth_hdr *hdr = (const void *)data;
+		size_t hdr_len = sizeof(*hdr);
+		uint16_t type;
+
+		if (len < hdr_len) {
+			return 0;
+		}
+
+		type = ntohs(hdr->type);
+		if (type == NET_ETH_PTYPE_VLAN) {
+			/* Skip the tag, the real type follows it */
+			hdr_len += sizeof(uint32_t);
+			if (len < hdr_len) {
+				return 0;
+			}
+
+			type = sys_get_be16(data + hdr_len - sizeof(uint16_t));
+		}
+
+		if (type != NET_ETH_PTYPE_IP && type != NET_ETH_PTYPE_IPV6) {
+			return 0;
+		}
+
+		data += hdr_len;
+		len -= hdr_len;
+	}
+#endif
+
+	/* The low bits of FNV-1a only depend on the low bits of each byte,
+	 * flows differing in the same bits of several fields would end up on
+	 * the same queue. Take the queue from the high bits instead.
+	 */
+	return ((uint64_t)rx_flow_hash(data, len) * NET_TC_RX_QUEUES) >> 32;
+}
+#endif /* NET_TC_RX_QUEUES > 1 */
+
 #if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
 static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
@@ -63,9 +196,18 @@ bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
 void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 {
 #if NET_TC_RX_COUNT > 0
+	uint8_t queue = tc * NET_TC_RX_QUEUES;
+
+#if NET_TC_RX_QUEUES > 1
+	queue += rx_flow_queue(pkt);
+
+	net_stats_update_rx_queue(net_pkt_iface(pkt), queue,
+				  net_pkt_get_len(pkt));
+#endif
+
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
-	submit_to_queue(&rx_classes[tc].fifo, pkt);
+	submit_to_queue(&rx_classes[queue].fifo, pkt);
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
@@ -343,12 +485,13 @@ void net_tc_rx_init(void)
 	net_if_foreach(net_tc_rx_stats_priority_setup, NULL);
 #endif
 
-	for (i = 0; i < NET_TC_RX_COUNT; i++) {
+	for (i = 0; i < NET_TC_RX_QUEUE_COUNT; i++) {
 		uint8_t thread_priority;
 		int priority;
 		k_tid_t tid;
 
-		thread_priority = rx_tc2thread(i);
+		/* All the queues of a traffic class share its priority */
+		thread_priority = rx_tc2thread(i / NET_TC_RX_QUEUES);
 
 		priority = IS_ENABLED(CONFIG_NET_TC_THREAD_COOPERATIVE) ?
 			K_PRIO_COOP(thread_priority) :
@@ -378,10 +521,22 @@ void net_tc_rx_init(void)
 		if (IS_ENABLED(CONFIG_THREAD_NAME)) {
 			char name[MAX_NAME_LEN];
 
-			snprintk(name, sizeof(name), "rx_q[%d]", i);
+			if (NET_TC_RX_QUEUES > 1) {
+				snprintk(name, sizeof(name), "rx_q[%d.%d]",
+					 i / NET_TC_RX_QUEUES,
+					 i % NET_TC_RX_QUEUES);
+			} else {
+				snprintk(name, sizeof(name), "rx_q[%d]", i);
+			}
+
 			k_thread_name_set(tid, name);
 		}
 
+#if defined(CONFIG_NET_TC_RX_FLOW_CPU_AFFINITY)
+		(void)k_thread_cpu_pin(tid, (i % NET_TC_RX_QUEUES) %
+					    arch_num_cpus());
+#endif
+
 		k_thread_start(tid);
 	}
 #endif
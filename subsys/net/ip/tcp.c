@@ -56,6 +56,11 @@ static sys_slist_t tcp_conns = SYS_SLIST_STATIC_INIT(&tcp_conns);
 
 static K_MUTEX_DEFINE(tcp_lock);
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Connections whose endpoints are known, hashed by their 4-tuple */
+static sys_slist_t tcp_conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+#endif
+
 K_MEM_SLAB_DEFINE_STATIC(tcp_conns_slab, sizeof(struct tcp),
 				CONFIG_NET_MAX_CONTEXTS, 4);
 
@@ -222,6 +227,55 @@ static int tcp_endpoint_set(union tcp_endpoint *ep, struct net_pkt *pkt,
 	return ret;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+static sys_slist_t *tcp_conn_hash_bucket(const union tcp_endpoint *local,
+					 const union tcp_endpoint *remote)
+{
+	uint32_t hash = ((uint32_t)local->sin.sin_port << 16) |
+			remote->sin.sin_port;
+
+	/* The low order address bits carry nearly all the entropy */
+	if (IS_ENABLED(CONFIG_NET_IPV6) && local->sa.sa_family == AF_INET6) {
+		hash ^= local->sin6.sin6_addr.s6_addr32[3] ^
+			remote->sin6.sin6_addr.s6_addr32[3];
+	} else {
+		hash ^= local->sin.sin_addr.s_addr ^
+			remote->sin.sin_addr.s_addr;
+	}
+
+	hash *= 0x9e3779b1U;
+
+	return &tcp_conn_hash[(hash ^ (hash >> 16)) &
+			      (CONFIG_NET_CONN_HASH_BUCKETS - 1)];
+}
+
+/* Must be called whenever conn->src and conn->dst have been (re)set */
+static void tcp_conn_hash_add(struct tcp *conn)
+{
+	k_mutex_lock(&tcp_lock, K_FOREVER);
+
+	if (conn->hash_bucket != NULL) {
+		sys_slist_find_and_remove(conn->hash_bucket, &conn->hash_node);
+	}
+
+	conn->hash_bucket = tcp_conn_hash_bucket(&conn->src, &conn->dst);
+	sys_slist_prepend(conn->hash_bucket, &conn->hash_node);
+
+	k_mutex_unlock(&tcp_lock);
+}
+
+static void tcp_conn_hash_del(struct tcp *conn)
+{
+	if (conn->hash_bucket != NULL) {
+		sys_slist_find_and_remove(conn->hash_bucket, &conn->hash_node);
+		conn->hash_bucket = NULL;
+	}
+}
+#else
+#define tcp_conn_hash_add(...)
+#define tcp_conn_hash_del(...)
+#endif /* CONFIG_NET_CONN_HASH */
+
 static const char *tcp_flags(uint8_t flags)
 {
 #define BUF_SIZE 25 /* 6 * 4 + 1 */
@@ -453,6 +507,7 @@ static int tcp_conn_unref(struct tcp *conn)
 	(void)k_work_cancel_delayable(&conn->ack_timer);
 
 	sys_slist_find_and_remove(&tcp_conns, &conn->next);
+	tcp_conn_hash_del(conn);
 
 	memset(conn, 0, sizeof(*conn));
 
@@ -960,6 +1015,45 @@ static int get_tcp_nodelay(struct tcp *conn, void *value, size_t *len)
 	return 0;
 }
 
+static int set_tcp_congestion(struct tcp *conn, const void *value, size_t len)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	const struct tcp_cc_ops *ops;
+
+	ops = tcp_cc_find(value, len);
+	if (ops == NULL) {
+		return -ENOENT;
+	}
+
+	if (ops != conn->cc.ops) {
+		tcp_cc_set_ops(&conn->cc, ops);
+	}
+
+	return 0;
+#else
+	return -ENOPROTOOPT;
+#endif
+}
+
+static int get_tcp_congestion(struct tcp *conn, void *value, size_t *len)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	size_t name_len = strlen(conn->cc.ops->name) + 1;
+
+	if (len == NULL) {
+		return -EINVAL;
+	}
+
+	/* Like Linux, silently truncate the name to the buffer size */
+	*len = MIN(*len, name_len);
+	memcpy(value, conn->cc.ops->name, *len);
+
+	return 0;
+#else
+	return -ENOPROTOOPT;
+#endif
+}
+
 static int net_tcp_set_mss_opt(struct tcp *conn, struct net_pkt *pkt)
 {
 	NET_PKT_DATA_ACCESS_DEFINE(mss_opt_access, struct tcp_mss_option);
@@ -1111,6 +1205,26 @@ static int tcp_pkt_peek(struct net_pkt *to, struct net_pkt *from, size_t pos,
 	return net_pkt_copy(to, from, len);
 }
 
+/* Amount of data we may have in flight: the peer's receive window,
+ * further limited by the congestion window if there is one.
+ */
+static int tcp_send_window(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return MIN(conn->send_win, conn->cc.cwnd);
+#else
+	return conn->send_win;
+#endif
+}
+
+static inline void tcp_cc_stats_update(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	net_stats_update_tcp_cwnd(conn->iface, conn->cc.cwnd,
+				  conn->cc.ssthresh);
+#endif
+}
+
 static bool tcp_window_full(struct tcp *conn)
 {
 	bool window_full = (conn->send_data_total >= conn->send_win);
@@ -1120,6 +1234,13 @@ static bool tcp_window_full(struct tcp *conn)
 	return window_full;
 }
 
+static inline void tcp_notify_writable(struct tcp *conn)
+{
+	if (conn->context) {
+		net_context_notify_writable(conn->context);
+	}
+}
+
 static int tcp_unsent_len(struct tcp *conn)
 {
 	int unsent_len;
@@ -1132,10 +1253,11 @@ static int tcp_unsent_len(struct tcp *conn)
 	}
 
 	unsent_len = conn->send_data_total - conn->unacked_len;
-	if (conn->unacked_len >= conn->send_win) {
+	if (conn->unacked_len >= tcp_send_window(conn)) {
 		unsent_len = 0;
 	} else {
-		unsent_len = MIN(unsent_len, conn->send_win - conn->unacked_len);
+		unsent_len = MIN(unsent_len,
+				 tcp_send_window(conn) - conn->unacked_len);
 	}
  out:
 	NET_DBG("unsent_len=%d", unsent_len);
@@ -1147,10 +1269,14 @@ static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
 	int len;
+	int window;
 	struct net_pkt *pkt;
 
+	/* The congestion window may have shrunk below what is in flight */
+	window = MAX(tcp_send_window(conn) - conn->unacked_len, 0);
+
 	len = MIN3(conn->send_data_total - conn->unacked_len,
-		   conn->send_win - conn->unacked_len,
+		   window,
 		   conn_mss(conn));
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
@@ -1245,6 +1371,43 @@ static int tcp_send_queued_data(struct tcp *conn)
 	return ret;
 }
 
+#ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
+/* Resend the first unacknowledged segment */
+static void tcp_fast_retransmit(struct tcp *conn)
+{
+	int temp_unacked_len = conn->unacked_len;
+
+	conn->unacked_len = 0;
+
+	(void)tcp_send_data(conn);
+
+	/* Restore the current transmission */
+	conn->unacked_len = temp_unacked_len;
+}
+#endif
+
+static inline bool tcp_in_fast_recovery(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	return conn->cc.in_recovery;
+#else
+	return false;
+#endif
+}
+
+/* (Re)start congestion control once the connection is established and
+ * the peer's MSS is known.
+ */
+static void tcp_cc_start(struct tcp *conn)
+{
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_init(&conn->cc, conn_mss(conn));
+	tcp_cc_stats_update(conn);
+#else
+	ARG_UNUSED(conn);
+#endif
+}
+
 static void tcp_cleanup_recv_queue(struct k_work *work)
 {
 	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
@@ -1280,6 +1443,16 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	/* Only the first timeout of a retransmission episode reduces
+	 * ssthresh, RFC 5681 section 3.1.
+	 */
+	if (conn->data_mode == TCP_DATA_MODE_SEND && conn->unacked_len > 0) {
+		tcp_cc_timeout(&conn->cc, conn->unacked_len);
+		tcp_cc_stats_update(conn);
+	}
+#endif
+
 	conn->data_mode = TCP_DATA_MODE_RESEND;
 	conn->unacked_len = 0;
 
@@ -1474,6 +1647,10 @@ static struct tcp *tcp_conn_alloc(struct net_context *context)
 	 */
 	conn->seq = 0U;
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+	tcp_cc_init(&conn->cc, NET_TCP_DEFAULT_MSS);
+#endif
+
 	sys_slist_init(&conn->send_queue);
 
 	k_work_init_delayable(&conn->send_timer, tcp_send_process);
@@ -1524,6 +1701,7 @@ out:
 	return ret;
 }
 
+#if !defined(CONFIG_NET_CONN_HASH)
 static bool tcp_endpoint_cmp(union tcp_endpoint *ep, struct net_pkt *pkt,
 			     enum pkt_addr which)
 {
@@ -1541,7 +1719,35 @@ static bool tcp_conn_cmp(struct tcp *conn, struct net_pkt *pkt)
 	return tcp_endpoint_cmp(&conn->src, pkt, TCP_EP_DST) &&
 		tcp_endpoint_cmp(&conn->dst, pkt, TCP_EP_SRC);
 }
+#endif
 
+#if defined(CONFIG_NET_CONN_HASH)
+static struct tcp *tcp_conn_search(struct net_pkt *pkt)
+{
+	union tcp_endpoint local;
+	union tcp_endpoint remote;
+	sys_slist_t *bucket;
+	struct tcp *conn;
+	size_t len;
+
+	if (tcp_endpoint_set(&local, pkt, TCP_EP_DST) < 0 ||
+	    tcp_endpoint_set(&remote, pkt, TCP_EP_SRC) < 0) {
+		return NULL;
+	}
+
+	len = tcp_endpoint_len(local.sa.sa_family);
+	bucket = tcp_conn_hash_bucket(&local, &remote);
+
+	SYS_SLIST_FOR_EACH_CONTAINER(bucket, conn, hash_node) {
+		if (!memcmp(&conn->src, &local, len) &&
+		    !memcmp(&conn->dst, &remote, len)) {
+			return conn;
+		}
+	}
+
+	return NULL;
+}
+#else
 static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 {
 	bool found = false;
@@ -1557,6 +1763,7 @@ static struct tcp *tcp_conn_search(struct net_pkt *pkt)
 
 	return found ? conn : NULL;
 }
+#endif /* CONFIG_NET_CONN_HASH */
 
 static struct tcp *tcp_conn_new(struct net_pkt *pkt);
 
@@ -1734,6 +1941,8 @@ static struct tcp *tcp_conn_new(struct net_pkt *pkt)
 		goto err;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	NET_DBG("conn: src: %s, dst: %s",
 		net_sprint_addr(conn->src.sa.sa_family,
 				(const void *)&conn->src.sin.sin_addr),
@@ -2144,6 +2353,7 @@ static enum net_verdict tcp_in(struct tcp *conn, struct net_pkt *pkt)
 			(void)k_sem_take(&conn->tx_sem, K_NO_WAIT);
 		} else {
 			k_sem_give(&conn->tx_sem);
+			tcp_notify_writable(conn);
 		}
 	}
 
@@ -2180,6 +2390,7 @@ next_state:
 			k_work_cancel_delayable(&conn->establish_timer);
 			tcp_send_timer_cancel(conn);
 			next = TCP_ESTABLISHED;
+			tcp_cc_start(conn);
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -2221,6 +2432,7 @@ next_state:
 			}
 
 			next = TCP_ESTABLISHED;
+			tcp_cc_start(conn);
 			tcp_conn_ref(conn);
 			net_context_set_state(conn->context,
 					      NET_CONTEXT_CONNECTED);
@@ -2267,6 +2479,8 @@ next_state:
 
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
 		if (th && (net_tcp_seq_cmp(th_ack(th), conn->seq) == 0)) {
+			bool dup_ack = false;
+
 			/* Only if there is pending data, increment the duplicate ack count */
 			if (conn->send_data_total > 0) {
 				/* There could be also payload, only without payload account them */
@@ -2276,6 +2490,7 @@ next_state:
 					 */
 					conn->dup_ack_cnt = MIN(conn->dup_ack_cnt + 1,
 						DUPLICATE_ACK_RETRANSMIT_TRHESHOLD + 1);
+					dup_ack = true;
 				}
 			} else {
 				conn->dup_ack_cnt = 0;
@@ -2283,16 +2498,24 @@ next_state:
 
 			/* Only do fast retransmit when not already in a resend state */
 			if ((conn->data_mode == TCP_DATA_MODE_SEND) &&
+			    !tcp_in_fast_recovery(conn) &&
 			    (conn->dup_ack_cnt == DUPLICATE_ACK_RETRANSMIT_TRHESHOLD)) {
-				/* Apply a fast retransmit */
-				int temp_unacked_len = conn->unacked_len;
-
-				conn->unacked_len = 0;
-
-				(void)tcp_send_data(conn);
-
-				/* Restore the current transmission */
-				conn->unacked_len = temp_unacked_len;
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+				tcp_cc_enter_recovery(&conn->cc, conn->unacked_len,
+						      conn->seq + conn->unacked_len);
+				tcp_cc_stats_update(conn);
+				net_stats_update_tcp_recovery(conn->iface);
+#endif
+				tcp_fast_retransmit(conn);
+			} else if (dup_ack && tcp_in_fast_recovery(conn)) {
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+				/* Each further duplicate ACK means a segment has
+				 * left the network, inflate the window and send
+				 * new data if it allows.
+				 */
+				tcp_cc_dup_ack(&conn->cc);
+				(void)tcp_send_queued_data(conn);
+#endif
 			}
 		}
 #endif
@@ -2329,11 +2552,24 @@ next_state:
 
 			if (!tcp_window_full(conn)) {
 				k_sem_give(&conn->tx_sem);
+				tcp_notify_writable(conn);
 			}
 
 			conn_seq(conn, + len_acked);
 			net_stats_update_tcp_seg_recv(conn->iface);
 
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+			/* A partial ACK during fast recovery means the next
+			 * segment was lost as well, resend it right away
+			 * (RFC 6582).
+			 */
+			if (tcp_cc_ack(&conn->cc, len_acked, th_ack(th),
+				       conn->unacked_len)) {
+				tcp_fast_retransmit(conn);
+			}
+			tcp_cc_stats_update(conn);
+#endif
+
 			conn_send_data_dump(conn);
 
 			if (!k_work_delayable_remaining_get(
@@ -2475,6 +2711,7 @@ next_state:
 
 		if (connection_ok) {
 			k_sem_give(&conn->connect_sem);
+			tcp_notify_writable(conn);
 		}
 
 		goto next_state;
@@ -2815,8 +3052,11 @@ int net_tcp_connect(struct net_context *context,
 
 	default:
 		ret = -EPROTONOSUPPORT;
+		goto out;
 	}
 
+	tcp_conn_hash_add(conn);
+
 	if (!(IS_ENABLED(CONFIG_NET_TEST_PROTOCOL) ||
 	      IS_ENABLED(CONFIG_NET_TEST))) {
 		conn->seq = tcp_init_isn(&conn->src.sa, &conn->dst.sa);
@@ -3023,6 +3263,7 @@ static enum net_verdict tcp_input(struct net_conn *net_conn,
 			conn = context->tcp;
 			tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 			tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+			tcp_conn_hash_add(conn);
 			/* Make an extra reference, the sanity check suite
 			 * will delete the connection explicitly
 			 */
@@ -3145,6 +3386,7 @@ enum net_verdict tp_input(struct net_conn *net_conn,
 				conn = context->tcp;
 				tcp_endpoint_set(&conn->dst, pkt, TCP_EP_SRC);
 				tcp_endpoint_set(&conn->src, pkt, TCP_EP_DST);
+				tcp_conn_hash_add(conn);
 				conn->iface = pkt->iface;
 				tcp_conn_ref(conn);
 			}
@@ -3332,6 +3574,9 @@ int net_tcp_set_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = set_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = set_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
@@ -3357,6 +3602,9 @@ int net_tcp_get_option(struct net_context *context,
 	case TCP_OPT_NODELAY:
 		ret = get_tcp_nodelay(conn, value, len);
 		break;
+	case TCP_OPT_CONGESTION:
+		ret = get_tcp_congestion(conn, value, len);
+		break;
 	}
 
 	k_mutex_unlock(&conn->lock);
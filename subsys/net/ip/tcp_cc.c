@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generic TCP congestion control: slow start, congestion avoidance
+ * hooks, and NewReno fast recovery (RFC 5681, RFC 6582). The NewReno
+ * window growth and reduction also live here as the default
+ * algorithm.
+ */
+
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "tcp_cc.h"
+
+static const struct tcp_cc_ops *const algorithms[] = {
+	&tcp_cc_newreno,
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+	&tcp_cc_cubic,
+#endif
+};
+
+/* Sequence number comparison, see net_tcp_seq_cmp() */
+static inline bool seq_geq(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) >= 0;
+}
+
+static inline void cwnd_set(struct tcp_cc *cc, uint32_t cwnd)
+{
+	cc->cwnd = CLAMP(cwnd, cc->mss, TCP_CC_CWND_MAX);
+}
+
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len)
+{
+	size_t name_len = strnlen(name, MIN(len, TCP_CC_NAME_MAX));
+
+	/* Longer than any algorithm name, no need to look further */
+	if (name_len == TCP_CC_NAME_MAX) {
+		return NULL;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(algorithms); i++) {
+		if (strlen(algorithms[i]->name) == name_len &&
+		    strncmp(algorithms[i]->name, name, name_len) == 0) {
+			return algorithms[i];
+		}
+	}
+
+	return NULL;
+}
+
+const struct tcp_cc_ops *tcp_cc_default(void)
+{
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+	return &tcp_cc_cubic;
+#else
+	return &tcp_cc_newreno;
+#endif
+}
+
+void tcp_cc_init(struct tcp_cc *cc, uint16_t mss)
+{
+	if (cc->ops == NULL) {
+		cc->ops = tcp_cc_default();
+	}
+
+	cc->mss = mss;
+	cc->ssthresh = UINT32_MAX;
+	cc->cwnd_acked = 0U;
+	cc->in_recovery = false;
+
+	/* Initial window, RFC 5681 section 3.1 */
+	if (mss > 2190) {
+		cc->cwnd = 2 * mss;
+	} else if (mss > 1095) {
+		cc->cwnd = 3 * mss;
+	} else {
+		cc->cwnd = 4 * mss;
+	}
+
+	tcp_cc_set_ops(cc, cc->ops);
+}
+
+void tcp_cc_set_ops(struct tcp_cc *cc, const struct tcp_cc_ops *ops)
+{
+	cc->ops = ops;
+	memset(cc->priv, 0, sizeof(cc->priv));
+
+	if (ops->init != NULL) {
+		ops->init(cc);
+	}
+}
+
+bool tcp_cc_ack(struct tcp_cc *cc, uint32_t acked, uint32_t ack,
+		uint32_t flight)
+{
+	if (cc->in_recovery) {
+		if (seq_geq(ack, cc->recover)) {
+			/* Full acknowledgment, RFC 6582 section 3.2 step 3 */
+			cwnd_set(cc, MIN(cc->ssthresh, MAX(flight, cc->mss) + cc->mss));
+			cc->in_recovery = false;
+			cc->cwnd_acked = 0U;
+
+			return false;
+		}
+
+		/* Partial acknowledgment: deflate by the amount acked and
+		 * add back one MSS if at least that much was acked.
+		 */
+		cwnd_set(cc, (cc->cwnd > acked ? cc->cwnd - acked : 0) +
+			     (acked >= cc->mss ? cc->mss : 0));
+
+		return true;
+	}
+
+	if (cc->cwnd < cc->ssthresh) {
+		/* Slow start, at most one MSS per ACK (RFC 5681, 3.1) */
+		cwnd_set(cc, cc->cwnd + MIN(acked, cc->mss));
+	} else {
+		cc->ops->cong_avoid(cc, acked);
+		cwnd_set(cc, cc->cwnd);
+	}
+
+	return false;
+}
+
+void tcp_cc_enter_recovery(struct tcp_cc *cc, uint32_t flight,
+			   uint32_t snd_nxt)
+{
+	cc->ssthresh = cc->ops->ssthresh(cc, flight);
+	cwnd_set(cc, cc->ssthresh + 3 * cc->mss);
+	cc->recover = snd_nxt;
+	cc->cwnd_acked = 0U;
+	cc->in_recovery = true;
+}
+
+void tcp_cc_dup_ack(struct tcp_cc *cc)
+{
+	if (cc->in_recovery) {
+		cwnd_set(cc, cc->cwnd + cc->mss);
+	}
+}
+
+void tcp_cc_timeout(struct tcp_cc *cc, uint32_t flight)
+{
+	cc->ssthresh = cc->ops->ssthresh(cc, flight);
+	cwnd_set(cc, cc->mss);
+	cc->cwnd_acked = 0U;
+	cc->in_recovery = false;
+}
+
+static void newreno_cong_avoid(struct tcp_cc *cc, uint32_t acked)
+{
+	/* One MSS per window worth of acknowledged data */
+	cc->cwnd_acked += acked;
+	if (cc->cwnd_acked >= cc->cwnd) {
+		cc->cwnd_acked -= cc->cwnd;
+		cc->cwnd += cc->mss;
+	}
+}
+
+static uint32_t newreno_ssthresh(struct tcp_cc *cc, uint32_t flight)
+{
+	return MAX(flight / 2, 2U * cc->mss);
+}
+
+const struct tcp_cc_ops tcp_cc_newreno = {
+	.name = "newreno",
+	.cong_avoid = newreno_cong_avoid,
+	.ssthresh = newreno_ssthresh,
+};
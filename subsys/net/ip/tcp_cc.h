@@ -0,0 +1,145 @@
+/** @file
+ @brief TCP congestion control
+
+ This is not to be included by the application.
+ */
+
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef __TCP_CC_H
+#define __TCP_CC_H
+
+#include <zephyr/types.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum length of an algorithm name, including the terminator */
+#define TCP_CC_NAME_MAX 16
+
+/** Upper bound of the congestion window, in bytes */
+#define TCP_CC_CWND_MAX (1U << 20)
+
+struct tcp_cc;
+
+/**
+ * A congestion control algorithm. The generic code in tcp_cc.c deals
+ * with slow start, fast retransmit/fast recovery (RFC 5681, RFC 6582)
+ * and retransmission timeouts, and asks the algorithm how to grow the
+ * window in congestion avoidance and how far to cut it on loss.
+ */
+struct tcp_cc_ops {
+	/** Name used to select the algorithm with TCP_CONGESTION */
+	const char *name;
+
+	/** Reset the private state, optional */
+	void (*init)(struct tcp_cc *cc);
+
+	/** Grow cwnd after @a acked bytes were acknowledged while
+	 *  cwnd >= ssthresh and not in fast recovery.
+	 */
+	void (*cong_avoid)(struct tcp_cc *cc, uint32_t acked);
+
+	/** Return the new ssthresh once a loss has been detected with
+	 *  @a flight bytes outstanding.
+	 */
+	uint32_t (*ssthresh)(struct tcp_cc *cc, uint32_t flight);
+};
+
+/** Per connection congestion control state */
+struct tcp_cc {
+	const struct tcp_cc_ops *ops;
+	uint32_t cwnd;
+	uint32_t ssthresh;
+	/* Bytes acknowledged towards the next cwnd increment */
+	uint32_t cwnd_acked;
+	/* Highest sequence number sent when fast recovery started */
+	uint32_t recover;
+	uint16_t mss;
+	bool in_recovery;
+	/* Algorithm private state */
+	uint32_t priv[6];
+};
+
+extern const struct tcp_cc_ops tcp_cc_newreno;
+#if defined(CONFIG_NET_TCP_CC_CUBIC)
+extern const struct tcp_cc_ops tcp_cc_cubic;
+#endif
+
+/**
+ * @brief Look up a congestion control algorithm by name
+ *
+ * @param name Algorithm name, need not be NUL terminated
+ * @param len Maximum length of @a name, only the first TCP_CC_NAME_MAX
+ *        bytes are looked at
+ *
+ * @return Algorithm, or NULL if there is none by that name
+ */
+const struct tcp_cc_ops *tcp_cc_find(const char *name, size_t len);
+
+/** @brief Algorithm selected by CONFIG_NET_TCP_CC_DEFAULT_* */
+const struct tcp_cc_ops *tcp_cc_default(void);
+
+/**
+ * @brief (Re)start congestion control for a connection
+ *
+ * Sets the initial window (RFC 5681) for the given MSS and an
+ * unbounded ssthresh. The algorithm in cc->ops is kept, or the
+ * default one is used if none is set.
+ */
+void tcp_cc_init(struct tcp_cc *cc, uint16_t mss);
+
+/**
+ * @brief Switch a connection to another algorithm
+ *
+ * The current window is kept, only the algorithm private state is
+ * reset.
+ */
+void tcp_cc_set_ops(struct tcp_cc *cc, const struct tcp_cc_ops *ops);
+
+/**
+ * @brief New data was acknowledged
+ *
+ * @param cc Congestion control state
+ * @param acked Number of newly acknowledged bytes
+ * @param ack Acknowledgment number of the segment
+ * @param flight Bytes still outstanding after this ACK
+ *
+ * @return true if this was a partial ACK during fast recovery, in which
+ *         case the first unacknowledged segment must be retransmitted.
+ */
+bool tcp_cc_ack(struct tcp_cc *cc, uint32_t acked, uint32_t ack,
+		uint32_t flight);
+
+/**
+ * @brief Enter fast recovery on the third duplicate ACK
+ *
+ * @param cc Congestion control state
+ * @param flight Bytes outstanding
+ * @param snd_nxt Next sequence number to be sent
+ */
+void tcp_cc_enter_recovery(struct tcp_cc *cc, uint32_t flight,
+			   uint32_t snd_nxt);
+
+/** @brief Additional duplicate ACK received during fast recovery */
+void tcp_cc_dup_ack(struct tcp_cc *cc);
+
+/**
+ * @brief The retransmission timer expired
+ *
+ * @param cc Congestion control state
+ * @param flight Bytes outstanding when the timer expired
+ */
+void tcp_cc_timeout(struct tcp_cc *cc, uint32_t flight);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TCP_CC_H */
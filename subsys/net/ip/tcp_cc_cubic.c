@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* CUBIC congestion control (RFC 8312) with C = 0.4 and beta = 0.7.
+ * Windows are kept in bytes and time in milliseconds, the cubic
+ * function is evaluated in 64 bit integer arithmetic.
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
+
+#include "tcp_cc.h"
+
+struct cubic {
+	/* Window just before the last reduction */
+	uint32_t w_max;
+	/* Start of the current congestion avoidance epoch, 0 if none */
+	uint32_t epoch_start;
+	/* Time to grow back to w_max, in ms */
+	uint32_t k;
+	/* Window the cubic function is centered on */
+	uint32_t origin;
+	/* Window standard TCP would have reached in this epoch */
+	uint32_t w_est;
+};
+
+BUILD_ASSERT(sizeof(struct cubic) <= sizeof(((struct tcp_cc *)0)->priv));
+
+/* Limit on |t - K| so that the cube fits in 64 bits */
+#define CUBIC_MAX_DELTA_MS 100000
+
+static inline struct cubic *cubic_get(struct tcp_cc *cc)
+{
+	return (struct cubic *)cc->priv;
+}
+
+static uint32_t cbrt64(uint64_t x)
+{
+	uint64_t y = 0;
+
+	for (int s = 63; s >= 0; s -= 3) {
+		uint64_t b;
+
+		y <<= 1;
+		b = 3 * y * (y + 1) + 1;
+		if ((x >> s) >= b) {
+			x -= b << s;
+			y++;
+		}
+	}
+
+	return (uint32_t)y;
+}
+
+static void cubic_epoch_start(struct tcp_cc *cc, struct cubic *c,
+			      uint32_t now)
+{
+	c->epoch_start = MAX(now, 1U);
+	c->w_est = cc->cwnd;
+	cc->cwnd_acked = 0U;
+
+	if (cc->cwnd < c->w_max) {
+		/* K = cbrt((W_max - cwnd) / C) with W in segments and
+		 * K in seconds, i.e. K^3 = (W_max - cwnd) / mss * 2.5e9 ms^3
+		 */
+		c->k = cbrt64((uint64_t)(c->w_max - cc->cwnd) * 2500000000ULL /
+			      cc->mss);
+		c->origin = c->w_max;
+	} else {
+		c->k = 0U;
+		c->origin = cc->cwnd;
+	}
+}
+
+static void cubic_cong_avoid(struct tcp_cc *cc, uint32_t acked)
+{
+	struct cubic *c = cubic_get(cc);
+	uint32_t now = k_uptime_get_32();
+	int64_t delta;
+	int64_t target;
+	uint32_t needed;
+	int64_t t;
+
+	if (c->epoch_start == 0U) {
+		cubic_epoch_start(cc, c, now);
+	}
+
+	t = CLAMP((int64_t)(now - c->epoch_start) - c->k,
+		  -CUBIC_MAX_DELTA_MS, CUBIC_MAX_DELTA_MS);
+
+	/* W_cubic(t) = C * (t - K)^3 + W_max, C = 0.4 segments/s^3 */
+	delta = t * t * t / 1000000 * 4 * cc->mss / 10000;
+	target = (int64_t)c->origin + delta;
+
+	/* TCP friendly region, RFC 8312 section 4.2: standard TCP with
+	 * beta = 0.7 grows by 3 * (1 - beta) / (1 + beta) = 9/17 MSS per RTT.
+	 */
+	c->w_est += (uint32_t)((uint64_t)acked * cc->mss * 9 / (17ULL * cc->cwnd));
+	if (c->w_est > target) {
+		target = c->w_est;
+	}
+
+	/* Never more than 1.5 times the window per RTT */
+	target = MIN(target, (int64_t)cc->cwnd + cc->cwnd / 2);
+
+	if (target > cc->cwnd) {
+		needed = (uint32_t)((uint64_t)cc->cwnd * cc->mss /
+				    (uint32_t)(target - cc->cwnd));
+	} else {
+		needed = 100 * cc->cwnd;
+	}
+
+	cc->cwnd_acked += acked;
+	if (cc->cwnd_acked >= needed) {
+		cc->cwnd_acked -= needed;
+		cc->cwnd += cc->mss;
+	}
+}
+
+static uint32_t cubic_ssthresh(struct tcp_cc *cc, uint32_t flight)
+{
+	struct cubic *c = cubic_get(cc);
+
+	ARG_UNUSED(flight);
+
+	/* Fast convergence, RFC 8312 section 4.6 */
+	if (cc->cwnd < c->w_max) {
+		c->w_max = (uint32_t)((uint64_t)cc->cwnd * 17 / 20);
+	} else {
+		c->w_max = cc->cwnd;
+	}
+
+	c->epoch_start = 0U;
+
+	return MAX((uint32_t)((uint64_t)cc->cwnd * 7 / 10), 2U * cc->mss);
+}
+
+const struct tcp_cc_ops tcp_cc_cubic = {
+	.name = "cubic",
+	.cong_avoid = cubic_cong_avoid,
+	.ssthresh = cubic_ssthresh,
+};
@@ -5,6 +5,9 @@
  */
 
 #include "tp.h"
+#if defined(CONFIG_NET_TCP_CONGESTION_CONTROL)
+#include "tcp_cc.h"
+#endif
 
 #define is(_a, _b) (strcmp((_a), (_b)) == 0)
 
@@ -224,6 +227,10 @@ struct tcp_options {
 
 struct tcp { /* TCP connection */
 	sys_snode_t next;
+#if defined(CONFIG_NET_CONN_HASH)
+	sys_snode_t hash_node;
+	sys_slist_t *hash_bucket; /* NULL until both endpoints are set */
+#endif
 	struct net_context *context;
 	struct net_pkt *send_data;
 	struct net_pkt *queue_recv_data;
@@ -270,6 +277,9 @@ struct tcp { /* TCP connection */
 	uint16_t send_win;
 #ifdef CONFIG_NET_TCP_RANDOMIZED_RTO
 	uint16_t rto;
+#endif
+#ifdef CONFIG_NET_TCP_CONGESTION_CONTROL
+	struct tcp_cc cc;
 #endif
 	uint8_t send_data_retries;
 #ifdef CONFIG_NET_TCP_FAST_RETRANSMIT
@@ -125,6 +125,16 @@ static void zsock_received_cb(struct net_context *ctx,
 			      int status,
 			      void *user_data);
 
+static inline void zsock_notify(struct net_context *ctx, int events)
+{
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	z_poll_watch_notify(&ctx->poll_watchers, events);
+#else
+	ARG_UNUSED(ctx);
+	ARG_UNUSED(events);
+#endif
+}
+
 static int fifo_wait_non_empty(struct k_fifo *fifo, k_timeout_t timeout)
 {
 	struct k_poll_event events[] = {
@@ -197,6 +207,10 @@ static int zsock_socket_internal(int family, int type, int proto)
 	 */
 	k_condvar_init(&ctx->cond.recv);
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	sys_slist_init(&ctx->poll_watchers);
+#endif
+
 	/* TCP context is effectively owned by both application
 	 * and the stack: stack may detect that peer closed/aborted
 	 * connection, but it must not dispose of the context behind
@@ -263,6 +277,10 @@ int zsock_close_ctx(struct net_context *ctx)
 
 	zsock_flush_queue(ctx);
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	z_poll_watch_close(&ctx->poll_watchers, ZSOCK_POLLNVAL);
+#endif
+
 	SET_ERRNO(net_context_put(ctx));
 
 	return 0;
@@ -352,8 +370,12 @@ static void zsock_accepted_cb(struct net_context *new_ctx,
 				       NULL);
 		k_fifo_init(&new_ctx->recv_q);
 		k_condvar_init(&new_ctx->cond.recv);
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+		sys_slist_init(&new_ctx->poll_watchers);
+#endif
 
 		k_fifo_put(&parent->accept_q, new_ctx);
+		zsock_notify(parent, ZSOCK_POLLIN);
 
 		/* TCP context is effectively owned by both application
 		 * and the stack: stack may detect that peer closed/aborted
@@ -402,6 +424,9 @@ static void zsock_received_cb(struct net_context *ctx,
 			NET_DBG("Set EOF flag on pkt %p", last_pkt);
 		}
 
+		zsock_notify(ctx, ZSOCK_POLLIN | ZSOCK_POLLHUP |
+				  (status < 0 ? ZSOCK_POLLERR : 0));
+
 		goto unlock;
 	}
 
@@ -412,6 +437,8 @@ static void zsock_received_cb(struct net_context *ctx,
 
 	k_fifo_put(&ctx->recv_q, pkt);
 
+	zsock_notify(ctx, ZSOCK_POLLIN);
+
 unlock:
 	if (ctx->cond.lock) {
 		(void)k_mutex_unlock(ctx->cond.lock);
@@ -434,6 +461,8 @@ int zsock_shutdown_ctx(struct net_context *ctx, int how)
 
 		zsock_flush_queue(ctx);
 
+		zsock_notify(ctx, ZSOCK_POLLIN | ZSOCK_POLLHUP);
+
 		/* Let reader to wake if it was sleeping */
 		(void)k_condvar_signal(&ctx->cond.recv);
 	} else if (how == ZSOCK_SHUT_WR || how == ZSOCK_SHUT_RDWR) {
@@ -956,6 +985,73 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As on Linux, an error after the first message is left for the
+	 * next call to report.
+	 */
+	return i > 0 ? (int)i : (int)ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	ssize_t ret = 0;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	/* Every message needs its own copy from user memory anyway */
+	for (i = 0; i < vlen; i++) {
+		unsigned int len;
+
+		ret = z_vrfy_zsock_sendmsg(sock, &msgvec[i].msg_hdr, flags);
+		if (ret < 0) {
+			break;
+		}
+
+		len = ret;
+		Z_OOPS(z_user_to_copy(&msgvec[i].msg_len, &len, sizeof(len)));
+	}
+
+	return i > 0 ? (int)i : (int)ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -1110,17 +1206,55 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+static int zsock_dgram_src_addr(struct net_context *ctx, struct net_pkt *pkt,
+				struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+	    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
+		/*
+		 * Packets from offloaded IP stack do not have IP
+		 * headers, so src address cannot be figured out at this
+		 * point. The best we can do is returning remote address
+		 * if that was set using connect() call.
+		 */
+		if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
+			memcpy(src_addr, &ctx->remote,
+			       MIN(*addrlen, sizeof(ctx->remote)));
+		} else {
+			return -ENOTSUP;
+		}
+	} else {
+		int rv;
+
+		rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
+					   src_addr, *addrlen);
+		if (rv < 0) {
+			LOG_ERR("sock_get_pkt_src_addr %d", rv);
+			return rv;
+		}
+	}
+
+	/* addrlen is a value-result argument, set to actual
+	 * size of source address
+	 */
+	if (src_addr->sa_family == AF_INET) {
+		*addrlen = sizeof(struct sockaddr_in);
+	} else if (src_addr->sa_family == AF_INET6) {
+		*addrlen = sizeof(struct sockaddr_in6);
+	} else {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+/* Wait for the next datagram and dequeue it, or with ZSOCK_MSG_PEEK
+ * only look at it. Sets errno and returns NULL on failure.
+ */
+static struct net_pkt *zsock_recv_dgram_pkt(struct net_context *ctx,
+					    int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
-	size_t recv_len = 0;
-	size_t read_len;
-	struct net_pkt_cursor backup;
 	struct net_pkt *pkt;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
@@ -1133,7 +1267,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		ret = zsock_wait_data(ctx, &timeout);
 		if (ret < 0) {
 			errno = -ret;
-			return -1;
+			return NULL;
 		}
 	}
 
@@ -1144,7 +1278,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		/* EAGAIN when timeout expired, EINTR when cancelled */
 		if (res && res != -EAGAIN && res != -EINTR) {
 			errno = -res;
-			return -1;
+			return NULL;
 		}
 
 		pkt = k_fifo_peek_head(&ctx->recv_q);
@@ -1154,48 +1288,37 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	if (!pkt) {
 		errno = EAGAIN;
+		return NULL;
+	}
+
+	return pkt;
+}
+
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	size_t recv_len = 0;
+	size_t read_len;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags);
+	if (!pkt) {
 		return -1;
 	}
 
 	net_pkt_cursor_backup(pkt, &backup);
 
 	if (src_addr && addrlen) {
-		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
-		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
-			/*
-			 * Packets from offloaded IP stack do not have IP
-			 * headers, so src address cannot be figured out at this
-			 * point. The best we can do is returning remote address
-			 * if that was set using connect() call.
-			 */
-			if (ctx->flags & NET_CONTEXT_REMOTE_ADDR_SET) {
-				memcpy(src_addr, &ctx->remote,
-				       MIN(*addrlen, sizeof(ctx->remote)));
-			} else {
-				errno = ENOTSUP;
-				goto fail;
-			}
-		} else {
-			int rv;
-
-			rv = sock_get_pkt_src_addr(pkt, net_context_get_proto(ctx),
-						   src_addr, *addrlen);
-			if (rv < 0) {
-				errno = -rv;
-				LOG_ERR("sock_get_pkt_src_addr %d", rv);
-				goto fail;
-			}
-		}
+		int rv;
 
-		/* addrlen is a value-result argument, set to actual
-		 * size of source address
-		 */
-		if (src_addr->sa_family == AF_INET) {
-			*addrlen = sizeof(struct sockaddr_in);
-		} else if (src_addr->sa_family == AF_INET6) {
-			*addrlen = sizeof(struct sockaddr_in6);
-		} else {
-			errno = ENOTSUP;
+		rv = zsock_dgram_src_addr(ctx, pkt, src_addr, addrlen);
+		if (rv < 0) {
+			errno = -rv;
 			goto fail;
 		}
 	}
@@ -1229,6 +1352,76 @@ fail:
 	return -1;
 }
 
+/* Like zsock_recv_dgram(), but scatters the datagram over the iovecs of
+ * a message header.
+ */
+static ssize_t zsock_recv_dgram_msg(struct net_context *ctx,
+				    struct msghdr *msg, int flags)
+{
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+	size_t read_len = 0;
+	size_t recv_len;
+
+	pkt = zsock_recv_dgram_pkt(ctx, flags);
+	if (!pkt) {
+		return -1;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
+	msg->msg_flags = 0;
+	msg->msg_controllen = 0;
+
+	if (msg->msg_name && msg->msg_namelen > 0) {
+		int rv;
+
+		rv = zsock_dgram_src_addr(ctx, pkt, msg->msg_name,
+					  &msg->msg_namelen);
+		if (rv < 0) {
+			errno = -rv;
+			goto fail;
+		}
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	for (size_t i = 0; i < msg->msg_iovlen && read_len < recv_len; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, recv_len - read_len);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			errno = ENOBUFS;
+			goto fail;
+		}
+
+		read_len += len;
+	}
+
+	if (read_len < recv_len) {
+		msg->msg_flags |= ZSOCK_MSG_TRUNC;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS) &&
+	    !(flags & ZSOCK_MSG_PEEK)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	} else {
+		net_pkt_cursor_restore(pkt, &backup);
+	}
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : read_len;
+
+fail:
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	}
+
+	return -1;
+}
+
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 					void *buf,
 					size_t max_len,
@@ -1418,6 +1611,418 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static int zsock_recvmsg_obj(void *obj, const struct socket_op_vtable *vtable,
+			     struct msghdr *msg, int flags)
+{
+	if (vtable == &sock_fd_op_vtable &&
+	    net_context_get_type(obj) == SOCK_DGRAM) {
+		return zsock_recv_dgram_msg(obj, msg, flags);
+	}
+
+	/* Other sockets can only fill a single buffer */
+	if (vtable->recvfrom == NULL || msg->msg_iovlen != 1) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	msg->msg_flags = 0;
+	msg->msg_controllen = 0;
+
+	return vtable->recvfrom(obj, msg->msg_iov[0].iov_base,
+				msg->msg_iov[0].iov_len, flags,
+				msg->msg_name,
+				msg->msg_name ? &msg->msg_namelen : NULL);
+}
+
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t ret = 0;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		ret = zsock_recvmsg_obj(obj, vtable, &msgvec[i].msg_hdr,
+					flags & ~ZSOCK_MSG_WAITFORONE);
+		if (ret < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = ret;
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As on Linux, an error after the first message is left for the
+	 * next call to report.
+	 */
+	return i > 0 ? (int)i : (int)ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	unsigned int i;
+	int ret = 0;
+
+	Z_OOPS(Z_SYSCALL_MEMORY_ARRAY_WRITE(msgvec, vlen,
+					    sizeof(struct mmsghdr)));
+
+	/* Messages are checked and received one by one, so that only a
+	 * single iovec array needs to be copied at a time.
+	 */
+	for (i = 0; i < vlen; i++) {
+		struct mmsghdr mmsg;
+		struct iovec *user_iov;
+		size_t iov_size;
+
+		Z_OOPS(z_user_from_copy(&mmsg, &msgvec[i], sizeof(mmsg)));
+
+		user_iov = mmsg.msg_hdr.msg_iov;
+
+		Z_OOPS(Z_SYSCALL_VERIFY(!size_mul_overflow(mmsg.msg_hdr.msg_iovlen,
+							   sizeof(struct iovec),
+							   &iov_size)));
+		mmsg.msg_hdr.msg_iov = z_user_alloc_from_copy(user_iov, iov_size);
+		if (mmsg.msg_hdr.msg_iov == NULL) {
+			errno = ENOMEM;
+			ret = -1;
+			break;
+		}
+
+		for (size_t j = 0; j < mmsg.msg_hdr.msg_iovlen; j++) {
+			Z_OOPS(Z_SYSCALL_MEMORY_WRITE(mmsg.msg_hdr.msg_iov[j].iov_base,
+						      mmsg.msg_hdr.msg_iov[j].iov_len));
+		}
+
+		Z_OOPS(mmsg.msg_hdr.msg_name &&
+		       Z_SYSCALL_MEMORY_WRITE(mmsg.msg_hdr.msg_name,
+					      mmsg.msg_hdr.msg_namelen));
+
+		ret = z_impl_zsock_recvmmsg(sock, &mmsg, 1,
+					    flags & ~ZSOCK_MSG_WAITFORONE);
+
+		k_free(mmsg.msg_hdr.msg_iov);
+
+		if (ret <= 0) {
+			break;
+		}
+
+		mmsg.msg_hdr.msg_iov = user_iov;
+		Z_OOPS(z_user_to_copy(&msgvec[i], &mmsg, sizeof(mmsg)));
+
+		if (flags & ZSOCK_MSG_WAITFORONE) {
+			flags |= ZSOCK_MSG_DONTWAIT;
+		}
+	}
+
+	return i > 0 ? (int)i : (int)ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+/* Zero-copy send buffers point to application memory, the user data
+ * remembers whom to notify once the stack lets go of them: a callback
+ * for supervisor threads, a poll signal for user threads.
+ */
+struct zsock_zc_tx {
+	zsock_zc_done_cb_t cb;
+	void *user_data;
+	struct k_poll_signal *sig;
+	const void *buf;
+	size_t len;
+};
+
+static void zsock_zc_tx_destroy(struct net_buf *buf);
+
+NET_BUF_POOL_DEFINE(zsock_zc_tx_pool, CONFIG_NET_SOCKETS_ZEROCOPY_TX_COUNT,
+		    0, sizeof(struct zsock_zc_tx), zsock_zc_tx_destroy);
+
+static void zsock_zc_tx_destroy(struct net_buf *buf)
+{
+	struct zsock_zc_tx tx = *(struct zsock_zc_tx *)net_buf_user_data(buf);
+
+	net_buf_destroy(buf);
+
+	if (tx.cb) {
+		tx.cb(tx.buf, tx.len, tx.user_data);
+	} else if (tx.sig) {
+		k_poll_signal_raise(tx.sig, 0);
+	}
+}
+
+/* Zero-copy only makes sense for native datagram sockets, which queue
+ * received data as net_pkt and send each call as one packet.
+ */
+static struct net_context *zsock_zc_get_ctx(int sock, struct k_mutex **lock)
+{
+	const struct socket_op_vtable *vtable;
+	struct net_context *ctx;
+
+	/* The loaned buffers and the completion callbacks live in kernel
+	 * memory, so zsock_recv_loan() and zsock_sendto_zc() are not system
+	 * calls. User threads send with zsock_sendto_zc_signal() instead.
+	 */
+	if (k_is_user_context()) {
+		errno = EPERM;
+		return NULL;
+	}
+
+	ctx = get_sock_vtable(sock, &vtable, lock);
+	if (ctx == NULL) {
+		errno = EBADF;
+		return NULL;
+	}
+
+	if (vtable != &sock_fd_op_vtable ||
+	    net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return NULL;
+	}
+
+	return ctx;
+}
+
+ssize_t zsock_recv_loan(int sock, struct zsock_rx_loan *loan, int flags,
+			struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	k_timeout_t timeout = K_FOREVER;
+	struct net_context *ctx;
+	struct k_mutex *lock;
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	size_t offset;
+	int ret;
+
+	if (loan == NULL || (flags & ~ZSOCK_MSG_DONTWAIT)) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+		ret = zsock_wait_data(ctx, &timeout);
+		if (ret < 0) {
+			errno = -ret;
+			ret = -1;
+			goto unlock;
+		}
+	}
+
+	pkt = k_fifo_get(&ctx->recv_q, timeout);
+	if (!pkt) {
+		errno = EAGAIN;
+		ret = -1;
+		goto unlock;
+	}
+
+	if (src_addr && addrlen) {
+		ret = zsock_dgram_src_addr(ctx, pkt, src_addr, addrlen);
+		if (ret < 0) {
+			net_pkt_unref(pkt);
+			errno = -ret;
+			ret = -1;
+			goto unlock;
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	/* The cursor sits right after the protocol headers, skip any
+	 * fragment it has reached the end of.
+	 */
+	frag = pkt->cursor.buf;
+	offset = frag ? pkt->cursor.pos - frag->data : 0;
+
+	while (frag && offset >= frag->len && frag->frags) {
+		offset -= frag->len;
+		frag = frag->frags;
+	}
+
+	loan->pkt = pkt;
+	loan->frags = frag;
+	loan->offset = offset;
+	loan->len = net_pkt_remaining_data(pkt);
+
+	ret = loan->len;
+
+unlock:
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+void zsock_recv_loan_return(struct zsock_rx_loan *loan)
+{
+	if (loan->pkt) {
+		net_pkt_unref(loan->pkt);
+	}
+
+	memset(loan, 0, sizeof(*loan));
+}
+
+static ssize_t zsock_zc_send(int sock, const void *buf, size_t len, int flags,
+			     const struct sockaddr *dest_addr, socklen_t addrlen,
+			     const struct zsock_zc_tx *done)
+{
+	k_timeout_t timeout = K_FOREVER;
+	uint32_t retry_timeout = WAIT_BUFS_INITIAL_MS;
+	uint64_t buf_timeout = 0;
+	struct net_context *ctx;
+	struct zsock_zc_tx *tx;
+	struct k_mutex *lock;
+	struct net_buf *frag;
+	int status;
+
+	ctx = zsock_zc_get_ctx(sock, &lock);
+	if (ctx == NULL) {
+		return -1;
+	}
+
+	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
+		timeout = K_NO_WAIT;
+	} else {
+		net_context_get_option(ctx, NET_OPT_SNDTIMEO, &timeout, NULL);
+		buf_timeout = sys_clock_timeout_end_calc(MAX_WAIT_BUFS);
+	}
+
+	frag = net_buf_alloc_with_data(&zsock_zc_tx_pool, (void *)buf, len,
+				       timeout);
+	if (!frag) {
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	/* Armed before sending as the packet may be gone by the time
+	 * net_context_sendto_frags() returns.
+	 */
+	tx = net_buf_user_data(frag);
+	*tx = *done;
+	tx->buf = buf;
+	tx->len = len;
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	/* Register the callback before sending in order to receive the
+	 * response from the peer.
+	 */
+	status = net_context_recv(ctx, zsock_received_cb,
+				  K_NO_WAIT, ctx->user_data);
+	if (status < 0) {
+		errno = -status;
+		status = -1;
+		goto fail;
+	}
+
+	while (1) {
+		status = net_context_sendto_frags(ctx, frag, dest_addr,
+						  addrlen, NULL, timeout,
+						  ctx->user_data);
+		if (status < 0) {
+			status = send_check_and_wait(ctx, status, buf_timeout,
+						     timeout, &retry_timeout);
+			if (status < 0) {
+				goto fail;
+			}
+
+			continue;
+		}
+
+		break;
+	}
+
+	k_mutex_unlock(lock);
+
+	return status;
+
+fail:
+	k_mutex_unlock(lock);
+
+	/* The buffer was never handed over, release it silently */
+	tx->cb = NULL;
+	tx->sig = NULL;
+	net_buf_unref(frag);
+
+	return status;
+}
+
+ssize_t zsock_sendto_zc(int sock, const void *buf, size_t len, int flags,
+			const struct sockaddr *dest_addr, socklen_t addrlen,
+			zsock_zc_done_cb_t cb, void *user_data)
+{
+	struct zsock_zc_tx done = {
+		.cb = cb,
+		.user_data = user_data,
+	};
+
+	return zsock_zc_send(sock, buf, len, flags, dest_addr, addrlen, &done);
+}
+
+ssize_t z_impl_zsock_sendto_zc_signal(int sock, const void *buf, size_t len,
+				      int flags, const struct sockaddr *dest_addr,
+				      socklen_t addrlen, struct k_poll_signal *sig)
+{
+	struct zsock_zc_tx done = {
+		.sig = sig,
+	};
+
+	return zsock_zc_send(sock, buf, len, flags, dest_addr, addrlen, &done);
+}
+
+#ifdef CONFIG_USERSPACE
+ssize_t z_vrfy_zsock_sendto_zc_signal(int sock, const void *buf, size_t len,
+				      int flags, const struct sockaddr *dest_addr,
+				      socklen_t addrlen, struct k_poll_signal *sig)
+{
+	struct sockaddr_storage dest_addr_copy;
+
+	/* The stack reads the buffer after this call returns, until the
+	 * signal is raised. The caller only has to be allowed to read it.
+	 */
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(buf, len));
+	Z_OOPS(Z_SYSCALL_OBJ(sig, K_OBJ_POLL_SIGNAL));
+	if (dest_addr) {
+		Z_OOPS(Z_SYSCALL_VERIFY(addrlen <= sizeof(dest_addr_copy)));
+		Z_OOPS(z_user_from_copy(&dest_addr_copy, (void *)dest_addr,
+					addrlen));
+	}
+
+	return z_impl_zsock_sendto_zc_signal(sock, buf, len, flags,
+			dest_addr ? (struct sockaddr *)&dest_addr_copy : NULL,
+			addrlen, sig);
+}
+#include <syscalls/zsock_sendto_zc_signal_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -1884,6 +2489,35 @@ int zsock_getsockopt_ctx(struct net_context *ctx, int level, int optname,
 		case TCP_NODELAY:
 			ret = net_tcp_get_option(ctx, TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_get_option(ctx, TCP_OPT_CONGESTION, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+		}
+
+		break;
+
+	case IPPROTO_UDP:
+		switch (optname) {
+		case UDP_SEGMENT:
+			if (IS_ENABLED(CONFIG_NET_UDP_GSO)) {
+				ret = net_context_get_option(ctx,
+							     NET_OPT_UDP_SEGMENT,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
 
 		break;
@@ -2182,7 +2816,37 @@ int zsock_setsockopt_ctx(struct net_context *ctx, int level, int optname,
 			ret = net_tcp_set_option(ctx,
 						 TCP_OPT_NODELAY, optval, optlen);
 			return ret;
+
+		case TCP_CONGESTION:
+			ret = net_tcp_set_option(ctx,
+						 TCP_OPT_CONGESTION, optval, optlen);
+			if (ret < 0) {
+				errno = -ret;
+				return -1;
+			}
+
+			return 0;
+		}
+		break;
+
+	case IPPROTO_UDP:
+		switch (optname) {
+		case UDP_SEGMENT:
+			if (IS_ENABLED(CONFIG_NET_UDP_GSO)) {
+				ret = net_context_set_option(ctx,
+							     NET_OPT_UDP_SEGMENT,
+							     optval, optlen);
+				if (ret < 0) {
+					errno = -ret;
+					return -1;
+				}
+
+				return 0;
+			}
+
+			break;
 		}
+
 		break;
 
 	case IPPROTO_IP:
@@ -2497,6 +3161,25 @@ static int sock_ioctl_vmeth(void *obj, unsigned int request, va_list args)
 		return 0;
 	}
 
+#if defined(CONFIG_FDTABLE_POLL_WATCH)
+	case ZFD_IOCTL_POLL_WATCH: {
+		struct net_context *ctx = obj;
+		struct z_poll_watch *watch;
+		int add;
+
+		watch = va_arg(args, struct z_poll_watch *);
+		add = va_arg(args, int);
+
+		if (add) {
+			z_poll_watch_add(&ctx->poll_watchers, watch);
+		} else {
+			z_poll_watch_remove(&ctx->poll_watchers, watch);
+		}
+
+		return 0;
+	}
+#endif
+
 	default:
 		errno = EOPNOTSUPP;
 		return -1;
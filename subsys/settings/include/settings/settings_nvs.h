@@ -46,6 +46,15 @@ struct settings_nvs {
 
 	uint16_t cache_next;
 #endif
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	/* hash of the first name element for each name ID */
+	uint16_t load_index[CONFIG_SETTINGS_NVS_LOAD_INDEX_SIZE];
+#endif
+	/* a transaction commit is in progress, last_name_id is written at its
+	 * end
+	 */
+	bool in_save;
+	bool last_name_id_dirty;
 };
 
 /* register nvs to be a source of settings */
@@ -24,6 +24,160 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+/* Open addressing hash table of the handlers, keyed by their full name. It is
+ * only used when all handlers fit in it, otherwise the handlers are searched
+ * linearly.
+ */
+#define SETTINGS_INDEX_MAX_FILL (CONFIG_SETTINGS_HANDLER_INDEX_SIZE * 3 / 4)
+
+static struct settings_index_entry {
+	struct settings_handler_static *ch;
+	uint32_t hash;
+	uint16_t name_len;
+} settings_index[CONFIG_SETTINGS_HANDLER_INDEX_SIZE];
+
+static uint16_t settings_index_cnt;
+static bool settings_index_complete;
+
+static uint32_t settings_index_hash(const char *name, size_t len)
+{
+	/* FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (len--) {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+static void settings_index_add(struct settings_handler_static *ch)
+{
+	size_t len = strlen(ch->name);
+	uint32_t hash = settings_index_hash(ch->name, len);
+	struct settings_index_entry *entry;
+	uint32_t i = hash % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+
+	while (true) {
+		entry = &settings_index[i];
+
+		if (entry->ch == NULL) {
+			break;
+		}
+
+		/* A later handler of the same name replaces the earlier one,
+		 * like in the linear search.
+		 */
+		if ((entry->hash == hash) && (entry->name_len == len) &&
+		    !strcmp(entry->ch->name, ch->name)) {
+			entry->ch = ch;
+			return;
+		}
+
+		i = (i + 1) % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+	}
+
+	if ((settings_index_cnt >= SETTINGS_INDEX_MAX_FILL) ||
+	    (len > UINT16_MAX)) {
+		settings_index_complete = false;
+		return;
+	}
+
+	entry->ch = ch;
+	entry->hash = hash;
+	entry->name_len = len;
+	settings_index_cnt++;
+}
+
+static struct settings_handler_static *settings_index_get(const char *name,
+							 size_t len)
+{
+	uint32_t hash = settings_index_hash(name, len);
+	struct settings_index_entry *entry;
+	uint32_t i = hash % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+
+	while (true) {
+		entry = &settings_index[i];
+
+		if (entry->ch == NULL) {
+			return NULL;
+		}
+
+		if ((entry->hash == hash) && (entry->name_len == len) &&
+		    !strncmp(entry->ch->name, name, len)) {
+			return entry->ch;
+		}
+
+		i = (i + 1) % CONFIG_SETTINGS_HANDLER_INDEX_SIZE;
+	}
+}
+
+static void settings_index_rebuild(void)
+{
+	memset(settings_index, 0, sizeof(settings_index));
+	settings_index_cnt = 0;
+	settings_index_complete = true;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_index_add(ch);
+	}
+
+#if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
+	struct settings_handler *ch;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&settings_handlers, ch, node) {
+		settings_index_add((struct settings_handler_static *)ch);
+	}
+#endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+}
+
+/* Find the handler with the longest name matching the start of name, see
+ * settings_parse_and_lookup(). Returns false when the index can't be used.
+ */
+static bool settings_index_lookup(const char *name,
+				  struct settings_handler_static **match,
+				  const char **next)
+{
+	/* Name lengths at which a handler name may end */
+	uint16_t ends[SETTINGS_MAX_DIR_DEPTH + 1];
+	int cnt = 0;
+	size_t i;
+
+	if (!settings_index_complete || !name) {
+		return false;
+	}
+
+	for (i = 0; ; i++) {
+		if ((name[i] == SETTINGS_NAME_SEPARATOR) ||
+		    (name[i] == SETTINGS_NAME_END) || (name[i] == '\0')) {
+			if ((cnt == ARRAY_SIZE(ends)) || (i > UINT16_MAX)) {
+				return false;
+			}
+			ends[cnt++] = i;
+		}
+
+		if ((name[i] == SETTINGS_NAME_END) || (name[i] == '\0')) {
+			break;
+		}
+	}
+
+	*match = NULL;
+
+	while (cnt--) {
+		*match = settings_index_get(name, ends[cnt]);
+		if (*match) {
+			if (next && (name[ends[cnt]] == SETTINGS_NAME_SEPARATOR)) {
+				*next = &name[ends[cnt] + 1];
+			}
+			break;
+		}
+	}
+
+	return true;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_INDEX */
 
 void settings_store_init(void);
 
@@ -32,6 +186,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_index_rebuild();
+#endif
 	settings_store_init();
 }
 
@@ -56,11 +213,32 @@ int settings_register(struct settings_handler *handler)
 		}
 	}
 	sys_slist_append(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	settings_index_add((struct settings_handler_static *)handler);
+#endif
 
 end:
 	k_mutex_unlock(&settings_lock);
 	return rc;
 }
+
+bool settings_deregister(struct settings_handler *handler)
+{
+	bool found;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	found = sys_slist_find_and_remove(&settings_handlers, &handler->node);
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (found) {
+		/* Deregistering is rare, rebuild rather than delete. */
+		settings_index_rebuild();
+	}
+#endif
+
+	k_mutex_unlock(&settings_lock);
+	return found;
+}
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
 int settings_name_steq(const char *name, const char *key, const char **next)
@@ -145,6 +323,12 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 		*next = NULL;
 	}
 
+#if defined(CONFIG_SETTINGS_HANDLER_INDEX)
+	if (settings_index_lookup(name, &bestmatch, next)) {
+		return bestmatch;
+	}
+#endif
+
 	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
 		if (!settings_name_steq(name, ch->name, &tmpnext)) {
 			continue;
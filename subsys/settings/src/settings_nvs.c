@@ -30,13 +30,17 @@ struct settings_nvs_read_fn_arg {
 
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg);
+static int settings_nvs_save_start(struct settings_store *cs);
 static int settings_nvs_save(struct settings_store *cs, const char *name,
 			     const char *value, size_t val_len);
+static int settings_nvs_save_end(struct settings_store *cs);
 static void *settings_nvs_storage_get(struct settings_store *cs);
 
 static struct settings_store_itf settings_nvs_itf = {
 	.csi_load = settings_nvs_load,
+	.csi_save_start = settings_nvs_save_start,
 	.csi_save = settings_nvs_save,
+	.csi_save_end = settings_nvs_save_end,
 	.csi_storage_get = settings_nvs_storage_get
 };
 
@@ -118,6 +122,68 @@ static uint16_t settings_nvs_cache_match(struct settings_nvs *cf, const char *na
 }
 #endif /* CONFIG_SETTINGS_NVS_NAME_CACHE */
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+/* load_index values which are not a name hash */
+#define SETTINGS_NVS_LOAD_UNKNOWN 0
+#define SETTINGS_NVS_LOAD_EMPTY 1
+
+static uint16_t settings_nvs_load_hash(const char *name)
+{
+	uint16_t hash;
+	int len;
+
+	len = settings_name_next(name, NULL);
+	hash = crc16_ccitt(0xffff, name, len);
+
+	/* Collisions only cost a read, keep the special values free. */
+	if (hash <= SETTINGS_NVS_LOAD_EMPTY) {
+		hash += 2;
+	}
+
+	return hash;
+}
+
+static void settings_nvs_load_index_set(struct settings_nvs *cf,
+					uint16_t name_id, uint16_t hash)
+{
+	uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+	if (i < CONFIG_SETTINGS_NVS_LOAD_INDEX_SIZE) {
+		cf->load_index[i] = hash;
+	}
+}
+
+static uint16_t settings_nvs_load_index_get(struct settings_nvs *cf,
+					    uint16_t name_id)
+{
+	uint16_t i = name_id - NVS_NAMECNT_ID - 1;
+
+	if (i < CONFIG_SETTINGS_NVS_LOAD_INDEX_SIZE) {
+		return cf->load_index[i];
+	}
+
+	return SETTINGS_NVS_LOAD_UNKNOWN;
+}
+#endif /* CONFIG_SETTINGS_NVS_LOAD_INDEX */
+
+static int settings_nvs_last_name_id_write(struct settings_nvs *cf)
+{
+	int rc;
+
+	if (cf->in_save) {
+		cf->last_name_id_dirty = true;
+		return 0;
+	}
+
+	rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
+		       sizeof(uint16_t));
+	if (rc >= 0) {
+		cf->last_name_id_dirty = false;
+	}
+
+	return rc;
+}
+
 static int settings_nvs_load(struct settings_store *cs,
 			     const struct settings_load_arg *arg)
 {
@@ -128,6 +194,14 @@ static int settings_nvs_load(struct settings_store *cs,
 	char buf;
 	ssize_t rc1, rc2;
 	uint16_t name_id = NVS_NAMECNT_ID;
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	uint16_t subtree_hash = SETTINGS_NVS_LOAD_UNKNOWN;
+	uint16_t hash;
+
+	if (arg && arg->subtree) {
+		subtree_hash = settings_nvs_load_hash(arg->subtree);
+	}
+#endif
 
 	name_id = cf->last_name_id + 1;
 
@@ -138,6 +212,17 @@ static int settings_nvs_load(struct settings_store *cs,
 			break;
 		}
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+		/* Skip unused IDs and the settings of other subtrees. */
+		hash = settings_nvs_load_index_get(cf, name_id);
+		if ((hash == SETTINGS_NVS_LOAD_EMPTY) ||
+		    ((hash != SETTINGS_NVS_LOAD_UNKNOWN) &&
+		     (subtree_hash != SETTINGS_NVS_LOAD_UNKNOWN) &&
+		     (hash != subtree_hash))) {
+			continue;
+		}
+#endif
+
 		/* In the NVS backend, each setting item is stored in two NVS
 		 * entries one for the setting's name and one with the
 		 * setting's value.
@@ -147,6 +232,10 @@ static int settings_nvs_load(struct settings_store *cs,
 			       &buf, sizeof(buf));
 
 		if ((rc1 <= 0) && (rc2 <= 0)) {
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+			settings_nvs_load_index_set(cf, name_id,
+						    SETTINGS_NVS_LOAD_EMPTY);
+#endif
 			continue;
 		}
 
@@ -163,11 +252,19 @@ static int settings_nvs_load(struct settings_store *cs,
 			}
 			nvs_delete(&cf->cf_nvs, name_id);
 			nvs_delete(&cf->cf_nvs, name_id + NVS_NAME_ID_OFFSET);
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+			settings_nvs_load_index_set(cf, name_id,
+						    SETTINGS_NVS_LOAD_EMPTY);
+#endif
 			continue;
 		}
 
 		/* Found a name, this might not include a trailing \0 */
 		name[rc1] = '\0';
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+		settings_nvs_load_index_set(cf, name_id,
+					    settings_nvs_load_hash(name));
+#endif
 		read_fn_arg.fs = &cf->cf_nvs;
 		read_fn_arg.id = name_id + NVS_NAME_ID_OFFSET;
 
@@ -256,8 +353,7 @@ found:
 
 		if (name_id == cf->last_name_id) {
 			cf->last_name_id--;
-			rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID,
-				       &cf->last_name_id, sizeof(uint16_t));
+			rc = settings_nvs_last_name_id_write(cf);
 			if (rc < 0) {
 				/* Error: can't to store
 				 * the largest name ID in use.
@@ -277,6 +373,10 @@ found:
 			return rc;
 		}
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+		settings_nvs_load_index_set(cf, name_id,
+					    SETTINGS_NVS_LOAD_EMPTY);
+#endif
 		return 0;
 	}
 
@@ -285,6 +385,13 @@ found:
 		return -ENOMEM;
 	}
 
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	if (write_name) {
+		settings_nvs_load_index_set(cf, write_name_id,
+					    SETTINGS_NVS_LOAD_UNKNOWN);
+	}
+#endif
+
 	/* write the value */
 	rc = nvs_write(&cf->cf_nvs, write_name_id + NVS_NAME_ID_OFFSET,
 		       value, val_len);
@@ -298,15 +405,58 @@ found:
 		if (rc < 0) {
 			return rc;
 		}
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+		settings_nvs_load_index_set(cf, write_name_id,
+					    settings_nvs_load_hash(name));
+#endif
 	}
 
 	/* update the last_name_id and write to flash if required*/
 	if (write_name_id > cf->last_name_id) {
 		cf->last_name_id = write_name_id;
-		rc = nvs_write(&cf->cf_nvs, NVS_NAMECNT_ID, &cf->last_name_id,
-			       sizeof(uint16_t));
+		rc = settings_nvs_last_name_id_write(cf);
+	}
+
+	if (rc < 0) {
+		return rc;
+	}
+
+	return 0;
+}
+
+static int settings_nvs_save_start(struct settings_store *cs)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+
+#if defined(CONFIG_SETTINGS_TXN)
+	/* Only a transaction commit defers the write of the largest name ID:
+	 * the transaction journal still holds the values whose keys are lost
+	 * if the commit is interrupted. A plain save writes it for each key.
+	 */
+	cf->in_save = settings_txn_in_commit();
+#else
+	ARG_UNUSED(cf);
+#endif
+
+	return 0;
+}
+
+static int settings_nvs_save_end(struct settings_store *cs)
+{
+	struct settings_nvs *cf = CONTAINER_OF(cs, struct settings_nvs, cf_store);
+	int rc;
+
+	cf->in_save = false;
+
+	if (!cf->last_name_id_dirty) {
+		return 0;
 	}
 
+	/* On failure the ID stays dirty and the next save retries the write,
+	 * until then the keys added by the commit are only found after reset
+	 * by writing them again from the transaction journal.
+	 */
+	rc = settings_nvs_last_name_id_write(cf);
 	if (rc < 0) {
 		return rc;
 	}
@@ -338,6 +488,12 @@ int settings_nvs_backend_init(struct settings_nvs *cf)
 		cf->last_name_id = last_name_id;
 	}
 
+	cf->in_save = false;
+	cf->last_name_id_dirty = false;
+#if CONFIG_SETTINGS_NVS_LOAD_INDEX
+	memset(cf->load_index, 0, sizeof(cf->load_index));
+#endif
+
 	LOG_DBG("Initialized");
 	return 0;
 }
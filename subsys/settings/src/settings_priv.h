@@ -125,6 +125,13 @@ extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
 extern struct settings_store *settings_save_dst;
 
+#if defined(CONFIG_SETTINGS_TXN)
+/* The values of a committed transaction are being written to the
+ * destination, whose journal covers them until they are all stored.
+ */
+bool settings_txn_in_commit(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
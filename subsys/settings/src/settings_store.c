@@ -24,6 +24,14 @@ sys_slist_t settings_load_srcs;
 struct settings_store *settings_save_dst;
 extern struct k_mutex settings_lock;
 
+#if defined(CONFIG_SETTINGS_TXN)
+/* Key under which a committed transaction is stored until it is applied. */
+#define SETTINGS_TXN_JOURNAL "settings/txn"
+
+static void settings_txn_recover(void);
+static void settings_txn_recover_request(void);
+#endif
+
 void settings_src_register(struct settings_store *cs)
 {
 	sys_slist_append(&settings_load_srcs, &cs->cs_next);
@@ -32,6 +40,9 @@ void settings_src_register(struct settings_store *cs)
 void settings_dst_register(struct settings_store *cs)
 {
 	settings_save_dst = cs;
+#if defined(CONFIG_SETTINGS_TXN)
+	settings_txn_recover_request();
+#endif
 }
 
 int settings_load(void)
@@ -54,6 +65,9 @@ int settings_load_subtree(const char *subtree)
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#if defined(CONFIG_SETTINGS_TXN)
+	settings_txn_recover();
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -81,6 +95,9 @@ int settings_load_subtree_direct(
 	 *    commit all
 	 */
 	k_mutex_lock(&settings_lock, K_FOREVER);
+#if defined(CONFIG_SETTINGS_TXN)
+	settings_txn_recover();
+#endif
 	SYS_SLIST_FOR_EACH_CONTAINER(&settings_load_srcs, cs, cs_next) {
 		cs->cs_itf->csi_load(cs, &arg);
 	}
@@ -88,6 +105,320 @@ int settings_load_subtree_direct(
 	return 0;
 }
 
+#if defined(CONFIG_SETTINGS_TXN)
+/*
+ * Values staged by the open transaction. Each record holds the name with its
+ * terminating '\0', the value length as uint16_t and the value.
+ */
+static struct {
+	uint8_t buf[CONFIG_SETTINGS_TXN_BUF_SIZE];
+	size_t used;
+	k_tid_t owner;
+	/* the destination may hold a journal which was not applied */
+	bool recover;
+	/* the values of a journal are being written */
+	bool committing;
+} settings_txn;
+
+static size_t settings_txn_rec_len(const uint8_t *rec)
+{
+	size_t name_len = strlen((const char *)rec) + 1;
+	uint16_t val_len;
+
+	memcpy(&val_len, rec + name_len, sizeof(val_len));
+
+	return name_len + sizeof(val_len) + val_len;
+}
+
+static int settings_txn_stage(const char *name, const void *value,
+			      size_t val_len)
+{
+	uint8_t *rec = settings_txn.buf;
+	uint8_t *end = settings_txn.buf + settings_txn.used;
+	size_t name_len, rec_len;
+	size_t old_len = 0;
+	uint16_t len16;
+
+	if (!name) {
+		return -EINVAL;
+	}
+
+	if (value == NULL) {
+		val_len = 0;
+	}
+
+	if (val_len > UINT16_MAX) {
+		return -ENOMEM;
+	}
+
+	name_len = strlen(name) + 1;
+	rec_len = name_len + sizeof(len16) + val_len;
+	len16 = val_len;
+
+	/* Look for an earlier value of the same key, it is replaced. */
+	while (rec < end) {
+		if (!strcmp((const char *)rec, name)) {
+			old_len = settings_txn_rec_len(rec);
+			break;
+		}
+		rec += settings_txn_rec_len(rec);
+	}
+
+	if (settings_txn.used - old_len + rec_len > sizeof(settings_txn.buf)) {
+		return -ENOMEM;
+	}
+
+	if (old_len) {
+		memmove(rec, rec + old_len, end - rec - old_len);
+		settings_txn.used -= old_len;
+	}
+
+	rec = settings_txn.buf + settings_txn.used;
+	memcpy(rec, name, name_len);
+	memcpy(rec + name_len, &len16, sizeof(len16));
+	if (val_len) {
+		memcpy(rec + name_len + sizeof(len16), value, val_len);
+	}
+	settings_txn.used += rec_len;
+
+	return 0;
+}
+
+/* Apply the records of settings_txn.buf to the destination and drop the
+ * journal holding them.
+ */
+static int settings_txn_apply(struct settings_store *cs)
+{
+	const uint8_t *rec = settings_txn.buf;
+	const uint8_t *end = settings_txn.buf + settings_txn.used;
+	const char *name;
+	uint16_t val_len;
+	int rc = 0;
+	int rc2;
+
+	settings_txn.committing = true;
+
+	if (cs->cs_itf->csi_save_start) {
+		cs->cs_itf->csi_save_start(cs);
+	}
+
+	while (rec < end) {
+		name = (const char *)rec;
+		rec += strlen(name) + 1;
+		memcpy(&val_len, rec, sizeof(val_len));
+		rec += sizeof(val_len);
+
+		rc = cs->cs_itf->csi_save(cs, name,
+					  val_len ? (const char *)rec : NULL,
+					  val_len);
+		if (rc) {
+			LOG_ERR("Transaction save of %s failed (err %d)",
+				name, rc);
+			break;
+		}
+		rec += val_len;
+	}
+
+	if (cs->cs_itf->csi_save_end) {
+		rc2 = cs->cs_itf->csi_save_end(cs);
+		if (!rc) {
+			rc = rc2;
+		}
+	}
+
+	settings_txn.committing = false;
+
+	/* The journal is only dropped once every value is stored. */
+	if (!rc) {
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL, NULL, 0);
+	}
+
+	return rc;
+}
+
+static int settings_txn_journal_set(const char *key, size_t len,
+				    settings_read_cb read_cb, void *cb_arg,
+				    void *param)
+{
+	ssize_t rc;
+
+	ARG_UNUSED(param);
+
+	if (key) {
+		return 0;
+	}
+
+	settings_txn.used = 0;
+
+	if (len > sizeof(settings_txn.buf)) {
+		LOG_ERR("Transaction journal too large (%zu bytes)", len);
+		return 0;
+	}
+
+	rc = read_cb(cb_arg, settings_txn.buf, len);
+	if (rc == (ssize_t)len) {
+		settings_txn.used = len;
+	}
+
+	return 0;
+}
+
+/* Check that the journal read back is a sequence of complete records. */
+static bool settings_txn_journal_valid(void)
+{
+	const uint8_t *rec = settings_txn.buf;
+	const uint8_t *end = settings_txn.buf + settings_txn.used;
+	uint16_t val_len;
+	size_t name_len;
+	size_t left;
+
+	while (rec < end) {
+		left = end - rec;
+		name_len = strnlen((const char *)rec, left) + 1;
+		if (name_len + sizeof(val_len) > left) {
+			return false;
+		}
+		memcpy(&val_len, rec + name_len, sizeof(val_len));
+		if (name_len + sizeof(val_len) + val_len > left) {
+			return false;
+		}
+		rec += name_len + sizeof(val_len) + val_len;
+	}
+
+	return true;
+}
+
+/*
+ * Complete a transaction whose commit was interrupted: if a journal is found
+ * in the destination its values are written again. Invoked with the settings
+ * lock held and no transaction open.
+ */
+static void settings_txn_recover(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	const struct settings_load_arg arg = {
+		.subtree = SETTINGS_TXN_JOURNAL,
+		.cb = settings_txn_journal_set,
+	};
+	int rc = 0;
+
+	if (!settings_txn.recover || settings_txn.owner || !cs) {
+		return;
+	}
+
+	settings_txn.used = 0;
+	cs->cs_itf->csi_load(cs, &arg);
+
+	if (settings_txn.used) {
+		if (settings_txn_journal_valid()) {
+			LOG_WRN("Completing an interrupted transaction");
+			rc = settings_txn_apply(cs);
+		} else {
+			LOG_ERR("Dropping a corrupted transaction journal");
+			rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+						  NULL, 0);
+		}
+	}
+
+	settings_txn.used = 0;
+	settings_txn.recover = (rc != 0);
+}
+
+static void settings_txn_recover_request(void)
+{
+	/* A new destination may hold the journal of an interrupted commit. */
+	settings_txn.recover = true;
+}
+
+bool settings_txn_in_commit(void)
+{
+	return settings_txn.committing;
+}
+
+int settings_txn_begin(void)
+{
+	if (!settings_save_dst) {
+		return -ENOENT;
+	}
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if (settings_txn.owner) {
+		/* Only the owner can get here while a transaction is open. */
+		k_mutex_unlock(&settings_lock);
+		return -EBUSY;
+	}
+
+	/* An older journal must be applied before it can be replaced. */
+	settings_txn_recover();
+
+	settings_txn.owner = k_current_get();
+	settings_txn.used = 0;
+
+	/* The lock is kept until the transaction ends. */
+	return 0;
+}
+
+static int settings_txn_end(void)
+{
+	if (settings_txn.owner != k_current_get()) {
+		return -EINVAL;
+	}
+
+	settings_txn.owner = NULL;
+	settings_txn.used = 0;
+	k_mutex_unlock(&settings_lock);
+
+	return 0;
+}
+
+int settings_txn_commit(void)
+{
+	struct settings_store *cs = settings_save_dst;
+	int rc = 0;
+	int rc2;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+
+	if ((settings_txn.owner == k_current_get()) && settings_txn.used) {
+		/* Storing the journal is the commit point: once it is
+		 * written, the values are applied even if that is
+		 * interrupted, before it nothing has been changed.
+		 */
+		rc = cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+					  (const char *)settings_txn.buf,
+					  settings_txn.used);
+		if (rc) {
+			LOG_ERR("Transaction journal save failed (err %d)", rc);
+			/* Don't leave a partly written journal behind. */
+			(void)cs->cs_itf->csi_save(cs, SETTINGS_TXN_JOURNAL,
+						   NULL, 0);
+		} else {
+			rc = settings_txn_apply(cs);
+			if (rc) {
+				settings_txn.recover = true;
+			}
+		}
+	}
+
+	rc2 = settings_txn_end();
+	k_mutex_unlock(&settings_lock);
+
+	return rc2 ? rc2 : rc;
+}
+
+int settings_txn_abort(void)
+{
+	int rc;
+
+	k_mutex_lock(&settings_lock, K_FOREVER);
+	rc = settings_txn_end();
+	k_mutex_unlock(&settings_lock);
+
+	return rc;
+}
+#endif /* CONFIG_SETTINGS_TXN */
+
 /*
  * Append a single value to persisted config. Don't store duplicate value.
  */
@@ -103,6 +434,15 @@ int settings_save_one(const char *name, const void *value, size_t val_len)
 
 	k_mutex_lock(&settings_lock, K_FOREVER);
 
+#if defined(CONFIG_SETTINGS_TXN)
+	/* Only the owner of an open transaction can hold the lock. */
+	if (settings_txn.owner) {
+		rc = settings_txn_stage(name, value, val_len);
+		k_mutex_unlock(&settings_lock);
+		return rc;
+	}
+#endif
+
 	rc = cs->cs_itf->csi_save(cs, name, (char *)value, val_len);
 
 	k_mutex_unlock(&settings_lock);
@@ -153,7 +493,10 @@ int settings_save(void)
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
 
 	if (cs->cs_itf->csi_save_end) {
-		cs->cs_itf->csi_save_end(cs);
+		rc2 = cs->cs_itf->csi_save_end(cs);
+		if (!rc) {
+			rc = rc2;
+		}
 	}
 	return rc;
 }
@@ -16,11 +16,100 @@ k_timeout_t _zbus_timeout_remainder(uint64_t end_ticks)
 	return K_TICKS((k_ticks_t)MAX(end_ticks - now_ticks, 0));
 }
 
+#if defined(CONFIG_ZBUS_OBSERVER_STATS)
+static struct k_spinlock _zbus_obs_stats_lock;
+
+void _zbus_obs_callback_run(const struct zbus_observer *obs, const struct zbus_channel *chan)
+{
+	struct zbus_observer_stats *stats = obs->stats;
+	uint32_t start = k_cycle_get_32();
+	uint32_t cycles;
+	k_spinlock_key_t key;
+
+	obs->callback(chan);
+
+	if (stats == NULL) {
+		return;
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	key = k_spin_lock(&_zbus_obs_stats_lock);
+	stats->count++;
+	stats->max_cycles = MAX(stats->max_cycles, cycles);
+	stats->total_cycles += cycles;
+	k_spin_unlock(&_zbus_obs_stats_lock, key);
+}
+
+int zbus_obs_stats_get(const struct zbus_observer *obs, struct zbus_observer_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	_ZBUS_ASSERT(obs != NULL, "obs is required");
+	_ZBUS_ASSERT(stats != NULL, "stats is required");
+
+	if (obs->stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&_zbus_obs_stats_lock);
+	*stats = *obs->stats;
+	k_spin_unlock(&_zbus_obs_stats_lock, key);
+
+	return 0;
+}
+
+int zbus_obs_stats_reset(const struct zbus_observer *obs)
+{
+	k_spinlock_key_t key;
+
+	_ZBUS_ASSERT(obs != NULL, "obs is required");
+
+	if (obs->stats == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&_zbus_obs_stats_lock);
+	memset(obs->stats, 0, sizeof(*obs->stats));
+	k_spin_unlock(&_zbus_obs_stats_lock, key);
+
+	return 0;
+}
+#else
+void _zbus_obs_callback_run(const struct zbus_observer *obs, const struct zbus_channel *chan)
+{
+	obs->callback(chan);
+}
+#endif /* CONFIG_ZBUS_OBSERVER_STATS */
+
+static inline int _zbus_notify_listener(const struct zbus_channel *chan,
+					const struct zbus_observer *obs, uint64_t end_ticks)
+{
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER)
+	if (obs->async) {
+		int err = _zbus_async_listener_dispatch(chan, obs, _zbus_timeout_remainder(end_ticks));
+
+		if (err) {
+			LOG_ERR("Observer %s at %p could not be dispatched. Error code %d",
+				_ZBUS_OBS_NAME(obs), obs, err);
+		}
+
+		return err;
+	}
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER */
+
+	_zbus_obs_callback_run(obs, chan);
+
+	return 0;
+}
+
 #if (CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0)
-static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *chan)
+static inline int _zbus_notify_runtime_listeners(const struct zbus_channel *chan,
+						 uint64_t end_ticks)
 {
 	__ASSERT(chan != NULL, "chan is required");
 
+	int last_error = 0, err;
 	struct zbus_observer_node *obs_nd, *tmp;
 
 	SYS_SLIST_FOR_EACH_CONTAINER_SAFE(chan->runtime_observers, obs_nd, tmp, node) {
@@ -28,9 +117,14 @@ static inline void _zbus_notify_runtime_listeners(const struct zbus_channel *cha
 		__ASSERT(obs_nd != NULL, "observer node is NULL");
 
 		if (obs_nd->obs->enabled && (obs_nd->obs->callback != NULL)) {
-			obs_nd->obs->callback(chan);
+			err = _zbus_notify_listener(chan, obs_nd->obs, end_ticks);
+			if (err) {
+				last_error = err;
+			}
 		}
 	}
+
+	return last_error;
 }
 
 static inline int _zbus_notify_runtime_subscribers(const struct zbus_channel *chan,
@@ -69,12 +163,18 @@ static int _zbus_notify_observers(const struct zbus_channel *chan, uint64_t end_
 	/* Notify static listeners */
 	for (const struct zbus_observer *const *obs = chan->observers; *obs != NULL; ++obs) {
 		if ((*obs)->enabled && ((*obs)->callback != NULL)) {
-			(*obs)->callback(chan);
+			err = _zbus_notify_listener(chan, *obs, end_ticks);
+			if (err) {
+				last_error = err;
+			}
 		}
 	}
 
 #if CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE > 0
-	_zbus_notify_runtime_listeners(chan);
+	err = _zbus_notify_runtime_listeners(chan, end_ticks);
+	if (err) {
+		last_error = err;
+	}
 #endif /* CONFIG_ZBUS_RUNTIME_OBSERVERS_POOL_SIZE */
 
 	/* Notify static subscribers */
@@ -120,6 +220,12 @@ int zbus_chan_pub(const struct zbus_channel *chan, const void *msg, k_timeout_t
 
 	memcpy(chan->message, msg, chan->message_size);
 
+#if defined(CONFIG_ZBUS_MSG_RING)
+	if (chan->ring != NULL) {
+		_zbus_ring_put(chan, msg);
+	}
+#endif
+
 	err = _zbus_notify_observers(chan, end_ticks);
 
 	k_mutex_unlock(chan->mutex);
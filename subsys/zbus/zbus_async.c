@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/util_macro.h>
+#include <zephyr/zbus/zbus.h>
+
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+struct zbus_async_event {
+	const struct zbus_channel *chan;
+	const struct zbus_observer *obs;
+};
+
+static void _zbus_async_event_run(const struct zbus_async_event *evt)
+{
+	/* The observer may have been disabled after the notification was queued */
+	if (evt->obs->enabled) {
+		_zbus_obs_callback_run(evt->obs, evt->chan);
+	}
+}
+
+#if defined(CONFIG_ZBUS_ASYNC_LISTENER_WORKQUEUE)
+
+/* A single work item drains the queue. It never runs concurrently with itself, so the
+ * notifications are executed in the order they were queued.
+ */
+K_MSGQ_DEFINE(_zbus_async_queue, sizeof(struct zbus_async_event),
+	      CONFIG_ZBUS_ASYNC_LISTENER_QUEUE_SIZE, sizeof(void *));
+
+static struct k_work_q *_zbus_async_work_q = &k_sys_work_q;
+
+static void _zbus_async_work_handler(struct k_work *work)
+{
+	struct zbus_async_event evt;
+
+	ARG_UNUSED(work);
+
+	while (k_msgq_get(&_zbus_async_queue, &evt, K_NO_WAIT) == 0) {
+		_zbus_async_event_run(&evt);
+	}
+}
+
+static K_WORK_DEFINE(_zbus_async_work, _zbus_async_work_handler);
+
+void zbus_async_listener_work_queue_set(struct k_work_q *queue)
+{
+	__ASSERT(queue != NULL, "queue is required");
+
+	_zbus_async_work_q = queue;
+}
+
+int _zbus_async_listener_dispatch(const struct zbus_channel *chan,
+				  const struct zbus_observer *obs, k_timeout_t timeout)
+{
+	struct zbus_async_event evt = {.chan = chan, .obs = obs};
+	int err;
+
+	err = k_msgq_put(&_zbus_async_queue, &evt, timeout);
+	if (err) {
+		return err;
+	}
+
+	err = k_work_submit_to_queue(_zbus_async_work_q, &_zbus_async_work);
+
+	return err < 0 ? err : 0;
+}
+
+#else /* CONFIG_ZBUS_ASYNC_LISTENER_THREADS */
+
+/* Each channel is always served by the same worker, so the notifications of a channel are
+ * executed in order while different channels are served in parallel.
+ */
+static void _zbus_async_worker(void *p1, void *p2, void *p3)
+{
+	struct k_msgq *queue = p1;
+	struct zbus_async_event evt;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_msgq_get(queue, &evt, K_FOREVER);
+		_zbus_async_event_run(&evt);
+	}
+}
+
+#define _ZBUS_ASYNC_WORKER_DEFINE(_idx, _)                                                         \
+	K_MSGQ_DEFINE(_zbus_async_queue_##_idx, sizeof(struct zbus_async_event),                  \
+		      CONFIG_ZBUS_ASYNC_LISTENER_QUEUE_SIZE, sizeof(void *));                     \
+	K_THREAD_DEFINE(_zbus_async_worker_##_idx, CONFIG_ZBUS_ASYNC_LISTENER_THREADS_STACK_SIZE,  \
+			_zbus_async_worker, &_zbus_async_queue_##_idx, NULL, NULL,                 \
+			CONFIG_ZBUS_ASYNC_LISTENER_THREADS_PRIORITY, 0, 0)
+
+#define _ZBUS_ASYNC_QUEUE_REF(_idx, _) &_zbus_async_queue_##_idx
+
+LISTIFY(CONFIG_ZBUS_ASYNC_LISTENER_THREADS_NUM, _ZBUS_ASYNC_WORKER_DEFINE, (;));
+
+static struct k_msgq *const _zbus_async_queues[] = {
+	LISTIFY(CONFIG_ZBUS_ASYNC_LISTENER_THREADS_NUM, _ZBUS_ASYNC_QUEUE_REF, (,))
+};
+
+int _zbus_async_listener_dispatch(const struct zbus_channel *chan,
+				  const struct zbus_observer *obs, k_timeout_t timeout)
+{
+	struct zbus_async_event evt = {.chan = chan, .obs = obs};
+	size_t worker = (POINTER_TO_UINT(chan) / sizeof(struct zbus_channel)) %
+			ARRAY_SIZE(_zbus_async_queues);
+
+	return k_msgq_put(_zbus_async_queues[worker], &evt, timeout);
+}
+
+#endif /* CONFIG_ZBUS_ASYNC_LISTENER_WORKQUEUE */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+static inline uint8_t *_zbus_ring_slot(const struct zbus_channel *chan, uint32_t seq)
+{
+	const struct zbus_chan_ring *ring = chan->ring;
+
+	return ring->buffer + (size_t)(seq & (ring->len - 1)) * chan->message_size;
+}
+
+/* Must be called with the channel's mutex locked */
+void _zbus_ring_put(const struct zbus_channel *chan, const void *msg)
+{
+	memcpy(_zbus_ring_slot(chan, chan->ring->seq), msg, chan->message_size);
+
+	chan->ring->seq++;
+}
+
+int zbus_ring_cursor_init(struct zbus_ring_cursor *cursor, const struct zbus_channel *chan,
+			  k_timeout_t timeout)
+{
+	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(cursor != NULL, "cursor is required");
+	_ZBUS_ASSERT(chan != NULL, "chan is required");
+
+	if (chan->ring == NULL) {
+		return -EINVAL;
+	}
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	cursor->chan = chan;
+	cursor->seq = chan->ring->seq;
+	cursor->lost = 0;
+
+	k_mutex_unlock(chan->mutex);
+
+	return 0;
+}
+
+int zbus_ring_claim(struct zbus_ring_cursor *cursor, const void **msg, k_timeout_t timeout)
+{
+	int err;
+	uint32_t pending;
+	const struct zbus_channel *chan;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(cursor != NULL, "cursor is required");
+	_ZBUS_ASSERT(cursor->chan != NULL, "cursor is not initialized");
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	chan = cursor->chan;
+
+	err = k_mutex_lock(chan->mutex, timeout);
+	if (err) {
+		return err;
+	}
+
+	pending = chan->ring->seq - cursor->seq;
+	if (pending == 0) {
+		k_mutex_unlock(chan->mutex);
+
+		return -ENODATA;
+	}
+
+	if (pending > chan->ring->len) {
+		/* The oldest messages were overwritten, skip to the oldest one kept */
+		cursor->lost += pending - chan->ring->len;
+		cursor->seq = chan->ring->seq - chan->ring->len;
+
+		LOG_DBG("%u messages lost by a ring reader", pending - chan->ring->len);
+	}
+
+	*msg = _zbus_ring_slot(chan, cursor->seq);
+
+	return 0;
+}
+
+int zbus_ring_finish(struct zbus_ring_cursor *cursor)
+{
+	int err;
+
+	_ZBUS_ASSERT(!k_is_in_isr(), "zbus cannot be used inside ISRs");
+	_ZBUS_ASSERT(cursor != NULL, "cursor is required");
+	_ZBUS_ASSERT(cursor->chan != NULL, "cursor is not initialized");
+
+	err = k_mutex_unlock(cursor->chan->mutex);
+	if (err) {
+		return err;
+	}
+
+	cursor->seq++;
+
+	return 0;
+}
+
+int zbus_ring_read(struct zbus_ring_cursor *cursor, void *msg, k_timeout_t timeout)
+{
+	int err;
+	const void *slot;
+
+	_ZBUS_ASSERT(msg != NULL, "msg is required");
+
+	err = zbus_ring_claim(cursor, &slot, timeout);
+	if (err) {
+		return err;
+	}
+
+	memcpy(msg, slot, cursor->chan->message_size);
+
+	return zbus_ring_finish(cursor);
+}
@@ -12,6 +12,11 @@
 /* Max size of a message string */
 #define MAX_MSG 256
 
+/* The benchmarks below rely on the receiver task never running at the same
+ * time as the master task, so only the MPMC queue comparison runs on SMP.
+ */
+#ifndef CONFIG_SMP
+
 /* flag for performing the Mailbox benchmark */
 #define MAILBOX_BENCH
 
@@ -36,4 +41,11 @@
 /* flag for performing the Event benchmark */
 #define EVENT_BENCH
 
+#endif /* !CONFIG_SMP */
+
+/* flag for performing the lock-free MPMC queue benchmark */
+#ifdef CONFIG_MPMCQ
+#define MPMCQ_BENCH
+#endif
+
 #endif /* _CONFIG_H */
@@ -126,6 +126,7 @@ void main(void)
 					 output_file);
 		PRINT_STRING(dashline, output_file);
 		queue_test();
+		mpmcq_test();
 		sema_test();
 		mutex_test();
 		memorymap_test();
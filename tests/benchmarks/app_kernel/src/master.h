@@ -98,6 +98,12 @@ extern void queue_test(void);
 #define queue_test dummy_test
 #endif
 
+#ifdef MPMCQ_BENCH
+extern void mpmcq_test(void);
+#else
+#define mpmcq_test dummy_test
+#endif
+
 #ifdef MUTEX_BENCH
 extern void mutex_test(void);
 #else
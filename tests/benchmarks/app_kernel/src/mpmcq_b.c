@@ -0,0 +1,172 @@
+/* mpmcq_b.c */
+
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "master.h"
+
+#ifdef MPMCQ_BENCH
+
+/* Power of two large enough for all the runs, so a put never fails */
+#define MPMCQ_LEN 512
+BUILD_ASSERT(MPMCQ_LEN >= NR_OF_FIFO_RUNS);
+
+#define HELPER_STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+struct fifo_item {
+	void *fifo_reserved;
+};
+
+static struct fifo_item fifo_items[NR_OF_FIFO_RUNS];
+
+K_FIFO_DEFINE(BENCH_FIFO);
+K_MPMCQ_DEFINE(BENCH_MPMCQ, MPMCQ_LEN);
+
+/**
+ *
+ * @brief Uncontended enqueue and dequeue of k_fifo and k_mpmcq
+ *
+ */
+static void mpmcq_single_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&BENCH_FIFO, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue item in k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&BENCH_FIFO, K_NO_WAIT);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue item from k_fifo",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_mpmcq_put(&BENCH_MPMCQ, &fifo_items[i]);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue item in k_mpmcq",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_mpmcq_get(&BENCH_MPMCQ, K_NO_WAIT);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue item from k_mpmcq",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
+
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+
+static K_THREAD_STACK_DEFINE(helper_stack, HELPER_STACK_SIZE);
+static struct k_thread helper_thread;
+
+static void fifo_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_fifo_get(&BENCH_FIFO, K_FOREVER);
+	}
+}
+
+static void mpmcq_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_mpmcq_get(&BENCH_MPMCQ, K_FOREVER);
+	}
+}
+
+static void start_consumer(k_thread_entry_t entry)
+{
+	k_thread_create(&helper_thread, helper_stack,
+			K_THREAD_STACK_SIZEOF(helper_stack), entry,
+			NULL, NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0,
+			K_NO_WAIT);
+}
+
+/**
+ *
+ * @brief Transfer items to a consumer running on another CPU
+ *
+ * The measured time covers the whole transfer, i.e. until the consumer
+ * has dequeued the last item.
+ *
+ */
+static void mpmcq_smp_test(void)
+{
+	uint32_t et; /* elapsed time */
+	int i;
+
+	start_consumer(fifo_consumer);
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_fifo_put(&BENCH_FIFO, &fifo_items[i]);
+	}
+	k_thread_join(&helper_thread, K_FOREVER);
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "transfer item through k_fifo to another CPU",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	start_consumer(mpmcq_consumer);
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		(void)k_mpmcq_put(&BENCH_MPMCQ, &fifo_items[i]);
+	}
+	k_thread_join(&helper_thread, K_FOREVER);
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "transfer item through k_mpmcq to another CPU",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
+
+#endif /* CONFIG_MP_MAX_NUM_CPUS > 1 */
+
+/**
+ *
+ * @brief Lock-free MPMC queue versus FIFO speed test
+ *
+ */
+void mpmcq_test(void)
+{
+	PRINT_STRING(dashline, output_file);
+
+	mpmcq_single_test();
+
+#if CONFIG_MP_MAX_NUM_CPUS > 1
+	mpmcq_smp_test();
+#endif
+}
+
+#endif /* MPMCQ_BENCH */
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the cost of the local GATT database lookups done by the ATT
+ * server for each request, on a large database and without any radio: the
+ * lookups are done with the same calls and arguments as the request handlers
+ * of the ATT layer.
+ *
+ * The database holds 32 vendor services of 4 characteristics each, and the
+ * requests target the last service, as a client would after discovering the
+ * database.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/gatt.h>
+
+#define NUM_SVCS	32
+#define NUM_REQS	4096
+
+#define TEST_UUID(svc, chrc) BT_UUID_DECLARE_128(BT_UUID_128_ENCODE( \
+	0x8e7f1a00 + (svc), 0x7d52, 0x4e33, 0xa4b5, 0x3c2a19e40000 + (chrc)))
+
+static uint8_t value[4];
+
+static ssize_t read_value(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			  void *buf, uint16_t len, uint16_t offset)
+{
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, value,
+				 sizeof(value));
+}
+
+#define TEST_CHRC(svc, chrc)                                                   \
+	BT_GATT_CHARACTERISTIC(TEST_UUID(svc, chrc),                           \
+			       BT_GATT_CHRC_READ | BT_GATT_CHRC_NOTIFY,        \
+			       BT_GATT_PERM_READ, read_value, NULL, value)
+
+#define TEST_ATTRS(svc, _)                                                     \
+	static struct bt_gatt_attr attrs_##svc[] = {                           \
+		BT_GATT_PRIMARY_SERVICE(TEST_UUID(svc, 0)),                    \
+		TEST_CHRC(svc, 1),                                             \
+		TEST_CHRC(svc, 2),                                             \
+		TEST_CHRC(svc, 3),                                             \
+		TEST_CHRC(svc, 4),                                             \
+		BT_GATT_CCC(NULL, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE),     \
+	}
+
+LISTIFY(NUM_SVCS, TEST_ATTRS, (;));
+
+#define TEST_SVC(svc, _) BT_GATT_SERVICE(attrs_##svc)
+
+static struct bt_gatt_service svcs[] = {
+	LISTIFY(NUM_SVCS, TEST_SVC, (,))
+};
+
+static uint32_t found;
+
+static uint8_t found_cb(const struct bt_gatt_attr *attr, uint16_t handle,
+			void *user_data)
+{
+	found++;
+
+	return BT_GATT_ITER_STOP;
+}
+
+static uint8_t count_cb(const struct bt_gatt_attr *attr, uint16_t handle,
+			void *user_data)
+{
+	found++;
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void *gatt_db_setup(void)
+{
+	uint16_t count = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(svcs); i++) {
+		zassert_ok(bt_gatt_service_register(&svcs[i]));
+		count += svcs[i].attr_count;
+	}
+
+	TC_PRINT("%u attributes registered, %u handles indexed\n", count,
+		 CONFIG_BT_GATT_DB_INDEX_SIZE);
+
+	return NULL;
+}
+
+static void gatt_db_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	found = 0;
+}
+
+static uint32_t ns_per_req(uint32_t cycles)
+{
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / NUM_REQS);
+}
+
+/* Read, Write and Prepare Write Requests look up a single handle */
+ZTEST(gatt_db, test_handle)
+{
+	struct bt_gatt_attr *attrs = svcs[NUM_SVCS - 1].attrs;
+	uint32_t start, cycles;
+	uint16_t handle;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_REQS; i++) {
+		handle = attrs[i % svcs[NUM_SVCS - 1].attr_count].handle;
+
+		bt_gatt_foreach_attr(handle, handle, found_cb, NULL);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(found, NUM_REQS, "%u attributes found", found);
+	TC_PRINT("Handle lookup: %u ns per request\n", ns_per_req(cycles));
+}
+
+/* Read By Type Request for the value of a characteristic */
+ZTEST(gatt_db, test_read_type)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_REQS; i++) {
+		bt_gatt_foreach_attr_type(0x0001, 0xffff,
+					  TEST_UUID(NUM_SVCS - 1, 1 + i % 4),
+					  NULL, 0, count_cb, NULL);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(found, NUM_REQS, "%u attributes found", found);
+	TC_PRINT("Read By Type: %u ns per request\n", ns_per_req(cycles));
+}
+
+/* Characteristic discovery of the last service, one declaration per
+ * Read By Type Request.
+ */
+ZTEST(gatt_db, test_discover_chrc)
+{
+	struct bt_gatt_attr *attrs = svcs[NUM_SVCS - 1].attrs;
+	uint32_t start, cycles;
+	uint16_t handle;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_REQS; i++) {
+		handle = attrs[1 + (i % 4) * 2].handle;
+
+		bt_gatt_foreach_attr_type(handle, 0xffff, BT_UUID_GATT_CHRC,
+					  NULL, 1, found_cb, NULL);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(found, NUM_REQS, "%u attributes found", found);
+	TC_PRINT("Characteristic discovery: %u ns per request\n",
+		 ns_per_req(cycles));
+}
+
+/* Attribute lookup by UUID, as done by the application before notifying */
+ZTEST(gatt_db, test_find_by_uuid)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_REQS; i++) {
+		found += !!bt_gatt_find_by_uuid(NULL, 0,
+						TEST_UUID(NUM_SVCS - 1, 1 + i % 4));
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(found, NUM_REQS, "%u attributes found", found);
+	TC_PRINT("Find by UUID: %u ns per lookup\n", ns_per_req(cycles));
+}
+
+ZTEST_SUITE(gatt_db, NULL, gatt_db_setup, gatt_db_before, NULL, NULL);
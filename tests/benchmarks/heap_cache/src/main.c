@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compares small-block allocation throughput of a spinlock-protected
+ * sys_heap against the same heap behind a sys_heap_cache, with one
+ * worker thread per CPU for 1..N CPUs, then reports the cache and
+ * heap fragmentation statistics.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/sys_heap_cache.h>
+
+#define HEAP_BYTES (32 * 1024)
+#define WINDOW_MS 500
+#define BURST 8
+#define STACK_SIZE 1024
+
+static char heap_mem[HEAP_BYTES] __aligned(8);
+static struct sys_heap heap;
+static struct k_spinlock heap_lock;
+static struct sys_heap_cache cache;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_MAX_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_MAX_NUM_CPUS];
+static uint32_t counts[CONFIG_MP_MAX_NUM_CPUS];
+static volatile bool use_cache;
+
+static void *bench_alloc(size_t bytes)
+{
+	if (use_cache) {
+		return sys_heap_cache_alloc(&cache, bytes);
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&heap_lock);
+	void *ret = sys_heap_alloc(&heap, bytes);
+
+	k_spin_unlock(&heap_lock, key);
+	return ret;
+}
+
+static void bench_free(void *mem)
+{
+	if (use_cache) {
+		sys_heap_cache_free(&cache, mem);
+		return;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&heap_lock);
+
+	sys_heap_free(&heap, mem);
+	k_spin_unlock(&heap_lock, key);
+}
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	uint32_t *count = p1;
+	uint32_t seed = POINTER_TO_UINT(p2);
+	void *blocks[BURST];
+
+	ARG_UNUSED(p3);
+
+	while (true) {
+		for (int i = 0; i < BURST; i++) {
+			/* Cheap LCG, sizes 8..135 bytes */
+			seed = seed * 1103515245U + 12345U;
+			blocks[i] = bench_alloc(8 + ((seed >> 16) & 127));
+		}
+		for (int i = 0; i < BURST; i++) {
+			if (blocks[i] != NULL) {
+				bench_free(blocks[i]);
+				(*count)++;
+			}
+		}
+	}
+}
+
+static uint32_t run(int ncpus, bool cached)
+{
+	uint32_t total = 0;
+
+	use_cache = cached;
+
+	for (int i = 0; i < ncpus; i++) {
+		counts[i] = 0;
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				&counts[i], UINT_TO_POINTER(i + 1), NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+#endif
+		k_thread_start(&threads[i]);
+	}
+
+	k_msleep(WINDOW_MS);
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_abort(&threads[i]);
+		total += counts[i];
+	}
+
+	/* Aborted workers may have leaked up to a burst each */
+	return total * (1000U / WINDOW_MS);
+}
+
+ZTEST(heap_cache, test_functional)
+{
+	void *blocks[64];
+
+	/* Stay on one CPU so the flush below sees every cached block */
+	k_sched_lock();
+
+	sys_heap_init(&heap, heap_mem, HEAP_BYTES);
+	sys_heap_cache_init(&cache, &heap, &heap_lock);
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		size_t sz = 1 + (i * 37) % 300;
+
+		blocks[i] = sys_heap_cache_alloc(&cache, sz);
+		zassert_not_null(blocks[i], "alloc %d failed", i);
+		zassert_true(((uintptr_t)blocks[i] &
+			      (__alignof__(z_max_align_t) - 1)) == 0,
+			     "misaligned block");
+		zassert_true(sys_heap_usable_size(&heap, blocks[i]) >= sz,
+			     "block too small");
+		memset(blocks[i], i, sz);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		sys_heap_cache_free(&cache, blocks[i]);
+	}
+
+	sys_heap_cache_flush(&cache);
+	k_sched_unlock();
+	zassert_true(sys_heap_validate(&heap), "heap corrupt");
+
+	struct sys_heap_cache_stats stats;
+
+	zassert_ok(sys_heap_cache_stats_get(&cache, &stats));
+	zassert_equal(stats.cached_bytes, 0, "flush left blocks cached");
+	zassert_equal(stats.heap.allocated_bytes, 0, "blocks leaked");
+}
+
+ZTEST(heap_cache, test_scaling)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	struct sys_heap_cache_stats stats;
+
+	for (int n = 1; n <= num_cpus; n++) {
+		sys_heap_init(&heap, heap_mem, HEAP_BYTES);
+		uint32_t locked = run(n, false);
+
+		sys_heap_init(&heap, heap_mem, HEAP_BYTES);
+		sys_heap_cache_init(&cache, &heap, &heap_lock);
+		uint32_t cached = run(n, true);
+
+		TC_PRINT("cpus %d: locked %u allocs/s, cached %u allocs/s\n",
+			 n, locked, cached);
+	}
+
+	zassert_ok(sys_heap_cache_stats_get(&cache, &stats));
+	TC_PRINT("hits %u refills %u drains %u cached %zu bytes\n",
+		 stats.hits, stats.refills, stats.drains, stats.cached_bytes);
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		TC_PRINT("  class %4u: %u blocks\n",
+			 1U << (SYS_HEAP_CACHE_MIN_SHIFT + i),
+			 stats.cached_blocks[i]);
+	}
+	TC_PRINT("heap free %zu allocated %zu max %zu\n",
+		 stats.heap.free_bytes, stats.heap.allocated_bytes,
+		 stats.heap.max_allocated_bytes);
+}
+
+ZTEST_SUITE(heap_cache, NULL, NULL, NULL, NULL, NULL);
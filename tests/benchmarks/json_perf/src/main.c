@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Compares the throughput of the descriptor-based JSON parser and encoder
+ * with the streaming parser and the resumable encoder, on a document of
+ * sensor readings such as a device would report to a cloud service.
+ *
+ * The streaming parser is fed the document in FRAGMENT_SIZE bytes
+ * fragments, as it would be from a net_buf chain, and the resumable encoder
+ * writes it in FRAGMENT_SIZE bytes chunks. json_obj_parse() modifies its
+ * input, so the time to copy the document is included in its measurement.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/data/json.h>
+
+#define NUM_READINGS	32
+#define ITERATIONS	200
+#define FRAGMENT_SIZE	64
+
+struct reading {
+	const char *sensor;
+	int value;
+	bool valid;
+};
+
+struct report {
+	const char *device;
+	int timestamp;
+	struct reading readings[NUM_READINGS];
+	size_t num_readings;
+};
+
+static const struct json_obj_descr reading_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct reading, sensor, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct reading, value, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_PRIM(struct reading, valid, JSON_TOK_TRUE),
+};
+
+static const struct json_obj_descr report_descr[] = {
+	JSON_OBJ_DESCR_PRIM(struct report, device, JSON_TOK_STRING),
+	JSON_OBJ_DESCR_PRIM(struct report, timestamp, JSON_TOK_NUMBER),
+	JSON_OBJ_DESCR_OBJ_ARRAY(struct report, readings, NUM_READINGS,
+				 num_readings, reading_descr,
+				 ARRAY_SIZE(reading_descr)),
+};
+
+static char sensor_names[NUM_READINGS][16];
+static struct report report;
+static char document[2048];
+static size_t document_len;
+static char work[sizeof(document)];
+
+static void print_throughput(const char *name, size_t len, uint32_t cycles)
+{
+	uint64_t ns = k_cyc_to_ns_floor64(cycles);
+
+	TC_PRINT("%s: %u ns per document, %u KiB/s\n", name,
+		 (uint32_t)(ns / ITERATIONS),
+		 (uint32_t)((uint64_t)len * ITERATIONS * NSEC_PER_SEC / 1024 / ns));
+}
+
+static void *json_perf_setup(void)
+{
+	int ret;
+
+	report.device = "sensor-hub-0001";
+	report.timestamp = 1680000000;
+	report.num_readings = NUM_READINGS;
+
+	for (int i = 0; i < NUM_READINGS; i++) {
+		snprintk(sensor_names[i], sizeof(sensor_names[i]), "temp%d", i);
+		report.readings[i].sensor = sensor_names[i];
+		report.readings[i].value = -4000 + i * 317;
+		report.readings[i].valid = (i % 5) != 0;
+	}
+
+	ret = json_obj_encode_buf(report_descr, ARRAY_SIZE(report_descr),
+				  &report, document, sizeof(document));
+	zassert_equal(ret, 0, "json_obj_encode_buf failed: %d", ret);
+
+	document_len = strlen(document);
+	TC_PRINT("%zu bytes document, %d readings\n", document_len, NUM_READINGS);
+
+	return NULL;
+}
+
+ZTEST(json_perf, test_parse)
+{
+	struct report parsed;
+	uint32_t start, cycles;
+	int64_t ret;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		memcpy(work, document, document_len);
+		ret = json_obj_parse(work, document_len, report_descr,
+				     ARRAY_SIZE(report_descr), &parsed);
+		zassert_equal(ret, BIT_MASK(ARRAY_SIZE(report_descr)),
+			      "json_obj_parse failed: %lld", (long long)ret);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(parsed.num_readings, NUM_READINGS, NULL);
+	print_throughput("json_obj_parse", document_len, cycles);
+}
+
+static int count_tokens(const struct json_stream_token *tok, void *user_data)
+{
+	uint32_t *count = user_data;
+
+	if (!tok->partial) {
+		(*count)++;
+	}
+
+	return 0;
+}
+
+ZTEST(json_perf, test_stream)
+{
+	struct json_stream stream;
+	uint32_t start, cycles;
+	uint32_t count = 0;
+	char buf[32];
+	size_t n;
+	int ret;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		json_stream_init(&stream, buf, sizeof(buf), count_tokens, &count);
+
+		for (size_t off = 0; off < document_len; off += n) {
+			n = MIN(FRAGMENT_SIZE, document_len - off);
+
+			ret = json_stream_feed(&stream, document + off, n);
+			zassert_equal(ret, 0, "json_stream_feed failed: %d", ret);
+		}
+
+		ret = json_stream_finish(&stream);
+		zassert_equal(ret, 0, "json_stream_finish failed: %d", ret);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	/* The report object, its 3 keys, 2 values and the readings array */
+	zassert_equal(count, ITERATIONS * (2 + 3 + 2 + 2 + NUM_READINGS * (2 + 2 * 3)),
+		      "%u tokens", count);
+	print_throughput("json_stream_feed", document_len, cycles);
+}
+
+ZTEST(json_perf, test_encode)
+{
+	uint32_t start, cycles;
+	int ret;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		ret = json_obj_encode_buf(report_descr, ARRAY_SIZE(report_descr),
+					  &report, work, sizeof(work));
+		zassert_equal(ret, 0, "json_obj_encode_buf failed: %d", ret);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	print_throughput("json_obj_encode_buf", document_len, cycles);
+}
+
+ZTEST(json_perf, test_encoder)
+{
+	struct json_encoder enc;
+	uint32_t start, cycles;
+	char chunk[FRAGMENT_SIZE];
+	size_t len = 0;
+	ssize_t ret;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		json_obj_encoder_init(&enc, report_descr, ARRAY_SIZE(report_descr),
+				      &report);
+		len = 0;
+
+		do {
+			ret = json_encoder_write(&enc, chunk, sizeof(chunk));
+			zassert_true(ret >= 0, "json_encoder_write failed: %d", (int)ret);
+			len += ret;
+		} while (ret > 0);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(len, document_len, "%zu bytes encoded", len);
+	print_throughput("json_encoder_write", document_len, cycles);
+}
+
+ZTEST_SUITE(json_perf, NULL, json_perf_setup, NULL, NULL, NULL);
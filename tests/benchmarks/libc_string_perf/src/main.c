@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the string and memory functions of the C library for sizes from
+ * 1 byte to 64 KiB, with word-aligned buffers and with a misaligned source,
+ * as found when copying headers and payloads out of network buffers.
+ *
+ * Each measurement processes at least BYTES_PER_RUN bytes, so small sizes
+ * are run many times. Build with and without
+ * CONFIG_MINIMAL_LIBC_OPTIMIZE_STRING_FOR_SIZE to compare the word-sized
+ * and the byte-sized implementations, or with
+ * CONFIG_MINIMAL_LIBC_ARCH_STRING to measure the SSE2 or NEON ones.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#define MAX_SIZE	(64 * 1024)
+#define BYTES_PER_RUN	(256 * 1024)
+#define MIN_RUNS	16
+
+static const size_t sizes[] = {
+	1, 4, 16, 64, 256, 1024, 4096, 16384, MAX_SIZE,
+};
+
+static uint8_t buf_a[MAX_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+static uint8_t buf_b[MAX_SIZE + sizeof(uintptr_t)] __aligned(sizeof(uintptr_t));
+
+/* Keeps the results alive, so the calls are not optimized out */
+static volatile uintptr_t sink;
+
+enum str_func {
+	FUNC_MEMCPY,
+	FUNC_MEMMOVE,
+	FUNC_MEMSET,
+	FUNC_MEMCMP,
+	FUNC_MEMCHR,
+	FUNC_STRLEN,
+	FUNC_STRCMP,
+};
+
+static const char *const func_names[] = {
+	[FUNC_MEMCPY] = "memcpy",
+	[FUNC_MEMMOVE] = "memmove",
+	[FUNC_MEMSET] = "memset",
+	[FUNC_MEMCMP] = "memcmp",
+	[FUNC_MEMCHR] = "memchr",
+	[FUNC_STRLEN] = "strlen",
+	[FUNC_STRCMP] = "strcmp",
+};
+
+static void prepare(size_t size, size_t src_offset)
+{
+	/* Equal strings of <size> bytes, the source one at <src_offset> */
+	memset(buf_a, 'a', sizeof(buf_a));
+	memset(buf_b, 'a', sizeof(buf_b));
+	buf_a[src_offset + size] = '\0';
+	buf_b[size] = '\0';
+}
+
+static uintptr_t run(enum str_func func, uint8_t *dst, const uint8_t *src, size_t size)
+{
+	switch (func) {
+	case FUNC_MEMCPY:
+		return (uintptr_t)memcpy(dst, src, size);
+	case FUNC_MEMMOVE:
+		/* overlapping, backward */
+		return (uintptr_t)memmove(dst + 1, dst, size - 1);
+	case FUNC_MEMSET:
+		return (uintptr_t)memset(dst, 'a', size);
+	case FUNC_MEMCMP:
+		return (uintptr_t)memcmp(dst, src, size);
+	case FUNC_MEMCHR:
+		return (uintptr_t)memchr(src, 'b', size);
+	case FUNC_STRLEN:
+		return strlen((const char *)src);
+	default:
+		return (uintptr_t)strcmp((const char *)dst, (const char *)src);
+	}
+}
+
+static void measure(enum str_func func, size_t src_offset)
+{
+	uint32_t start, cycles;
+	uint64_t ns;
+	size_t runs;
+
+	TC_PRINT("%s, source offset %zu:\n", func_names[func], src_offset);
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		size_t size = sizes[i];
+
+		runs = MAX(BYTES_PER_RUN / size, MIN_RUNS);
+		prepare(size, src_offset);
+
+		start = k_cycle_get_32();
+		for (size_t r = 0; r < runs; r++) {
+			sink = run(func, buf_b, buf_a + src_offset, size);
+		}
+		cycles = k_cycle_get_32() - start;
+
+		ns = k_cyc_to_ns_floor64(cycles);
+		TC_PRINT("  %6zu bytes: %8u ns, %6u MB/s\n", size,
+			 (uint32_t)(ns / runs),
+			 ns ? (uint32_t)((uint64_t)size * runs * 1000 / ns) : 0);
+	}
+}
+
+ZTEST(libc_string_perf, test_aligned)
+{
+	for (size_t func = 0; func < ARRAY_SIZE(func_names); func++) {
+		measure(func, 0);
+	}
+}
+
+ZTEST(libc_string_perf, test_misaligned)
+{
+	for (size_t func = 0; func < ARRAY_SIZE(func_names); func++) {
+		measure(func, 1);
+	}
+}
+
+ZTEST_SUITE(libc_string_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the per-message cost of the access layer dispatch of
+ * bt_mesh_model_recv() on a large composition, without any radio: messages
+ * are passed to the access layer as the transport layer would after
+ * decrypting them.
+ *
+ * The composition models a multi-channel device: every element holds the
+ * same set of models, and every model subscribes to its own group addresses.
+ * The messages are addressed to the last model of the last element, which
+ * is the worst case for walking the opcode and subscription lists.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "net.h"
+#include "access.h"
+
+#define NUM_ELEMS	16
+#define NUM_MODELS	8
+#define NUM_OPS		4
+#define NUM_MSGS	(16 * 1024)
+
+#define PRIMARY_ADDR	0x0001
+#define GROUP_ADDR(elem, mod, i) \
+	(0xc000 + ((elem) * NUM_MODELS + (mod)) * CONFIG_BT_MESH_MODEL_GROUP_COUNT + (i))
+#define OPCODE(mod, i)	BT_MESH_MODEL_OP_2(0x82, (mod) * NUM_OPS + (i))
+
+static uint32_t handled;
+
+static int handler(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		   struct net_buf_simple *buf)
+{
+	handled++;
+
+	return 0;
+}
+
+#define MODEL_OPS(mod, _)                                                      \
+	static const struct bt_mesh_model_op ops_##mod[] = {                   \
+		{ OPCODE(mod, 0), BT_MESH_LEN_MIN(0), handler },               \
+		{ OPCODE(mod, 1), BT_MESH_LEN_MIN(0), handler },               \
+		{ OPCODE(mod, 2), BT_MESH_LEN_MIN(0), handler },               \
+		{ OPCODE(mod, 3), BT_MESH_LEN_MIN(0), handler },               \
+		BT_MESH_MODEL_OP_END,                                          \
+	}
+
+LISTIFY(NUM_MODELS, MODEL_OPS, (;));
+
+#define ELEM_MODELS(elem, _)                                                   \
+	static struct bt_mesh_model models_##elem[] = {                        \
+		BT_MESH_MODEL(0x1000, ops_0, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1001, ops_1, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1002, ops_2, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1003, ops_3, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1004, ops_4, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1005, ops_5, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1006, ops_6, NULL, NULL),                      \
+		BT_MESH_MODEL(0x1007, ops_7, NULL, NULL),                      \
+	}
+
+LISTIFY(NUM_ELEMS, ELEM_MODELS, (;));
+
+#define ELEM(elem, _) BT_MESH_ELEM(elem, models_##elem, BT_MESH_MODEL_NONE)
+
+static struct bt_mesh_elem elements[] = {
+	LISTIFY(NUM_ELEMS, ELEM, (,))
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = 0xffff,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static void sub_init(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+		     bool vnd, bool primary, void *user_data)
+{
+	mod->keys[0] = 0;
+
+	for (int i = 0; i < mod->groups_cnt; i++) {
+		mod->groups[i] = GROUP_ADDR(mod->elem_idx, mod->mod_idx, i);
+	}
+}
+
+static void *mesh_access_setup(void)
+{
+	zassert_ok(bt_mesh_comp_register(&comp));
+	bt_mesh_comp_provision(PRIMARY_ADDR);
+
+	bt_mesh_model_foreach(sub_init, NULL);
+	bt_mesh_model_sub_index_rebuild();
+
+	TC_PRINT("%u elements, %u opcode index entries, %u subscription index entries\n",
+		 NUM_ELEMS, CONFIG_BT_MESH_ACCESS_OP_INDEX_SIZE,
+		 CONFIG_BT_MESH_ACCESS_SUB_INDEX_SIZE);
+
+	return NULL;
+}
+
+static void mesh_access_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	handled = 0;
+}
+
+static uint32_t recv_msgs(uint16_t dst)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, 8);
+	struct net_buf_simple_state state;
+	struct bt_mesh_net_rx rx = {
+		.ctx = {
+			.app_idx = 0,
+			.addr = 0x7fff,
+			.recv_dst = dst,
+		},
+	};
+	uint32_t start, cycles;
+
+	net_buf_simple_add_be16(&buf, OPCODE(NUM_MODELS - 1, NUM_OPS - 1));
+	net_buf_simple_add_u8(&buf, 0x01);
+	net_buf_simple_save(&buf, &state);
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_MSGS; i++) {
+		bt_mesh_model_recv(&rx, &buf);
+		net_buf_simple_restore(&buf, &state);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(handled, NUM_MSGS, "%u messages handled", handled);
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / NUM_MSGS);
+}
+
+ZTEST(mesh_access, test_unicast)
+{
+	TC_PRINT("Unicast dispatch: %u ns per message\n",
+		 recv_msgs(PRIMARY_ADDR + NUM_ELEMS - 1));
+}
+
+ZTEST(mesh_access, test_group)
+{
+	TC_PRINT("Group dispatch: %u ns per message\n",
+		 recv_msgs(GROUP_ADDR(NUM_ELEMS - 1, NUM_MODELS - 1, 1)));
+}
+
+ZTEST(mesh_access, test_has_addr)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_MSGS; i++) {
+		/* Every other lookup misses, as for traffic to other nodes */
+		handled += bt_mesh_has_addr(GROUP_ADDR(NUM_ELEMS - 1, NUM_MODELS - 1,
+						       i & 1) + (i & 2) * 0x100);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(handled, NUM_MSGS / 2, "%u subscribed lookups", handled);
+	TC_PRINT("Group address lookup: %u ns per address\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / NUM_MSGS));
+}
+
+ZTEST_SUITE(mesh_access, NULL, mesh_access_setup, mesh_access_before, NULL, NULL);
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the per-PDU cost of the Network Message Cache and Replay
+ * Protection List lookups on the mesh RX path, without any radio: the
+ * network layer state is driven directly, as it would be by
+ * bt_mesh_net_recv() for PDUs that decrypted successfully.
+ *
+ * The traffic models a relay in a large network: the source addresses of
+ * the PDUs cycle through as many nodes as the RPL holds, and every PDU is
+ * received several times, as relayed by several neighbours.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "net.h"
+#include "msg_cache.h"
+#include "rpl.h"
+
+#define NUM_NODES	CONFIG_BT_MESH_CRPL
+#define COPIES		3
+#define NUM_PDUS	(16 * 1024)
+
+static uint32_t node_seq[NUM_NODES];
+
+static uint16_t node_addr(uint32_t node)
+{
+	/* Spread the unicast addresses as a provisioner would */
+	return 0x0001 + node * 4;
+}
+
+static void *mesh_rx_setup(void)
+{
+	TC_PRINT("%u entries RPL, %u entries message cache\n", CONFIG_BT_MESH_CRPL,
+		 CONFIG_BT_MESH_MSG_CACHE_SIZE);
+
+	return NULL;
+}
+
+static void mesh_rx_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_mesh_msg_cache_clear();
+	bt_mesh_rpl_clear();
+	memset(node_seq, 0, sizeof(node_seq));
+}
+
+ZTEST(mesh_rx, test_msg_cache)
+{
+	uint32_t start, cycles;
+	uint32_t dup = 0;
+	uint32_t node;
+	uint16_t src;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_PDUS; i++) {
+		node = (i / COPIES) % NUM_NODES;
+		src = node_addr(node);
+
+		if (i % COPIES == 0) {
+			node_seq[node]++;
+		}
+
+		if (bt_mesh_msg_cache_match(src, node_seq[node])) {
+			dup++;
+			continue;
+		}
+
+		bt_mesh_msg_cache_add(src, node_seq[node]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(dup, NUM_PDUS - ceiling_fraction(NUM_PDUS, COPIES),
+		      "%u duplicates", dup);
+	TC_PRINT("Network Message Cache: %u ns per PDU\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / NUM_PDUS));
+}
+
+ZTEST(mesh_rx, test_rpl)
+{
+	struct bt_mesh_net_rx rx = {
+		.net_if = BT_MESH_NET_IF_ADV,
+		.local_match = 1,
+	};
+	uint32_t start, cycles;
+	uint32_t replayed = 0;
+	uint32_t node;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < NUM_PDUS; i++) {
+		node = (i / COPIES) % NUM_NODES;
+
+		if (i % COPIES == 0) {
+			node_seq[node]++;
+		}
+
+		rx.ctx.addr = node_addr(node);
+		rx.seq = node_seq[node];
+
+		if (bt_mesh_rpl_check(&rx, NULL)) {
+			replayed++;
+		}
+	}
+	cycles = k_cycle_get_32() - start;
+
+	/* Only the first copy of each PDU is accepted */
+	zassert_equal(replayed, NUM_PDUS - ceiling_fraction(NUM_PDUS, COPIES),
+		      "%u replays", replayed);
+	TC_PRINT("Replay Protection List: %u ns per PDU\n",
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / NUM_PDUS));
+}
+
+ZTEST_SUITE(mesh_rx, NULL, mesh_rx_setup, mesh_rx_before, NULL, NULL);
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the cost of demultiplexing an incoming UDP packet to its
+ * connection handler as the number of registered handlers grows.
+ * The handler the packet is destined to is registered first, which
+ * puts it at the tail of the connection list, i.e. the worst case for
+ * a linear search.  The same packet is then fed to net_conn_input()
+ * repeatedly and the average number of cycles per packet is reported
+ * for each number of handlers.  With CONFIG_NET_CONN_HASH and enough
+ * buckets this should stay flat.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/net/net_core.h>
+#include <zephyr/net/net_pkt.h>
+#include <zephyr/net/net_ip.h>
+#include <zephyr/net/net_if.h>
+#include <zephyr/net/dummy.h>
+
+#include "connection.h"
+
+#define TARGET_PORT 4242
+#define OTHER_PORT_BASE 10000
+#define MAX_HANDLERS (CONFIG_NET_MAX_CONN - 4)
+#define ITERATIONS 2000
+
+static struct in_addr my_addr = { { { 192, 0, 2, 1 } } };
+static struct in_addr peer_addr = { { { 192, 0, 2, 2 } } };
+
+static struct net_conn_handle *handles[MAX_HANDLERS];
+static struct net_ipv4_hdr ipv4_hdr;
+static struct net_udp_hdr udp_hdr;
+static uint32_t target_hits;
+static uint32_t other_hits;
+
+static int dummy_dev_init(const struct device *dev)
+{
+	return 0;
+}
+
+static void dummy_iface_init(struct net_if *iface)
+{
+	static uint8_t mac[] = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0x01 };
+
+	net_if_set_link_addr(iface, mac, sizeof(mac), NET_LINK_ETHERNET);
+}
+
+static int dummy_send(const struct device *dev, struct net_pkt *pkt)
+{
+	return 0;
+}
+
+static struct dummy_api dummy_api = {
+	.iface_api.init = dummy_iface_init,
+	.send = dummy_send,
+};
+
+NET_DEVICE_INIT(net_conn_demux, "net_conn_demux", dummy_dev_init, NULL,
+		NULL, NULL,
+		CONFIG_KERNEL_INIT_PRIORITY_DEFAULT, &dummy_api, DUMMY_L2,
+		NET_L2_GET_CTX_TYPE(DUMMY_L2), 127);
+
+/* Handlers keep the packet (NET_OK) so it can be fed in again */
+static enum net_verdict target_cb(struct net_conn *conn, struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  union net_proto_header *proto_hdr,
+				  void *user_data)
+{
+	target_hits++;
+
+	return NET_OK;
+}
+
+static enum net_verdict other_cb(struct net_conn *conn, struct net_pkt *pkt,
+				 union net_ip_header *ip_hdr,
+				 union net_proto_header *proto_hdr,
+				 void *user_data)
+{
+	other_hits++;
+
+	return NET_OK;
+}
+
+static struct net_conn_handle *register_port(uint16_t port, net_conn_cb_t cb)
+{
+	struct sockaddr_in local = {
+		.sin_family = AF_INET,
+		.sin_addr = my_addr,
+	};
+	struct net_conn_handle *handle;
+	int ret;
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET, NULL,
+				(struct sockaddr *)&local, 0, port,
+				NULL, cb, NULL, &handle);
+	zassert_equal(ret, 0, "cannot register port %u (%d)", port, ret);
+
+	return handle;
+}
+
+static uint32_t measure(struct net_pkt *pkt)
+{
+	union net_ip_header ip_hdr = { .ipv4 = &ipv4_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	enum net_verdict verdict;
+	uint32_t start, cycles;
+
+	target_hits = 0U;
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < ITERATIONS; i++) {
+		verdict = net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	zassert_equal(verdict, NET_OK, "packet not delivered");
+	zassert_equal(target_hits, ITERATIONS, "packet delivered %u times",
+		      target_hits);
+	zassert_equal(other_hits, 0, "packet delivered to wrong handler");
+
+	return cycles / ITERATIONS;
+}
+
+ZTEST(net_conn_demux, test_udp_demux)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	struct net_conn_handle *target;
+	struct net_pkt *pkt;
+	int registered = 0;
+
+	zassert_not_null(iface, "no interface");
+	zassert_not_null(net_if_ipv4_addr_add(iface, &my_addr,
+					      NET_ADDR_MANUAL, 0),
+			 "cannot add address");
+
+	net_ipv4_addr_copy_raw(ipv4_hdr.src, (uint8_t *)&peer_addr);
+	net_ipv4_addr_copy_raw(ipv4_hdr.dst, (uint8_t *)&my_addr);
+	udp_hdr.src_port = htons(TARGET_PORT + 1);
+	udp_hdr.dst_port = htons(TARGET_PORT);
+
+	pkt = net_pkt_alloc_on_iface(iface, K_FOREVER);
+	zassert_not_null(pkt, "cannot allocate packet");
+	net_pkt_set_family(pkt, AF_INET);
+
+	target = register_port(TARGET_PORT, target_cb);
+
+	for (int n = 8; n <= MAX_HANDLERS; n *= 2) {
+		while (registered < n) {
+			handles[registered] = register_port(OTHER_PORT_BASE + registered,
+							    other_cb);
+			registered++;
+		}
+
+		TC_PRINT("handlers %4d: %6u cycles/packet\n", n + 1, measure(pkt));
+	}
+
+	for (int i = 0; i < registered; i++) {
+		net_conn_unregister(handles[i]);
+	}
+
+	net_conn_unregister(target);
+	net_pkt_unref(pkt);
+}
+
+ZTEST_SUITE(net_conn_demux, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures nvs_write() and nvs_read() latency on the flash simulator with
+ * hardware timing simulation enabled. A fixed set of IDs is rewritten in a
+ * pseudo-random order until the storage has wrapped around several times,
+ * so that sectors are closed and garbage collected along the way. The
+ * average and the worst case time of each call are reported; the worst
+ * case write is the one that has to garbage collect a sector.
+ *
+ * The test thread yields between writes, giving the background garbage
+ * collection a chance to run when it is enabled.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/random/rand32.h>
+#include <zephyr/storage/flash_map.h>
+
+#define NVS_PARTITION		storage_partition
+#define NVS_PARTITION_DEVICE	FIXED_PARTITION_DEVICE(NVS_PARTITION)
+#define NVS_PARTITION_OFFSET	FIXED_PARTITION_OFFSET(NVS_PARTITION)
+
+#define SECTOR_COUNT	8
+#define NUM_IDS		48
+#define DATA_LEN	24
+#define NUM_WRITES	4000
+
+static struct nvs_fs fs;
+
+struct latency {
+	uint64_t total;
+	uint32_t worst;
+	uint32_t count;
+};
+
+static void latency_add(struct latency *lat, uint32_t cycles)
+{
+	lat->total += cycles;
+	lat->worst = MAX(lat->worst, cycles);
+	lat->count++;
+}
+
+static void latency_print(const char *name, const struct latency *lat)
+{
+	TC_PRINT("%s %5u: avg %6u us, worst %6u us\n", name, lat->count,
+		 k_cyc_to_us_floor32((uint32_t)(lat->total / lat->count)),
+		 k_cyc_to_us_floor32(lat->worst));
+}
+
+static void *nvs_perf_setup(void)
+{
+	struct flash_pages_info info;
+	int err;
+
+	fs.flash_device = NVS_PARTITION_DEVICE;
+	zassert_true(device_is_ready(fs.flash_device), "flash device not ready");
+
+	fs.offset = NVS_PARTITION_OFFSET;
+	err = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	zassert_equal(err, 0, "unable to get page info: %d", err);
+
+	fs.sector_size = info.size;
+	fs.sector_count = SECTOR_COUNT;
+
+	err = nvs_mount(&fs);
+	zassert_equal(err, 0, "nvs_mount failed: %d", err);
+
+	err = nvs_clear(&fs);
+	zassert_equal(err, 0, "nvs_clear failed: %d", err);
+
+	err = nvs_mount(&fs);
+	zassert_equal(err, 0, "nvs_mount failed: %d", err);
+
+	return NULL;
+}
+
+ZTEST(nvs_perf, test_write_read)
+{
+	struct latency wr = { 0 }, rd = { 0 };
+	uint8_t data[DATA_LEN], buf[DATA_LEN];
+	uint32_t start, seq[NUM_IDS] = { 0 };
+	uint16_t id;
+	ssize_t len;
+
+	for (int i = 0; i < NUM_WRITES; i++) {
+		id = sys_rand32_get() % NUM_IDS;
+		seq[id]++;
+		memset(data, (uint8_t)id, sizeof(data));
+		memcpy(data, &seq[id], sizeof(seq[id]));
+
+		start = k_cycle_get_32();
+		len = nvs_write(&fs, id, data, sizeof(data));
+		latency_add(&wr, k_cycle_get_32() - start);
+		zassert_equal(len, sizeof(data), "nvs_write failed: %d", len);
+
+		id = sys_rand32_get() % NUM_IDS;
+
+		start = k_cycle_get_32();
+		len = nvs_read(&fs, id, buf, sizeof(buf));
+		latency_add(&rd, k_cycle_get_32() - start);
+
+		if (seq[id] == 0) {
+			zassert_equal(len, -ENOENT, "nvs_read found unwritten id %u", id);
+		} else {
+			zassert_equal(len, sizeof(buf), "nvs_read failed: %d", len);
+			zassert_mem_equal(buf, &seq[id], sizeof(seq[id]),
+					  "stale data read for id %u", id);
+		}
+
+		k_yield();
+	}
+
+	TC_PRINT("%d ids of %d bytes, %d sectors of %u bytes\n", NUM_IDS,
+		 DATA_LEN, SECTOR_COUNT, fs.sector_size);
+	latency_print("nvs_write", &wr);
+	latency_print("nvs_read ", &rd);
+}
+
+ZTEST_SUITE(nvs_perf, NULL, nvs_perf_setup, NULL, NULL, NULL);
@@ -70,6 +70,87 @@ static inline int _stamp(int state)
 /* #define stamp(s) printk("%s @ %d\n", #s, _stamp(s)) */
 #define stamp(s) _stamp(s)
 
+#ifdef CONFIG_SMP
+/* Context switch throughput versus core count.  For each number of
+ * CPUs N from 1 to the number available, N pairs of threads ping-pong
+ * a semaphore between themselves for a fixed window and the total
+ * number of hand-offs is reported.  On a scheduler that scales, the
+ * rate grows roughly linearly with N.
+ */
+#define TP_MAX_PAIRS CONFIG_MP_MAX_NUM_CPUS
+#define TP_WINDOW_MS 1000
+
+static K_THREAD_STACK_ARRAY_DEFINE(tp_stacks, 2 * TP_MAX_PAIRS, 1024);
+static struct k_thread tp_threads[2 * TP_MAX_PAIRS];
+static struct k_sem tp_sems[2 * TP_MAX_PAIRS];
+static atomic_t tp_switches;
+
+static void tp_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct k_sem *mine = arg1;
+	struct k_sem *peer = arg2;
+
+	ARG_UNUSED(arg3);
+
+	while (true) {
+		k_sem_take(mine, K_FOREVER);
+		atomic_inc(&tp_switches);
+		k_sem_give(peer);
+	}
+}
+
+static void throughput_run(int pairs, int prio)
+{
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_sem_init(&tp_sems[i], 0, 1);
+	}
+
+	atomic_set(&tp_switches, 0);
+
+	for (int i = 0; i < 2 * pairs; i++) {
+		/* Thread 2p waits on sem 2p and wakes 2p+1, and vice versa */
+		int peer = i ^ 1;
+
+		k_thread_create(&tp_threads[i], tp_stacks[i],
+				K_THREAD_STACK_SIZEOF(tp_stacks[i]),
+				tp_fn, &tp_sems[i], &tp_sems[peer], NULL,
+				prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		/* Keep each pair on its own CPU so the N-pair run
+		 * really exercises N cores and nothing more.
+		 */
+		k_thread_cpu_mask_clear(&tp_threads[i]);
+		k_thread_cpu_mask_enable(&tp_threads[i], i / 2);
+#endif
+		k_thread_start(&tp_threads[i]);
+	}
+
+	for (int p = 0; p < pairs; p++) {
+		k_sem_give(&tp_sems[2 * p]);
+	}
+
+	k_msleep(TP_WINDOW_MS);
+
+	uint32_t n = atomic_get(&tp_switches);
+
+	for (int i = 0; i < 2 * pairs; i++) {
+		k_thread_abort(&tp_threads[i]);
+	}
+
+	printk("throughput cpus %d switches %u (%u/s)\n",
+	       pairs, n, n * (1000U / TP_WINDOW_MS));
+}
+
+static void throughput_bench(int prio)
+{
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int n = 1; n <= num_cpus && n <= TP_MAX_PAIRS; n++) {
+		throughput_run(n, prio);
+	}
+}
+#endif
+
 static void partner_fn(void *arg1, void *arg2, void *arg3)
 {
 	ARG_UNUSED(arg1);
@@ -148,5 +229,12 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+#ifdef CONFIG_SMP
+	/* Workers run below main so it can always preempt them to
+	 * close the measurement window.
+	 */
+	throughput_bench(main_prio + 1);
+#endif
 	printk("fin\n");
 }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the boot time cost of loading a large number of settings from
+ * NVS, and the cost of finding the handler of a key. The settings are
+ * spread over a mix of static and dynamic handlers, as on a device with
+ * many Bluetooth bonds and application settings.
+ *
+ * The settings are written directly to NVS before the settings subsystem
+ * is initialized, which is much faster than saving them one by one.
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include "settings/settings_nvs.h"
+
+#define SETTINGS_PARTITION DT_FIXED_PARTITION_ID(DT_CHOSEN(zephyr_settings_partition))
+
+#define NUM_STATIC	64
+#define NUM_DYNAMIC	32
+#define NUM_HANDLERS	(NUM_STATIC + NUM_DYNAMIC)
+#define NUM_KEYS	2048
+#define NUM_LOOKUPS	(4 * NUM_KEYS)
+
+static uint32_t set_cnt[NUM_HANDLERS];
+
+static int perf_set(int handler, const char *key, size_t len,
+		    settings_read_cb read_cb, void *cb_arg)
+{
+	uint32_t val;
+	int rc;
+
+	zassert_equal(len, sizeof(val), "unexpected length for %s", key);
+
+	rc = read_cb(cb_arg, &val, sizeof(val));
+	zassert_equal(rc, sizeof(val), "read_cb failed: %d", rc);
+	zassert_equal(val % NUM_HANDLERS, handler, "key %s loaded by handler %d",
+		      key, handler);
+
+	set_cnt[handler]++;
+
+	return 0;
+}
+
+#define STATIC_HANDLER_DEFINE(n, _)						\
+	static int perf_set_##n(const char *key, size_t len,			\
+				settings_read_cb read_cb, void *cb_arg)		\
+	{									\
+		return perf_set(n, key, len, read_cb, cb_arg);			\
+	}									\
+	SETTINGS_STATIC_HANDLER_DEFINE(perf_##n, "st/" STRINGIFY(n), NULL,	\
+				       perf_set_##n, NULL, NULL)
+
+LISTIFY(NUM_STATIC, STATIC_HANDLER_DEFINE, (;));
+
+static char dynamic_names[NUM_DYNAMIC][8];
+static struct settings_handler dynamic_handlers[NUM_DYNAMIC];
+
+static int dynamic_set(const char *key, size_t len, settings_read_cb read_cb,
+		       void *cb_arg)
+{
+	uint32_t val;
+	int rc;
+
+	rc = read_cb(cb_arg, &val, sizeof(val));
+	zassert_equal(rc, sizeof(val), "read_cb failed: %d", rc);
+
+	set_cnt[val % NUM_HANDLERS]++;
+
+	return 0;
+}
+
+static void key_name(uint32_t key, char *name, size_t size)
+{
+	uint32_t handler = key % NUM_HANDLERS;
+
+	if (handler < NUM_STATIC) {
+		snprintf(name, size, "st/%u/k%u", handler, key);
+	} else {
+		snprintf(name, size, "dy%u/k%u", handler - NUM_STATIC, key);
+	}
+}
+
+/* Store the keys the way the NVS settings backend does. */
+static void settings_perf_fill(void)
+{
+	const struct flash_area *fa;
+	struct flash_sector sector;
+	uint32_t sector_cnt = 1;
+	static struct nvs_fs fs;
+	char name[SETTINGS_MAX_NAME_LEN];
+	uint16_t id;
+	ssize_t len;
+	int err;
+
+	err = flash_area_open(SETTINGS_PARTITION, &fa);
+	zassert_equal(err, 0, "flash_area_open failed: %d", err);
+
+	err = flash_area_get_sectors(SETTINGS_PARTITION, &sector_cnt, &sector);
+	zassert_true(err == 0 || err == -ENOMEM, "flash_area_get_sectors failed: %d", err);
+
+	fs.flash_device = fa->fa_dev;
+	fs.offset = fa->fa_off;
+	fs.sector_size = CONFIG_SETTINGS_NVS_SECTOR_SIZE_MULT * sector.fs_size;
+	fs.sector_count = CONFIG_SETTINGS_NVS_SECTOR_COUNT;
+	zassert_true(fs.sector_size * fs.sector_count <= fa->fa_size,
+		     "settings partition too small");
+
+	err = nvs_mount(&fs);
+	zassert_equal(err, 0, "nvs_mount failed: %d", err);
+	err = nvs_clear(&fs);
+	zassert_equal(err, 0, "nvs_clear failed: %d", err);
+	err = nvs_mount(&fs);
+	zassert_equal(err, 0, "nvs_mount failed: %d", err);
+
+	for (uint32_t key = 0; key < NUM_KEYS; key++) {
+		id = NVS_NAMECNT_ID + 1 + key;
+		key_name(key, name, sizeof(name));
+
+		len = nvs_write(&fs, id + NVS_NAME_ID_OFFSET, &key, sizeof(key));
+		zassert_equal(len, sizeof(key), "nvs_write failed: %d", len);
+		len = nvs_write(&fs, id, name, strlen(name));
+		zassert_equal(len, strlen(name), "nvs_write failed: %d", len);
+	}
+
+	id = NVS_NAMECNT_ID + NUM_KEYS;
+	len = nvs_write(&fs, NVS_NAMECNT_ID, &id, sizeof(id));
+	zassert_equal(len, sizeof(id), "nvs_write failed: %d", len);
+
+	flash_area_close(fa);
+}
+
+static void *settings_perf_setup(void)
+{
+	int err;
+
+	settings_perf_fill();
+
+	err = settings_subsys_init();
+	zassert_equal(err, 0, "settings_subsys_init failed: %d", err);
+
+	for (int i = 0; i < NUM_DYNAMIC; i++) {
+		snprintf(dynamic_names[i], sizeof(dynamic_names[i]), "dy%d", i);
+		dynamic_handlers[i].name = dynamic_names[i];
+		dynamic_handlers[i].h_set = dynamic_set;
+
+		err = settings_register(&dynamic_handlers[i]);
+		zassert_equal(err, 0, "settings_register failed: %d", err);
+	}
+
+	return NULL;
+}
+
+ZTEST(settings_perf, test_load)
+{
+	uint32_t start, cycles, total = 0;
+	int err;
+
+	memset(set_cnt, 0, sizeof(set_cnt));
+
+	start = k_cycle_get_32();
+	err = settings_load();
+	cycles = k_cycle_get_32() - start;
+	zassert_equal(err, 0, "settings_load failed: %d", err);
+
+	for (int i = 0; i < NUM_HANDLERS; i++) {
+		total += set_cnt[i];
+	}
+	zassert_equal(total, NUM_KEYS, "%u keys loaded", total);
+
+	TC_PRINT("%d keys, %d static and %d dynamic handlers\n", NUM_KEYS,
+		 NUM_STATIC, NUM_DYNAMIC);
+	TC_PRINT("settings_load: %u us, %u us per key\n",
+		 k_cyc_to_us_floor32(cycles), k_cyc_to_us_floor32(cycles / NUM_KEYS));
+}
+
+ZTEST(settings_perf, test_lookup)
+{
+	static char names[NUM_HANDLERS][SETTINGS_MAX_NAME_LEN];
+	struct settings_handler_static *ch;
+	const char *next;
+	uint32_t start, cycles;
+
+	for (int i = 0; i < NUM_HANDLERS; i++) {
+		key_name(NUM_KEYS + i, names[i], sizeof(names[i]));
+	}
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < NUM_LOOKUPS; i++) {
+		ch = settings_parse_and_lookup(names[i % NUM_HANDLERS], &next);
+		zassert_not_null(ch, "no handler for %s", names[i % NUM_HANDLERS]);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("settings_parse_and_lookup: %u ns avg\n",
+		 (uint32_t)k_cyc_to_ns_floor64(cycles) / NUM_LOOKUPS);
+}
+
+ZTEST_SUITE(settings_perf, NULL, settings_perf_setup, NULL, NULL, NULL);
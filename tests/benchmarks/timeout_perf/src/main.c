@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures the cost of arming and cancelling kernel timeouts as the
+ * number of pending timeouts grows.  N k_timers are started with
+ * pseudo-random durations (so the timeout queue can't just append),
+ * then all of them are stopped in a different pseudo-random order.
+ * The average number of cycles per k_timer_start() and per
+ * k_timer_stop() is reported for each N.  Durations are far in the
+ * future so that nothing expires during the measurement.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/random/rand32.h>
+
+#define MAX_TIMERS 4096
+#define BASE_MS 100000
+#define SPREAD_MS 100000
+
+static struct k_timer timers[MAX_TIMERS];
+static uint16_t order[MAX_TIMERS];
+
+static void shuffle(int n)
+{
+	for (int i = 0; i < n; i++) {
+		order[i] = i;
+	}
+
+	for (int i = n - 1; i > 0; i--) {
+		int j = sys_rand32_get() % (i + 1);
+		uint16_t tmp = order[i];
+
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+}
+
+static void measure(int n)
+{
+	uint32_t start, arm_cycles, cancel_cycles;
+
+	shuffle(n);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < n; i++) {
+		k_timer_start(&timers[order[i]],
+			      K_MSEC(BASE_MS + order[(i * 7) % n] % SPREAD_MS),
+			      K_NO_WAIT);
+	}
+	arm_cycles = k_cycle_get_32() - start;
+
+	shuffle(n);
+
+	start = k_cycle_get_32();
+	for (int i = 0; i < n; i++) {
+		k_timer_stop(&timers[order[i]]);
+	}
+	cancel_cycles = k_cycle_get_32() - start;
+
+	TC_PRINT("timeouts %5d: arm %6u cycles/op, cancel %6u cycles/op\n",
+		 n, arm_cycles / n, cancel_cycles / n);
+
+	for (int i = 0; i < n; i++) {
+		zassert_true(k_timer_remaining_ticks(&timers[i]) == 0,
+			     "timer %d still pending", i);
+	}
+}
+
+ZTEST(timeout_perf, test_arm_cancel)
+{
+	for (int i = 0; i < MAX_TIMERS; i++) {
+		k_timer_init(&timers[i], NULL, NULL);
+	}
+
+	for (int n = 16; n <= MAX_TIMERS; n *= 4) {
+		measure(n);
+	}
+}
+
+ZTEST_SUITE(timeout_perf, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Measures work queue throughput, for a single thread work queue and for a
+ * work queue pool with one thread per CPU.
+ *
+ * Batches of independent work items are submitted, and the time until the
+ * whole batch completed is reported per item.  Items either return at once,
+ * which shows the dispatch overhead, or busy wait, which shows how well the
+ * work gets spread over the CPUs.  In the fan out case the items are
+ * submitted from a work item, so that they all start out on the list of a
+ * single pool thread and the other threads have to steal them.
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WORKERS CONFIG_MP_MAX_NUM_CPUS
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define NUM_ITEMS 64
+#define NUM_ROUNDS 32
+#define LOAD_US 50
+
+static K_THREAD_STACK_DEFINE(single_stack, STACK_SIZE);
+static struct k_work_q single_queue;
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker pool_workers[NUM_WORKERS];
+static struct k_work_q pool_queue;
+
+static struct k_work items[NUM_ITEMS];
+static struct k_work fan_out_work;
+static struct k_work_q *fan_out_queue;
+static uint32_t load_us;
+static atomic_t remaining;
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static void item_handler(struct k_work *work)
+{
+	if (load_us > 0U) {
+		k_busy_wait(load_us);
+	}
+
+	if (atomic_dec(&remaining) == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void fan_out_handler(struct k_work *work)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		(void)k_work_submit_to_queue(fan_out_queue, &items[i]);
+	}
+}
+
+/* Run the batches and return the time per item, in nanoseconds. */
+static uint32_t run(struct k_work_q *queue, bool fan_out)
+{
+	uint32_t start, cycles;
+
+	start = k_cycle_get_32();
+	for (int r = 0; r < NUM_ROUNDS; r++) {
+		atomic_set(&remaining, NUM_ITEMS);
+
+		if (fan_out) {
+			fan_out_queue = queue;
+			(void)k_work_submit_to_queue(queue, &fan_out_work);
+		} else {
+			for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+				(void)k_work_submit_to_queue(queue, &items[i]);
+			}
+		}
+
+		zassert_ok(k_sem_take(&done_sem, K_SECONDS(10)));
+	}
+	cycles = k_cycle_get_32() - start;
+
+	/* The last item may still be running, keep it off the next queue */
+	(void)k_work_queue_drain(queue, false);
+
+	return (uint32_t)(k_cyc_to_ns_floor64(cycles) / (NUM_ROUNDS * NUM_ITEMS));
+}
+
+static void report(const char *name, bool fan_out)
+{
+	uint32_t single = run(&single_queue, fan_out);
+	uint32_t pool = run(&pool_queue, fan_out);
+
+	TC_PRINT("%s: single thread %u ns, pool of %u threads %u ns per item\n",
+		 name, single, NUM_WORKERS, pool);
+}
+
+static void *work_queue_setup(void)
+{
+	const struct k_work_queue_config pool_cfg = {
+		.name = "bench_pool",
+		.pin_workers = IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	};
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i], item_handler);
+	}
+
+	k_work_init(&fan_out_work, fan_out_handler);
+
+	k_work_queue_start(&single_queue, single_stack,
+			   K_THREAD_STACK_SIZEOF(single_stack), WORKER_PRIORITY,
+			   NULL);
+	k_work_queue_pool_start(&pool_queue, pool_workers, NUM_WORKERS,
+				pool_stacks[0], STACK_SIZE, WORKER_PRIORITY,
+				&pool_cfg);
+
+	TC_PRINT("%u CPUs, %u items per batch\n", arch_num_cpus(), NUM_ITEMS);
+
+	return NULL;
+}
+
+ZTEST(work_queue, test_dispatch)
+{
+	load_us = 0U;
+	report("Empty items", false);
+}
+
+ZTEST(work_queue, test_load)
+{
+	load_us = LOAD_US;
+	report("Busy items", false);
+}
+
+ZTEST(work_queue, test_fan_out)
+{
+	load_us = LOAD_US;
+	report("Busy items, fan out", true);
+}
+
+ZTEST_SUITE(work_queue, NULL, work_queue_setup, NULL, NULL, NULL);
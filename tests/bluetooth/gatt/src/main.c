@@ -230,6 +230,57 @@ ZTEST(test_gatt, test_gatt_foreach)
 	}
 }
 
+ZTEST(test_gatt, test_gatt_foreach_uuid)
+{
+	/* Characteristic declaration UUID derived from the Base UUID */
+	const struct bt_uuid *chrc_uuid = BT_UUID_DECLARE_128(
+		BT_UUID_128_ENCODE(0x00002803, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB));
+	const struct bt_gatt_attr *attr;
+	uint16_t num;
+
+	/* Ensure our test services are registered */
+	bt_gatt_service_unregister(&test_svc);
+	bt_gatt_service_unregister(&test1_svc);
+
+	zassert_false(bt_gatt_service_register(&test_svc),
+		     "Test service registration failed");
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		     "Test service1 registration failed");
+
+	/* Find all characteristics by their 128-bit UUID */
+	num = 0;
+	bt_gatt_foreach_attr_type(test_attrs[0].handle, 0xffff, chrc_uuid,
+				  NULL, 0, count_attr, &num);
+	zassert_equal(num, 2, "Number of attributes don't match");
+
+	/* Find characteristics within a handle range */
+	num = 0;
+	bt_gatt_foreach_attr_type(test_attrs[0].handle + 2, 0xffff,
+				  BT_UUID_GATT_CHRC, NULL, 0, count_attr, &num);
+	zassert_equal(num, 1, "Number of attributes don't match");
+
+	num = 0;
+	bt_gatt_foreach_attr_type(test_attrs[0].handle, test1_attrs[0].handle,
+				  BT_UUID_GATT_CHRC, NULL, 0, count_attr, &num);
+	zassert_equal(num, 1, "Number of attributes don't match");
+
+	/* Find the attribute following another */
+	attr = bt_gatt_attr_next(&test1_attrs[0]);
+	zassert_equal_ptr(attr, &test1_attrs[1], "Attribute don't match");
+
+	/* Unregistered attributes are no longer found */
+	zassert_false(bt_gatt_service_unregister(&test1_svc),
+		     "Test service1 unregister failed");
+
+	num = 0;
+	bt_gatt_foreach_attr_type(test_attrs[0].handle, 0xffff,
+				  BT_UUID_GATT_CHRC, NULL, 0, count_attr, &num);
+	zassert_equal(num, 1, "Number of attributes don't match");
+
+	zassert_false(bt_gatt_service_register(&test1_svc),
+		     "Test service1 registration failed");
+}
+
 ZTEST(test_gatt, test_gatt_read)
 {
 	const struct bt_gatt_attr *attr;
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Checks the Network Message Cache: the last CONFIG_BT_MESH_MSG_CACHE_SIZE
+ * messages added are found, the older ones are not, and a rewound message is
+ * forgotten without evicting any other one.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "msg_cache.h"
+
+#define CACHE_SIZE CONFIG_BT_MESH_MSG_CACHE_SIZE
+/* Message added out of the sequence of the test */
+#define OTHER_MSG (10 * CACHE_SIZE)
+
+/* Message number n, several sources sending the same sequence numbers and
+ * several messages coming from the same source.
+ */
+static uint16_t msg_src(uint32_t n)
+{
+	return 0x0001 + n % 5;
+}
+
+static uint32_t msg_seq(uint32_t n)
+{
+	return 0x10000 + n / 5;
+}
+
+static void msg_add(uint32_t n)
+{
+	bt_mesh_msg_cache_add(msg_src(n), msg_seq(n));
+}
+
+/* Messages first to last - 1 must be cached, the few around them not */
+static void cache_verify(uint32_t first, uint32_t last)
+{
+	for (uint32_t n = (first > 2 ? first - 2 : 0); n < last + 2; n++) {
+		zassert_equal(bt_mesh_msg_cache_match(msg_src(n), msg_seq(n)),
+			      n >= first && n < last, "Message %u", n);
+	}
+}
+
+static void msg_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_mesh_msg_cache_clear();
+}
+
+ZTEST(bt_mesh_msg_cache, test_evict)
+{
+	for (uint32_t n = 0; n < 3 * CACHE_SIZE; n++) {
+		msg_add(n);
+		cache_verify(n + 1 > CACHE_SIZE ? n + 1 - CACHE_SIZE : 0, n + 1);
+	}
+
+	bt_mesh_msg_cache_clear();
+
+	for (uint32_t n = 0; n < 3 * CACHE_SIZE; n++) {
+		zassert_false(bt_mesh_msg_cache_match(msg_src(n), msg_seq(n)),
+			      "Message %u", n);
+	}
+}
+
+ZTEST(bt_mesh_msg_cache, test_seq_wrap)
+{
+	/* Only the 17 LSbs of the sequence number are cached */
+	bt_mesh_msg_cache_add(0x0001, 0x012345);
+	zassert_true(bt_mesh_msg_cache_match(0x0001, 0x012345));
+	zassert_true(bt_mesh_msg_cache_match(0x0001, 0x032345));
+	zassert_false(bt_mesh_msg_cache_match(0x0001, 0x002345));
+	zassert_false(bt_mesh_msg_cache_match(0x0002, 0x012345));
+}
+
+ZTEST(bt_mesh_msg_cache, test_rewind)
+{
+	for (uint32_t n = 0; n < CACHE_SIZE; n++) {
+		msg_add(n);
+	}
+
+	bt_mesh_msg_cache_rewind();
+	cache_verify(0, CACHE_SIZE - 1);
+
+	/* The rewound entry is reused, evicting nothing */
+	msg_add(OTHER_MSG);
+	zassert_true(bt_mesh_msg_cache_match(msg_src(OTHER_MSG), msg_seq(OTHER_MSG)));
+	cache_verify(0, CACHE_SIZE - 1);
+
+	/* Then the oldest one is */
+	msg_add(OTHER_MSG + 1);
+	zassert_true(bt_mesh_msg_cache_match(msg_src(OTHER_MSG), msg_seq(OTHER_MSG)));
+	cache_verify(1, CACHE_SIZE - 1);
+}
+
+ZTEST(bt_mesh_msg_cache, test_rewind_wrap)
+{
+	for (uint32_t n = 0; n < 2 * CACHE_SIZE + 1; n++) {
+		/* Each message is rewound, as when failing the replay
+		 * protection, then received again.
+		 */
+		msg_add(n);
+		bt_mesh_msg_cache_rewind();
+		zassert_false(bt_mesh_msg_cache_match(msg_src(n), msg_seq(n)),
+			      "Message %u", n);
+		msg_add(n);
+		cache_verify(n + 1 > CACHE_SIZE ? n + 1 - CACHE_SIZE : 0, n + 1);
+	}
+
+	/* Rewind the last entry of the ring, the first one being the next to
+	 * be replaced.
+	 */
+	for (uint32_t n = 2 * CACHE_SIZE + 1; n < 3 * CACHE_SIZE; n++) {
+		msg_add(n);
+	}
+
+	bt_mesh_msg_cache_rewind();
+	cache_verify(2 * CACHE_SIZE, 3 * CACHE_SIZE - 1);
+
+	msg_add(OTHER_MSG);
+	zassert_true(bt_mesh_msg_cache_match(msg_src(OTHER_MSG), msg_seq(OTHER_MSG)));
+	cache_verify(2 * CACHE_SIZE, 3 * CACHE_SIZE - 1);
+
+	msg_add(OTHER_MSG + 1);
+	cache_verify(2 * CACHE_SIZE + 1, 3 * CACHE_SIZE - 1);
+}
+
+ZTEST_SUITE(bt_mesh_msg_cache, NULL, NULL, msg_cache_before, NULL, NULL);
@@ -0,0 +1,410 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Checks that received Network PDUs are decrypted with the right subnet or
+ * friendship credentials while subnets are added and deleted, go through the
+ * Key Refresh procedure, and friendships are set up and torn down.
+ *
+ * The PDUs are encrypted and obfuscated here with the raw keys of the
+ * credentials they are meant for, then decoded as they would be on the RX
+ * path, which must report the subnet, key and kind of credentials used.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "crypto.h"
+#include "net.h"
+#include "transport.h"
+#include "foundation.h"
+#include "friend.h"
+#include "msg_cache.h"
+
+#define SRC_ADDR 0x0100
+/* Neither local nor of an LPN, with TTL 0 the PDUs are never relayed */
+#define DST_ADDR 0x0200
+#define LPN_ADDR 0x0300
+
+#define NET_IDX_A 0x0001
+#define NET_IDX_B 0x0002
+#define NET_IDX_C 0x0003
+#define NET_IDX_D 0x0004
+
+static const uint8_t net_key[][16] = {
+	{ 0x11 }, { 0x22 }, { 0x33 }, { 0x44 }, { 0x55 },
+};
+
+static uint32_t pdu_seq;
+
+static struct bt_mesh_model root_models[] = {
+	BT_MESH_MODEL_CFG_SRV,
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, root_models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = BT_COMP_ID_LF,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static const struct bt_mesh_prov prov;
+
+/* Unsegmented access message from SRC_ADDR to DST_ADDR with TTL 0 */
+static void pdu_create(struct net_buf_simple *buf,
+		       const struct bt_mesh_net_cred *cred)
+{
+	const uint8_t payload[] = { 0x00, 0xaa, 0xbb, 0xcc, 0x01, 0x02, 0x03, 0x04 };
+	uint32_t iv_index = bt_mesh.iv_index;
+
+	net_buf_simple_reset(buf);
+	net_buf_simple_add_u8(buf, cred->nid | (iv_index & 0x01) << 7);
+	net_buf_simple_add_u8(buf, 0x00);
+	net_buf_simple_add_be24(buf, ++pdu_seq);
+	net_buf_simple_add_be16(buf, SRC_ADDR);
+	net_buf_simple_add_be16(buf, DST_ADDR);
+	net_buf_simple_add_mem(buf, payload, sizeof(payload));
+
+	zassert_ok(bt_mesh_net_encrypt(cred->enc, buf, iv_index, false));
+	zassert_ok(bt_mesh_net_obfuscate(buf->data, iv_index, cred->privacy));
+}
+
+static int pdu_decode(const struct bt_mesh_net_cred *cred,
+		      struct bt_mesh_net_rx *rx)
+{
+	NET_BUF_SIMPLE_DEFINE(in, BT_MESH_NET_MAX_PDU_LEN);
+	NET_BUF_SIMPLE_DEFINE(out, BT_MESH_NET_MAX_PDU_LEN);
+
+	pdu_create(&in, cred);
+
+	return bt_mesh_net_decode(&in, BT_MESH_NET_IF_ADV, rx, &out);
+}
+
+/* A PDU encrypted with cred is decrypted with the given credentials of sub */
+static void cred_verify(const struct bt_mesh_net_cred *cred,
+			struct bt_mesh_subnet *sub, bool new_key,
+			bool friend_cred)
+{
+	struct bt_mesh_net_rx rx = { 0 };
+
+	zassert_ok(pdu_decode(cred, &rx), "NID 0x%02x not found", cred->nid);
+	zassert_equal_ptr(rx.sub, sub, "Subnet 0x%03x instead of 0x%03x",
+			  rx.sub->net_idx, sub->net_idx);
+	zassert_equal(rx.ctx.net_idx, sub->net_idx);
+	zassert_equal(rx.new_key, new_key, "NID 0x%02x: new key %u", cred->nid,
+		      rx.new_key);
+	zassert_equal(rx.friend_cred, friend_cred, "NID 0x%02x: friend cred %u",
+		      cred->nid, rx.friend_cred);
+	zassert_equal(rx.ctx.addr, SRC_ADDR);
+	zassert_equal(rx.seq, pdu_seq);
+}
+
+/* A PDU encrypted with cred is not decrypted at all */
+static void cred_missing(const struct bt_mesh_net_cred *cred)
+{
+	struct bt_mesh_net_rx rx = { 0 };
+
+	zassert_equal(pdu_decode(cred, &rx), -ENOENT, "NID 0x%02x found",
+		      cred->nid);
+}
+
+static struct bt_mesh_subnet *subnet_add(uint16_t net_idx, const uint8_t key[16])
+{
+	zassert_equal(bt_mesh_subnet_add(net_idx, key), STATUS_SUCCESS,
+		      "Adding 0x%03x", net_idx);
+
+	return bt_mesh_subnet_get(net_idx);
+}
+
+static void kr_phase_set(uint16_t net_idx, uint8_t phase, uint8_t expected)
+{
+	zassert_equal(bt_mesh_subnet_kr_phase_set(net_idx, &phase), STATUS_SUCCESS);
+	zassert_equal(phase, expected);
+}
+
+static uint8_t key_nid(const uint8_t key[16])
+{
+	uint8_t enc[16], privacy[16];
+	uint8_t p = 0, nid;
+
+	zassert_ok(bt_mesh_k2(key, &p, 1, &nid, enc, privacy));
+
+	return nid;
+}
+
+/* Two NetKeys whose credentials fall in the same NID bucket */
+static void keys_same_nid(uint8_t key_a[16], uint8_t key_b[16])
+{
+	uint8_t seen[BIT(7)] = { 0 };
+	uint8_t nid;
+
+	for (int i = 1; i <= ARRAY_SIZE(seen) + 1; i++) {
+		memset(key_b, 0x5a, 16);
+		key_b[0] = i;
+
+		nid = key_nid(key_b);
+		if (seen[nid]) {
+			memset(key_a, 0x5a, 16);
+			key_a[0] = seen[nid];
+			return;
+		}
+
+		seen[nid] = i;
+	}
+
+	zassert_unreachable("No NID collision");
+}
+
+static struct bt_mesh_friend *friendship_setup(struct bt_mesh_subnet *sub,
+					       uint16_t lpn_addr)
+{
+	struct bt_mesh_ctl_friend_req req = {
+		/* Minimum queue size of 2 */
+		.criteria = 0x01,
+		.recv_delay = 0x64,
+		/* 25.6 s */
+		.poll_to = { 0x00, 0x01, 0x00 },
+		.num_elem = 1,
+	};
+	struct bt_mesh_net_rx rx = {
+		.sub = sub,
+		.ctx.net_idx = sub->net_idx,
+		.ctx.addr = lpn_addr,
+		.net_if = BT_MESH_NET_IF_ADV,
+	};
+	struct bt_mesh_friend *frnd;
+	struct net_buf_simple buf;
+
+	net_buf_simple_init_with_data(&buf, &req, sizeof(req));
+	zassert_ok(bt_mesh_friend_req(&rx, &buf));
+
+	frnd = bt_mesh_friend_find(sub->net_idx, lpn_addr, true, false);
+	zassert_not_null(frnd);
+
+	/* The LPN never polls, keep the offer pending rather than timing out */
+	(void)k_work_cancel_delayable(&frnd->timer);
+
+	return frnd;
+}
+
+static void *net_cred_setup(void)
+{
+	zassert_ok(bt_mesh_init(&prov, &comp));
+
+	/* Done by bt_mesh_start() once provisioned */
+	zassert_ok(bt_mesh_friend_init());
+
+	return NULL;
+}
+
+static void net_cred_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Also ends all friendships */
+	bt_mesh_net_keys_reset();
+	bt_mesh_msg_cache_clear();
+}
+
+static void net_cred_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	atomic_clear_bit(bt_mesh.flags, BT_MESH_VALID);
+}
+
+ZTEST(bt_mesh_net_cred, test_subnets)
+{
+	uint8_t key_a[16], key_b[16];
+	struct bt_mesh_subnet *a, *b, *c, *d;
+	struct bt_mesh_net_cred old;
+
+	/* The first credentials of a bucket fail to decrypt the PDUs of the
+	 * second ones, which are then tried.
+	 */
+	keys_same_nid(key_a, key_b);
+	a = subnet_add(NET_IDX_A, key_a);
+	b = subnet_add(NET_IDX_B, key_b);
+	c = subnet_add(NET_IDX_C, net_key[0]);
+	zassert_equal(a->keys[0].msg.nid, b->keys[0].msg.nid);
+
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+	cred_verify(&c->keys[0].msg, c, false, false);
+
+	old = a->keys[0].msg;
+	zassert_equal(bt_mesh_subnet_del(NET_IDX_A), STATUS_SUCCESS);
+
+	cred_missing(&old);
+	cred_verify(&b->keys[0].msg, b, false, false);
+	cred_verify(&c->keys[0].msg, c, false, false);
+
+	/* The freed subnet is reused with another key */
+	d = subnet_add(NET_IDX_D, net_key[1]);
+	zassert_equal_ptr(d, a);
+
+	cred_missing(&old);
+	cred_verify(&b->keys[0].msg, b, false, false);
+	cred_verify(&c->keys[0].msg, c, false, false);
+	cred_verify(&d->keys[0].msg, d, false, false);
+}
+
+ZTEST(bt_mesh_net_cred, test_key_refresh)
+{
+	struct bt_mesh_subnet *a, *b;
+	struct bt_mesh_net_cred old;
+
+	a = subnet_add(NET_IDX_A, net_key[0]);
+	b = subnet_add(NET_IDX_B, net_key[1]);
+	old = a->keys[0].msg;
+
+	/* Phase 1: the new key is accepted along with the old one */
+	zassert_equal(bt_mesh_subnet_update(NET_IDX_A, net_key[2]), STATUS_SUCCESS);
+
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&a->keys[1].msg, a, true, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+
+	/* Phase 2: the keys are swapped for TX only */
+	kr_phase_set(NET_IDX_A, BT_MESH_KR_PHASE_2, BT_MESH_KR_PHASE_2);
+
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&a->keys[1].msg, a, true, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+
+	/* Phase 3: the old key is revoked, the new one taking its place */
+	kr_phase_set(NET_IDX_A, BT_MESH_KR_PHASE_3, BT_MESH_KR_NORMAL);
+	zassert_false(a->keys[1].valid);
+
+	cred_missing(&old);
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+
+	/* Straight from Phase 1 to revocation */
+	old = a->keys[0].msg;
+	zassert_equal(bt_mesh_subnet_update(NET_IDX_A, net_key[3]), STATUS_SUCCESS);
+	cred_verify(&a->keys[1].msg, a, true, false);
+
+	kr_phase_set(NET_IDX_A, BT_MESH_KR_PHASE_3, BT_MESH_KR_NORMAL);
+
+	cred_missing(&old);
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+}
+
+ZTEST(bt_mesh_net_cred, test_friendship)
+{
+	struct bt_mesh_friend *frnd_a, *frnd_b;
+	struct bt_mesh_subnet *a, *b;
+	struct bt_mesh_net_cred old;
+
+	a = subnet_add(NET_IDX_A, net_key[0]);
+	b = subnet_add(NET_IDX_B, net_key[1]);
+	frnd_a = friendship_setup(a, LPN_ADDR);
+	frnd_b = friendship_setup(b, LPN_ADDR + 1);
+
+	cred_verify(&frnd_a->cred[0], a, false, true);
+	cred_verify(&frnd_b->cred[0], b, false, true);
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&b->keys[0].msg, b, false, false);
+
+	/* The friendship credentials follow the Key Refresh of their subnet */
+	zassert_equal(bt_mesh_subnet_update(NET_IDX_A, net_key[2]), STATUS_SUCCESS);
+
+	cred_verify(&frnd_a->cred[0], a, false, true);
+	cred_verify(&frnd_a->cred[1], a, true, true);
+	cred_verify(&a->keys[1].msg, a, true, false);
+
+	kr_phase_set(NET_IDX_A, BT_MESH_KR_PHASE_2, BT_MESH_KR_PHASE_2);
+
+	cred_verify(&frnd_a->cred[0], a, false, true);
+	cred_verify(&frnd_a->cred[1], a, true, true);
+
+	old = frnd_a->cred[0];
+	kr_phase_set(NET_IDX_A, BT_MESH_KR_PHASE_3, BT_MESH_KR_NORMAL);
+
+	cred_missing(&old);
+	cred_verify(&frnd_a->cred[0], a, false, true);
+	cred_verify(&frnd_b->cred[0], b, false, true);
+	cred_verify(&a->keys[0].msg, a, false, false);
+
+	/* Ending a friendship leaves the subnet credentials */
+	old = frnd_a->cred[0];
+	zassert_ok(bt_mesh_friend_terminate(LPN_ADDR));
+
+	cred_missing(&old);
+	cred_verify(&a->keys[0].msg, a, false, false);
+	cred_verify(&frnd_b->cred[0], b, false, true);
+
+	/* Deleting a subnet ends the friendships on it */
+	old = frnd_b->cred[0];
+	zassert_equal(bt_mesh_subnet_del(NET_IDX_B), STATUS_SUCCESS);
+
+	cred_missing(&old);
+	cred_verify(&a->keys[0].msg, a, false, false);
+
+	/* A new friendship gets its own credentials */
+	frnd_b = friendship_setup(a, LPN_ADDR + 2);
+
+	cred_verify(&frnd_b->cred[0], a, false, true);
+	cred_verify(&a->keys[0].msg, a, false, false);
+}
+
+#if defined(CONFIG_BT_MESH_NET_RX_WORKQ)
+#define QUEUE_SIZE CONFIG_BT_MESH_NET_RX_WORKQ_QUEUE_SIZE
+
+ZTEST(bt_mesh_net_cred, test_recv_deferred)
+{
+	NET_BUF_SIMPLE_DEFINE(buf, BT_MESH_NET_MAX_PDU_LEN);
+	uint32_t seq[QUEUE_SIZE + 2];
+	struct bt_mesh_subnet *sub;
+
+	sub = subnet_add(NET_IDX_A, net_key[0]);
+
+	/* Ignored until provisioned */
+	pdu_create(&buf, &sub->keys[0].msg);
+	bt_mesh_net_recv_deferred(&buf, -40);
+	k_sleep(K_MSEC(100));
+	zassert_false(bt_mesh_msg_cache_match(SRC_ADDR, pdu_seq));
+
+	atomic_set_bit(bt_mesh.flags, BT_MESH_VALID);
+
+	/* Without the work queue running, the PDUs past the size of the
+	 * queue are dropped.
+	 */
+	k_sched_lock();
+
+	for (int i = 0; i < ARRAY_SIZE(seq); i++) {
+		pdu_create(&buf, &sub->keys[0].msg);
+		seq[i] = pdu_seq;
+		bt_mesh_net_recv_deferred(&buf, -40);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(seq); i++) {
+		zassert_false(bt_mesh_msg_cache_match(SRC_ADDR, seq[i]),
+			      "PDU %d decoded", i);
+	}
+
+	k_sched_unlock();
+	k_sleep(K_MSEC(100));
+
+	for (int i = 0; i < ARRAY_SIZE(seq); i++) {
+		zassert_equal(bt_mesh_msg_cache_match(SRC_ADDR, seq[i]), i < QUEUE_SIZE,
+			      "PDU %d", i);
+	}
+
+	/* Room is made for new PDUs as the queue is drained */
+	pdu_create(&buf, &sub->keys[0].msg);
+	bt_mesh_net_recv_deferred(&buf, -40);
+	k_sleep(K_MSEC(100));
+	zassert_true(bt_mesh_msg_cache_match(SRC_ADDR, pdu_seq));
+}
+#endif /* CONFIG_BT_MESH_NET_RX_WORKQ */
+
+ZTEST_SUITE(bt_mesh_net_cred, NULL, net_cred_setup, net_cred_before,
+	    net_cred_after, NULL);
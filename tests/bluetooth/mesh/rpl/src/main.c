@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2023 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Checks that the Replay Protection List finds its entries by source
+ * address whatever the order in which they were added and removed, including
+ * when the source addresses collide in the index of the list.
+ *
+ * The entries are loaded and removed through the settings handler of the
+ * RPL, as they would be on boot and when an entry is deleted from storage,
+ * and looked up through bt_mesh_rpl_check(), as on the RX path.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "net.h"
+#include "rpl.h"
+#include "settings.h"
+
+/* Same as the index of rpl.c, to pick colliding source addresses */
+#define RPL_INDEX_BITS (32 - __builtin_clz(2 * CONFIG_BT_MESH_CRPL - 1))
+#define RPL_INDEX_SIZE BIT(RPL_INDEX_BITS)
+
+/* Sequence number of the probes, above any stored one */
+#define PROBE_SEQ BIT_MASK(24)
+
+/* Layout of the RPL entries in persistent storage, as in rpl.c */
+struct rpl_val {
+	uint32_t seq:24,
+		 old_iv:1;
+};
+
+static uint32_t rpl_hash(uint16_t src)
+{
+	return ((uint32_t)src * 0x9e3779b1U) >> (32 - RPL_INDEX_BITS);
+}
+
+/* Lowest unicast address above after whose index bucket is hash */
+static uint16_t addr_with_hash(uint32_t hash, uint16_t after)
+{
+	for (uint32_t src = after + 1; BT_MESH_ADDR_IS_UNICAST(src); src++) {
+		if (rpl_hash(src) == hash) {
+			return src;
+		}
+	}
+
+	zassert_unreachable("No address in bucket %u", hash);
+	return BT_MESH_ADDR_UNASSIGNED;
+}
+
+static int rpl_load(uint16_t src, uint32_t seq, bool old_iv)
+{
+	struct rpl_val val = {
+		.seq = seq,
+		.old_iv = old_iv,
+	};
+	char path[18];
+
+	snprintk(path, sizeof(path), "bt/mesh/RPL/%x", src);
+
+	return settings_runtime_set(path, &val, sizeof(val));
+}
+
+static void rpl_remove(uint16_t src)
+{
+	char path[18];
+
+	snprintk(path, sizeof(path), "bt/mesh/RPL/%x", src);
+
+	zassert_ok(settings_runtime_set(path, NULL, 0), "Removing 0x%04x", src);
+}
+
+/* Returns the entry of src, NULL if there is none */
+static struct bt_mesh_rpl *rpl_find(uint16_t src)
+{
+	struct bt_mesh_net_rx rx = {
+		.net_if = BT_MESH_NET_IF_ADV,
+		.local_match = 1,
+		.ctx.addr = src,
+		.seq = PROBE_SEQ,
+	};
+	struct bt_mesh_rpl *match = NULL;
+
+	/* A new sequence number of a known source is accepted, with the entry
+	 * of the source as match, while an unknown source gets a free entry.
+	 */
+	if (bt_mesh_rpl_check(&rx, &match) || match->src != src) {
+		return NULL;
+	}
+
+	return match;
+}
+
+static void rpl_verify(const uint16_t *addrs, size_t count, const bool *removed)
+{
+	for (size_t i = 0; i < count; i++) {
+		struct bt_mesh_rpl *rpl = rpl_find(addrs[i]);
+
+		if (removed[i]) {
+			zassert_is_null(rpl, "0x%04x found after removal", addrs[i]);
+		} else {
+			zassert_not_null(rpl, "0x%04x not found", addrs[i]);
+			zassert_equal(rpl->seq, i + 1, "0x%04x: seq %u", addrs[i],
+				      (uint32_t)rpl->seq);
+		}
+	}
+}
+
+static void *rpl_setup(void)
+{
+	zassert_ok(settings_subsys_init());
+
+	/* The settings handlers of mesh are only active once it's initialized */
+	atomic_set_bit(bt_mesh.flags, BT_MESH_INIT);
+	bt_mesh_settings_init();
+
+	return NULL;
+}
+
+static void rpl_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_mesh_rpl_clear();
+	bt_mesh_rpl_pending_store(BT_MESH_ADDR_ALL_NODES);
+}
+
+ZTEST(bt_mesh_rpl, test_remove_collisions)
+{
+	uint16_t addrs[7];
+	bool removed[ARRAY_SIZE(addrs)] = { false };
+	/* Removed from the head, the middle and the wrapped end of a run */
+	const int order[] = { 0, 2, 4, 6, 1, 3, 5 };
+	uint16_t src = BT_MESH_ADDR_UNASSIGNED;
+
+	/* A run of entries from the last bucket of the index, wrapping to the
+	 * first ones, interleaved with entries whose bucket is in the run.
+	 */
+	for (int i = 0; i < 4; i++) {
+		src = addr_with_hash(RPL_INDEX_SIZE - 1, src);
+		addrs[i] = src;
+	}
+
+	addrs[4] = addr_with_hash(0, BT_MESH_ADDR_UNASSIGNED);
+	addrs[5] = addr_with_hash(2, BT_MESH_ADDR_UNASSIGNED);
+	addrs[6] = addr_with_hash(1, BT_MESH_ADDR_UNASSIGNED);
+
+	for (int i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_ok(rpl_load(addrs[i], i + 1, false), "Loading 0x%04x", addrs[i]);
+	}
+
+	rpl_verify(addrs, ARRAY_SIZE(addrs), removed);
+
+	for (int i = 0; i < ARRAY_SIZE(order); i++) {
+		rpl_remove(addrs[order[i]]);
+		removed[order[i]] = true;
+		rpl_verify(addrs, ARRAY_SIZE(addrs), removed);
+	}
+
+	/* The removed entries can be added back in any order */
+	for (int i = ARRAY_SIZE(order) - 1; i >= 0; i--) {
+		zassert_ok(rpl_load(addrs[order[i]], order[i] + 1, false));
+		removed[order[i]] = false;
+		rpl_verify(addrs, ARRAY_SIZE(addrs), removed);
+	}
+}
+
+ZTEST(bt_mesh_rpl, test_remove_reuse)
+{
+	const uint16_t extra = CONFIG_BT_MESH_CRPL + 1;
+	struct bt_mesh_net_rx rx = {
+		.net_if = BT_MESH_NET_IF_ADV,
+		.local_match = 1,
+		.ctx.addr = extra,
+		.seq = 1,
+	};
+	struct bt_mesh_rpl *match = NULL;
+
+	for (uint16_t src = 1; src <= CONFIG_BT_MESH_CRPL; src++) {
+		zassert_ok(rpl_load(src, src, false), "Loading 0x%04x", src);
+	}
+
+	/* Messages from unknown sources are dropped while the list is full */
+	zassert_equal(rpl_load(extra, 1, false), -ENOMEM);
+	zassert_true(bt_mesh_rpl_check(&rx, &match));
+
+	/* The entry of a removed source is reused by the next one */
+	rpl_remove(CONFIG_BT_MESH_CRPL / 2);
+	zassert_false(bt_mesh_rpl_check(&rx, &match));
+	zassert_not_null(match);
+	zassert_equal(match->src, BT_MESH_ADDR_UNASSIGNED);
+
+	bt_mesh_rpl_update(match, &rx);
+	zassert_equal(rpl_find(extra), match);
+	zassert_true(bt_mesh_rpl_check(&rx, NULL), "Replay accepted");
+
+	for (uint16_t src = 1; src <= CONFIG_BT_MESH_CRPL; src++) {
+		if (src == CONFIG_BT_MESH_CRPL / 2) {
+			zassert_is_null(rpl_find(src));
+		} else {
+			zassert_not_null(rpl_find(src), "0x%04x not found", src);
+		}
+	}
+}
+
+ZTEST(bt_mesh_rpl, test_reset)
+{
+	uint16_t addrs[8];
+	bool removed[ARRAY_SIZE(addrs)];
+	uint16_t src = BT_MESH_ADDR_UNASSIGNED;
+	int kept = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(addrs); i++) {
+		src = addr_with_hash(RPL_INDEX_SIZE / 2, src);
+		addrs[i] = src;
+
+		/* Entries of the previous IV index are dropped by the reset,
+		 * the following ones moving down the list to fill the holes.
+		 */
+		removed[i] = (i % 3 != 1);
+		zassert_ok(rpl_load(src, i + 1, removed[i]), "Loading 0x%04x", src);
+	}
+
+	bt_mesh_rpl_reset();
+
+	rpl_verify(addrs, ARRAY_SIZE(addrs), removed);
+
+	for (int i = 0; i < ARRAY_SIZE(addrs); i++) {
+		if (!removed[i]) {
+			zassert_true(rpl_find(addrs[i])->old_iv, "0x%04x not old", addrs[i]);
+			kept++;
+		}
+	}
+
+	/* All the other entries are free again */
+	for (int i = kept; i < CONFIG_BT_MESH_CRPL; i++) {
+		zassert_ok(rpl_load(++src, 1, false), "Loading entry %d", i);
+	}
+
+	zassert_equal(rpl_load(++src, 1, false), -ENOMEM);
+
+	/* Now two IV indexes old */
+	bt_mesh_rpl_reset();
+
+	for (int i = 0; i < ARRAY_SIZE(addrs); i++) {
+		zassert_is_null(rpl_find(addrs[i]), "0x%04x found", addrs[i]);
+	}
+}
+
+ZTEST_SUITE(bt_mesh_rpl, NULL, rpl_setup, rpl_before, NULL, NULL);
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Tests for lock-free MPMC queue objects
+ * @defgroup kernel_mpmcq_tests MPMC Queues
+ * @ingroup all_tests
+ * @{
+ * @}
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/irq_offload.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define QUEUE_LEN 8
+#define NUM_WORKERS 2
+#define ITEMS_PER_PRODUCER 1000
+
+K_MPMCQ_DEFINE(mpmcq, QUEUE_LEN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, NUM_WORKERS * 2, STACK_SIZE);
+static struct k_thread worker_threads[NUM_WORKERS * 2];
+
+static K_SEM_DEFINE(done_sem, 0, NUM_WORKERS * 2);
+
+static uintptr_t items[QUEUE_LEN];
+
+static void drain(void)
+{
+	while (k_mpmcq_get(&mpmcq, K_NO_WAIT) != NULL) {
+	}
+}
+
+static void mpmcq_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	drain();
+	k_sem_reset(&done_sem);
+}
+
+ZTEST_SUITE(mpmcq, NULL, NULL, mpmcq_before, NULL, NULL);
+
+ZTEST(mpmcq, test_mpmcq_init)
+{
+	struct k_mpmcq_slot slots[4];
+	struct k_mpmcq q;
+
+	zassert_equal(k_mpmcq_init(&q, slots, 0), -EINVAL);
+	zassert_equal(k_mpmcq_init(&q, slots, 1), -EINVAL);
+	zassert_equal(k_mpmcq_init(&q, slots, 3), -EINVAL);
+	zassert_equal(k_mpmcq_init(&q, slots, ARRAY_SIZE(slots)), 0);
+
+	zassert_is_null(k_mpmcq_get(&q, K_NO_WAIT));
+	zassert_equal(k_mpmcq_put(&q, &items[0]), 0);
+	zassert_equal_ptr(k_mpmcq_get(&q, K_NO_WAIT), &items[0]);
+}
+
+ZTEST(mpmcq, test_mpmcq_order_and_full)
+{
+	/* Several laps, so that slot sequence numbers wrap around the ring */
+	for (int lap = 0; lap < 4; lap++) {
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			zassert_equal(k_mpmcq_put(&mpmcq, &items[i]), 0);
+		}
+
+		zassert_equal(k_mpmcq_put(&mpmcq, &items[0]), -ENOMEM);
+
+		for (int i = 0; i < QUEUE_LEN; i++) {
+			zassert_equal_ptr(k_mpmcq_get(&mpmcq, K_NO_WAIT),
+					  &items[i]);
+		}
+
+		zassert_is_null(k_mpmcq_get(&mpmcq, K_NO_WAIT));
+
+		/* Shift the ring position for the next lap */
+		zassert_equal(k_mpmcq_put(&mpmcq, &items[lap]), 0);
+		zassert_equal_ptr(k_mpmcq_get(&mpmcq, K_NO_WAIT), &items[lap]);
+	}
+}
+
+static void isr_put(const void *arg)
+{
+	zassert_equal(k_mpmcq_put(&mpmcq, (void *)arg), 0);
+}
+
+static void isr_get(const void *arg)
+{
+	void **data = (void **)arg;
+
+	*data = k_mpmcq_get(&mpmcq, K_NO_WAIT);
+}
+
+ZTEST(mpmcq, test_mpmcq_isr)
+{
+	void *data = NULL;
+
+	irq_offload(isr_put, &items[1]);
+	zassert_equal_ptr(k_mpmcq_get(&mpmcq, K_NO_WAIT), &items[1]);
+
+	zassert_equal(k_mpmcq_put(&mpmcq, &items[2]), 0);
+	irq_offload(isr_get, &data);
+	zassert_equal_ptr(data, &items[2]);
+
+	irq_offload(isr_get, &data);
+	zassert_is_null(data);
+}
+
+ZTEST(mpmcq, test_mpmcq_get_timeout)
+{
+	int64_t start = k_uptime_get();
+
+	zassert_is_null(k_mpmcq_get(&mpmcq, K_MSEC(50)));
+	zassert_true(k_uptime_get() - start >= 50, "returned too early");
+}
+
+static void blocked_consumer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal_ptr(k_mpmcq_get(&mpmcq, K_FOREVER), p1);
+	k_sem_give(&done_sem);
+}
+
+ZTEST(mpmcq, test_mpmcq_blocking_get)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&worker_threads[0], worker_stacks[0], STACK_SIZE,
+			      blocked_consumer, &items[3], NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	/* Let the consumer block on the empty queue */
+	k_msleep(10);
+
+	zassert_equal(k_mpmcq_put(&mpmcq, &items[3]), 0);
+	zassert_equal(k_sem_take(&done_sem, K_MSEC(100)), 0);
+
+	k_thread_join(tid, K_FOREVER);
+}
+
+static atomic_t consumed_sum;
+static atomic_t consumed_count;
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uintptr_t base = POINTER_TO_UINT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uintptr_t i = 1; i <= ITEMS_PER_PRODUCER; i++) {
+		while (k_mpmcq_put(&mpmcq, UINT_TO_POINTER(base + i)) != 0) {
+			k_yield();
+		}
+	}
+
+	k_sem_give(&done_sem);
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	void *data;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (atomic_get(&consumed_count) < NUM_WORKERS * ITEMS_PER_PRODUCER) {
+		data = k_mpmcq_get(&mpmcq, K_MSEC(10));
+		if (data != NULL) {
+			atomic_add(&consumed_sum, (atomic_val_t)POINTER_TO_UINT(data));
+			atomic_inc(&consumed_count);
+		}
+	}
+
+	k_sem_give(&done_sem);
+}
+
+ZTEST(mpmcq, test_mpmcq_concurrent)
+{
+	atomic_val_t expected = 0;
+
+	atomic_clear(&consumed_sum);
+	atomic_clear(&consumed_count);
+
+	for (int i = 0; i < NUM_WORKERS; i++) {
+		uintptr_t base = (uintptr_t)i * ITEMS_PER_PRODUCER;
+
+		expected += (atomic_val_t)(base * ITEMS_PER_PRODUCER +
+					   ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2);
+
+		k_thread_create(&worker_threads[i], worker_stacks[i], STACK_SIZE,
+				consumer, NULL, NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		k_thread_create(&worker_threads[NUM_WORKERS + i],
+				worker_stacks[NUM_WORKERS + i], STACK_SIZE,
+				producer, UINT_TO_POINTER(base), NULL, NULL,
+				K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < NUM_WORKERS * 2; i++) {
+		zassert_equal(k_sem_take(&done_sem, K_SECONDS(10)), 0);
+	}
+
+	for (int i = 0; i < NUM_WORKERS * 2; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&consumed_count), NUM_WORKERS * ITEMS_PER_PRODUCER);
+	zassert_equal(atomic_get(&consumed_sum), expected);
+	zassert_is_null(k_mpmcq_get(&mpmcq, K_NO_WAIT));
+}
@@ -1061,6 +1061,183 @@ ZTEST(smp, test_smp_switch_torture)
 	}
 }
 
+/* Threads used by the run queue tests below record which CPU they ran
+ * on and in which order they were dispatched.
+ */
+#define RUNQ_NUM_THREADS (2 * MAX_NUM_THREADS)
+
+static struct k_thread runq_thread[RUNQ_NUM_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(runq_stack, RUNQ_NUM_THREADS, STACK_SIZE);
+static volatile int runq_cpu_id[RUNQ_NUM_THREADS];
+static volatile int runq_order[RUNQ_NUM_THREADS];
+static atomic_t runq_seq;
+static atomic_t runq_hogs;
+static volatile bool runq_hold;
+
+static void runq_hog_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	atomic_inc(&runq_hogs);
+	while (runq_hold) {
+	}
+}
+
+static void runq_worker_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+	int id = POINTER_TO_INT(p1);
+
+	runq_cpu_id[id] = curr_cpu();
+	runq_order[atomic_inc(&runq_seq)] = id;
+	k_busy_wait(DELAY_US);
+}
+
+static void runq_worker_create(int id, int prio)
+{
+	runq_cpu_id[id] = -1;
+	k_thread_create(&runq_thread[id], runq_stack[id], STACK_SIZE,
+			runq_worker_fn, INT_TO_POINTER(id), NULL, NULL,
+			prio, 0, K_FOREVER);
+}
+
+/**
+ * @brief Test that idle CPUs pick up threads queued elsewhere
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Keep all other CPUs busy with cooperative threads, make
+ * one worker per CPU runnable while nothing can take them, then let
+ * the busy CPUs go.  With CONFIG_SCHED_PER_CPU_RUNQ the workers all
+ * land in the same per-CPU queue, so every CPU running one of them
+ * means the siblings stole from it.
+ */
+ZTEST(smp, test_per_cpu_runq_steal)
+{
+	unsigned int num_cpus = arch_num_cpus();
+	uint32_t seen = 0U;
+
+	runq_hold = true;
+	atomic_set(&runq_hogs, 0);
+	atomic_set(&runq_seq, 0);
+
+	for (int i = 0; i < num_cpus - 1; i++) {
+		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
+				runq_hog_fn, NULL, NULL, NULL,
+				K_PRIO_COOP(2), 0, K_NO_WAIT);
+	}
+	while (atomic_get(&runq_hogs) < num_cpus - 1) {
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		runq_worker_create(i, K_PRIO_PREEMPT(1));
+		k_thread_start(&runq_thread[i]);
+	}
+
+	runq_hold = false;
+
+	for (int i = 0; i < num_cpus; i++) {
+		k_thread_join(&runq_thread[i], K_FOREVER);
+	}
+	for (int i = 0; i < num_cpus - 1; i++) {
+		k_thread_join(&tthread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		zassert_true(runq_cpu_id[i] >= 0, "worker %d did not run", i);
+		seen |= BIT(runq_cpu_id[i]);
+	}
+	zassert_equal(seen, BIT_MASK(num_cpus),
+		      "workers only ran on CPUs 0x%x", seen);
+}
+
+/**
+ * @brief Test priority order of threads queued on one CPU
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Pin a set of threads to the current CPU and make them
+ * runnable lowest priority first while this cooperative thread holds
+ * the CPU.  The other CPUs must not steal them, and once we block
+ * they must be dispatched highest priority first.
+ */
+ZTEST(smp, test_per_cpu_runq_prio_order)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	int cpu = curr_cpu();
+
+	atomic_set(&runq_seq, 0);
+
+	for (int i = RUNQ_NUM_THREADS - 1; i >= 0; i--) {
+		runq_worker_create(i, K_PRIO_PREEMPT(i + 1));
+		zassert_ok(k_thread_cpu_pin(&runq_thread[i], cpu));
+		k_thread_start(&runq_thread[i]);
+	}
+
+	for (int i = 0; i < RUNQ_NUM_THREADS; i++) {
+		k_thread_join(&runq_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < RUNQ_NUM_THREADS; i++) {
+		zassert_equal(runq_cpu_id[i], cpu,
+			      "thread %d ran on CPU %d, pinned to %d",
+			      i, runq_cpu_id[i], cpu);
+		zassert_equal(runq_order[i], i,
+			      "thread %d dispatched at position %d",
+			      runq_order[i], i);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+/**
+ * @brief Test that CPU masks are honored when queueing threads
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Make one thread pinned to each CPU runnable from this CPU
+ * and check that each of them ran where it was pinned.  Then check
+ * that a thread with every CPU masked off is never run.
+ */
+ZTEST(smp, test_per_cpu_runq_cpu_mask)
+{
+#ifdef CONFIG_SCHED_CPU_MASK
+	unsigned int num_cpus = arch_num_cpus();
+
+	for (int i = 0; i < num_cpus; i++) {
+		runq_worker_create(i, K_PRIO_PREEMPT(1));
+		zassert_ok(k_thread_cpu_pin(&runq_thread[i], i));
+		k_thread_start(&runq_thread[i]);
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		k_thread_join(&runq_thread[i], K_FOREVER);
+	}
+
+	for (int i = 0; i < num_cpus; i++) {
+		zassert_equal(runq_cpu_id[i], i,
+			      "thread pinned to CPU %d ran on CPU %d",
+			      i, runq_cpu_id[i]);
+	}
+
+	runq_worker_create(0, K_PRIO_PREEMPT(1));
+	zassert_ok(k_thread_cpu_mask_clear(&runq_thread[0]));
+	k_thread_start(&runq_thread[0]);
+
+	zassert_equal(k_thread_join(&runq_thread[0], K_MSEC(100)), -EAGAIN,
+		      "thread with an empty CPU mask exited");
+	zassert_equal(runq_cpu_id[0], -1, "thread with an empty CPU mask ran");
+
+	k_thread_abort(&runq_thread[0]);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void *smp_tests_setup(void)
 {
 	/* Sleep a bit to guarantee that both CPUs enter an idle
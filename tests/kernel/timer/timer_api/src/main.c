@@ -65,6 +65,9 @@ static struct k_timer status_anytime_timer;
 static struct k_timer status_sync_timer;
 static struct k_timer remain_timer;
 
+#define ORDER_TIMERS 6
+static struct k_timer order_timers[ORDER_TIMERS];
+
 static ZTEST_BMEM struct timer_data tdata;
 
 #define TIMER_ASSERT(exp, tmr)			 \
@@ -781,6 +784,95 @@ ZTEST_USER(timer_api, test_timeout_abs)
 #endif
 }
 
+static ZTEST_BMEM int order_expired[ORDER_TIMERS];
+static ZTEST_BMEM int order_cnt;
+
+static void order_expire(struct k_timer *timer)
+{
+	if (order_cnt < ORDER_TIMERS) {
+		order_expired[order_cnt++] = timer - order_timers;
+	}
+}
+
+/**
+ * @brief Test the expiry order of several timers
+ *
+ * Starts timers with absolute expiry times out of order, two of them
+ * expiring in the same tick, then stops one and restarts another before
+ * they expire. Checks that the remaining times match the expiry times,
+ * and that the timers expire by expiry time, and in start order when
+ * expiring in the same tick.
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_start(), k_timer_stop(), k_timer_remaining_ticks()
+ */
+ZTEST_USER(timer_api, test_timer_expiry_order)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	static const int expected[] = { 1, 2, 3, 0, 5 };
+	const k_ticks_t step = k_ms_to_ticks_ceil32(10);
+	k_ticks_t base, now, rem0, rem1;
+
+	order_cnt = 0;
+	init_timer_data();
+
+	/* Leave enough time to start all timers before the first expires */
+	base = k_uptime_ticks() + k_ms_to_ticks_ceil32(DURATION);
+
+	k_timer_start(&order_timers[0], K_TIMEOUT_ABS_TICKS(base + 3 * step),
+		      K_NO_WAIT);
+	k_timer_start(&order_timers[1], K_TIMEOUT_ABS_TICKS(base + step),
+		      K_NO_WAIT);
+	k_timer_start(&order_timers[2], K_TIMEOUT_ABS_TICKS(base + 2 * step),
+		      K_NO_WAIT);
+	k_timer_start(&order_timers[3], K_TIMEOUT_ABS_TICKS(base + 2 * step),
+		      K_NO_WAIT);
+	k_timer_start(&order_timers[4], K_TIMEOUT_ABS_TICKS(base),
+		      K_NO_WAIT);
+	k_timer_start(&order_timers[5], K_TIMEOUT_ABS_TICKS(base),
+		      K_NO_WAIT);
+
+	/** TESTPOINT: remaining time follows the expiry time */
+	do {
+		now = k_uptime_ticks();
+		rem0 = k_timer_remaining_ticks(&order_timers[0]);
+		rem1 = k_timer_remaining_ticks(&order_timers[1]);
+	} while (now != k_uptime_ticks());
+
+	TIMER_ASSERT(now + rem0 == base + 3 * step, &order_timers[0]);
+	TIMER_ASSERT(now + rem1 == base + step, &order_timers[1]);
+
+	/** TESTPOINT: stopped and restarted timers leave their old slot */
+	k_timer_stop(&order_timers[4]);
+	TIMER_ASSERT(k_timer_remaining_ticks(&order_timers[4]) == 0,
+		     &order_timers[4]);
+	k_timer_start(&order_timers[5], K_TIMEOUT_ABS_TICKS(base + 4 * step),
+		      K_NO_WAIT);
+
+	/* Wait a step past the last expiry, so that its handler has also
+	 * completed on SMP.
+	 */
+	while (k_uptime_ticks() <= base + 5 * step) {
+		/* Busy wait, so this also works without multithreading */
+	}
+
+	for (int i = 0; i < ORDER_TIMERS; i++) {
+		k_timer_stop(&order_timers[i]);
+	}
+
+	zassert_equal(order_cnt, ARRAY_SIZE(expected),
+		      "%d timers expired", order_cnt);
+	for (int i = 0; i < ARRAY_SIZE(expected); i++) {
+		zassert_equal(order_expired[i], expected[i],
+			      "timer %d expired in place of timer %d",
+			      order_expired[i], expected[i]);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 ZTEST_USER(timer_api, test_sleep_abs)
 {
 	if (!IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -831,6 +923,10 @@ void *setup_timer_api(void)
 	timer_init(&status_sync_timer, duration_expire, duration_stop);
 	timer_init(&remain_timer, duration_expire, duration_stop);
 
+	for (int i = 0; i < ORDER_TIMERS; i++) {
+		timer_init(&order_timers[i], order_expire, NULL);
+	}
+
 	if (IS_ENABLED(CONFIG_MULTITHREADING)) {
 		k_thread_access_grant(k_current_get(), &ktimer, &timer0, &timer1,
 			      &timer2, &timer3, &timer4);
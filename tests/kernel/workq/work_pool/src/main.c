@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define NUM_WORKERS 4
+#define NUM_ITEMS 32
+#define NUM_RESUBMITS 16
+#define WORKER_PRIORITY K_PRIO_PREEMPT(1)
+#define TIMEOUT K_SECONDS(2)
+
+static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks, NUM_WORKERS, STACK_SIZE);
+static struct k_work_q_worker pool_workers[NUM_WORKERS];
+static struct k_work_q pool;
+
+struct test_item {
+	struct k_work work;
+	/* Number of workers currently running the handler. */
+	atomic_t running;
+	/* Number of completed handler invocations. */
+	atomic_t runs;
+	/* Number of runs left before the item reports completion. */
+	atomic_t left;
+	/* Thread that last ran the handler. */
+	k_tid_t thread;
+};
+
+static struct test_item items[NUM_ITEMS];
+
+/* Number of times a handler was entered while already running. */
+static atomic_t overlaps;
+
+/* Given by an item when it has run the requested number of times. */
+static K_SEM_DEFINE(done_sem, 0, NUM_ITEMS);
+
+/* Work synchronization objects must be in cache-coherent memory,
+ * which excludes stacks on some architectures.
+ */
+static struct k_work_sync work_sync;
+
+/* Runs for a while, resubmitting itself from the handler until the
+ * requested number of runs is reached.
+ */
+static void item_handler(struct k_work *work)
+{
+	struct test_item *item = CONTAINER_OF(work, struct test_item, work);
+	atomic_val_t left;
+
+	if (atomic_inc(&item->running) != 0) {
+		atomic_inc(&overlaps);
+	}
+
+	k_busy_wait(100);
+	item->thread = k_current_get();
+
+	atomic_dec(&item->running);
+	atomic_inc(&item->runs);
+
+	left = atomic_dec(&item->left);
+	if (left > 1) {
+		(void)k_work_submit_to_queue(&pool, work);
+	} else if (left == 1) {
+		k_sem_give(&done_sem);
+	}
+}
+
+static void submit_all(atomic_val_t runs)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		atomic_set(&items[i].left, runs);
+		zassert_equal(k_work_submit_to_queue(&pool, &items[i].work), 1);
+	}
+}
+
+static void wait_all(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_ok(k_sem_take(&done_sem, TIMEOUT), "item timed out");
+	}
+}
+
+static void *work_pool_setup(void)
+{
+	const struct k_work_queue_config cfg = {
+		.name = "test_pool",
+		.pin_workers = IS_ENABLED(CONFIG_SCHED_CPU_MASK),
+	};
+
+	k_work_queue_pool_start(&pool, pool_workers, NUM_WORKERS,
+				pool_stacks[0], STACK_SIZE, WORKER_PRIORITY,
+				&cfg);
+
+	return NULL;
+}
+
+static void work_pool_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		k_work_init(&items[i].work, item_handler);
+		atomic_clear(&items[i].running);
+		atomic_clear(&items[i].runs);
+		atomic_clear(&items[i].left);
+		items[i].thread = NULL;
+	}
+
+	atomic_clear(&overlaps);
+	k_sem_reset(&done_sem);
+}
+
+static void work_pool_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Leave no item running into the next test */
+	zassert_true(k_work_queue_drain(&pool, false) >= 0);
+}
+
+ZTEST(work_pool, test_thread_get)
+{
+	zassert_equal_ptr(k_work_queue_thread_get(&pool),
+			  &pool_workers[0].thread);
+}
+
+ZTEST(work_pool, test_run)
+{
+	submit_all(1);
+	wait_all();
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(atomic_get(&items[i].runs), 1);
+	}
+
+	zassert_equal(atomic_get(&overlaps), 0);
+}
+
+/* Items resubmitted from their own handler and from the test thread while
+ * they run must never run on two workers at once.
+ */
+ZTEST(work_pool, test_no_reentrancy)
+{
+	submit_all(NUM_RESUBMITS);
+
+	for (int r = 0; r < NUM_RESUBMITS; r++) {
+		for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+			(void)k_work_submit_to_queue(&pool, &items[i].work);
+		}
+
+		/* Let the workers pick up items, so that some of the
+		 * submissions above hit running items.
+		 */
+		k_msleep(1);
+	}
+
+	wait_all();
+	zassert_true(k_work_queue_drain(&pool, false) >= 0);
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_true(atomic_get(&items[i].runs) >= NUM_RESUBMITS);
+	}
+
+	zassert_equal(atomic_get(&overlaps), 0);
+}
+
+/* Independent items spread over the workers when there is more than one
+ * CPU to run them.
+ */
+ZTEST(work_pool, test_spread)
+{
+	bool spread = false;
+
+	if (arch_num_cpus() == 1) {
+		ztest_test_skip();
+	}
+
+	submit_all(NUM_RESUBMITS);
+	wait_all();
+
+	for (size_t i = 1; i < ARRAY_SIZE(items); i++) {
+		spread |= (items[i].thread != items[0].thread);
+	}
+
+	zassert_true(spread, "all items ran on one worker");
+}
+
+ZTEST(work_pool, test_flush)
+{
+	struct test_item *item = &items[NUM_ITEMS - 1];
+
+	submit_all(1);
+
+	/* The last item is queued behind all others, and may get stolen
+	 * while the flush waits for it.
+	 */
+	zassert_true(k_work_flush(&item->work, &work_sync));
+	zassert_equal(atomic_get(&item->runs), 1);
+	zassert_equal(k_work_busy_get(&item->work), 0);
+
+	wait_all();
+	zassert_false(k_work_flush(&item->work, &work_sync));
+}
+
+ZTEST(work_pool, test_cancel_sync)
+{
+	submit_all(NUM_RESUBMITS);
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		(void)k_work_cancel_sync(&items[i].work, &work_sync);
+
+		zassert_equal(k_work_busy_get(&items[i].work), 0);
+		zassert_equal(atomic_get(&items[i].running), 0);
+	}
+
+	zassert_equal(atomic_get(&overlaps), 0);
+}
+
+ZTEST(work_pool, test_drain)
+{
+	submit_all(1);
+
+	zassert_equal(k_work_queue_drain(&pool, true), 1);
+
+	for (size_t i = 0; i < ARRAY_SIZE(items); i++) {
+		zassert_equal(atomic_get(&items[i].runs), 1);
+		zassert_equal(k_work_busy_get(&items[i].work), 0);
+	}
+
+	/* Plugged: submissions from outside the pool are rejected */
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0].work), -EBUSY);
+	zassert_ok(k_work_queue_unplug(&pool));
+	zassert_equal(k_work_queue_unplug(&pool), -EALREADY);
+
+	atomic_set(&items[0].left, 1);
+	zassert_equal(k_work_submit_to_queue(&pool, &items[0].work), 1);
+	zassert_ok(k_sem_take(&done_sem, TIMEOUT));
+}
+
+ZTEST_SUITE(work_pool, NULL, work_pool_setup, work_pool_before,
+	    work_pool_after, NULL);
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+/*
+ * The string functions handle the head and tail of buffers byte by byte and
+ * the middle word by word, so check every combination of alignments for
+ * lengths spanning several words.
+ */
+#define ALIGNS	(2 * sizeof(uintptr_t))
+#define MAX_LEN	(8 * sizeof(uintptr_t) + 3)
+#define BUF_LEN	(2 * (MAX_LEN + ALIGNS))
+
+static uint8_t src_buf[BUF_LEN] __aligned(sizeof(uintptr_t));
+static uint8_t dst_buf[BUF_LEN] __aligned(sizeof(uintptr_t));
+static uint8_t ref_buf[BUF_LEN] __aligned(sizeof(uintptr_t));
+
+static void fill(uint8_t *buf, size_t len, uint8_t seed)
+{
+	for (size_t i = 0; i < len; i++) {
+		/* never zero, to be usable as string contents */
+		buf[i] = (uint8_t)(seed + i * 7) % 120 + 1;
+	}
+}
+
+/**
+ * @brief Test memcpy with all alignments
+ *
+ * @see memcpy().
+ */
+ZTEST(test_c_lib, test_memcpy_align)
+{
+	fill(src_buf, sizeof(src_buf), 3);
+
+	for (size_t da = 0; da < ALIGNS; da++) {
+		for (size_t sa = 0; sa < ALIGNS; sa++) {
+			for (size_t n = 0; n <= MAX_LEN; n++) {
+				memset(dst_buf, 0, sizeof(dst_buf));
+				zassert_equal(memcpy(dst_buf + da, src_buf + sa, n),
+					      dst_buf + da, "memcpy error");
+
+				for (size_t i = 0; i < sizeof(dst_buf); i++) {
+					uint8_t expected = (i >= da && i < da + n) ?
+							   src_buf[sa + i - da] : 0;
+
+					zassert_equal(dst_buf[i], expected,
+						      "memcpy failed: %zu %zu %zu",
+						      da, sa, n);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Test memmove of overlapping buffers with all alignments
+ *
+ * @see memmove().
+ */
+ZTEST(test_c_lib, test_memmove_align)
+{
+	for (size_t da = 0; da < ALIGNS; da++) {
+		for (size_t sa = 0; sa < ALIGNS; sa++) {
+			for (size_t n = 0; n <= MAX_LEN; n++) {
+				/* move forward then backward over the same buffer */
+				for (int back = 0; back < 2; back++) {
+					size_t s = back ? sa : sa + da + 1;
+					size_t d = back ? sa + da + 1 : sa;
+
+					fill(dst_buf, sizeof(dst_buf), n);
+					memcpy(ref_buf, dst_buf, sizeof(ref_buf));
+					for (size_t i = 0; i < n; i++) {
+						ref_buf[d + i] = dst_buf[s + i];
+					}
+
+					zassert_equal(memmove(dst_buf + d, dst_buf + s, n),
+						      dst_buf + d, "memmove error");
+					zassert_mem_equal(dst_buf, ref_buf, sizeof(ref_buf),
+							  "memmove failed: %zu %zu %zu",
+							  d, s, n);
+				}
+			}
+		}
+	}
+}
+
+/**
+ * @brief Test memcmp and memchr with all alignments
+ *
+ * @see memcmp(), memchr().
+ */
+ZTEST(test_c_lib, test_memcmp_memchr_align)
+{
+	fill(src_buf, sizeof(src_buf), 5);
+
+	for (size_t da = 0; da < ALIGNS; da++) {
+		for (size_t sa = 0; sa < ALIGNS; sa++) {
+			for (size_t n = 1; n <= MAX_LEN; n++) {
+				uint8_t *m1 = dst_buf + da;
+				uint8_t *m2 = src_buf + sa;
+
+				memcpy(m1, m2, n);
+				zassert_equal(memcmp(m1, m2, n), 0, "memcmp failed");
+
+				/* a difference in any byte, the last one being the hardest */
+				m1[n - 1]++;
+				zassert_true(memcmp(m1, m2, n) > 0, "memcmp failed");
+				m1[n - 1] -= 2;
+				zassert_true(memcmp(m1, m2, n) < 0, "memcmp failed");
+				m1[n - 1]++;
+
+				m1[n / 2] = 0;
+				zassert_equal(memchr(m1, 0, n), m1 + n / 2,
+					      "memchr failed: %zu %zu", da, n);
+				zassert_is_null(memchr(m2, 0, n), "memchr failed");
+			}
+		}
+	}
+}
+
+/**
+ * @brief Test strlen and strcmp with all alignments
+ *
+ * @see strlen(), strcmp().
+ */
+ZTEST(test_c_lib, test_strlen_strcmp_align)
+{
+	for (size_t a1 = 0; a1 < ALIGNS; a1++) {
+		for (size_t a2 = 0; a2 < ALIGNS; a2++) {
+			for (size_t n = 0; n <= MAX_LEN; n++) {
+				char *s1 = (char *)dst_buf + a1;
+				char *s2 = (char *)src_buf + a2;
+
+				fill(dst_buf, sizeof(dst_buf), 9);
+				s1[n] = '\0';
+				memcpy(s2, s1, n + 1);
+
+				zassert_equal(strlen(s1), n, "strlen failed: %zu %zu",
+					      a1, n);
+				zassert_equal(strcmp(s1, s2), 0, "strcmp failed");
+
+				if (n == 0) {
+					continue;
+				}
+
+				/* a longer string is greater */
+				s2[n] = 'x';
+				s2[n + 1] = '\0';
+				zassert_true(strcmp(s1, s2) < 0, "strcmp failed");
+				zassert_true(strcmp(s2, s1) > 0, "strcmp failed");
+			}
+		}
+	}
+}
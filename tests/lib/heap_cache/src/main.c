@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/sys/sys_heap_cache.h>
+
+#define HEAP_SZ 0x2000
+
+#define DEPTH CONFIG_SYS_HEAP_CACHE_DEPTH
+#define BATCH MAX(DEPTH / 2, 1)
+#define MAX_SIZE BIT(SYS_HEAP_CACHE_MIN_SHIFT + CONFIG_SYS_HEAP_CACHE_CLASSES - 1)
+#define BLOCK_ALIGN __alignof__(z_max_align_t)
+
+/* Class used by the tests counting blocks: the heap pads small blocks
+ * enough to push their usable size into the next class.
+ */
+#define TEST_CLS MIN(2, CONFIG_SYS_HEAP_CACHE_CLASSES - 1)
+#define TEST_SIZE BIT(SYS_HEAP_CACHE_MIN_SHIFT + TEST_CLS)
+
+static uint8_t __aligned(8) heapmem[HEAP_SZ];
+static struct sys_heap heap;
+static struct k_spinlock heap_lock;
+static struct sys_heap_cache cache;
+
+static struct sys_heap_cache_stats stats_get(void)
+{
+	struct sys_heap_cache_stats stats;
+
+	zassert_equal(sys_heap_cache_stats_get(&cache, &stats), 0,
+		      "stats_get failed");
+
+	return stats;
+}
+
+static void *heap_alloc(size_t align, size_t bytes)
+{
+	k_spinlock_key_t key = k_spin_lock(&heap_lock);
+	void *mem = sys_heap_aligned_alloc(&heap, align, bytes);
+
+	k_spin_unlock(&heap_lock, key);
+
+	return mem;
+}
+
+static void fill_check(uint8_t *mem, size_t bytes, uint8_t pattern)
+{
+	memset(mem, pattern, bytes);
+	for (size_t i = 0; i < bytes; i++) {
+		zassert_equal(mem[i], pattern, "block overlaps another");
+	}
+}
+
+ZTEST(heap_cache, test_alloc_free)
+{
+	struct sys_heap_cache_stats stats;
+	uint8_t *a, *b;
+
+	zassert_is_null(sys_heap_cache_alloc(&cache, 0), "0 byte alloc");
+	sys_heap_cache_free(&cache, NULL);
+
+	for (size_t bytes = 1; bytes <= MAX_SIZE; bytes++) {
+		a = sys_heap_cache_alloc(&cache, bytes);
+		b = sys_heap_cache_alloc(&cache, bytes);
+		zassert_true(a != NULL && b != NULL,
+			     "alloc of %zu bytes failed", bytes);
+		zassert_equal((uintptr_t)a & (BLOCK_ALIGN - 1), 0,
+			      "block not aligned");
+		zassert_true(sys_heap_usable_size(&heap, a) >= bytes,
+			     "block too small");
+
+		/* Live blocks must not overlap */
+		fill_check(a, bytes, 0x5a);
+		fill_check(b, bytes, 0xa5);
+		zassert_equal(a[bytes - 1], 0x5a, "blocks overlap");
+
+		sys_heap_cache_free(&cache, a);
+		sys_heap_cache_free(&cache, b);
+	}
+
+	stats = stats_get();
+	zassert_true(stats.hits > 0, "no allocation served from a magazine");
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+
+	/* Blocks above the biggest class bypass the magazines */
+	a = sys_heap_cache_alloc(&cache, MAX_SIZE + 1);
+	zassert_not_null(a, "big alloc failed");
+	sys_heap_cache_free(&cache, a);
+	zassert_equal(stats_get().hits, stats.hits, "big alloc cached");
+	zassert_equal(stats_get().refills, stats.refills, "big alloc cached");
+}
+
+ZTEST(heap_cache, test_aligned_alloc)
+{
+	uint32_t hits = stats_get().hits;
+	uint8_t *mem;
+
+	/* Alignments no stricter than the cached blocks' are cached */
+	for (size_t align = 1; align <= BLOCK_ALIGN; align <<= 1) {
+		mem = sys_heap_cache_aligned_alloc(&cache, align, TEST_SIZE);
+		zassert_not_null(mem, "alloc aligned to %zu failed", align);
+		zassert_equal((uintptr_t)mem & (align - 1), 0,
+			      "block not aligned to %zu", align);
+		sys_heap_cache_free(&cache, mem);
+	}
+	zassert_true(stats_get().hits > hits, "aligned alloc not cached");
+
+	/* Stricter alignments are served by the heap */
+	hits = stats_get().hits;
+	for (size_t align = 2 * BLOCK_ALIGN; align <= 256; align <<= 1) {
+		mem = sys_heap_cache_aligned_alloc(&cache, align, TEST_SIZE);
+		zassert_not_null(mem, "alloc aligned to %zu failed", align);
+		zassert_equal((uintptr_t)mem & (align - 1), 0,
+			      "block not aligned to %zu", align);
+		fill_check(mem, TEST_SIZE, 0xa5);
+		sys_heap_cache_free(&cache, mem);
+	}
+	zassert_equal(stats_get().hits, hits, "strictly aligned alloc cached");
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+}
+
+ZTEST(heap_cache, test_realloc)
+{
+	uint8_t *mem, *mem2;
+
+	mem = sys_heap_cache_aligned_realloc(&cache, NULL, BLOCK_ALIGN,
+					     TEST_SIZE);
+	zassert_not_null(mem, "realloc of NULL failed");
+	for (size_t i = 0; i < TEST_SIZE; i++) {
+		mem[i] = i;
+	}
+
+	/* Grow a cached block beyond the biggest class and back */
+	mem2 = sys_heap_cache_aligned_realloc(&cache, mem, BLOCK_ALIGN,
+					      4 * MAX_SIZE);
+	zassert_not_null(mem2, "growing realloc failed");
+	for (size_t i = 0; i < TEST_SIZE; i++) {
+		zassert_equal(mem2[i], (uint8_t)i, "data lost by realloc");
+	}
+
+	mem = sys_heap_cache_aligned_realloc(&cache, mem2, BLOCK_ALIGN, 1);
+	zassert_not_null(mem, "shrinking realloc failed");
+	zassert_equal(mem[0], 0, "data lost by realloc");
+
+	/* A block from the cache can be reallocated */
+	sys_heap_cache_free(&cache, mem);
+	mem = sys_heap_cache_alloc(&cache, TEST_SIZE);
+	zassert_not_null(mem, "alloc failed");
+	mem2 = sys_heap_cache_aligned_realloc(&cache, mem, BLOCK_ALIGN,
+					      TEST_SIZE / 2);
+	zassert_not_null(mem2, "realloc of a cached block failed");
+
+	zassert_is_null(sys_heap_cache_aligned_realloc(&cache, mem2,
+						       BLOCK_ALIGN, 0),
+			"realloc to 0 bytes returned a block");
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+}
+
+ZTEST(heap_cache, test_refill_drain)
+{
+	struct sys_heap_cache_stats stats;
+	void *blocks[DEPTH + 1];
+
+	/* The magazines are per CPU, keep the thread on this one */
+	k_sched_lock();
+
+	/* An empty magazine is refilled with a batch of blocks */
+	blocks[0] = sys_heap_cache_alloc(&cache, TEST_SIZE);
+	zassert_not_null(blocks[0], "alloc failed");
+	zassert_true(sys_heap_usable_size(&heap, blocks[0]) < 2 * TEST_SIZE,
+		     "test block lands in another class");
+	stats = stats_get();
+	zassert_equal(stats.refills, 1, "no refill");
+	zassert_equal(stats.hits, 0);
+	zassert_equal(stats.cached_blocks[TEST_CLS], BATCH - 1,
+		      "refill did not cache a batch");
+
+	for (int i = 1; i < BATCH; i++) {
+		blocks[i] = sys_heap_cache_alloc(&cache, TEST_SIZE);
+		zassert_not_null(blocks[i], "alloc failed");
+	}
+	stats = stats_get();
+	zassert_equal(stats.refills, 1, "refill before the magazine is empty");
+	zassert_equal(stats.hits, BATCH - 1);
+	zassert_equal(stats.cached_blocks[TEST_CLS], 0);
+
+	for (int i = BATCH; i <= DEPTH; i++) {
+		blocks[i] = sys_heap_cache_alloc(&cache, TEST_SIZE);
+		zassert_not_null(blocks[i], "alloc failed");
+	}
+
+	/* Frees fill the magazine up to its depth without touching the
+	 * heap, one more returns the oldest batch.
+	 */
+	sys_heap_cache_flush(&cache);
+	for (int i = 0; i < DEPTH; i++) {
+		sys_heap_cache_free(&cache, blocks[i]);
+	}
+	stats = stats_get();
+	zassert_equal(stats.drains, 0, "drain before the magazine is full");
+	zassert_equal(stats.cached_blocks[TEST_CLS], DEPTH);
+
+	sys_heap_cache_free(&cache, blocks[DEPTH]);
+	stats = stats_get();
+	zassert_equal(stats.drains, 1, "full magazine not drained");
+	zassert_equal(stats.cached_blocks[TEST_CLS], DEPTH - BATCH + 1);
+
+	/* The most recently freed block is handed out first */
+	zassert_equal_ptr(sys_heap_cache_alloc(&cache, TEST_SIZE),
+			  blocks[DEPTH], "magazine is not LIFO");
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+
+	k_sched_unlock();
+}
+
+ZTEST(heap_cache, test_heap_block)
+{
+	struct sys_heap_cache_stats stats;
+	void *mem;
+
+	k_sched_lock();
+
+	/* A block allocated from the heap directly is cached when freed
+	 * through the cache, and handed out again from there.
+	 */
+	mem = heap_alloc(BLOCK_ALIGN, TEST_SIZE);
+	zassert_not_null(mem, "heap alloc failed");
+	sys_heap_cache_free(&cache, mem);
+
+	stats = stats_get();
+	zassert_equal(stats.cached_blocks[TEST_CLS], 1, "heap block not cached");
+	zassert_equal_ptr(sys_heap_cache_alloc(&cache, TEST_SIZE), mem,
+			  "heap block not reused");
+	zassert_equal(stats_get().hits, stats.hits + 1);
+	sys_heap_cache_free(&cache, mem);
+
+	/* A heap block too big for any class goes back to the heap */
+	mem = heap_alloc(BLOCK_ALIGN, 2 * MAX_SIZE);
+	zassert_not_null(mem, "heap alloc failed");
+	sys_heap_cache_free(&cache, mem);
+	stats = stats_get();
+	zassert_equal(stats.cached_blocks[TEST_CLS], 1, "big block cached");
+	for (int i = 0; i < CONFIG_SYS_HEAP_CACHE_CLASSES; i++) {
+		if (i != TEST_CLS) {
+			zassert_equal(stats.cached_blocks[i], 0,
+				      "big block cached");
+		}
+	}
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+
+	k_sched_unlock();
+}
+
+ZTEST(heap_cache, test_stats)
+{
+	struct sys_heap_cache_stats stats;
+	void *blocks[MIN(3, DEPTH)];
+	size_t usable = 0;
+
+	k_sched_lock();
+
+	zassert_equal(sys_heap_cache_stats_get(NULL, &stats), -EINVAL);
+	zassert_equal(sys_heap_cache_stats_get(&cache, NULL), -EINVAL);
+
+	stats = stats_get();
+	zassert_equal(stats.cached_bytes, 0);
+
+	/* Cached bytes count the usable size of the cached blocks, which
+	 * may exceed their class size.
+	 */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = heap_alloc(BLOCK_ALIGN, TEST_SIZE + i);
+		zassert_not_null(blocks[i], "heap alloc failed");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		usable += sys_heap_usable_size(&heap, blocks[i]);
+		sys_heap_cache_free(&cache, blocks[i]);
+	}
+
+	stats = stats_get();
+	zassert_equal(stats.cached_bytes, usable, "cached bytes %zu != %zu",
+		      stats.cached_bytes, usable);
+
+#ifdef CONFIG_SYS_HEAP_RUNTIME_STATS
+	/* Cached blocks are allocated from the heap's point of view */
+	size_t allocated = stats.heap.allocated_bytes;
+
+	zassert_true(allocated >= usable, "cached blocks not allocated");
+	sys_heap_cache_flush(&cache);
+	stats = stats_get();
+	zassert_equal(stats.cached_bytes, 0, "flush left blocks cached");
+	zassert_true(stats.heap.allocated_bytes <= allocated - usable,
+		     "flush did not return the blocks");
+#endif
+
+	k_sched_unlock();
+}
+
+ZTEST(heap_cache, test_exhaustion)
+{
+	static void *blocks[HEAP_SZ / TEST_SIZE];
+	struct sys_heap_cache_stats stats;
+	size_t bytes;
+	void *big;
+	int n;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_SYS_HEAP_RUNTIME_STATS);
+
+	k_sched_lock();
+
+	/* Fill the heap, then free everything, partly into a magazine */
+	for (n = 0; n < ARRAY_SIZE(blocks); n++) {
+		blocks[n] = sys_heap_cache_alloc(&cache, TEST_SIZE);
+		if (blocks[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > DEPTH, "heap too small for the test");
+
+	for (int i = 0; i < n; i++) {
+		sys_heap_cache_free(&cache, blocks[i]);
+	}
+
+	/* A request bigger than the free heap memory is only satisfied
+	 * once the cached blocks are returned to the heap.
+	 */
+	stats = stats_get();
+	zassert_true(stats.cached_bytes > 0, "no block cached");
+	bytes = stats.heap.free_bytes + stats.cached_bytes / 2;
+
+	big = sys_heap_cache_alloc(&cache, bytes);
+	zassert_not_null(big, "cached blocks kept the heap exhausted");
+	zassert_equal(stats_get().cached_bytes, 0, "magazines not flushed");
+	sys_heap_cache_free(&cache, big);
+	zassert_true(sys_heap_validate(&heap), "heap invalid");
+
+	k_sched_unlock();
+}
+
+static void heap_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	sys_heap_init(&heap, heapmem, HEAP_SZ);
+	sys_heap_cache_init(&cache, &heap, &heap_lock);
+}
+
+ZTEST_SUITE(heap_cache, NULL, NULL, heap_cache_before, NULL, NULL);
@@ -770,4 +770,240 @@ ZTEST(lib_json_test, test_large_descriptor)
 	zassert_true(ret & ((int64_t)1 << 39), "Field int39 not decoded");
 }
 
+struct stream_log {
+	char text[512];
+	size_t len;
+	bool in_token;
+};
+
+static void stream_log_append(struct stream_log *log, const char *str, size_t len)
+{
+	zassert_true(log->len + len < sizeof(log->text), "Token log overflow");
+
+	memcpy(log->text + log->len, str, len);
+	log->len += len;
+	log->text[log->len] = '\0';
+}
+
+static int stream_log_cb(const struct json_stream_token *tok, void *user_data)
+{
+	struct stream_log *log = user_data;
+	char prefix[8];
+
+	if (!log->in_token) {
+		/* Chunks of a partial string are logged as a single token */
+		snprintk(prefix, sizeof(prefix), "%c%u%s:", tok->type, tok->depth,
+			 tok->key ? "k" : "");
+		stream_log_append(log, prefix, strlen(prefix));
+	}
+
+	if (tok->len > 0) {
+		stream_log_append(log, tok->start, tok->len);
+	}
+
+	log->in_token = tok->partial;
+	if (!tok->partial) {
+		stream_log_append(log, "|", 1);
+	}
+
+	return 0;
+}
+
+static int stream_parse_fragments(const char *json, size_t len, size_t frag_len,
+				  char *buf, size_t buf_size,
+				  struct stream_log *log)
+{
+	struct json_stream stream;
+	size_t n;
+	int ret;
+
+	memset(log, 0, sizeof(*log));
+	json_stream_init(&stream, buf, buf_size, stream_log_cb, log);
+
+	for (size_t off = 0; off < len; off += n) {
+		n = MIN(frag_len, len - off);
+
+		ret = json_stream_feed(&stream, json + off, n);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+
+	return json_stream_finish(&stream);
+}
+
+ZTEST(lib_json_test, test_json_stream_tokens)
+{
+	char encoded[] = "{\"some_string\":\"zephyr 123\\uABCD456\","
+		"\"some_int\":\t-42\n,"
+		"\"some_bool\":true,\"none\":null,"
+		"\"some_nested_struct\":{"
+		"\"nested_int\":1234,"
+		"\"nested_bool\":false,"
+		"\"nested_string\":\"escaped: \\t\\\"\"},"
+		"\"some_array\":[11,22, 33,\t4.5e3,[],{}]"
+		"}\n";
+	const char expected[] = "{0:|\"1k:some_string|\"1:zephyr 123\\uABCD456|"
+		"\"1k:some_int|01:-42|\"1k:some_bool|t1:true|\"1k:none|n1:null|"
+		"\"1k:some_nested_struct|{1:|\"2k:nested_int|02:1234|"
+		"\"2k:nested_bool|f2:false|\"2k:nested_string|"
+		"\"2:escaped: \\t\\\"|}1:|"
+		"\"1k:some_array|[1:|02:11|02:22|02:33|02:4.5e3|[2:|]2:|{2:|}2:|]1:|}0:|";
+	struct stream_log log;
+	char buf[32];
+	int ret;
+
+	ret = stream_parse_fragments(encoded, sizeof(encoded) - 1,
+				     sizeof(encoded), buf, sizeof(buf), &log);
+	zassert_equal(ret, 0, "Parsing failed");
+	zassert_true(!strcmp(log.text, expected), "Unexpected tokens: %s", log.text);
+
+	/* Every token may be split across fragments */
+	for (size_t frag_len = 1; frag_len < sizeof(encoded); frag_len++) {
+		ret = stream_parse_fragments(encoded, sizeof(encoded) - 1,
+					     frag_len, buf, sizeof(buf), &log);
+		zassert_equal(ret, 0, "Parsing failed with %zu bytes fragments",
+			      frag_len);
+		zassert_true(!strcmp(log.text, expected),
+			     "Unexpected tokens with %zu bytes fragments: %s",
+			     frag_len, log.text);
+	}
+
+	/* Strings longer than the token buffer are reported in chunks */
+	ret = stream_parse_fragments(encoded, sizeof(encoded) - 1, 3, buf, 5,
+				     &log);
+	zassert_equal(ret, 0, "Parsing failed with a small token buffer");
+	zassert_true(!strcmp(log.text, expected), "Unexpected tokens: %s", log.text);
+
+	/* While numbers must fit in it */
+	ret = stream_parse_fragments("[123456]", 8, 1, buf, 4, &log);
+	zassert_equal(ret, -ENOMEM, "Long number not rejected");
+
+	/* Without a token buffer, no token may span fragments */
+	ret = stream_parse_fragments("[\"abc\"]", 7, 7, buf, 0, &log);
+	zassert_equal(ret, 0, "Parsing failed without a token buffer");
+	ret = stream_parse_fragments("[\"abc\"]", 7, 3, buf, 0, &log);
+	zassert_equal(ret, -ENOMEM, "Split string not rejected");
+
+	/* Top-level values other than containers end with the input */
+	ret = stream_parse_fragments("-17", 3, 1, buf, sizeof(buf), &log);
+	zassert_equal(ret, 0, "Top-level number not parsed");
+	zassert_true(!strcmp(log.text, "00:-17|"), "Unexpected tokens: %s", log.text);
+}
+
+static int stream_abort_cb(const struct json_stream_token *tok, void *user_data)
+{
+	return tok->type == JSON_TOK_NUMBER ? -ECANCELED : 0;
+}
+
+ZTEST(lib_json_test, test_json_stream_invalid)
+{
+	const char *const invalid[] = {
+		"{\"a\":1,}", "[1 2]", "{\"a\" 1}", "{1:2}", "[1}", "{\"a\":1]",
+		"}", "[1]]", "[1] 2", "[tru]", "[nul]", "\"\\x\"", "\"\\u12G4\"",
+		"[\"a\":1]", "{\"a\":}",
+	};
+	const char *const incomplete[] = {
+		"", "[", "{\"a\"", "{\"a\":", "[1,", "\"abc", "[tr",
+	};
+	struct json_stream stream;
+	struct stream_log log;
+	char buf[16];
+	int ret;
+
+	for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+		ret = stream_parse_fragments(invalid[i], strlen(invalid[i]), 2,
+					     buf, sizeof(buf), &log);
+		zassert_equal(ret, -EINVAL, "Invalid value accepted: %s", invalid[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(incomplete); i++) {
+		ret = stream_parse_fragments(incomplete[i], strlen(incomplete[i]),
+					     2, buf, sizeof(buf), &log);
+		zassert_equal(ret, -EINVAL, "Incomplete value accepted: %s",
+			      incomplete[i]);
+	}
+
+	/* Errors returned by the callback stop the parsing */
+	json_stream_init(&stream, buf, sizeof(buf), stream_abort_cb, NULL);
+	zassert_equal(json_stream_feed(&stream, "[\"a\",1,", 7), -ECANCELED,
+		      "Callback error not propagated");
+	zassert_equal(json_stream_feed(&stream, "2]", 2), -EINVAL,
+		      "Parsing continued after an error");
+}
+
+static void encoder_check_chunks(struct json_encoder *enc, size_t chunk_len,
+				 const char *expected)
+{
+	char encoded[1024];
+	size_t len = 0;
+	ssize_t ret;
+
+	do {
+		zassert_true(len + chunk_len <= sizeof(encoded), "Output too long");
+
+		ret = json_encoder_write(enc, encoded + len, chunk_len);
+		zassert_true(ret >= 0, "Encoding failed");
+		zassert_true(ret <= chunk_len, "Chunk too long");
+		len += ret;
+	} while (ret > 0);
+
+	zassert_equal(len, strlen(expected), "Encoded length mismatch with %zu bytes chunks",
+		      chunk_len);
+	zassert_equal(memcmp(encoded, expected, len), 0,
+		      "Encoded contents not consistent with %zu bytes chunks", chunk_len);
+}
+
+ZTEST(lib_json_test, test_json_encoder_chunks)
+{
+	struct test_struct ts = {
+		.some_string = "\"quoted\"\n",
+		.some_int = INT32_MIN,
+		.some_bool = true,
+		.some_nested_struct = {
+			.nested_int = -1234,
+			.nested_string = "this should be escaped: \t"
+		},
+		.some_array = { 1, 4, 8, 16, 32 },
+		.some_array_len = 5,
+		.another_array_len = 0,
+		.xnother_nexx = {
+			.nested_int = 1234,
+			.nested_bool = true,
+			.nested_string = "",
+		},
+	};
+	struct obj_array oa = {
+		.elements = {
+			{ .name = "Sim\303\263n Bol\303\255var", .height = 168 },
+			{ .name = "Pel\303\251", .height = 173 },
+		},
+		.num_elements = 2,
+	};
+	struct json_encoder enc;
+	char expected[512];
+	int ret;
+
+	ret = json_obj_encode_buf(test_descr, ARRAY_SIZE(test_descr), &ts,
+				  expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding function failed");
+
+	for (size_t chunk_len = 1; chunk_len <= strlen(expected); chunk_len++) {
+		json_obj_encoder_init(&enc, test_descr, ARRAY_SIZE(test_descr), &ts);
+		encoder_check_chunks(&enc, chunk_len, expected);
+	}
+
+	ret = json_arr_encode_buf(obj_array_descr, &oa, expected, sizeof(expected));
+	zassert_equal(ret, 0, "Encoding function failed");
+
+	for (size_t chunk_len = 1; chunk_len <= strlen(expected); chunk_len++) {
+		json_arr_encoder_init(&enc, obj_array_descr, &oa);
+		encoder_check_chunks(&enc, chunk_len, expected);
+	}
+
+	json_obj_encoder_init(&enc, test_descr, ARRAY_SIZE(test_descr), &ts);
+	zassert_equal(json_encoder_write(&enc, expected, 0), -EINVAL,
+		      "Empty buffer accepted");
+}
+
 ZTEST_SUITE(lib_json_test, NULL, NULL, NULL, NULL, NULL);
@@ -24,6 +24,7 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_SOCKETS_LOG_LEVEL);
 
 #define MAX_CONNS 5
 
+#define TCP_CC_NAME_LEN 16
 #define TCP_TEARDOWN_TIMEOUT K_SECONDS(3)
 #define THREAD_SLEEP 50 /* ms */
 
@@ -335,7 +336,7 @@ void tcp_server_block_thread(void *vps_sock, void *unused2, void *unused3)
 	test_close(new_sock);
 }
 
-void test_v4_send_recv_large_common(int tcp_nodelay)
+void test_v4_send_recv_large_common(int tcp_nodelay, const char *congestion)
 {
 	int rv;
 	int c_sock;
@@ -360,6 +361,12 @@ void test_v4_send_recv_large_common(int tcp_nodelay)
 	rv = setsockopt(c_sock, IPPROTO_TCP, TCP_NODELAY, (char *) &tcp_nodelay, sizeof(int));
 	zassert_equal(rv, 0, "setsockopt failed (%d)", rv);
 
+	if (congestion != NULL) {
+		rv = setsockopt(c_sock, IPPROTO_TCP, TCP_CONGESTION, congestion,
+				strlen(congestion));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+	}
+
 	/* send piece by piece */
 	ssize_t total_send = 0;
 	int iteration = 0;
@@ -416,20 +423,42 @@ static void restore_packet_loss_ratio(void)
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_normal)
 {
-	test_v4_send_recv_large_common(0);
+	test_v4_send_recv_large_common(0, NULL);
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss)
 {
 	set_packet_loss_ratio();
-	test_v4_send_recv_large_common(0);
+	test_v4_send_recv_large_common(0, NULL);
 	restore_packet_loss_ratio();
 }
 
 ZTEST(net_socket_tcp, test_v4_send_recv_large_no_delay)
 {
 	set_packet_loss_ratio();
-	test_v4_send_recv_large_common(1);
+	test_v4_send_recv_large_common(1, NULL);
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss_newreno)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		ztest_test_skip();
+	}
+
+	set_packet_loss_ratio();
+	test_v4_send_recv_large_common(0, "newreno");
+	restore_packet_loss_ratio();
+}
+
+ZTEST(net_socket_tcp, test_v4_send_recv_large_packet_loss_cubic)
+{
+	if (!IS_ENABLED(CONFIG_NET_TCP_CC_CUBIC)) {
+		ztest_test_skip();
+	}
+
+	set_packet_loss_ratio();
+	test_v4_send_recv_large_common(0, "cubic");
 	restore_packet_loss_ratio();
 }
 
@@ -1061,6 +1090,48 @@ ZTEST(net_socket_tcp, test_so_protocol)
 	test_context_cleanup();
 }
 
+ZTEST(net_socket_tcp, test_tcp_congestion)
+{
+	struct sockaddr_in bind_addr4;
+	char name[TCP_CC_NAME_LEN];
+	socklen_t optlen;
+	int sock, rv;
+
+	if (!IS_ENABLED(CONFIG_NET_TCP_CONGESTION_CONTROL)) {
+		ztest_test_skip();
+	}
+
+	prepare_sock_tcp_v4(MY_IPV4_ADDR, ANY_PORT, &sock, &bind_addr4);
+
+	optlen = sizeof(name);
+	rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(strcmp(name, IS_ENABLED(CONFIG_NET_TCP_CC_DEFAULT_CUBIC) ?
+				   "cubic" : "newreno"), 0,
+		      "unexpected default algorithm %s", name);
+
+	rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "nosuchcc",
+			sizeof("nosuchcc"));
+	zassert_equal(rv, -1, "setsockopt accepted unknown algorithm");
+	zassert_equal(errno, ENOENT, "unexpected errno %d", errno);
+
+	if (IS_ENABLED(CONFIG_NET_TCP_CC_CUBIC)) {
+		rv = setsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, "cubic",
+				sizeof("cubic"));
+		zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+		optlen = sizeof(name);
+		rv = getsockopt(sock, IPPROTO_TCP, TCP_CONGESTION, name, &optlen);
+		zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+		zassert_equal(strcmp(name, "cubic"), 0, "algorithm not changed");
+		zassert_equal(optlen, sizeof("cubic"), "invalid size");
+	}
+
+	test_close(sock);
+
+	test_context_cleanup();
+}
+
 ZTEST(net_socket_tcp, test_so_rcvbuf)
 {
 	struct sockaddr_in bind_addr4;
@@ -1294,4 +1294,345 @@ ZTEST(net_socket_udp, test_23_v6_dgram_overflow)
 			    BUF_AND_SIZE(test_str_all_tx_bufs));
 }
 
-ZTEST_SUITE(net_socket_udp, NULL, NULL, NULL, NULL, NULL);
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static K_SEM_DEFINE(zc_done, 0, 1);
+static const void *zc_done_buf;
+static size_t zc_done_len;
+
+static void zc_done_cb(const void *buf, size_t len, void *user_data)
+{
+	zc_done_buf = buf;
+	zc_done_len = len;
+	k_sem_give(&zc_done);
+}
+
+static void test_zerocopy(int sock_c, int sock_s,
+			  struct sockaddr *addr_c, socklen_t addrlen_c,
+			  struct sockaddr *addr_s, socklen_t addrlen_s)
+{
+	static const char payload[] = TEST_STR2;
+	struct sockaddr_storage src_addr;
+	socklen_t src_addrlen = sizeof(src_addr);
+	struct zsock_rx_loan loan;
+	struct net_buf *frag;
+	size_t offset;
+	size_t copied = 0;
+	ssize_t rv;
+
+	rv = bind(sock_s, addr_s, addrlen_s);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(sock_c, addr_c, addrlen_c);
+	zassert_equal(rv, 0, "client bind failed");
+
+	k_sem_reset(&zc_done);
+
+	rv = zsock_sendto_zc(sock_c, payload, STRLEN(payload), 0,
+			     addr_s, addrlen_s, zc_done_cb, NULL);
+	zassert_equal(rv, STRLEN(payload), "zero-copy send failed (%d)", errno);
+
+	zassert_ok(k_sem_take(&zc_done, K_MSEC(500)), "no TX completion");
+	zassert_equal_ptr(zc_done_buf, payload, "wrong buffer completed");
+	zassert_equal(zc_done_len, STRLEN(payload), "wrong length completed");
+
+	rv = zsock_recv_loan(sock_s, &loan, 0, (struct sockaddr *)&src_addr,
+			     &src_addrlen);
+	zassert_equal(rv, STRLEN(payload), "loan failed (%d)", errno);
+	zassert_equal(loan.len, STRLEN(payload), "wrong loan length");
+	zassert_equal(src_addrlen, addrlen_c, "wrong source address length");
+	zassert_equal(src_addr.ss_family, addr_c->sa_family,
+		      "wrong source address family");
+	zassert_not_null(loan.frags, "no fragments lent");
+
+	memset(rx_buf, 0, sizeof(rx_buf));
+
+	for (frag = loan.frags, offset = loan.offset;
+	     frag && copied < loan.len; frag = frag->frags, offset = 0) {
+		size_t len = MIN(frag->len - offset, loan.len - copied);
+
+		memcpy(rx_buf + copied, frag->data + offset, len);
+		copied += len;
+	}
+
+	zassert_equal(copied, STRLEN(payload), "fragments too short");
+	zassert_mem_equal(rx_buf, payload, copied, "wrong data");
+
+	zsock_recv_loan_return(&loan);
+	zassert_is_null(loan.frags, "loan not cleared");
+
+	rv = zsock_recv_loan(sock_s, &loan, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "loan without data succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = zsock_recv_loan(sock_s, NULL, ZSOCK_MSG_DONTWAIT, NULL, NULL);
+	zassert_equal(rv, -1, "loan into NULL succeeded");
+	zassert_equal(errno, EINVAL, "incorrect errno value");
+
+	rv = close(sock_c);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock_s);
+	zassert_equal(rv, 0, "close failed");
+}
+#endif /* CONFIG_NET_SOCKETS_ZEROCOPY */
+
+ZTEST(net_socket_udp, test_24_v4_zerocopy)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	test_zerocopy(client_sock, server_sock,
+		      (struct sockaddr *)&client_addr, sizeof(client_addr),
+		      (struct sockaddr *)&server_addr, sizeof(server_addr));
+#else
+	ztest_test_skip();
+#endif
+}
+
+ZTEST(net_socket_udp, test_25_v6_zerocopy)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(MY_IPV6_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v6(MY_IPV6_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	test_zerocopy(client_sock, server_sock,
+		      (struct sockaddr *)&client_addr, sizeof(client_addr),
+		      (struct sockaddr *)&server_addr, sizeof(server_addr));
+#else
+	ztest_test_skip();
+#endif
+}
+
+#define MMSG_COUNT 3
+
+ZTEST_USER(net_socket_udp, test_26_v4_sendmmsg_recvmmsg)
+{
+	static const char * const payload[MMSG_COUNT] = {
+		"first", "second datagram", "third"
+	};
+	char recv_buf[MMSG_COUNT][32];
+	struct sockaddr_in src_addr[MMSG_COUNT];
+	struct iovec send_iov[MMSG_COUNT];
+	struct iovec recv_iov[MMSG_COUNT];
+	struct mmsghdr send_msg[MMSG_COUNT];
+	struct mmsghdr recv_msg[MMSG_COUNT];
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	int rv;
+	int i;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	memset(send_msg, 0, sizeof(send_msg));
+	memset(recv_msg, 0, sizeof(recv_msg));
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		send_iov[i].iov_base = (void *)payload[i];
+		send_iov[i].iov_len = strlen(payload[i]);
+		send_msg[i].msg_hdr.msg_name = &server_addr;
+		send_msg[i].msg_hdr.msg_namelen = sizeof(server_addr);
+		send_msg[i].msg_hdr.msg_iov = &send_iov[i];
+		send_msg[i].msg_hdr.msg_iovlen = 1;
+
+		recv_iov[i].iov_base = recv_buf[i];
+		recv_iov[i].iov_len = sizeof(recv_buf[i]);
+		recv_msg[i].msg_hdr.msg_name = &src_addr[i];
+		recv_msg[i].msg_hdr.msg_namelen = sizeof(src_addr[i]);
+		recv_msg[i].msg_hdr.msg_iov = &recv_iov[i];
+		recv_msg[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	rv = sendmmsg(client_sock, send_msg, MMSG_COUNT, 0);
+	zassert_equal(rv, MMSG_COUNT, "sendmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(send_msg[i].msg_len, strlen(payload[i]),
+			      "wrong sent length");
+	}
+
+	/* Let all of them arrive, only the first one is waited for */
+	k_msleep(100);
+
+	rv = recvmmsg(server_sock, recv_msg, MMSG_COUNT, MSG_WAITFORONE);
+	zassert_equal(rv, MMSG_COUNT, "recvmmsg failed (%d)", errno);
+
+	for (i = 0; i < MMSG_COUNT; i++) {
+		zassert_equal(recv_msg[i].msg_len, strlen(payload[i]),
+			      "wrong received length");
+		zassert_mem_equal(recv_buf[i], payload[i], strlen(payload[i]),
+				  "wrong data");
+		zassert_equal(recv_msg[i].msg_hdr.msg_namelen,
+			      sizeof(struct sockaddr_in), "wrong address length");
+		zassert_equal(src_addr[i].sin_family, AF_INET,
+			      "wrong address family");
+		zassert_equal(recv_msg[i].msg_hdr.msg_flags, 0, "unexpected flags");
+	}
+
+	/* Nothing left */
+	rv = recvmmsg(server_sock, recv_msg, MMSG_COUNT, MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recvmmsg without data succeeded");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	/* Truncation is reported per message */
+	recv_iov[0].iov_len = 2;
+
+	rv = sendmmsg(client_sock, send_msg, 1, 0);
+	zassert_equal(rv, 1, "sendmmsg failed (%d)", errno);
+
+	rv = recvmmsg(server_sock, recv_msg, 1, 0);
+	zassert_equal(rv, 1, "recvmmsg failed (%d)", errno);
+	zassert_equal(recv_msg[0].msg_len, 2, "wrong received length");
+	zassert_equal(recv_msg[0].msg_hdr.msg_flags, MSG_TRUNC,
+		      "truncation not reported");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+}
+
+ZTEST(net_socket_udp, test_27_v4_udp_segment)
+{
+#if defined(CONFIG_NET_UDP_GSO)
+	static const char payload[] = TEST_STR2;
+	const int segment = 64;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	int client_sock;
+	int server_sock;
+	size_t received = 0;
+	int optval;
+	socklen_t optlen = sizeof(optval);
+	int rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	rv = setsockopt(client_sock, IPPROTO_UDP, UDP_SEGMENT, &segment,
+			sizeof(segment));
+	zassert_equal(rv, 0, "setsockopt failed (%d)", errno);
+
+	rv = getsockopt(client_sock, IPPROTO_UDP, UDP_SEGMENT, &optval, &optlen);
+	zassert_equal(rv, 0, "getsockopt failed (%d)", errno);
+	zassert_equal(optval, segment, "wrong segment size");
+
+	rv = sendto(client_sock, payload, STRLEN(payload), 0,
+		    (struct sockaddr *)&server_addr, sizeof(server_addr));
+	zassert_equal(rv, STRLEN(payload), "sendto failed (%d)", errno);
+
+	/* Every datagram carries one segment, the last one the rest */
+	while (received < STRLEN(payload)) {
+		size_t expected = MIN(segment, STRLEN(payload) - received);
+
+		rv = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+		zassert_equal(rv, expected, "wrong datagram size (%d)", rv);
+		zassert_mem_equal(rx_buf, payload + received, expected,
+				  "wrong data");
+
+		received += rv;
+	}
+
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), MSG_DONTWAIT);
+	zassert_equal(rv, -1, "unexpected datagram");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+static struct k_poll_signal zc_signal;
+#endif
+
+ZTEST_USER(net_socket_udp, test_28_v4_zerocopy_signal)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	static const char payload[] = TEST_STR2;
+	struct k_poll_event event = K_POLL_EVENT_INITIALIZER(
+		K_POLL_TYPE_SIGNAL, K_POLL_MODE_NOTIFY_ONLY, &zc_signal);
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+	struct zsock_rx_loan loan;
+	unsigned int signaled;
+	int client_sock;
+	int server_sock;
+	int result;
+	ssize_t rv;
+
+	prepare_sock_udp_v4(MY_IPV4_ADDR, ANY_PORT, &client_sock, &client_addr);
+	prepare_sock_udp_v4(MY_IPV4_ADDR, SERVER_PORT, &server_sock, &server_addr);
+
+	rv = bind(server_sock, (struct sockaddr *)&server_addr,
+		  sizeof(server_addr));
+	zassert_equal(rv, 0, "bind failed");
+
+	k_poll_signal_reset(&zc_signal);
+
+	rv = zsock_sendto_zc_signal(client_sock, payload, STRLEN(payload), 0,
+				    (struct sockaddr *)&server_addr,
+				    sizeof(server_addr), &zc_signal);
+	zassert_equal(rv, STRLEN(payload), "zero-copy send failed (%d)", errno);
+
+	zassert_ok(k_poll(&event, 1, K_MSEC(500)), "no TX completion");
+	k_poll_signal_check(&zc_signal, &signaled, &result);
+	zassert_true(signaled, "signal not raised");
+	zassert_equal(result, 0, "wrong signal result");
+
+	rv = recv(server_sock, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, STRLEN(payload), "recv failed (%d)", errno);
+	zassert_mem_equal(rx_buf, payload, rv, "wrong data");
+
+	if (k_is_user_context()) {
+		/* Buffer loans remain for supervisor threads only */
+		rv = zsock_recv_loan(server_sock, &loan, ZSOCK_MSG_DONTWAIT,
+				     NULL, NULL);
+		zassert_equal(rv, -1, "loan from user mode succeeded");
+		zassert_equal(errno, EPERM, "incorrect errno value");
+	}
+
+	rv = close(client_sock);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(server_sock);
+	zassert_equal(rv, 0, "close failed");
+#else
+	ztest_test_skip();
+#endif
+}
+
+static void *udp_tests_setup(void)
+{
+#if defined(CONFIG_NET_SOCKETS_ZEROCOPY)
+	k_poll_signal_init(&zc_signal);
+	k_object_access_grant(&zc_signal, k_current_get());
+#endif
+
+	return NULL;
+}
+
+ZTEST_SUITE(net_socket_udp, NULL, udp_tests_setup, NULL, NULL, NULL);
@@ -1070,3 +1070,234 @@ static void run_after(void *dummy)
 }
 
 ZTEST_SUITE(net_traffic_class, NULL, NULL, run_before, run_after, NULL);
+
+#if NET_TC_RX_QUEUES > 1 && defined(CONFIG_NET_STATISTICS)
+#include "net_stats.h"
+
+#define FLOW_PORT 4242
+#define FLOW_SRC_PORT 5000
+#define FLOW_COUNT 8
+#define FLOW_PKTS 4
+#define FLOW_SPREAD_COUNT 32
+
+static struct net_context *flow_ctx;
+static struct k_sem flow_recv;
+static uint8_t flow_next_seq[FLOW_SPREAD_COUNT];
+static k_tid_t flow_thread[FLOW_SPREAD_COUNT];
+static bool flow_failed;
+
+static void flow_recv_cb(struct net_context *context,
+			 struct net_pkt *pkt,
+			 union net_ip_header *ip_hdr,
+			 union net_proto_header *proto_hdr,
+			 int status,
+			 void *user_data)
+{
+	int flow = ntohs(proto_hdr->udp->src_port) - FLOW_SRC_PORT;
+	uint8_t seq;
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+
+	if (flow < 0 || flow >= FLOW_SPREAD_COUNT ||
+	    net_pkt_skip(pkt, NET_IPV6UDPH_LEN) ||
+	    net_pkt_read_u8(pkt, &seq)) {
+		flow_failed = true;
+		goto out;
+	}
+
+	/* Packets of a flow are all handled by the thread of one queue, in
+	 * the order they were received.
+	 */
+	if (flow_thread[flow] == NULL) {
+		flow_thread[flow] = k_current_get();
+	} else if (flow_thread[flow] != k_current_get()) {
+		DBG("Flow %d seq %u on another thread\n", flow, seq);
+		flow_failed = true;
+	}
+
+	if (seq != flow_next_seq[flow]) {
+		DBG("Flow %d seq %u, expecting %u\n", flow, seq,
+		    flow_next_seq[flow]);
+		flow_failed = true;
+	}
+
+	flow_next_seq[flow] = seq + 1;
+
+out:
+	k_sem_give(&flow_recv);
+	net_pkt_unref(pkt);
+}
+
+/* UDP packet to FLOW_PORT with one byte of payload, from a source address
+ * and port of its own for each flow.
+ */
+static struct net_pkt *flow_pkt_create(struct net_if *iface, int flow,
+				       uint8_t seq)
+{
+	struct net_ipv6_hdr ipv6 = {
+		.vtc = 0x60,
+		.len = htons(NET_UDPH_LEN + sizeof(seq)),
+		.nexthdr = IPPROTO_UDP,
+		.hop_limit = 64,
+	};
+	struct net_udp_hdr udp = {
+		.src_port = htons(FLOW_SRC_PORT + flow),
+		.dst_port = htons(FLOW_PORT),
+		.len = htons(NET_UDPH_LEN + sizeof(seq)),
+	};
+	struct net_pkt *pkt;
+
+	net_ipv6_addr_copy_raw(ipv6.src, (uint8_t *)&dst_addr);
+	ipv6.src[15] = flow + 1;
+	net_ipv6_addr_copy_raw(ipv6.dst, (uint8_t *)&my_addr1);
+
+	pkt = net_pkt_rx_alloc_with_buffer(iface, NET_IPV6UDPH_LEN + sizeof(seq),
+					   AF_INET6, IPPROTO_UDP, K_NO_WAIT);
+	zassert_not_null(pkt, "Cannot allocate pkt");
+
+	net_pkt_set_priority(pkt, NET_PRIORITY_BE);
+
+	zassert_ok(net_pkt_write(pkt, &ipv6, sizeof(ipv6)));
+	zassert_ok(net_pkt_write(pkt, &udp, sizeof(udp)));
+	zassert_ok(net_pkt_write_u8(pkt, seq));
+
+	net_pkt_set_ip_hdr_len(pkt, sizeof(ipv6));
+	net_pkt_set_ipv6_ext_len(pkt, 0);
+	udp.chksum = net_calc_chksum_udp(pkt);
+
+	net_pkt_cursor_init(pkt);
+	net_pkt_set_overwrite(pkt, true);
+	net_pkt_skip(pkt, sizeof(ipv6) + offsetof(struct net_udp_hdr, chksum));
+	zassert_ok(net_pkt_write(pkt, &udp.chksum, sizeof(udp.chksum)));
+
+	return pkt;
+}
+
+/* Receive a packet of the flow, returning the RX queue it was steered to */
+static int flow_pkt_recv(int flow, uint8_t seq)
+{
+	struct net_if *iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	net_stats_t pkts[ARRAY_SIZE(net_stats.rxq)];
+	int queue = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = net_stats.rxq[i].pkts;
+	}
+
+	zassert_ok(net_recv_data(iface, flow_pkt_create(iface, flow, seq)));
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		if (net_stats.rxq[i].pkts != pkts[i]) {
+			zassert_equal(queue, -1, "Flow %d on several queues", flow);
+			queue = i;
+		}
+	}
+
+	zassert_not_equal(queue, -1, "Flow %d not steered", flow);
+
+	return queue;
+}
+
+static void flow_wait(int count)
+{
+	for (int i = 0; i < count; i++) {
+		zassert_ok(k_sem_take(&flow_recv, WAIT_TIME),
+			   "%d packets out of %d received", i, count);
+	}
+
+	zassert_false(flow_failed, "Flow verification failed");
+}
+
+ZTEST(net_traffic_class_rx_flow, test_flow_order)
+{
+	int queue[FLOW_COUNT];
+	int q;
+
+	/* Interleave the packets of the flows, as they would come in */
+	for (int seq = 0; seq < FLOW_PKTS; seq++) {
+		for (int flow = 0; flow < FLOW_COUNT; flow++) {
+			q = flow_pkt_recv(flow, seq);
+
+			if (seq == 0) {
+				queue[flow] = q;
+			} else {
+				zassert_equal(q, queue[flow],
+					      "Flow %d seq %d on queue %d, not %d",
+					      flow, seq, q, queue[flow]);
+			}
+		}
+	}
+
+	flow_wait(FLOW_COUNT * FLOW_PKTS);
+
+	for (int flow = 0; flow < FLOW_COUNT; flow++) {
+		zassert_equal(flow_next_seq[flow], FLOW_PKTS,
+			      "Flow %d: %u packets", flow, flow_next_seq[flow]);
+	}
+}
+
+ZTEST(net_traffic_class_rx_flow, test_flow_spread)
+{
+	int per_queue[ARRAY_SIZE(net_stats.rxq)] = { 0 };
+	int first, last;
+
+	for (int flow = 0; flow < FLOW_SPREAD_COUNT; flow++) {
+		per_queue[flow_pkt_recv(flow, 0)]++;
+	}
+
+	flow_wait(FLOW_SPREAD_COUNT);
+
+	/* All the queues of the class got some of the flows */
+	first = net_rx_priority2tc(NET_PRIORITY_BE) * NET_TC_RX_QUEUES;
+	last = first + NET_TC_RX_QUEUES - 1;
+
+	for (int i = 0; i < ARRAY_SIZE(per_queue); i++) {
+		if (i >= first && i <= last) {
+			zassert_true(per_queue[i] > 0, "No flow on queue %d", i);
+		} else {
+			zassert_equal(per_queue[i], 0, "Flow on queue %d", i);
+		}
+	}
+}
+
+static void *rx_flow_setup(void)
+{
+	struct sockaddr_in6 addr6 = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(FLOW_PORT),
+	};
+
+	address_setup();
+
+	k_sem_init(&flow_recv, 0, UINT_MAX);
+
+	zassert_ok(net_context_get(AF_INET6, SOCK_DGRAM, IPPROTO_UDP, &flow_ctx));
+
+	memcpy(&addr6.sin6_addr, &my_addr1, sizeof(struct in6_addr));
+	zassert_ok(net_context_bind(flow_ctx, (struct sockaddr *)&addr6,
+				    sizeof(addr6)));
+	zassert_ok(net_context_recv(flow_ctx, flow_recv_cb, K_NO_WAIT, NULL));
+
+	return NULL;
+}
+
+static void rx_flow_before(void *dummy)
+{
+	ARG_UNUSED(dummy);
+
+	(void)memset(flow_next_seq, 0, sizeof(flow_next_seq));
+	(void)memset(flow_thread, 0, sizeof(flow_thread));
+	flow_failed = false;
+}
+
+static void rx_flow_teardown(void *dummy)
+{
+	ARG_UNUSED(dummy);
+
+	net_context_unref(flow_ctx);
+}
+
+ZTEST_SUITE(net_traffic_class_rx_flow, NULL, rx_flow_setup, rx_flow_before,
+	    NULL, rx_flow_teardown);
+#endif /* NET_TC_RX_QUEUES > 1 && CONFIG_NET_STATISTICS */
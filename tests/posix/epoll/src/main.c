@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/ztest.h>
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+static K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+static struct k_thread writer_thread;
+
+struct epoll_fixture {
+	int epfd;
+	int efd;
+};
+
+static void *epoll_setup(void)
+{
+	static struct epoll_fixture fixture;
+
+	return &fixture;
+}
+
+static void epoll_before(void *f)
+{
+	struct epoll_fixture *fixture = f;
+
+	fixture->epfd = epoll_create1(0);
+	zassert_true(fixture->epfd >= 0, "epoll_create1 failed %d", errno);
+
+	fixture->efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(fixture->efd >= 0, "eventfd failed %d", errno);
+}
+
+static void epoll_after(void *f)
+{
+	struct epoll_fixture *fixture = f;
+
+	close(fixture->efd);
+	close(fixture->epfd);
+}
+
+ZTEST_SUITE(test_epoll, NULL, epoll_setup, epoll_before, epoll_after, NULL);
+
+static void epoll_add(struct epoll_fixture *fixture, uint32_t events)
+{
+	struct epoll_event ev = {
+		.events = events,
+		.data.fd = fixture->efd,
+	};
+	int ret;
+
+	ret = epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->efd, &ev);
+	zassert_equal(ret, 0, "epoll_ctl failed %d", errno);
+}
+
+ZTEST_F(test_epoll, test_epoll_ctl_errors)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+
+	zassert_equal(epoll_create1(1), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_create(0), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->efd, &ev), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->efd, NULL), -1);
+	zassert_equal(errno, ENOENT);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	zassert_equal(epoll_ctl(fixture->efd, EPOLL_CTL_ADD, fixture->epfd, &ev), -1);
+	zassert_equal(errno, EINVAL);
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_ADD, fixture->efd, &ev), -1);
+	zassert_equal(errno, EEXIST);
+
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->efd, NULL), 0);
+}
+
+ZTEST_F(test_epoll, test_epoll_level_triggered)
+{
+	struct epoll_event ev;
+	eventfd_t val;
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+
+	/* Reported for as long as the eventfd stays readable */
+	for (int i = 0; i < 2; i++) {
+		zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+		zassert_equal(ev.events, EPOLLIN);
+		zassert_equal(ev.data.fd, fixture->efd);
+	}
+
+	zassert_equal(eventfd_read(fixture->efd, &val), 0);
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+}
+
+ZTEST_F(test_epoll, test_epoll_edge_triggered)
+{
+	struct epoll_event ev;
+
+	epoll_add(fixture, EPOLLIN | EPOLLET);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+	zassert_equal(ev.events, EPOLLIN);
+
+	/* Still readable, but nothing changed since */
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+}
+
+ZTEST_F(test_epoll, test_epoll_oneshot)
+{
+	struct epoll_event ev = {
+		.events = EPOLLIN | EPOLLONESHOT,
+		.data.u32 = 42,
+	};
+
+	epoll_add(fixture, ev.events);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+
+	/* Rearm */
+	ev.events = EPOLLIN | EPOLLONESHOT;
+	ev.data.u32 = 42;
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_MOD, fixture->efd, &ev), 0);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+	zassert_equal(ev.data.u32, 42);
+}
+
+ZTEST_F(test_epoll, test_epoll_out)
+{
+	struct epoll_event ev;
+
+	epoll_add(fixture, EPOLLOUT);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 1);
+	zassert_equal(ev.events, EPOLLOUT);
+}
+
+ZTEST_F(test_epoll, test_epoll_del)
+{
+	struct epoll_event ev;
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+	zassert_equal(epoll_ctl(fixture->epfd, EPOLL_CTL_DEL, fixture->efd, NULL), 0);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+}
+
+ZTEST_F(test_epoll, test_epoll_closed_fd)
+{
+	struct epoll_event ev;
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+	close(fixture->efd);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 0), 0);
+
+	/* Reopen so that the fixture teardown has something to close */
+	fixture->efd = eventfd(0, EFD_NONBLOCK);
+	zassert_true(fixture->efd >= 0, "eventfd failed %d", errno);
+
+	/* The stale entry must not block a new registration */
+	epoll_add(fixture, EPOLLIN);
+}
+
+ZTEST_F(test_epoll, test_epoll_timeout)
+{
+	struct epoll_event ev;
+	int64_t start = k_uptime_get();
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, 100), 0);
+	zassert_true(k_uptime_get() - start >= 100, "returned too early");
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	int efd = POINTER_TO_INT(p1);
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_msleep(50);
+	(void)eventfd_write(efd, 1);
+}
+
+ZTEST_F(test_epoll, test_epoll_wakeup)
+{
+	struct epoll_event ev;
+
+	epoll_add(fixture, EPOLLIN);
+
+	k_thread_create(&writer_thread, writer_stack, K_THREAD_STACK_SIZEOF(writer_stack),
+			writer, INT_TO_POINTER(fixture->efd), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+
+	zassert_equal(epoll_wait(fixture->epfd, &ev, 1, -1), 1);
+	zassert_equal(ev.events, EPOLLIN);
+
+	k_thread_join(&writer_thread, K_FOREVER);
+}
+
+ZTEST_F(test_epoll, test_epoll_poll)
+{
+	struct pollfd pfd = {
+		.fd = fixture->epfd,
+		.events = POLLIN,
+	};
+
+	epoll_add(fixture, EPOLLIN);
+
+	zassert_equal(poll(&pfd, 1, 0), 0);
+
+	zassert_equal(eventfd_write(fixture->efd, 1), 0);
+
+	zassert_equal(poll(&pfd, 1, 0), 1);
+	zassert_equal(pfd.revents, POLLIN);
+}
@@ -869,3 +869,177 @@ ZTEST_F(nvs, test_nvs_cache_gc)
 	zassert_equal(num, 2, "invalid cache content after gc");
 #endif
 }
+
+/*
+ * Test that NVS RAM index is properly rebuilt on nvs_mount() and that IDs
+ * which do not fit in the index can still be read.
+ */
+ZTEST_F(nvs, test_nvs_ram_index)
+{
+#ifdef CONFIG_NVS_RAM_INDEX
+	int err;
+	uint16_t id;
+	uint16_t data;
+	uint32_t ate_addr;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.index_cnt, 0, "index not empty");
+	zassert_true(fixture->fs.index_complete, "index not complete");
+
+	/* Test index update after nvs_write() */
+
+	ate_addr = fixture->fs.ate_wra;
+	data = 1;
+	err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+
+	zassert_equal(fixture->fs.index_cnt, 1, "index not updated after write");
+	zassert_equal(fixture->fs.index[0].id, 1, "invalid index entry after write");
+	zassert_equal(fixture->fs.index[0].addr, ate_addr, "invalid index entry after write");
+
+	/* Test index initialization when the store is non-empty */
+
+	memset(fixture->fs.index, 0xAA, sizeof(fixture->fs.index));
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	zassert_equal(fixture->fs.index_cnt, 1, "invalid index after restart");
+	zassert_equal(fixture->fs.index[0].addr, ate_addr, "invalid index entry after restart");
+
+	err = nvs_read(&fixture->fs, 2, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read found a missing entry: %d", err);
+
+	/* Write more IDs than fit in the index, in reverse order */
+
+	for (id = CONFIG_NVS_RAM_INDEX_SIZE + 1; id > 0; id--) {
+		data = id;
+		err = nvs_write(&fixture->fs, id, &data, sizeof(data));
+		zassert_true(err >= 0, "nvs_write call failure: %d", err);
+	}
+
+	zassert_equal(fixture->fs.index_cnt, CONFIG_NVS_RAM_INDEX_SIZE, "index not full");
+	zassert_false(fixture->fs.index_complete, "overflowed index is complete");
+
+	for (id = 1; id <= CONFIG_NVS_RAM_INDEX_SIZE + 1; id++) {
+		err = nvs_read(&fixture->fs, id, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_read call failure: %d", err);
+		zassert_equal(data, id, "incorrect data read");
+	}
+
+	err = nvs_delete(&fixture->fs, 1);
+	zassert_equal(err, 0, "nvs_delete call failure: %d", err);
+	err = nvs_read(&fixture->fs, 1, &data, sizeof(data));
+	zassert_equal(err, -ENOENT, "nvs_read found a deleted entry: %d", err);
+#endif
+}
+
+/*
+ * Test that NVS RAM index does not contain any address from gc-ed sector
+ */
+ZTEST_F(nvs, test_nvs_ram_index_gc)
+{
+#ifdef CONFIG_NVS_RAM_INDEX
+	int err;
+	uint16_t data = 0;
+
+	fixture->fs.sector_count = 3;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* Fill the first sector with writes of ID 1 */
+
+	while (fixture->fs.data_wra + sizeof(data) <= fixture->fs.ate_wra) {
+		++data;
+		err = nvs_write(&fixture->fs, 1, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+	/* Fill the second sector with writes of ID 2 */
+
+	while ((fixture->fs.ate_wra >> ADDR_SECT_SHIFT) != 2) {
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* Let the gc of sector 0 finish */
+	while (fixture->fs.gc.active) {
+		if (IS_ENABLED(CONFIG_NVS_GC_WORK)) {
+			k_msleep(1);
+			continue;
+		}
+		++data;
+		err = nvs_write(&fixture->fs, 2, &data, sizeof(data));
+		zassert_equal(err, sizeof(data), "nvs_write call failure: %d", err);
+	}
+#endif
+
+	zassert_equal(fixture->fs.index_cnt, 2, "invalid index content after gc");
+	zassert_equal(fixture->fs.index[0].addr >> ADDR_SECT_SHIFT, 2,
+		      "index entry not moved by gc");
+	zassert_equal(fixture->fs.index[1].addr >> ADDR_SECT_SHIFT, 2,
+		      "invalid index entry after gc");
+#endif
+}
+
+/*
+ * Test that incremental gc keeps all entries readable while it is pending,
+ * is resumed by nvs_mount() when interrupted and finishes on later writes
+ * or from the work item.
+ */
+ZTEST_F(nvs, test_nvs_gc_incremental)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	uint16_t i = 0U;
+	const uint16_t max_id = 10;
+
+	fixture->fs.sector_count = 2;
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+
+	/* With two sectors the sector just closed is gc'ed, it holds the
+	 * latest data of all IDs.
+	 */
+	while (!fixture->fs.gc.active) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	zassert_true(i > max_id, "gc started too early");
+	zassert_true(fixture->fs.gc.pending > 0, "nothing left to move");
+	check_content(max_id, &fixture->fs);
+
+	/* Interrupt the gc */
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	zassert_false(fixture->fs.gc.active, "gc not resumed on mount");
+	check_content(max_id, &fixture->fs);
+
+	/* Start another gc and let it finish */
+	while (!fixture->fs.gc.active) {
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	while (fixture->fs.gc.active) {
+		if (IS_ENABLED(CONFIG_NVS_GC_WORK)) {
+			k_msleep(1);
+			continue;
+		}
+		write_content(max_id, i, i + 1, &fixture->fs);
+		i++;
+	}
+
+	zassert_equal(fixture->fs.gc.pending, 0, "gc finished with data left");
+	check_content(max_id, &fixture->fs);
+
+	err = nvs_mount(&fixture->fs);
+	zassert_true(err == 0, "nvs_mount call failure: %d", err);
+	check_content(max_id, &fixture->fs);
+#endif
+}
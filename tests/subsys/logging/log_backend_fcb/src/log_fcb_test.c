@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test flash circular buffer logger backend
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_backend_fcb.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME, LOG_LEVEL_DBG);
+
+#define MAX_RECORDS 64
+
+struct fetched {
+	uint32_t cnt;
+	uint32_t timestamp_ms[MAX_RECORDS];
+	uint8_t level[MAX_RECORDS];
+	char text[MAX_RECORDS][CONFIG_LOG_BACKEND_FCB_MAX_MSG_LEN + 1];
+	uint16_t boot;
+};
+
+static struct fetched fetched;
+
+static int collect(const struct log_backend_fcb_record *record, void *user_data)
+{
+	struct fetched *f = user_data;
+
+	if (f->cnt < MAX_RECORDS) {
+		f->timestamp_ms[f->cnt] = record->timestamp_ms;
+		f->level[f->cnt] = record->level;
+		memcpy(f->text[f->cnt], record->text, record->text_len);
+		f->text[f->cnt][record->text_len] = '\0';
+	}
+
+	f->boot = record->boot;
+	f->cnt++;
+
+	return 0;
+}
+
+static int fetch(uint32_t from_ms, uint32_t to_ms, uint8_t max_level)
+{
+	memset(&fetched, 0, sizeof(fetched));
+
+	return log_backend_fcb_fetch(log_backend_fcb_boot_get(), from_ms, to_ms,
+				     max_level, collect, &fetched);
+}
+
+static void process_all(void)
+{
+	while (log_process()) {
+	}
+}
+
+static void *log_fcb_setup(void)
+{
+	process_all();
+
+	return NULL;
+}
+
+static void log_fcb_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	process_all();
+	zassert_equal(log_backend_fcb_clear(), 0, "Failed to clear storage");
+}
+
+ZTEST(test_log_backend_fcb, test_fetch_all)
+{
+	char exp[16];
+
+	for (int i = 0; i < 10; i++) {
+		LOG_INF("msg %d", i);
+		process_all();
+	}
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 10, "Unexpected number of messages %u", fetched.cnt);
+	zassert_equal(fetched.boot, log_backend_fcb_boot_get());
+
+	for (int i = 0; i < 10; i++) {
+		snprintf(exp, sizeof(exp), "msg %d", i);
+		zassert_equal(strcmp(fetched.text[i], exp), 0,
+			      "Unexpected message \"%s\"", fetched.text[i]);
+		zassert_equal(fetched.level[i], LOG_LEVEL_INF);
+	}
+}
+
+ZTEST(test_log_backend_fcb, test_fetch_window)
+{
+	uint32_t ts[10];
+	uint32_t exp_cnt = 0;
+
+	for (int i = 0; i < 10; i++) {
+		LOG_WRN("window %d", i);
+		process_all();
+		k_msleep(20);
+	}
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 10);
+	memcpy(ts, fetched.timestamp_ms, sizeof(ts));
+
+	for (int i = 0; i < 10; i++) {
+		if ((ts[i] >= ts[3]) && (ts[i] <= ts[6])) {
+			exp_cnt++;
+		}
+	}
+
+	zassert_equal(fetch(ts[3], ts[6], LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, exp_cnt, "Unexpected number of messages %u", fetched.cnt);
+	zassert_equal(strcmp(fetched.text[0], "window 3"), 0);
+
+	zassert_equal(fetch(ts[9] + 1, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 0);
+
+	/* Other boots hold no messages. */
+	memset(&fetched, 0, sizeof(fetched));
+	zassert_equal(log_backend_fcb_fetch(log_backend_fcb_boot_get() + 1, 0, UINT32_MAX,
+					    LOG_LEVEL_DBG, collect, &fetched), 0);
+	zassert_equal(fetched.cnt, 0);
+}
+
+ZTEST(test_log_backend_fcb, test_fetch_level)
+{
+	LOG_ERR("error");
+	LOG_WRN("warning");
+	LOG_INF("info");
+	LOG_DBG("debug");
+	process_all();
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_WRN), 0);
+	zassert_equal(fetched.cnt, 2);
+	zassert_equal(fetched.level[0], LOG_LEVEL_ERR);
+	zassert_equal(fetched.level[1], LOG_LEVEL_WRN);
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 4);
+}
+
+ZTEST(test_log_backend_fcb, test_string_args)
+{
+	char buf[16];
+
+	/* Strings are copied when stored, not read back when fetched. */
+	strcpy(buf, "transient");
+	LOG_INF("%s %d %s", buf, 7, "const");
+	process_all();
+	strcpy(buf, "overwritten");
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 1);
+	zassert_equal(strcmp(fetched.text[0], "transient 7 const"), 0,
+		      "Unexpected message \"%s\"", fetched.text[0]);
+}
+
+ZTEST(test_log_backend_fcb, test_long_message)
+{
+	char buf[CONFIG_LOG_BACKEND_FCB_MAX_MSG_LEN + 1];
+
+	/* A package too long to be stored is kept formatted and truncated. */
+	memset(buf, 'x', sizeof(buf) - 1);
+	buf[sizeof(buf) - 1] = '\0';
+	LOG_INF("long %s", buf);
+	process_all();
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 1);
+	zassert_equal(strlen(fetched.text[0]), CONFIG_LOG_BACKEND_FCB_MAX_MSG_LEN);
+	zassert_equal(strncmp(fetched.text[0], "long xxx", 8), 0,
+		      "Unexpected message \"%s\"", fetched.text[0]);
+}
+
+ZTEST(test_log_backend_fcb, test_compression)
+{
+	struct log_backend_fcb_stats before, after;
+
+	Z_TEST_SKIP_IFNDEF(CONFIG_LOG_BACKEND_FCB_COMPRESSION);
+
+	log_backend_fcb_stats_get(&before);
+
+	for (int i = 0; i < 50; i++) {
+		LOG_INF("sensor reading %d within limits", i % 4);
+		process_all();
+	}
+
+	/* Fetching writes the pending block. */
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_equal(fetched.cnt, 50);
+
+	log_backend_fcb_stats_get(&after);
+	zassert_true(after.blocks > before.blocks);
+	zassert_true((after.stored_bytes - before.stored_bytes) * 2 <
+		     (after.raw_bytes - before.raw_bytes),
+		     "Poor compression: %u -> %u bytes",
+		     after.raw_bytes - before.raw_bytes,
+		     after.stored_bytes - before.stored_bytes);
+}
+
+ZTEST(test_log_backend_fcb, test_rotation)
+{
+	const int num = 4000;
+	char exp[32];
+
+	/* Hardly compressible messages, enough to wrap the partition. */
+	for (int i = 0; i < num; i++) {
+		LOG_INF("rot %d %08x", i, (uint32_t)(i * 2654435761U));
+		process_all();
+	}
+
+	zassert_equal(fetch(0, UINT32_MAX, LOG_LEVEL_DBG), 0);
+	zassert_true(fetched.cnt > 0);
+	zassert_true(fetched.cnt < num, "Storage did not wrap");
+
+	/* The oldest messages were erased, the newest ones are kept. */
+	snprintf(exp, sizeof(exp), "rot %d ", num - (int)fetched.cnt);
+	zassert_equal(strncmp(fetched.text[0], exp, strlen(exp)), 0,
+		      "Unexpected oldest message \"%s\"", fetched.text[0]);
+}
+
+ZTEST_SUITE(test_log_backend_fcb, NULL, log_fcb_setup, log_fcb_before, NULL, NULL);
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Log benchmark with all CPUs logging at the same time
+ *
+ */
+
+#include <zephyr/tc_util.h>
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_internal.h>
+#include <zephyr/logging/log.h>
+
+#define LOG_MODULE_NAME test
+LOG_MODULE_REGISTER(LOG_MODULE_NAME);
+
+#define NUM_THREADS CONFIG_MP_MAX_NUM_CPUS
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACK_SIZE)
+
+/* Fits in the buffer together with the messages of the other threads. */
+#define LOG_CALLS 64
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread threads[NUM_THREADS];
+static uint32_t cycles[NUM_THREADS];
+static atomic_t ready;
+static atomic_t go;
+static uint32_t total_drops;
+
+static void process(struct log_backend const *const backend,
+		    union log_msg_generic *msg)
+{
+}
+
+static void dropped(struct log_backend const *const backend, uint32_t cnt)
+{
+	total_drops += cnt;
+}
+
+const struct log_backend_api log_backend_test_api = {
+	.process = process,
+	.dropped = dropped,
+};
+
+LOG_BACKEND_DEFINE(backend, log_backend_test_api, false);
+
+static void logger(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	uint32_t cyc;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* Start all threads at once so that they contend on the logger. */
+	atomic_inc(&ready);
+	while (!atomic_get(&go)) {
+	}
+
+	cyc = k_cycle_get_32();
+	for (int i = 0; i < LOG_CALLS; i++) {
+		LOG_ERR("test %d %d", id, i);
+	}
+	cycles[id] = k_cycle_get_32() - cyc;
+}
+
+static uint32_t run_contended(int num_threads)
+{
+	uint32_t total_cyc = 0;
+
+	log_core_init();
+	log_init();
+	z_log_dropped_read_and_clear();
+	total_drops = 0;
+
+	atomic_clear(&ready);
+	atomic_clear(&go);
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, logger,
+				INT_TO_POINTER(i), NULL, NULL,
+				k_thread_priority_get(k_current_get()) + 1, 0, K_NO_WAIT);
+	}
+
+	/* Loggers have lower priority, sleep to let them all get ready. */
+	while (atomic_get(&ready) < num_threads) {
+		k_msleep(1);
+	}
+
+	atomic_set(&go, 1);
+
+	for (int i = 0; i < num_threads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total_cyc += cycles[i];
+	}
+
+	while (log_process()) {
+	}
+
+	zassert_equal(total_drops, 0, "Messages dropped, buffer too small");
+
+	return total_cyc / (num_threads * LOG_CALLS);
+}
+
+ZTEST(test_log_benchmark_smp, test_log_contended_store_time)
+{
+	for (int n = 1; n <= NUM_THREADS; n++) {
+		uint32_t cyc = run_contended(n);
+
+		PRINT("%d concurrent logging thread(s): %u cycles (%u ns) per log call\n",
+		      n, cyc, k_cyc_to_ns_ceil32(cyc));
+	}
+}
+
+static void *log_benchmark_setup(void)
+{
+	log_backend_enable(&backend, NULL, LOG_LEVEL_DBG);
+
+	PRINT("CPUS: %d\n", arch_num_cpus());
+	PRINT("\tPER_CPU_BUFFERS: %d\n", IS_ENABLED(CONFIG_LOG_PER_CPU_BUFFERS));
+	PRINT("\tBUFFER_SIZE: %d\n", CONFIG_LOG_BUFFER_SIZE);
+
+	return NULL;
+}
+
+ZTEST_SUITE(test_log_benchmark_smp, NULL, log_benchmark_setup, NULL, NULL, NULL);
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2023 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test framed dictionary based log output
+ */
+
+#include <zephyr/logging/log_output.h>
+#include <zephyr/logging/log_output_dict.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+#include <string.h>
+
+#define FRAME_HDR_LEN 14
+#define MSG_HDR_LEN sizeof(struct log_dict_output_normal_msg_hdr_t)
+#define TIMESTAMP 0x5a5a1234
+
+static uint8_t mock_buffer[512];
+static uint32_t mock_len;
+static uint32_t mock_calls;
+/* Largest number of bytes taken by one call of the output function */
+static size_t mock_chunk;
+
+static uint8_t exp_buffer[512];
+static uint32_t exp_len;
+
+static uint8_t log_output_buf[64];
+
+static struct log_dict_output_frame frame;
+
+static union {
+	struct log_msg msg;
+	uint8_t buf[sizeof(struct log_msg) + 64];
+} msg_buf;
+
+static int mock_output_func(uint8_t *buf, size_t size, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	size = MIN(size, mock_chunk);
+	zassert_true(mock_len + size <= sizeof(mock_buffer));
+	memcpy(&mock_buffer[mock_len], buf, size);
+	mock_len += size;
+	mock_calls++;
+
+	return size;
+}
+
+LOG_OUTPUT_DEFINE(log_output, mock_output_func,
+		  log_output_buf, sizeof(log_output_buf));
+
+static struct log_msg *msg_create(size_t pkg_len, size_t data_len)
+{
+	struct log_msg *msg = &msg_buf.msg;
+
+	zassert_true(pkg_len + data_len <= sizeof(msg_buf) - sizeof(*msg));
+
+	memset(&msg_buf, 0, sizeof(msg_buf));
+	msg->hdr.desc.domain = 1;
+	msg->hdr.desc.level = LOG_LEVEL_WRN;
+	msg->hdr.desc.package_len = pkg_len;
+	msg->hdr.desc.data_len = data_len;
+	msg->hdr.timestamp = TIMESTAMP;
+
+	for (size_t i = 0; i < pkg_len + data_len; i++) {
+		msg->data[i] = 0x80 + i;
+	}
+
+	return msg;
+}
+
+static void exp_put(const void *data, size_t len)
+{
+	memcpy(&exp_buffer[exp_len], data, len);
+	exp_len += len;
+}
+
+/* Header fields in target byte order, at their documented offsets */
+static void exp_frame_hdr(uint16_t len, uint32_t seq, uint32_t dropped)
+{
+	uint8_t *hdr = &exp_buffer[exp_len];
+
+	exp_put((uint8_t []){ 'Z', 'L', 1, 0 }, 4);
+	exp_put(&len, sizeof(len));
+	exp_put(&seq, sizeof(seq));
+	exp_put(&dropped, sizeof(dropped));
+
+	zassert_equal(&exp_buffer[exp_len] - hdr, FRAME_HDR_LEN);
+}
+
+static void exp_frame_msg(struct log_msg *msg, uint32_t seq, uint32_t dropped)
+{
+	struct log_dict_output_normal_msg_hdr_t msg_hdr;
+	size_t len = msg->hdr.desc.package_len + msg->hdr.desc.data_len;
+
+	memset(&msg_hdr, 0, sizeof(msg_hdr));
+	msg_hdr.type = MSG_NORMAL;
+	msg_hdr.domain = 1;
+	msg_hdr.level = LOG_LEVEL_WRN;
+	msg_hdr.package_len = msg->hdr.desc.package_len;
+	msg_hdr.data_len = msg->hdr.desc.data_len;
+	msg_hdr.source = 0;
+	msg_hdr.timestamp = TIMESTAMP;
+
+	exp_frame_hdr(MSG_HDR_LEN + len, seq, dropped);
+	exp_put(&msg_hdr, sizeof(msg_hdr));
+	exp_put(msg->data, len);
+}
+
+static void stream_verify(void)
+{
+	zassert_equal(mock_len, exp_len, "%u bytes output, %u expected", mock_len, exp_len);
+	zassert_mem_equal(mock_buffer, exp_buffer, exp_len);
+}
+
+static void log_output_dict_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(mock_buffer, 0, sizeof(mock_buffer));
+	mock_len = 0U;
+	mock_calls = 0U;
+	mock_chunk = SIZE_MAX;
+	exp_len = 0U;
+	memset(&frame, 0, sizeof(frame));
+}
+
+ZTEST(test_log_output_dict, test_frame_msg)
+{
+	struct log_msg *msg = msg_create(8, 4);
+
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 0, 0);
+
+	/* Passed in one call, to be sent in one datagram */
+	zassert_equal(mock_calls, 1);
+	stream_verify();
+
+	msg = msg_create(12, 0);
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 1, 0);
+
+	zassert_equal(mock_calls, 2);
+	stream_verify();
+	zassert_equal(frame.seq, 2);
+}
+
+ZTEST(test_log_output_dict, test_frame_msg_too_long)
+{
+	const size_t max_len = sizeof(log_output_buf) - FRAME_HDR_LEN - MSG_HDR_LEN;
+	struct log_msg *msg = msg_create(max_len, 0);
+
+	/* The largest message fitting in the output buffer */
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 0, 0);
+
+	/* A longer one is dropped without output nor frame */
+	msg = msg_create(max_len - 1, 2);
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+
+	zassert_equal(mock_calls, 1);
+	stream_verify();
+	zassert_equal(frame.seq, 1);
+	zassert_equal(frame.dropped, 1);
+
+	/* The next frame follows in sequence and reports the drop */
+	msg = msg_create(4, 4);
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 1, 1);
+
+	stream_verify();
+}
+
+ZTEST(test_log_output_dict, test_frame_dropped)
+{
+	struct log_msg *msg = msg_create(8, 0);
+
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 0, 0);
+
+	/* The total number of dropped messages is output without payload */
+	log_dict_output_frame_dropped_process(&log_output, &frame, 3);
+	exp_frame_hdr(0, 1, 3);
+
+	log_dict_output_frame_dropped_process(&log_output, &frame, 2);
+	exp_frame_hdr(0, 2, 5);
+
+	log_dict_output_frame_msg_process(&log_output, &frame, msg);
+	exp_frame_msg(msg, 3, 5);
+
+	zassert_equal(mock_calls, 4);
+	stream_verify();
+}
+
+ZTEST(test_log_output_dict, test_frame_partial_writes)
+{
+	struct log_msg *msg;
+
+	/* An output function taking a few bytes at a time gets the same stream */
+	mock_chunk = 5;
+
+	for (uint32_t i = 0; i < 4; i++) {
+		msg = msg_create(4 * i, i);
+		log_dict_output_frame_msg_process(&log_output, &frame, msg);
+		exp_frame_msg(msg, i, 0);
+	}
+
+	log_dict_output_frame_dropped_process(&log_output, &frame, 1);
+	exp_frame_hdr(0, 4, 1);
+
+	zassert_true(mock_calls > 5);
+	stream_verify();
+}
+
+ZTEST_SUITE(test_log_output_dict, NULL, NULL, log_output_dict_before, NULL, NULL);
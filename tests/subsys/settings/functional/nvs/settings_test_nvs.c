@@ -4,6 +4,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/ztest.h>
 #include <errno.h>
+#include <string.h>
 #include <zephyr/settings/settings.h>
 #include <zephyr/fs/nvs.h>
 
@@ -23,4 +24,129 @@ ZTEST(settings_functional, test_setting_storage_get)
 
 	zassert_true(nvs_rc >= 0, "Can't read nvs record (err=%d).", rc);
 }
+
+#if defined(CONFIG_SETTINGS_NVS_LOAD_INDEX)
+#include "settings/settings_nvs.h"
+
+struct load_index_keys {
+	unsigned int k1;
+	unsigned int k2;
+	unsigned int k3;
+	unsigned int other;
+};
+
+static int load_index_cb(const char *key, size_t len, settings_read_cb read_cb,
+			 void *cb_arg, void *param)
+{
+	struct load_index_keys *keys = param;
+
+	if (!strcmp(key, "k1")) {
+		keys->k1++;
+	} else if (!strcmp(key, "k2")) {
+		keys->k2++;
+	} else if (!strcmp(key, "k3")) {
+		keys->k3++;
+	} else {
+		keys->other++;
+	}
+
+	return 0;
+}
+
+static struct load_index_keys load_index_load(const char *subtree)
+{
+	struct load_index_keys keys = { 0 };
+	int rc;
+
+	rc = settings_load_subtree_direct(subtree, load_index_cb, &keys);
+	zassert_equal(0, rc, "settings_load_subtree_direct failed (err=%d)", rc);
+
+	return keys;
+}
+
+static uint16_t load_index_name_id(struct settings_nvs *cf, const char *name)
+{
+	char rdname[SETTINGS_MAX_NAME_LEN + 1];
+	ssize_t rc;
+
+	for (uint16_t id = NVS_NAMECNT_ID + 1; id <= cf->last_name_id; id++) {
+		rc = nvs_read(&cf->cf_nvs, id, rdname, sizeof(rdname) - 1);
+		if (rc <= 0) {
+			continue;
+		}
+
+		rdname[rc] = '\0';
+		if (!strcmp(name, rdname)) {
+			return id;
+		}
+	}
+
+	zassert_unreachable("%s not stored", name);
+
+	return 0;
+}
+
+ZTEST(settings_functional, test_setting_load_index)
+{
+	struct settings_nvs *cf;
+	struct load_index_keys keys;
+	void *storage;
+	uint16_t id;
+	uint8_t val = 0x5a;
+	int rc;
+
+	rc = settings_storage_get(&storage);
+	zassert_equal(0, rc, "Can't fetch storage reference (err=%d)", rc);
+	cf = CONTAINER_OF(storage, struct settings_nvs, cf_nvs);
+
+	zassert_equal(0, settings_save_one("lidx_a/k1", &val, sizeof(val)));
+	zassert_equal(0, settings_save_one("lidx_b/k1", &val, sizeof(val)));
+	zassert_equal(0, settings_save_one("lidx_a/k2", &val, sizeof(val)));
+
+	/* Index filled by the saves */
+	keys = load_index_load("lidx_a");
+	zassert_true(keys.k1 == 1 && keys.k2 == 1 && keys.other == 0);
+	keys = load_index_load("lidx_b");
+	zassert_true(keys.k1 == 1 && keys.k2 == 0 && keys.other == 0);
+
+	/* Freed name IDs are reused by new names of any subtree */
+	zassert_equal(0, settings_delete("lidx_a/k1"));
+	zassert_equal(0, settings_save_one("lidx_b/k3", &val, sizeof(val)));
+
+	keys = load_index_load("lidx_a");
+	zassert_true(keys.k1 == 0 && keys.k2 == 1 && keys.other == 0);
+	keys = load_index_load("lidx_b");
+	zassert_true(keys.k1 == 1 && keys.k3 == 1 && keys.other == 0);
+
+	/* Rename an entry behind the backend's back. Subtree loads trust the
+	 * index and do not read the entries of other subtrees, so the renamed
+	 * entry only shows up once the index is lost, as after a reboot.
+	 */
+	id = load_index_name_id(cf, "lidx_b/k1");
+	rc = nvs_write(&cf->cf_nvs, id, "lidx_a/k1", strlen("lidx_a/k1"));
+	zassert_true(rc >= 0, "Can't write nvs record (err=%d)", rc);
+
+	keys = load_index_load("lidx_a");
+	zassert_true(keys.k1 == 0 && keys.k2 == 1 && keys.other == 0,
+		     "entry of another subtree was read");
+
+	memset(cf->load_index, 0, sizeof(cf->load_index));
+
+	keys = load_index_load("lidx_a");
+	zassert_true(keys.k1 == 1 && keys.k2 == 1 && keys.other == 0,
+		     "index not rebuilt from storage");
+	keys = load_index_load("lidx_b");
+	zassert_true(keys.k1 == 0 && keys.k3 == 1 && keys.other == 0);
+
+	zassert_equal(0, settings_delete("lidx_a/k1"));
+	zassert_equal(0, settings_delete("lidx_a/k2"));
+	zassert_equal(0, settings_delete("lidx_b/k3"));
+
+	keys = load_index_load("lidx_a");
+	zassert_true(keys.k1 == 0 && keys.k2 == 0 && keys.other == 0);
+	keys = load_index_load("lidx_b");
+	zassert_true(keys.k1 == 0 && keys.k3 == 0 && keys.other == 0);
+}
+#endif /* CONFIG_SETTINGS_NVS_LOAD_INDEX */
+
 ZTEST_SUITE(settings_functional, NULL, NULL, NULL, NULL, NULL);
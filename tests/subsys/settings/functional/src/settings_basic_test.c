@@ -228,14 +228,6 @@ static struct settings_handler val3_settings = {
 	.h_commit = val3_commit,
 };
 
-/* helper routine to remove a handler from settings */
-int settings_deregister(struct settings_handler *handler)
-{
-	extern sys_slist_t settings_handlers;
-
-	return sys_slist_find_and_remove(&settings_handlers, &handler->node);
-}
-
 ZTEST(settings_functional, test_register_and_loading)
 {
 	int rc, err;
@@ -356,6 +348,52 @@ ZTEST(settings_functional, test_register_and_loading)
 	zassert_true(rc, "deregistering val3_settings failed");
 }
 
+static void check_lookup(const char *name, struct settings_handler *exp,
+			 const char *exp_next)
+{
+	struct settings_handler_static *ch;
+	const char *next;
+
+	ch = settings_parse_and_lookup(name, &next);
+	zassert_equal_ptr((struct settings_handler_static *)exp, ch,
+			  "wrong handler for %s", name);
+	if (exp_next) {
+		zassert_not_null(next, "no next for %s", name);
+		zassert_equal(0, strcmp(exp_next, next), "wrong next for %s: %s",
+			      name, next);
+	} else {
+		zassert_is_null(next, "unexpected next for %s", name);
+	}
+}
+
+ZTEST(settings_functional, test_parse_and_lookup)
+{
+	settings_subsys_init();
+
+	zassert_equal(0, settings_register(&val1_settings));
+	zassert_equal(0, settings_register(&val2_settings));
+	zassert_equal(0, settings_register(&val3_settings));
+
+	/* The handler with the longest matching name is found */
+	check_lookup("ps/ss/ss/val2", &val2_settings, "val2");
+	check_lookup("ps/ss/ss", &val2_settings, NULL);
+	check_lookup("ps/ss/x", &val3_settings, "x");
+	check_lookup("ps/ss=1", &val3_settings, NULL);
+	check_lookup("ps/ssx/ss", &val1_settings, "ssx/ss");
+	check_lookup("ps", &val1_settings, NULL);
+	check_lookup("p", NULL, NULL);
+	check_lookup("psx/ss", NULL, NULL);
+
+	zassert_true(settings_deregister(&val3_settings));
+	zassert_false(settings_deregister(&val3_settings));
+	check_lookup("ps/ss/x", &val1_settings, "ss/x");
+	check_lookup("ps/ss/ss/val2", &val2_settings, "val2");
+
+	zassert_true(settings_deregister(&val1_settings));
+	zassert_true(settings_deregister(&val2_settings));
+	check_lookup("ps/ss/ss/val2", NULL, NULL);
+}
+
 int val123_set(const char *key, size_t len,
 	       settings_read_cb read_cb, void *cb_arg)
 {
@@ -619,3 +657,214 @@ ZTEST(settings_functional, test_direct_loading_filter)
 	}
 	settings_deregister(&filtered_loader_settings);
 }
+
+#if defined(CONFIG_SETTINGS_TXN)
+#include "settings_priv.h"
+
+static struct {
+	uint8_t a;
+	uint8_t b;
+	unsigned int a_cnt;
+	unsigned int b_cnt;
+} txn_data;
+
+static int txn_set(const char *key, size_t len, settings_read_cb read_cb,
+		   void *cb_arg)
+{
+	uint8_t val;
+	int rc;
+
+	zassert_equal(1, len, "Unexpected size");
+
+	rc = read_cb(cb_arg, &val, sizeof(val));
+	zassert_equal(sizeof(val), rc, "read_cb failed");
+
+	if (!strcmp("a", key)) {
+		txn_data.a = val;
+		txn_data.a_cnt++;
+		return 0;
+	}
+	if (!strcmp("b", key)) {
+		txn_data.b = val;
+		txn_data.b_cnt++;
+		return 0;
+	}
+
+	zassert_unreachable("Unexpected key value: %s", key);
+
+	return 0;
+}
+
+static struct settings_handler txn_settings = {
+	.name = "txn",
+	.h_set = txn_set,
+};
+
+static void txn_load(void)
+{
+	int rc;
+
+	memset(&txn_data, 0, sizeof(txn_data));
+	rc = settings_load_subtree("txn");
+	zassert_equal(0, rc, "settings_load_subtree failed");
+}
+
+ZTEST(settings_functional, test_txn)
+{
+	static uint8_t big[CONFIG_SETTINGS_TXN_BUF_SIZE];
+	uint8_t val;
+	int rc;
+
+	settings_subsys_init();
+	rc = settings_register(&txn_settings);
+	zassert_true(rc == 0, "register of txn settings failed");
+
+	rc = settings_txn_commit();
+	zassert_equal(-EINVAL, rc, "commit without a transaction allowed");
+
+	/* Staged values are not stored before the commit */
+	rc = settings_txn_begin();
+	zassert_equal(0, rc, "settings_txn_begin failed");
+	rc = settings_txn_begin();
+	zassert_equal(-EBUSY, rc, "nested transaction allowed");
+
+	val = 1;
+	zassert_equal(0, settings_save_one("txn/a", &val, sizeof(val)));
+	val = 2;
+	zassert_equal(0, settings_save_one("txn/b", &val, sizeof(val)));
+	val = 3;
+	zassert_equal(0, settings_save_one("txn/a", &val, sizeof(val)));
+
+	txn_load();
+	zassert_equal(0, txn_data.a_cnt + txn_data.b_cnt,
+		      "staged values were stored");
+
+	rc = settings_txn_commit();
+	zassert_equal(0, rc, "settings_txn_commit failed");
+
+	/* Only the last staged value of a key is stored */
+	txn_load();
+	zassert_equal(1, txn_data.a_cnt);
+	zassert_equal(3, txn_data.a);
+	zassert_equal(1, txn_data.b_cnt);
+	zassert_equal(2, txn_data.b);
+
+	/* Aborted transactions do not change the storage */
+	zassert_equal(0, settings_txn_begin());
+	val = 4;
+	zassert_equal(0, settings_save_one("txn/a", &val, sizeof(val)));
+	zassert_equal(0, settings_delete("txn/b"));
+	zassert_equal(0, settings_txn_abort());
+	zassert_equal(-EINVAL, settings_txn_abort());
+
+	txn_load();
+	zassert_equal(3, txn_data.a);
+	zassert_equal(2, txn_data.b);
+
+	/* Deletes are staged too, a value which does not fit is refused */
+	zassert_equal(0, settings_txn_begin());
+	zassert_equal(0, settings_delete("txn/b"));
+	rc = settings_save_one("txn/a", big, sizeof(big));
+	zassert_equal(-ENOMEM, rc, "oversized value staged");
+	zassert_equal(0, settings_txn_commit());
+
+	txn_load();
+	zassert_equal(1, txn_data.a_cnt);
+	zassert_equal(3, txn_data.a);
+	zassert_equal(0, txn_data.b_cnt, "deleted value loaded");
+
+	settings_deregister(&txn_settings);
+}
+
+/* Append a record of the transaction journal format to buf. */
+static size_t txn_journal_add(uint8_t *buf, const char *name,
+			      const void *value, uint16_t val_len)
+{
+	size_t name_len = strlen(name) + 1;
+
+	memcpy(buf, name, name_len);
+	memcpy(buf + name_len, &val_len, sizeof(val_len));
+	if (val_len) {
+		memcpy(buf + name_len + sizeof(val_len), value, val_len);
+	}
+
+	return name_len + sizeof(val_len) + val_len;
+}
+
+static int txn_journal_cb(const char *key, size_t len,
+			  settings_read_cb read_cb, void *cb_arg, void *param)
+{
+	unsigned int *cnt = param;
+
+	(*cnt)++;
+
+	return 0;
+}
+
+static unsigned int txn_journal_count(void)
+{
+	unsigned int cnt = 0;
+	int rc;
+
+	rc = settings_load_subtree_direct("settings/txn", txn_journal_cb, &cnt);
+	zassert_equal(0, rc, "settings_load_subtree_direct failed");
+
+	return cnt;
+}
+
+ZTEST(settings_functional, test_txn_recover)
+{
+	uint8_t journal[32];
+	size_t len;
+	uint8_t val;
+	int rc;
+
+	settings_subsys_init();
+	rc = settings_register(&txn_settings);
+	zassert_true(rc == 0, "register of txn settings failed");
+
+	val = 1;
+	zassert_equal(0, settings_save_one("txn/a", &val, sizeof(val)));
+	zassert_equal(0, settings_save_one("txn/b", &val, sizeof(val)));
+
+	/* A commit interrupted after its journal was stored is completed
+	 * by the first load after a reset.
+	 */
+	val = 7;
+	len = txn_journal_add(journal, "txn/a", &val, sizeof(val));
+	len += txn_journal_add(journal + len, "txn/b", NULL, 0);
+	zassert_equal(0, settings_save_one("settings/txn", journal, len));
+	settings_dst_register(settings_save_dst);
+
+	txn_load();
+	zassert_equal(1, txn_data.a_cnt);
+	zassert_equal(7, txn_data.a);
+	zassert_equal(0, txn_data.b_cnt, "deleted value loaded");
+	zassert_equal(0, txn_journal_count(), "journal not dropped");
+
+	/* A truncated journal is dropped without changing any value. */
+	val = 8;
+	len = txn_journal_add(journal, "txn/a", &val, sizeof(val));
+	zassert_equal(0, settings_save_one("settings/txn", journal, len - 1));
+	settings_dst_register(settings_save_dst);
+
+	txn_load();
+	zassert_equal(7, txn_data.a);
+	zassert_equal(0, txn_journal_count(), "journal not dropped");
+
+	/* A committed transaction leaves no journal behind. */
+	zassert_equal(0, settings_txn_begin());
+	val = 9;
+	zassert_equal(0, settings_save_one("txn/b", &val, sizeof(val)));
+	zassert_equal(0, settings_txn_commit());
+	zassert_equal(0, txn_journal_count(), "journal not dropped");
+
+	txn_load();
+	zassert_equal(7, txn_data.a);
+	zassert_equal(9, txn_data.b);
+
+	zassert_equal(0, settings_delete("txn/a"));
+	zassert_equal(0, settings_delete("txn/b"));
+	settings_deregister(&txn_settings);
+}
+#endif /* CONFIG_SETTINGS_TXN */
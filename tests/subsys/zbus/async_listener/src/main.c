@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+#define SLOW_LISTENER_MS 100
+#define ORDER_PUBS	 8
+
+struct seq_msg {
+	uint32_t seq;
+};
+
+static K_SEM_DEFINE(slow_done, 0, 1);
+
+static void slow_cb(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+
+	k_msleep(SLOW_LISTENER_MS);
+	k_sem_give(&slow_done);
+}
+
+ZBUS_ASYNC_LISTENER_DEFINE(slow_lis, slow_cb);
+
+ZBUS_CHAN_DEFINE(slow_chan,	/* Name */
+		 struct seq_msg, /* Message type */
+
+		 NULL,			    /* Validator */
+		 NULL,			    /* User data */
+		 ZBUS_OBSERVERS(slow_lis), /* observers */
+		 ZBUS_MSG_INIT(0)	    /* Initial value */
+);
+
+static void order_cb(const struct zbus_channel *chan);
+
+ZBUS_ASYNC_LISTENER_DEFINE(order_lis, order_cb);
+
+ZBUS_CHAN_DEFINE(chan_a,	/* Name */
+		 struct seq_msg, /* Message type */
+
+		 NULL,			     /* Validator */
+		 NULL,			     /* User data */
+		 ZBUS_OBSERVERS(order_lis), /* observers */
+		 ZBUS_MSG_INIT(0)	     /* Initial value */
+);
+
+ZBUS_CHAN_DEFINE(chan_b,	/* Name */
+		 struct seq_msg, /* Message type */
+
+		 NULL,			     /* Validator */
+		 NULL,			     /* User data */
+		 ZBUS_OBSERVERS(order_lis), /* observers */
+		 ZBUS_MSG_INIT(0)	     /* Initial value */
+);
+
+struct order_state {
+	atomic_t in_flight;
+	atomic_t calls;
+	uint32_t last_seq;
+	bool overlap;
+	bool reordered;
+};
+
+static struct order_state order_a, order_b;
+static K_SEM_DEFINE(order_done, 0, 2 * ORDER_PUBS);
+
+static void order_cb(const struct zbus_channel *chan)
+{
+	struct order_state *state = (chan == &chan_a) ? &order_a : &order_b;
+	struct seq_msg msg;
+
+	if (atomic_inc(&state->in_flight) != 0) {
+		state->overlap = true;
+	}
+
+	zassert_equal(zbus_chan_read(chan, &msg, K_MSEC(200)), 0, NULL);
+	if (msg.seq < state->last_seq) {
+		state->reordered = true;
+	}
+	state->last_seq = msg.seq;
+
+	k_busy_wait(200);
+
+	atomic_dec(&state->in_flight);
+	atomic_inc(&state->calls);
+	k_sem_give(&order_done);
+}
+
+#define BUSY_US 500
+
+static void busy_cb(const struct zbus_channel *chan)
+{
+	ARG_UNUSED(chan);
+
+	k_busy_wait(BUSY_US);
+}
+
+ZBUS_LISTENER_DEFINE(busy_lis, busy_cb);
+ZBUS_SUBSCRIBER_DEFINE(stats_sub, 4);
+
+ZBUS_CHAN_DEFINE(stats_chan,	/* Name */
+		 struct seq_msg, /* Message type */
+
+		 NULL,			    /* Validator */
+		 NULL,			    /* User data */
+		 ZBUS_OBSERVERS(busy_lis), /* observers */
+		 ZBUS_MSG_INIT(0)	    /* Initial value */
+);
+
+ZTEST(async_listener, test_publisher_not_delayed)
+{
+	struct seq_msg msg = {.seq = 1};
+	int64_t start = k_uptime_get();
+
+	zassert_equal(zbus_chan_pub(&slow_chan, &msg, K_MSEC(SLOW_LISTENER_MS / 2)), 0, NULL);
+	zassert_true(k_uptime_get() - start < SLOW_LISTENER_MS / 2,
+		     "publisher waited for the listener");
+
+	zassert_equal(k_sem_take(&slow_done, K_MSEC(5 * SLOW_LISTENER_MS)), 0,
+		      "listener not executed");
+}
+
+ZTEST(async_listener, test_order_per_channel)
+{
+	struct seq_msg msg;
+
+	for (uint32_t i = 1; i <= ORDER_PUBS; i++) {
+		msg.seq = i;
+		zassert_equal(zbus_chan_pub(&chan_a, &msg, K_MSEC(200)), 0, NULL);
+		zassert_equal(zbus_chan_pub(&chan_b, &msg, K_MSEC(200)), 0, NULL);
+	}
+
+	for (int i = 0; i < 2 * ORDER_PUBS; i++) {
+		zassert_equal(k_sem_take(&order_done, K_MSEC(500)), 0, "listener not executed");
+	}
+
+	zassert_equal(atomic_get(&order_a.calls), ORDER_PUBS, NULL);
+	zassert_equal(atomic_get(&order_b.calls), ORDER_PUBS, NULL);
+	zassert_false(order_a.overlap || order_b.overlap, "listener executed concurrently");
+	zassert_false(order_a.reordered || order_b.reordered, "notifications executed out of order");
+	zassert_equal(order_a.last_seq, ORDER_PUBS, NULL);
+	zassert_equal(order_b.last_seq, ORDER_PUBS, NULL);
+}
+
+ZTEST(async_listener, test_stats)
+{
+	struct zbus_observer_stats stats;
+	struct seq_msg msg = {0};
+
+	zassert_equal(zbus_obs_stats_reset(&busy_lis), 0, NULL);
+
+	for (int i = 0; i < 4; i++) {
+		zassert_equal(zbus_chan_pub(&stats_chan, &msg, K_MSEC(200)), 0, NULL);
+	}
+
+	zassert_equal(zbus_obs_stats_get(&busy_lis, &stats), 0, NULL);
+	zassert_equal(stats.count, 4, NULL);
+	zassert_true(stats.max_cycles >= k_us_to_cyc_floor32(BUSY_US), NULL);
+	zassert_true(stats.total_cycles >= 4ULL * k_us_to_cyc_floor32(BUSY_US), NULL);
+
+	zassert_equal(zbus_obs_stats_reset(&busy_lis), 0, NULL);
+	zassert_equal(zbus_obs_stats_get(&busy_lis, &stats), 0, NULL);
+	zassert_equal(stats.count, 0, NULL);
+	zassert_equal(stats.max_cycles, 0, NULL);
+
+	/* Async listeners are measured too */
+	zassert_equal(zbus_obs_stats_get(&slow_lis, &stats), 0, NULL);
+
+	zassert_equal(zbus_obs_stats_get(&stats_sub, &stats), -EINVAL, NULL);
+	zassert_equal(zbus_obs_stats_get(NULL, &stats), -EFAULT, NULL);
+	zassert_equal(zbus_obs_stats_get(&busy_lis, NULL), -EFAULT, NULL);
+}
+
+ZTEST_SUITE(async_listener, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2023 The Zephyr Project Contributors
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/zbus/zbus.h>
+#include <zephyr/ztest.h>
+LOG_MODULE_DECLARE(zbus, CONFIG_ZBUS_LOG_LEVEL);
+
+#define RING_LEN 4
+
+struct sample_msg {
+	uint32_t seq;
+	uint32_t payload;
+};
+
+ZBUS_CHAN_RING_DEFINE(ring_chan,	  /* Name */
+		      struct sample_msg, /* Message type */
+
+		      NULL,		    /* Validator */
+		      NULL,		    /* User data */
+		      ZBUS_OBSERVERS_EMPTY, /* observers */
+		      ZBUS_MSG_INIT(0),	    /* Initial value */
+		      RING_LEN		    /* Ring length */
+);
+
+ZBUS_CHAN_DEFINE(plain_chan,	     /* Name */
+		 struct sample_msg, /* Message type */
+
+		 NULL,		       /* Validator */
+		 NULL,		       /* User data */
+		 ZBUS_OBSERVERS_EMPTY, /* observers */
+		 ZBUS_MSG_INIT(0)      /* Initial value */
+);
+
+static void publish(uint32_t from, uint32_t count)
+{
+	struct sample_msg msg;
+
+	for (uint32_t i = from; i < from + count; i++) {
+		msg.seq = i;
+		msg.payload = i * 3;
+		zassert_equal(zbus_chan_pub(&ring_chan, &msg, K_MSEC(200)), 0, NULL);
+	}
+}
+
+ZTEST(msg_ring, test_invalid_params)
+{
+	struct zbus_ring_cursor cursor;
+	struct sample_msg msg;
+	const void *slot;
+
+	zassert_equal(zbus_ring_cursor_init(&cursor, &plain_chan, K_NO_WAIT), -EINVAL, NULL);
+	zassert_equal(zbus_ring_cursor_init(NULL, &ring_chan, K_NO_WAIT), -EFAULT, NULL);
+	zassert_equal(zbus_ring_cursor_init(&cursor, NULL, K_NO_WAIT), -EFAULT, NULL);
+
+	zassert_equal(zbus_ring_cursor_init(&cursor, &ring_chan, K_NO_WAIT), 0, NULL);
+	zassert_equal(zbus_ring_claim(&cursor, NULL, K_NO_WAIT), -EFAULT, NULL);
+	zassert_equal(zbus_ring_read(&cursor, NULL, K_NO_WAIT), -EFAULT, NULL);
+	zassert_equal(zbus_ring_claim(&cursor, &slot, K_NO_WAIT), -ENODATA, NULL);
+	zassert_equal(zbus_ring_read(&cursor, &msg, K_NO_WAIT), -ENODATA, NULL);
+}
+
+ZTEST(msg_ring, test_read_in_order)
+{
+	struct zbus_ring_cursor cursor;
+	struct sample_msg msg;
+
+	zassert_equal(zbus_ring_cursor_init(&cursor, &ring_chan, K_NO_WAIT), 0, NULL);
+
+	publish(10, RING_LEN);
+
+	for (uint32_t i = 10; i < 10 + RING_LEN; i++) {
+		zassert_equal(zbus_ring_read(&cursor, &msg, K_NO_WAIT), 0, NULL);
+		zassert_equal(msg.seq, i, "read %u, expected %u", msg.seq, i);
+		zassert_equal(msg.payload, i * 3, NULL);
+	}
+	zassert_equal(zbus_ring_read(&cursor, &msg, K_NO_WAIT), -ENODATA, NULL);
+	zassert_equal(cursor.lost, 0, NULL);
+
+	/* The channel keeps the latest message as usual */
+	zassert_equal(zbus_chan_read(&ring_chan, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.seq, 10 + RING_LEN - 1, NULL);
+}
+
+ZTEST(msg_ring, test_overrun)
+{
+	struct zbus_ring_cursor cursor;
+	struct sample_msg msg;
+
+	zassert_equal(zbus_ring_cursor_init(&cursor, &ring_chan, K_NO_WAIT), 0, NULL);
+
+	publish(100, RING_LEN + 3);
+
+	/* The three oldest messages were overwritten */
+	for (uint32_t i = 103; i < 100 + RING_LEN + 3; i++) {
+		zassert_equal(zbus_ring_read(&cursor, &msg, K_NO_WAIT), 0, NULL);
+		zassert_equal(msg.seq, i, "read %u, expected %u", msg.seq, i);
+	}
+	zassert_equal(cursor.lost, 3, NULL);
+	zassert_equal(zbus_ring_read(&cursor, &msg, K_NO_WAIT), -ENODATA, NULL);
+}
+
+ZTEST(msg_ring, test_independent_cursors)
+{
+	struct zbus_ring_cursor fast, slow;
+	struct sample_msg msg;
+
+	zassert_equal(zbus_ring_cursor_init(&fast, &ring_chan, K_NO_WAIT), 0, NULL);
+	zassert_equal(zbus_ring_cursor_init(&slow, &ring_chan, K_NO_WAIT), 0, NULL);
+
+	publish(200, 2);
+	zassert_equal(zbus_ring_read(&fast, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.seq, 200, NULL);
+	zassert_equal(zbus_ring_read(&fast, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.seq, 201, NULL);
+
+	publish(202, 2);
+	zassert_equal(zbus_ring_read(&fast, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.seq, 202, NULL);
+
+	for (uint32_t i = 200; i < 204; i++) {
+		zassert_equal(zbus_ring_read(&slow, &msg, K_NO_WAIT), 0, NULL);
+		zassert_equal(msg.seq, i, NULL);
+	}
+	zassert_equal(slow.lost, 0, NULL);
+
+	zassert_equal(zbus_ring_read(&fast, &msg, K_NO_WAIT), 0, NULL);
+	zassert_equal(msg.seq, 203, NULL);
+}
+
+static struct k_sem publisher_done;
+
+static void publisher_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	struct sample_msg msg = {.seq = 300};
+
+	zassert_equal(zbus_chan_pub(&ring_chan, &msg, K_MSEC(50)), -EAGAIN,
+		      "publishing must wait for the claimed message");
+	k_sem_give(&publisher_done);
+}
+
+K_THREAD_STACK_DEFINE(publisher_stack, 1024);
+static struct k_thread publisher;
+
+ZTEST(msg_ring, test_claim_in_place)
+{
+	struct zbus_ring_cursor cursor;
+	const struct sample_msg *slot;
+
+	zassert_equal(zbus_ring_cursor_init(&cursor, &ring_chan, K_NO_WAIT), 0, NULL);
+
+	publish(400, 1);
+
+	zassert_equal(zbus_ring_claim(&cursor, (const void **)&slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(slot->seq, 400, NULL);
+	zassert_equal(slot->payload, 1200, NULL);
+
+	/* The claimed message cannot be overwritten */
+	k_sem_init(&publisher_done, 0, 1);
+	k_thread_create(&publisher, publisher_stack, K_THREAD_STACK_SIZEOF(publisher_stack),
+			publisher_thread, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+	zassert_equal(k_sem_take(&publisher_done, K_MSEC(500)), 0, NULL);
+	zassert_equal(slot->seq, 400, NULL);
+
+	zassert_equal(zbus_ring_finish(&cursor), 0, NULL);
+	zassert_equal(zbus_ring_claim(&cursor, (const void **)&slot, K_NO_WAIT), -ENODATA, NULL);
+}
+
+ZTEST_SUITE(msg_ring, NULL, NULL, NULL, NULL, NULL);